@@ -19,11 +19,9 @@
 #include "codec2/codec2_func.h"
 #include "alsa/alsa_func.h"
 
-// ring buffer size defines
-// 4MB
-#define BUFFSIZE  (1 << 22)
-// 1MB
-#define DATACHUNK (1 << 20)
+// ring buffer and chunk sizes are computed from the ALSA rate at setup
+#define BUFFSIZE  DSP_SIZE_AUTO
+#define DATACHUNK DSP_SIZE_AUTO
 
 void help();
 
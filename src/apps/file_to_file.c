@@ -14,6 +14,7 @@
 
 // local includes
 #include "dsp_node.h"
+#include "dsp_graph.h"
 #include "kill_throbber.h"
 #include "file/file_func.h"
 
@@ -38,6 +39,7 @@ int main(int argc, char *argv[])
   char *p_read_file = NULL;
   
   // structs
+  struct s_dsp_graph *p_graph = NULL;
   struct s_dsp_node *p_file_read_node;
   struct s_dsp_node *p_file_write_node;
   struct s_file_func_args *p_file_func_write_args;
@@ -84,49 +86,36 @@ int main(int argc, char *argv[])
 
   if(!p_file_func_read_args) goto cleanup_write_args;
 
-  p_file_read_node = dsp_create(BUFFSIZE, DATACHUNK);
+  p_graph = dsp_graphCreate();
 
-  if(!p_file_read_node) goto cleanup_read_args;
+  if(!p_graph) goto cleanup_read_args;
 
-  p_file_write_node = dsp_create(BUFFSIZE, DATACHUNK);
+  p_file_read_node = dsp_graphAdd(p_graph, BUFFSIZE, DATACHUNK, init_callback_file_read, pthread_function_file_read, free_callback_file_read, p_file_func_read_args);
 
-  if(!p_file_write_node) goto cleanup_read;
+  if(!p_file_read_node) goto cleanup_graph;
 
-  error = dsp_setup(p_file_read_node, init_callback_file_read, pthread_function_file_read, free_callback_file_read, p_file_func_read_args);
+  p_file_write_node = dsp_graphAdd(p_graph, BUFFSIZE, DATACHUNK, init_callback_file_write, pthread_function_file_write, free_callback_file_write, p_file_func_write_args);
 
-  if(error) goto cleanup_write;
-  
-  error = dsp_setup(p_file_write_node, init_callback_file_write, pthread_function_file_write, free_callback_file_write, p_file_func_write_args);
-
-  if(error) goto cleanup_write;
-
-  error = dsp_setInput(p_file_write_node, p_file_read_node);
-
-  if(error) goto cleanup_write;
+  if(!p_file_write_node) goto cleanup_graph;
 
-  error = dsp_start(p_file_read_node);
+  error = dsp_graphConnect(p_graph, p_file_read_node, p_file_write_node, 0);
 
-  if(error) goto cleanup_write;
+  if(error) goto cleanup_graph;
 
-  error = dsp_start(p_file_write_node);
+  error = dsp_graphStart(p_graph);
 
-  if(error) goto cleanup_write;
+  if(error) goto cleanup_graph;
 
   kill_throbber_start();
 
-  kill_throbber_wait();
-
-  error = dsp_wait(p_file_read_node);
+  error = dsp_graphWait(p_graph);
 
-  if(error) goto cleanup_write;
+  kill_throbber_end();
 
-  error = dsp_wait(p_file_write_node);
-
-cleanup_write:
-  dsp_cleanup(p_file_write_node);
+  kill_throbber_wait();
 
-cleanup_read:
-  dsp_cleanup(p_file_read_node);
+cleanup_graph:
+  dsp_graphCleanup(p_graph);
 
 cleanup_read_args:
   free_file_args(p_file_func_read_args);
@@ -14,6 +14,7 @@
 
 // local includes
 #include "dsp_node.h"
+#include "dsp_graph.h"
 #include "kill_throbber.h"
 #include "file/file_func.h"
 #include "codec2/codec2_func.h"
@@ -43,6 +44,7 @@ int main(int argc, char *argv[])
   char *p_read_file = NULL;
   
   // structs
+  struct s_dsp_graph *p_graph = NULL;
   struct s_dsp_node *p_file_read_node;
   struct s_dsp_node *p_codec2_mod_node;
   struct s_dsp_node *p_file_write_node;
@@ -105,91 +107,52 @@ int main(int argc, char *argv[])
 
   if(!p_codec2_mod_func_args) goto cleanup_read_args;
 
-  p_file_read_node = dsp_create(BUFFSIZE, DATACHUNK);
+  p_graph = dsp_graphCreate();
 
-  if(!p_file_read_node) goto cleanup_codec2_args;
+  if(!p_graph) goto cleanup_codec2_args;
 
-  p_codec2_mod_node = dsp_create(BUFFSIZE, DATACHUNK);
+  p_file_read_node = dsp_graphAdd(p_graph, BUFFSIZE, DATACHUNK, init_callback_file_read, pthread_function_file_read, free_callback_file_read, p_file_func_read_args);
 
-  if(!p_codec2_mod_node) goto cleanup_read;
+  if(!p_file_read_node) goto cleanup_graph;
 
-  p_file_write_node = dsp_create(BUFFSIZE, DATACHUNK);
+  p_codec2_mod_node = dsp_graphAdd(p_graph, BUFFSIZE, DATACHUNK, init_callback_codec2_mod, pthread_function_codec2_mod, free_callback_codec2_mod, p_codec2_mod_func_args);
 
-  if(!p_file_write_node) goto cleanup_codec2;
+  if(!p_codec2_mod_node) goto cleanup_graph;
 
-  p_soxr_node = dsp_create(BUFFSIZE, RESAMPCHUNK);
+  p_soxr_node = dsp_graphAdd(p_graph, BUFFSIZE, RESAMPCHUNK, init_callback_soxr, pthread_function_soxr, free_callback_soxr, p_soxr_func_args);
 
-  if(!p_soxr_node) goto cleanup_write;
+  if(!p_soxr_node) goto cleanup_graph;
 
-  error = dsp_setup(p_file_read_node, init_callback_file_read, pthread_function_file_read, free_callback_file_read, p_file_func_read_args);
+  p_file_write_node = dsp_graphAdd(p_graph, BUFFSIZE, DATACHUNK, init_callback_file_write, pthread_function_file_write, free_callback_file_write, p_file_func_write_args);
 
-  if(error) goto cleanup_soxr;
+  if(!p_file_write_node) goto cleanup_graph;
 
-  error = dsp_setup(p_soxr_node, init_callback_soxr, pthread_function_soxr, free_callback_soxr, p_soxr_func_args);
+  error = dsp_graphConnect(p_graph, p_file_read_node, p_codec2_mod_node, 0);
 
-  if(error) goto cleanup_soxr;
+  if(error) goto cleanup_graph;
 
-  error = dsp_setup(p_codec2_mod_node, init_callback_codec2_mod, pthread_function_codec2_mod, free_callback_codec2_mod, p_codec2_mod_func_args);
+  error = dsp_graphConnect(p_graph, p_codec2_mod_node, p_soxr_node, 0);
 
-  if(error) goto cleanup_soxr;
-  
-  error = dsp_setup(p_file_write_node, init_callback_file_write, pthread_function_file_write, free_callback_file_write, p_file_func_write_args);
-
-  if(error) goto cleanup_soxr;
-
-  error = dsp_setInput(p_codec2_mod_node, p_file_read_node);
-
-  if(error) goto cleanup_soxr;
-
-  error = dsp_setInput(p_soxr_node, p_codec2_mod_node);
-
-  if(error) goto cleanup_soxr;
-
-  error = dsp_setInput(p_file_write_node, p_soxr_node);
-
-  if(error) goto cleanup_soxr;
-
-  error = dsp_start(p_file_read_node);
+  if(error) goto cleanup_graph;
 
-  if(error) goto cleanup_soxr;
+  error = dsp_graphConnect(p_graph, p_soxr_node, p_file_write_node, 0);
 
-  error = dsp_start(p_soxr_node);
+  if(error) goto cleanup_graph;
 
-  if(error) goto cleanup_soxr;
+  error = dsp_graphStart(p_graph);
 
-  error = dsp_start(p_codec2_mod_node);
-
-  if(error) goto cleanup_soxr;
-
-  error = dsp_start(p_file_write_node);
-
-  if(error) goto cleanup_soxr;
+  if(error) goto cleanup_graph;
 
   kill_throbber_start();
 
-  error = dsp_wait(p_file_read_node);
-
-  error = dsp_wait(p_codec2_mod_node);
-
-  error = dsp_wait(p_soxr_node);
-
-  error = dsp_wait(p_file_write_node);
+  error = dsp_graphWait(p_graph);
 
   kill_throbber_end();
 
   kill_throbber_wait();
 
-cleanup_soxr:
-  dsp_cleanup(p_soxr_node);
-
-cleanup_write:
-  dsp_cleanup(p_file_write_node);
-
-cleanup_codec2:
-  dsp_cleanup(p_codec2_mod_node);
-
-cleanup_read:
-  dsp_cleanup(p_file_read_node);
+cleanup_graph:
+  dsp_graphCleanup(p_graph);
 
 cleanup_codec2_args:
   free_codec2_args(p_codec2_mod_func_args);
@@ -0,0 +1,876 @@
+//******************************************************************************
+/// @file     dsp_bench.c
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    benchmark each node type between a synthetic source and a null sink.
+/// @details  Every case is a graph description run over a sweep of chunk and
+///           buffer sizes, each node and edge is reported as CSV or JSON.
+//******************************************************************************
+
+// standard includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <getopt.h>
+#include <time.h>
+#include <signal.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+// local includes
+#include "dsp_node.h"
+#include "dsp_graph.h"
+#include "dsp_desc.h"
+#include "kill_throbber.h"
+
+// defaults
+#define BENCH_CHUNKS  "4k,64k,1m"
+#define BENCH_BUFFERS "1m,16m"
+#define BENCH_COUNT   (1UL << 26)
+#define BENCH_SECONDS 10
+#define BENCH_PORT    2000
+// poll of a running case, and polls without progress after the sources end before it is stopped.
+#define BENCH_POLL_NS 10000000L
+#define BENCH_IDLE    20
+
+// case needs a file to write, or a file of count elements to read.
+enum e_bench_file {BENCH_NO_FILE=0, BENCH_FILE_WRITE, BENCH_FILE_READ};
+
+// a benchmark case, src and sink are the bench nodes, dut the node under test.
+struct s_bench_case
+{
+  char const *p_name;
+  char const *p_desc;
+  enum e_bench_file file;
+  int tcp;
+};
+
+// options of a run.
+struct s_bench_opts
+{
+  unsigned long count;
+  unsigned long seconds;
+  unsigned short port;
+  char const *p_dir;
+  char **pp_sets;
+  int num_sets;
+  int json;
+};
+
+// loopback client of the tcp case, echos everything the server sends.
+struct s_bench_echo
+{
+  unsigned short port;
+  volatile int stop;
+  pthread_t thread;
+};
+
+static struct s_bench_case const g_bench_cases[] =
+{
+  {"ring_locked", "node src gen type=u8 ring=locked\nnode sink null type=u8\nedge src sink\n", BENCH_NO_FILE, 0},
+  {"ring_spsc", "node src gen type=u8 ring=spsc\nnode sink null type=u8\nedge src sink\n", BENCH_NO_FILE, 0},
+  {"convert_s16_float", "node src gen type=s16\nnode dut convert in=s16 out=float\nnode sink null type=float\nedge src dut\nedge dut sink\n", BENCH_NO_FILE, 0},
+  {"file_write", "node src gen type=u8\nnode dut file_write type=u8\nedge src dut\n", BENCH_FILE_WRITE, 0},
+  {"file_read", "node dut file_read type=u8\nnode sink null type=u8\nedge dut sink\n", BENCH_FILE_READ, 0},
+  {"codec2_mod", "node src gen type=u8\nnode dut codec2_mod type=s16\nnode sink null type=s16\nedge src dut\nedge dut sink\n", BENCH_NO_FILE, 0},
+  {"codec2_demod", "node src gen type=s16\nnode dut codec2_demod type=s16\nnode sink null type=u8\nedge src dut\nedge dut sink\n", BENCH_NO_FILE, 0},
+  {"soxr_48k_8k", "node src gen type=cfloat\nnode dut soxr in_rate=48000 out_rate=8000\nnode sink null type=cfloat\nedge src dut\nedge dut sink\n", BENCH_NO_FILE, 0},
+  {"soxr_8k_48k", "node src gen type=cfloat\nnode dut soxr in_rate=8000 out_rate=48000\nnode sink null type=cfloat\nedge src dut\nedge dut sink\n", BENCH_NO_FILE, 0},
+  {"soxr_44k1_48k", "node src gen type=cfloat\nnode dut soxr in_rate=44100 out_rate=48000\nnode sink null type=cfloat\nedge src dut\nedge dut sink\n", BENCH_NO_FILE, 0},
+  {"soxr_256k_8k", "node src gen type=cfloat\nnode dut soxr in_rate=256000 out_rate=8000\nnode sink null type=cfloat\nedge src dut\nedge dut sink\n", BENCH_NO_FILE, 0},
+  {"tcp_loopback", "node src gen type=u8\nnode dut tcp_send\nnode dut2 tcp_recv\nnode sink null type=u8\nedge src dut\nedge dut2 sink\n", BENCH_NO_FILE, 1},
+};
+
+#define BENCH_NUM_CASES (sizeof(g_bench_cases) / sizeof(g_bench_cases[0]))
+
+// ctrl+c ends the sweep after the current run.
+static volatile sig_atomic_t g_bench_stop = 0;
+
+void help();
+
+// run one case at one chunk and buffer size, print a row per node and edge.
+static int bench_run(struct s_bench_case const * const p_case, char const * const p_chunk, char const * const p_buffer, struct s_bench_opts const * const p_opts, FILE *p_out, int *p_rows);
+// print a row, CSV or a JSON object.
+static void bench_row(FILE *p_out, struct s_bench_opts const * const p_opts, int *p_rows, char const * const *pp_text, double const *p_values, int const *p_valid);
+// write a file of size bytes for the file read case.
+static int bench_file(char const * const p_path, unsigned long size);
+// number with a k, m or g binary multiple.
+static unsigned long bench_size(char const * const p_text);
+// monotonic or process cpu time in nanoseconds.
+static unsigned long long bench_now(clockid_t clock);
+// 1 if p_name is in the comma separated list p_list, every name for NULL.
+static int bench_selected(char const * const p_list, char const * const p_name);
+// ctrl+c
+static void bench_sig(int data);
+
+static void *bench_echo(void *p_data);
+
+// main :)
+int main(int argc, char *argv[])
+{
+  // varibles
+  int error = 0;
+  int opt   = 0;
+  int rows  = 0;
+  unsigned int index = 0;
+
+  // arrays
+  char *p_chunks  = NULL;
+  char *p_buffers = NULL;
+  char *p_cases   = NULL;
+  char *p_output  = NULL;
+
+  FILE *p_out = stdout;
+
+  // structs
+  struct s_bench_opts opts;
+
+  memset(&opts, 0, sizeof(opts));
+
+  opts.count = BENCH_COUNT;
+
+  opts.seconds = BENCH_SECONDS;
+
+  opts.port = BENCH_PORT;
+
+  opts.p_dir = "/tmp";
+
+  opts.pp_sets = calloc((size_t)argc, sizeof(char *));
+
+  if(!opts.pp_sets) return EXIT_FAILURE;
+
+  // get args
+  while((opt = getopt(argc, argv, "c:b:n:T:k:F:o:d:p:s:lh")) != -1)
+  {
+    switch(opt)
+    {
+      case 'c':
+        p_chunks = optarg;
+        break;
+      case 'b':
+        p_buffers = optarg;
+        break;
+      case 'n':
+        opts.count = bench_size(optarg);
+        break;
+      case 'T':
+        opts.seconds = strtoul(optarg, NULL, 0);
+        break;
+      case 'k':
+        p_cases = optarg;
+        break;
+      case 'F':
+        opts.json = !strcmp(optarg, "json");
+        break;
+      case 'o':
+        p_output = optarg;
+        break;
+      case 'd':
+        opts.p_dir = optarg;
+        break;
+      case 'p':
+        opts.port = (unsigned short)atoi(optarg);
+        break;
+      case 's':
+        opts.pp_sets[opts.num_sets++] = optarg;
+        break;
+      case 'l':
+        for(index = 0; index < BENCH_NUM_CASES; index++)
+        {
+          printf("%s\n", g_bench_cases[index].p_name);
+        }
+        free(opts.pp_sets);
+        return EXIT_SUCCESS;
+      case 'h':
+      default:
+        help();
+        free(opts.pp_sets);
+        return EXIT_SUCCESS;
+    }
+  }
+
+  p_chunks = strdup(p_chunks ? p_chunks : BENCH_CHUNKS);
+
+  p_buffers = strdup(p_buffers ? p_buffers : BENCH_BUFFERS);
+
+  if(!p_chunks || !p_buffers) goto cleanup_lists;
+
+  if(p_output)
+  {
+    p_out = fopen(p_output, "w");
+
+    if(!p_out)
+    {
+      fprintf(stderr, "ERROR: could not open %s, %s.\n", p_output, strerror(errno));
+
+      error = ~0;
+
+      goto cleanup_lists;
+    }
+  }
+
+  signal(SIGINT, bench_sig);
+
+  if(opts.json) fprintf(p_out, "[\n");
+
+  for(index = 0; (index < BENCH_NUM_CASES) && !g_bench_stop; index++)
+  {
+    char *p_chunk = NULL;
+    char *p_chunk_save = NULL;
+
+    if(!bench_selected(p_cases, g_bench_cases[index].p_name)) continue;
+
+    // strtok_r changes the list, work on a copy per case.
+    p_chunk = strdup(p_chunks);
+
+    if(!p_chunk) break;
+
+    for(char *p_c = strtok_r(p_chunk, ",", &p_chunk_save); p_c && !g_bench_stop; p_c = strtok_r(NULL, ",", &p_chunk_save))
+    {
+      char *p_buffer = strdup(p_buffers);
+      char *p_buffer_save = NULL;
+
+      if(!p_buffer) break;
+
+      for(char *p_b = strtok_r(p_buffer, ",", &p_buffer_save); p_b && !g_bench_stop; p_b = strtok_r(NULL, ",", &p_buffer_save))
+      {
+        fprintf(stderr, "INFO: %s chunk %s buffer %s\n", g_bench_cases[index].p_name, p_c, p_b);
+
+        if(bench_run(&g_bench_cases[index], p_c, p_b, &opts, p_out, &rows)) error = ~0;
+      }
+
+      free(p_buffer);
+    }
+
+    free(p_chunk);
+  }
+
+  if(opts.json) fprintf(p_out, "\n]\n");
+
+  if(p_out != stdout) fclose(p_out);
+
+cleanup_lists:
+  free(p_chunks);
+
+  free(p_buffers);
+
+  free(opts.pp_sets);
+
+  return (error ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+// help
+void help()
+{
+  printf("\n");
+
+  printf("Benchmark each node type between a synthetic source and a null sink.\n");
+
+  printf("-c:\tChunk sizes to sweep, comma separated (default %s).\n", BENCH_CHUNKS);
+  printf("-b:\tBuffer sizes to sweep, comma separated (default %s).\n", BENCH_BUFFERS);
+  printf("-n:\tElements the source writes per run (default %lu).\n", BENCH_COUNT);
+  printf("-T:\tSeconds a run may take before it is stopped (default %d).\n", BENCH_SECONDS);
+  printf("-k:\tCases to run, comma separated (default all, -l lists them).\n");
+  printf("-F:\tOutput format, csv (default) or json.\n");
+  printf("-o:\tOutput file (default stdout).\n");
+  printf("-d:\tDirectory for the file cases (default /tmp).\n");
+  printf("-p:\tPort for the tcp case (default %d).\n", BENCH_PORT);
+  printf("-s:\tSet a key in every run, name.key=value (graph.pool=2).\n");
+  printf("-l:\tList the cases.\n");
+  printf("-h:\tThis help information.\n");
+
+  printf("\n");
+}
+
+// run one case at one chunk and buffer size.
+static int bench_run(struct s_bench_case const * const p_case, char const * const p_chunk, char const * const p_buffer, struct s_bench_opts const * const p_opts, FILE *p_out, int *p_rows)
+{
+  int error = 0;
+  int idle  = 0;
+  int echo_started = 0;
+
+  unsigned int index = 0;
+  unsigned int line  = 0;
+
+  unsigned long long start_ns = 0;
+  unsigned long long stop_ns  = 0;
+  unsigned long long cpu_ns   = 0;
+  unsigned long long last_items = 0;
+
+  char path[256];
+  char set[DSP_DESC_LINE];
+
+  char *p_lines = NULL;
+  char *p_save  = NULL;
+  char *p_line  = NULL;
+
+  struct s_dsp_desc *p_desc = NULL;
+  struct s_dsp_graph *p_graph = NULL;
+
+  struct s_bench_echo echo;
+
+  struct timespec poll_time = {0, BENCH_POLL_NS};
+
+  snprintf(path, sizeof(path), "%s/dsp_bench_%s.bin", p_opts->p_dir, p_case->p_name);
+
+  p_desc = dsp_descCreate();
+
+  if(!p_desc) return ~0;
+
+  p_lines = strdup(p_case->p_desc);
+
+  if(!p_lines) goto error_cleanup;
+
+  for(p_line = strtok_r(p_lines, "\n", &p_save); p_line; p_line = strtok_r(NULL, "\n", &p_save))
+  {
+    char type[64];
+
+    line++;
+
+    // nodes of libraries that were not built skip the case.
+    if((sscanf(p_line, "node %*s %63s", type) == 1) && !dsp_descHasType(p_desc, type))
+    {
+      fprintf(stderr, "INFO: %s skipped, node type %s not built.\n", p_case->p_name, type);
+
+      goto cleanup;
+    }
+
+    if(dsp_descParse(p_desc, p_line, line)) goto error_cleanup;
+  }
+
+  for(index = 0; index < p_desc->num_nodes; index++)
+  {
+    char const *p_name = p_desc->p_nodes[index].p_name;
+
+    snprintf(set, sizeof(set), "%s.chunk=%s", p_name, p_chunk);
+
+    if(dsp_descSet(p_desc, set)) goto error_cleanup;
+
+    snprintf(set, sizeof(set), "%s.buffer=%s", p_name, p_buffer);
+
+    if(dsp_descSet(p_desc, set)) goto error_cleanup;
+
+    if(!strcmp(p_desc->p_nodes[index].p_type, "gen"))
+    {
+      snprintf(set, sizeof(set), "%s.count=%lu", p_name, p_opts->count);
+
+      if(dsp_descSet(p_desc, set)) goto error_cleanup;
+    }
+
+    if(!strncmp(p_desc->p_nodes[index].p_type, "tcp_", 4))
+    {
+      snprintf(set, sizeof(set), "%s.port=%u", p_name, p_opts->port);
+
+      if(dsp_descSet(p_desc, set)) goto error_cleanup;
+    }
+  }
+
+  if(p_case->file != BENCH_NO_FILE)
+  {
+    snprintf(set, sizeof(set), "dut.file=%s", path);
+
+    if(dsp_descSet(p_desc, set)) goto error_cleanup;
+  }
+
+  if((p_case->file == BENCH_FILE_READ) && bench_file(path, p_opts->count)) goto error_cleanup;
+
+  for(index = 0; index < (unsigned int)p_opts->num_sets; index++)
+  {
+    if(dsp_descSet(p_desc, p_opts->pp_sets[index])) goto error_cleanup;
+  }
+
+  p_graph = dsp_descBuild(p_desc);
+
+  if(!p_graph) goto error_cleanup;
+
+  if(p_case->tcp)
+  {
+    echo.port = p_opts->port;
+
+    echo.stop = 0;
+
+    if(pthread_create(&echo.thread, NULL, bench_echo, &echo)) goto error_cleanup;
+
+    echo_started = 1;
+  }
+
+  cpu_ns = bench_now(CLOCK_PROCESS_CPUTIME_ID);
+
+  start_ns = bench_now(CLOCK_MONOTONIC);
+
+  if(dsp_graphStart(p_graph)) goto error_cleanup;
+
+  // done when every node stopped, or the sources ended and nothing moved for a while (tcp never ends its reader).
+  for(;;)
+  {
+    int running = 0;
+    int sources = 0;
+
+    unsigned long long items = 0;
+
+    nanosleep(&poll_time, NULL);
+
+    for(index = 0; index < p_graph->num_nodes; index++)
+    {
+      struct s_dsp_stats stats;
+
+      struct s_dsp_node *p_node = p_graph->pp_nodes[index];
+
+      if(dsp_getState(p_node) != DSP_NODE_STOPPED)
+      {
+        running++;
+
+        if(p_node->input_type == DATA_INVALID) sources++;
+      }
+
+      if(!dsp_getStats(p_node, &stats)) items += stats.items_in + stats.items_out;
+    }
+
+    idle = ((items == last_items) ? idle + 1 : 0);
+
+    last_items = items;
+
+    if(!running) break;
+
+    if((!sources && (idle >= BENCH_IDLE)) || (bench_now(CLOCK_MONOTONIC) - start_ns >= p_opts->seconds * 1000000000ULL) || g_bench_stop)
+    {
+      kill_thread = 1;
+
+      break;
+    }
+  }
+
+  dsp_graphWait(p_graph);
+
+  stop_ns = bench_now(CLOCK_MONOTONIC);
+
+  cpu_ns = bench_now(CLOCK_PROCESS_CPUTIME_ID) - cpu_ns;
+
+  kill_thread = 0;
+
+  for(index = 0; index < p_graph->num_nodes; index++)
+  {
+    char name[64];
+
+    char const *p_text[5];
+
+    double values[17];
+
+    int valid[17];
+
+    unsigned int desc_index = 0;
+    unsigned int column = 0;
+
+    unsigned long items = 0;
+    unsigned long size  = 0;
+
+    double seconds = 0;
+
+    struct s_dsp_stats stats;
+    struct s_dsp_latency_stats latency;
+
+    struct s_dsp_node *p_node = p_graph->pp_nodes[index];
+
+    for(desc_index = 0; desc_index < p_desc->num_nodes; desc_index++)
+    {
+      if(p_desc->p_nodes[desc_index].p_node == p_node) break;
+    }
+
+    // converters the graph added are not in the description.
+    if(desc_index < p_desc->num_nodes)
+    {
+      snprintf(name, sizeof(name), "%s", p_desc->p_nodes[desc_index].p_name);
+    }
+    else
+    {
+      snprintf(name, sizeof(name), "node%u", index);
+    }
+
+    dsp_getStats(p_node, &stats);
+
+    items = ((p_node->input_type == DATA_INVALID) ? stats.items_out : stats.items_in);
+
+    size = ((p_node->input_type == DATA_INVALID) ? p_node->output_type_size : p_node->input_type_size);
+
+    if(stats.stop_ns > stats.start_ns) seconds = (double)(stats.stop_ns - stats.start_ns) / 1e9;
+
+    p_text[0] = p_case->p_name;
+    p_text[1] = p_chunk;
+    p_text[2] = p_buffer;
+    p_text[3] = "node";
+    p_text[4] = name;
+
+    memset(valid, 0, sizeof(valid));
+
+    values[column] = (double)items;
+    valid[column++] = 1;
+    values[column] = (double)(items * size);
+    valid[column++] = 1;
+    values[column] = seconds;
+    valid[column++] = 1;
+    values[column] = ((seconds > 0) ? (double)items / seconds : 0);
+    valid[column++] = 1;
+    values[column] = ((seconds > 0) ? (double)(items * size) / seconds / 1e6 : 0);
+    valid[column++] = 1;
+    values[column] = (double)cpu_ns * 100.0 / (double)(stop_ns - start_ns);
+    valid[column++] = 1;
+
+    // fill is a edge column.
+    column += 3;
+
+    if(!dsp_getLatency(p_node, &latency) && latency.count)
+    {
+      values[column] = (double)latency.p50_ns;
+      valid[column++] = 1;
+      values[column] = (double)latency.p99_ns;
+      valid[column++] = 1;
+      values[column] = (double)latency.p999_ns;
+      valid[column++] = 1;
+      values[column] = (double)latency.max_ns;
+      valid[column++] = 1;
+    }
+
+    // compute and the waits on each side, the node with the most compute holds the pipeline back.
+    column = 13;
+
+    if(stats.compute_ns + stats.input_wait_ns + stats.output_wait_ns)
+    {
+      double total_ns = (double)(stats.compute_ns + stats.input_wait_ns + stats.output_wait_ns);
+
+      values[column] = (double)stats.compute_ns * 100.0 / total_ns;
+      valid[column++] = 1;
+      values[column] = (double)stats.input_wait_ns * 100.0 / total_ns;
+      valid[column++] = 1;
+      values[column] = (double)stats.output_wait_ns * 100.0 / total_ns;
+      valid[column++] = 1;
+    }
+
+    bench_row(p_out, p_opts, p_rows, p_text, values, valid);
+  }
+
+  for(index = 0; index < p_graph->num_edges; index++)
+  {
+    char name[160];
+
+    char const *p_text[5];
+
+    double values[17];
+
+    int valid[17];
+
+    unsigned int desc_index = 0;
+
+    unsigned long items = 0;
+
+    double seconds = 0;
+
+    struct s_dsp_stats stats;
+    struct s_dsp_ring_fill fill;
+
+    struct s_dsp_graph_edge const *p_edge = &p_graph->p_edges[index];
+
+    char const *p_src = "node";
+    char const *p_dst = "node";
+
+    for(desc_index = 0; desc_index < p_desc->num_nodes; desc_index++)
+    {
+      if(p_desc->p_nodes[desc_index].p_node == p_edge->p_src) p_src = p_desc->p_nodes[desc_index].p_name;
+
+      if(p_desc->p_nodes[desc_index].p_node == p_edge->p_dst) p_dst = p_desc->p_nodes[desc_index].p_name;
+    }
+
+    snprintf(name, sizeof(name), "%s->%s:%u", p_src, p_dst, p_edge->port);
+
+    dsp_getStats(p_edge->p_dst, &stats);
+
+    // the reader counts every port, a single port reader is the edge.
+    items = ((p_edge->p_dst->num_input_ports == 1) ? stats.items_in : 0);
+
+    if(stats.stop_ns > stats.start_ns) seconds = (double)(stats.stop_ns - stats.start_ns) / 1e9;
+
+    p_text[0] = p_case->p_name;
+    p_text[1] = p_chunk;
+    p_text[2] = p_buffer;
+    p_text[3] = "edge";
+    p_text[4] = name;
+
+    memset(valid, 0, sizeof(valid));
+
+    values[0] = (double)items;
+    valid[0] = (p_edge->p_dst->num_input_ports == 1);
+    values[1] = (double)(items * p_edge->p_src->output_type_size);
+    valid[1] = valid[0];
+    values[2] = seconds;
+    valid[2] = 1;
+    values[3] = ((seconds > 0) ? (double)items / seconds : 0);
+    valid[3] = valid[0];
+    values[4] = ((seconds > 0) ? (double)(items * p_edge->p_src->output_type_size) / seconds / 1e6 : 0);
+    valid[4] = valid[0];
+
+    if(!dsp_getInputFill(p_edge->p_dst, p_edge->port, &fill) && fill.elapsed_ns)
+    {
+      values[6] = (double)fill.full_ns * 100.0 / (double)fill.elapsed_ns;
+      valid[6] = 1;
+      values[7] = (double)fill.empty_ns * 100.0 / (double)fill.elapsed_ns;
+      valid[7] = 1;
+      values[8] = (double)fill.high_water * 100.0 / (double)fill.size;
+      valid[8] = 1;
+    }
+
+    bench_row(p_out, p_opts, p_rows, p_text, values, valid);
+  }
+
+  goto cleanup;
+
+error_cleanup:
+  fprintf(stderr, "ERROR: %s chunk %s buffer %s failed.\n", p_case->p_name, p_chunk, p_buffer);
+
+  error = ~0;
+
+cleanup:
+  if(echo_started)
+  {
+    echo.stop = 1;
+
+    pthread_join(echo.thread, NULL);
+  }
+
+  dsp_descFree(p_desc);
+
+  free(p_lines);
+
+  if(p_case->file != BENCH_NO_FILE) unlink(path);
+
+  return error;
+}
+
+// print a row, CSV or a JSON object.
+static void bench_row(FILE *p_out, struct s_bench_opts const * const p_opts, int *p_rows, char const * const *pp_text, double const *p_values, int const *p_valid)
+{
+  static char const * const p_text_names[] = {"case", "chunk", "buffer", "kind", "name"};
+  static char const * const p_value_names[] = {"items", "bytes", "seconds", "items_per_s", "mb_per_s", "cpu_pct", "full_pct", "empty_pct", "high_water_pct", "p50_ns", "p99_ns", "p999_ns", "max_ns", "compute_pct", "input_wait_pct", "output_wait_pct"};
+
+  unsigned int index = 0;
+
+  if(!p_opts->json && !*p_rows)
+  {
+    for(index = 0; index < 5; index++) fprintf(p_out, "%s,", p_text_names[index]);
+
+    for(index = 0; index < 16; index++) fprintf(p_out, "%s%s", p_value_names[index], (index < 15 ? "," : "\n"));
+  }
+
+  if(p_opts->json)
+  {
+    fprintf(p_out, "%s  {", (*p_rows ? ",\n" : ""));
+
+    for(index = 0; index < 5; index++) fprintf(p_out, "\"%s\": \"%s\", ", p_text_names[index], pp_text[index]);
+
+    for(index = 0; index < 16; index++)
+    {
+      if(p_valid[index])
+      {
+        fprintf(p_out, "\"%s\": %.10g%s", p_value_names[index], p_values[index], (index < 15 ? ", " : "}"));
+      }
+      else
+      {
+        fprintf(p_out, "\"%s\": null%s", p_value_names[index], (index < 15 ? ", " : "}"));
+      }
+    }
+  }
+  else
+  {
+    for(index = 0; index < 5; index++) fprintf(p_out, "%s,", pp_text[index]);
+
+    for(index = 0; index < 16; index++)
+    {
+      if(p_valid[index]) fprintf(p_out, "%.10g", p_values[index]);
+
+      fprintf(p_out, "%s", (index < 15 ? "," : "\n"));
+    }
+  }
+
+  fflush(p_out);
+
+  (*p_rows)++;
+}
+
+// write a file of size bytes for the file read case.
+static int bench_file(char const * const p_path, unsigned long size)
+{
+  unsigned long index = 0;
+
+  unsigned char buffer[1 << 16];
+
+  FILE *p_file = fopen(p_path, "wb");
+
+  if(!p_file)
+  {
+    fprintf(stderr, "ERROR: could not create %s, %s.\n", p_path, strerror(errno));
+
+    return ~0;
+  }
+
+  for(index = 0; index < sizeof(buffer); index++) buffer[index] = (unsigned char)index;
+
+  for(index = 0; index < size; index += sizeof(buffer))
+  {
+    size_t length = ((size - index < sizeof(buffer)) ? (size_t)(size - index) : sizeof(buffer));
+
+    if(fwrite(buffer, 1, length, p_file) != length) break;
+  }
+
+  fclose(p_file);
+
+  return ((index < size) ? ~0 : 0);
+}
+
+// number with a k, m or g binary multiple.
+static unsigned long bench_size(char const * const p_text)
+{
+  char *p_end = NULL;
+
+  unsigned long size = strtoul(p_text, &p_end, 0);
+
+  switch(*p_end)
+  {
+    case 'g':
+    case 'G':
+      size <<= 10;
+      // fall through
+    case 'm':
+    case 'M':
+      size <<= 10;
+      // fall through
+    case 'k':
+    case 'K':
+      size <<= 10;
+      break;
+    default:
+      break;
+  }
+
+  return size;
+}
+
+// monotonic or process cpu time in nanoseconds.
+static unsigned long long bench_now(clockid_t clock)
+{
+  struct timespec now;
+
+  clock_gettime(clock, &now);
+
+  return ((unsigned long long)now.tv_sec * 1000000000ULL) + (unsigned long long)now.tv_nsec;
+}
+
+// 1 if p_name is in the comma separated list p_list.
+static int bench_selected(char const * const p_list, char const * const p_name)
+{
+  size_t length = strlen(p_name);
+
+  char const *p_temp = p_list;
+
+  if(!p_list) return 1;
+
+  while(p_temp && *p_temp)
+  {
+    if(!strncmp(p_temp, p_name, length) && ((p_temp[length] == ',') || (p_temp[length] == '\0'))) return 1;
+
+    p_temp = strchr(p_temp, ',');
+
+    if(p_temp) p_temp++;
+  }
+
+  return 0;
+}
+
+// ctrl+c
+static void bench_sig(int data)
+{
+  (void)data;
+
+  g_bench_stop = 1;
+
+  kill_thread = 1;
+}
+
+// loopback client of the tcp case, connects once the server listens and echos everything back.
+static void *bench_echo(void *p_data)
+{
+  int fd = -1;
+
+  unsigned char buffer[1 << 16];
+
+  struct s_bench_echo *p_echo = (struct s_bench_echo *)p_data;
+
+  struct sockaddr_in address;
+
+  struct timeval timeout = {0, 100000};
+
+  struct timespec retry = {0, BENCH_POLL_NS};
+
+  memset(&address, 0, sizeof(address));
+
+  address.sin_family = AF_INET;
+
+  address.sin_port = htons(p_echo->port);
+
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  while(!p_echo->stop)
+  {
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    if(fd < 0) return NULL;
+
+    if(!connect(fd, (struct sockaddr *)&address, sizeof(address))) break;
+
+    close(fd);
+
+    fd = -1;
+
+    nanosleep(&retry, NULL);
+  }
+
+  if(fd < 0) return NULL;
+
+  // a timeout so stop is seen while the server is quiet.
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  while(!p_echo->stop)
+  {
+    ssize_t sent = 0;
+    ssize_t length = recv(fd, buffer, sizeof(buffer), 0);
+
+    if(length == 0) break;
+
+    if(length < 0)
+    {
+      if((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) continue;
+
+      break;
+    }
+
+    while((sent < length) && !p_echo->stop)
+    {
+      ssize_t num = send(fd, buffer + sent, (size_t)(length - sent), MSG_NOSIGNAL);
+
+      if(num < 0)
+      {
+        if((errno == EAGAIN) || (errno == EINTR)) continue;
+
+        break;
+      }
+
+      sent += num;
+    }
+  }
+
+  close(fd);
+
+  return NULL;
+}
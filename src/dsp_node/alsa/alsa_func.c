@@ -10,7 +10,10 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include <errno.h>
+#include <poll.h>
 
+#include "dsp_node.h"
 #include "alsa_func.h"
 #include "kill_throbber.h"
 #include "logger.h"
@@ -19,6 +22,8 @@
 
 //convert alsa lib types to dsp node types
 enum e_binary_type convert_type(snd_pcm_format_t format);
+//wait till the pcm can be read or written, the node is ended or a poll period passed, returns 1 ready.
+static int alsa_wait(struct s_dsp_node * const p_dsp_node);
 
 // COMMON FUNCTIONS //
 
@@ -100,10 +105,20 @@ int init_callback_alsa_read(void *p_init_args, void *p_object)
     return ~0;
   }
 
+  //non blocking, the thread waits in alsa_wait where dsp_end can wake it.
+  error = snd_pcm_nonblock((snd_pcm_t *)p_dsp_node->p_data, 1);
+
+  if(error < 0) logger_warning_msg(p_dsp_node->p_logger, "ALSA READ NONBLOCK: %s", snd_strerror(error));
+
   p_dsp_node->input_type = DATA_INVALID;
 
   p_dsp_node->output_type = convert_type(p_alsa_args->format);
 
+  //interleaved, every frame is a element per channel.
+  p_dsp_node->output_rate = (double)p_alsa_args->rate * p_alsa_args->channels;
+
+  p_dsp_node->granularity = p_alsa_args->channels;
+
   logger_info_msg(p_dsp_node->p_logger, "ALSA, read node created for %p.", p_dsp_node);
 
   return 0;
@@ -112,7 +127,10 @@ int init_callback_alsa_read(void *p_init_args, void *p_object)
 //Pthread function for threading alsa read
 void* pthread_function_alsa_read(void *p_data)
 {
-  uint8_t *p_buffer = NULL;
+  unsigned long numElemReserved = 0;
+  unsigned long channels = 1;
+
+  void *p_buffer = NULL;
 
   struct s_dsp_node *p_dsp_node = NULL;
 
@@ -122,48 +140,57 @@ void* pthread_function_alsa_read(void *p_data)
   {
     fprintf(stderr, "ERROR: Data Struct is NULL.\n");
 
-    kill_thread = 1;
-
-    goto error_cleanup;
+    return NULL;
   }
 
   p_dsp_node->active = 1;
 
-  p_buffer = malloc(p_dsp_node->chunk_size * p_dsp_node->output_type_size);
-
-  if(!p_buffer)
-  {
-    logger_error_msg(p_dsp_node->p_logger, "ALSA, Could not allocate file read buffer");
-
-    kill_thread = 1;
-
-    goto error_cleanup;
-  }
-
   p_dsp_node->total_bytes_processed = 0;
 
+  //init set the granularity to the channels, a frame is a element per channel.
+  if(p_dsp_node->granularity > 1) channels = p_dsp_node->granularity;
+
   logger_info_msg(p_dsp_node->p_logger, "ALSA, read thread started.");
 
   do
   {
-    unsigned long numElemRead   = 0;
-    unsigned long numElemWrote  = 0;
+    snd_pcm_sframes_t numFrameRead = 0;
+
+    //nothing captured yet, check kill_thread and wait again, dsp_end wakes it at once.
+    if(!alsa_wait(p_dsp_node)) continue;
+
+    //capture straight into the output ring, 0 reserved means every consumer has ended.
+    numElemReserved = dsp_reserveOutputTimed(p_dsp_node, &p_buffer, (p_dsp_node->chunk_size > channels ? p_dsp_node->chunk_size / channels * channels : channels), dsp_deadline(DSP_NODE_POLL_MS));
 
-    numElemRead = (unsigned long)snd_pcm_readi((snd_pcm_t *)p_dsp_node->p_data, p_buffer, p_dsp_node->chunk_size);
+    //no space in time, check kill_thread and wait again, a overrun is recovered on the next read.
+    if(numElemReserved == DSP_NODE_TIMEOUT) continue;
 
-    p_dsp_node->total_bytes_processed += numElemRead * p_dsp_node->output_type_size;
+    if(!numElemReserved) break;
 
-    do
+    //the ring is a multiple of the frame, so whole frames are reserved and the wrap never splits one.
+    numFrameRead = snd_pcm_readi((snd_pcm_t *)p_dsp_node->p_data, p_buffer, numElemReserved / channels);
+
+    //woken with less then a period, nothing to commit.
+    if(numFrameRead == -EAGAIN) numFrameRead = 0;
+
+    if(numFrameRead < 0)
     {
-      numElemWrote += ringBufferBlockingWrite(p_dsp_node->p_output_ring_buffer, p_buffer + (numElemWrote * p_dsp_node->output_type_size), numElemRead - numElemWrote, NULL);
-    } while(numElemWrote < numElemRead);
+      logger_warning_msg(p_dsp_node->p_logger, "ALSA READ: %s", snd_strerror((int)numFrameRead));
 
-  } while(!kill_thread);
+      dsp_statsError(p_dsp_node);
 
-error_cleanup:
-  free(p_buffer);
+      numFrameRead = snd_pcm_recover((snd_pcm_t *)p_dsp_node->p_data, (int)numFrameRead, 0);
+
+      if(numFrameRead < 0) break;
+    }
+
+    p_dsp_node->total_bytes_processed += (unsigned long)numFrameRead * channels * p_dsp_node->output_type_size;
 
-  ringBufferEndBlocking(p_dsp_node->p_output_ring_buffer);
+    dsp_commitOutput(p_dsp_node, (unsigned long)numFrameRead * channels);
+
+  } while(!kill_thread && !dsp_isCancelled(p_dsp_node));
+
+  dsp_endOutput(p_dsp_node);
 
   logger_info_msg(p_dsp_node->p_logger, "ALSA, read thread finished.");
 
@@ -218,10 +245,20 @@ int init_callback_alsa_write(void *p_init_args, void *p_object)
     return ~0;
   }
 
+  //non blocking, the thread waits in alsa_wait where dsp_end can wake it.
+  error = snd_pcm_nonblock((snd_pcm_t *)p_dsp_node->p_data, 1);
+
+  if(error < 0) logger_warning_msg(p_dsp_node->p_logger, "ALSA WRITE NONBLOCK: %s", snd_strerror(error));
+
   p_dsp_node->output_type = DATA_INVALID;
 
   p_dsp_node->input_type = convert_type(p_alsa_args->format);
 
+  //interleaved, every frame is a element per channel.
+  p_dsp_node->input_rate = (double)p_alsa_args->rate * p_alsa_args->channels;
+
+  p_dsp_node->granularity = p_alsa_args->channels;
+
   logger_info_msg(p_dsp_node->p_logger, "ALSA, write node created for %p.", p_dsp_node);
 
   return 0;
@@ -231,8 +268,11 @@ int init_callback_alsa_write(void *p_init_args, void *p_object)
 void* pthread_function_alsa_write(void *p_data)
 {
   unsigned long numElemRead = 0;
+  unsigned long channels = 1;
 
-  uint8_t *p_buffer = NULL;
+  void const *p_buffer = NULL;
+
+  uint8_t *p_frame = NULL;
 
   struct s_dsp_node *p_dsp_node = NULL;
 
@@ -242,56 +282,103 @@ void* pthread_function_alsa_write(void *p_data)
   {
     fprintf(stderr, "ERROR: Data Struct is NULL.\n");
 
-    kill_thread = 1;
-
-    goto error_cleanup;
+    return NULL;
   }
 
   p_dsp_node->active = 1;
 
-  if(!p_dsp_node->p_input_ring_buffer)
+  if(!p_dsp_node->input_ports[0].p_ring_buffer)
   {
     logger_error_msg(p_dsp_node->p_logger, "ALSA, No input buffer set for file write!\n");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto error_cleanup;
   }
 
-  p_buffer = malloc(p_dsp_node->chunk_size * p_dsp_node->input_type_size);
+  p_dsp_node->total_bytes_processed = 0;
+
+  //init set the granularity to the channels, a frame is a element per channel.
+  if(p_dsp_node->granularity > 1) channels = p_dsp_node->granularity;
 
-  if(!p_buffer)
+  //the input ring belongs to upstream and may split a frame at its wrap, that frame is copied out here.
+  p_frame = malloc(channels * p_dsp_node->input_type_size);
+
+  if(!p_frame)
   {
-    logger_error_msg(p_dsp_node->p_logger, "ALSA, Could not allocate file read buffer");
+    logger_error_msg(p_dsp_node->p_logger, "ALSA, could not allocate a frame.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto error_cleanup;
   }
 
-  p_dsp_node->total_bytes_processed = 0;
-
   logger_info_msg(p_dsp_node->p_logger, "ALSA, write thread started.");
 
   do
   {
-    snd_pcm_sframes_t numFrameWrote = 0;
+    unsigned long numFrameWrote = 0;
+    unsigned long numFrame = 0;
 
-    numElemRead = ringBufferBlockingRead(p_dsp_node->p_input_ring_buffer, p_buffer, p_dsp_node->chunk_size, NULL);
+    int staged = 0;
 
-    p_dsp_node->total_bytes_processed += numElemRead * p_dsp_node->input_type_size;
+    //play straight out of the input ring, no staging buffer.
+    numElemRead = dsp_peekInputTimed(p_dsp_node, &p_buffer, p_dsp_node->chunk_size, dsp_deadline(DSP_NODE_POLL_MS));
 
-    do
+    //no data in time, check kill_thread and wait again, a underrun is recovered on the next write.
+    if(numElemRead == DSP_NODE_TIMEOUT) continue;
+
+    //less then a frame before the wrap, read the frame across it, a partial frame at the end is dropped.
+    if(numElemRead && (numElemRead < channels))
     {
-      numFrameWrote += snd_pcm_writei((snd_pcm_t *)p_dsp_node->p_data, p_buffer + (numFrameWrote * p_dsp_node->input_type_size), numElemRead - (unsigned long)numFrameWrote);
-    } while(numElemRead < (unsigned long)numFrameWrote);
+      numElemRead = dsp_readInput(p_dsp_node, p_frame, channels);
+
+      if(numElemRead < channels) break;
+
+      p_buffer = p_frame;
+
+      staged = 1;
+    }
+
+    numFrame = numElemRead / channels;
+
+    p_dsp_node->total_bytes_processed += numFrame * channels * p_dsp_node->input_type_size;
+
+    //a ended node drops what it could not play.
+    while((numFrameWrote < numFrame) && !kill_thread && !dsp_isCancelled(p_dsp_node))
+    {
+      snd_pcm_sframes_t numFrames = 0;
+
+      //device buffer full, dsp_end wakes the wait at once.
+      if(!alsa_wait(p_dsp_node)) continue;
+
+      numFrames = snd_pcm_writei((snd_pcm_t *)p_dsp_node->p_data, (uint8_t const *)p_buffer + (numFrameWrote * channels * p_dsp_node->input_type_size), numFrame - numFrameWrote);
+
+      if(numFrames == -EAGAIN) continue;
+
+      if(numFrames < 0)
+      {
+        logger_warning_msg(p_dsp_node->p_logger, "ALSA WRITE: %s", snd_strerror((int)numFrames));
+
+        dsp_statsError(p_dsp_node);
+
+        if(snd_pcm_recover((snd_pcm_t *)p_dsp_node->p_data, (int)numFrames, 0) < 0) break;
 
-  } while((numElemRead > 0) && !kill_thread);
+        continue;
+      }
+
+      numFrameWrote += (unsigned long)numFrames;
+    }
+
+    //whole frames go back to the ring, a staged frame was already read out of it.
+    if(!staged) dsp_releaseInput(p_dsp_node, numFrame * channels);
+
+  } while((numElemRead > 0) && !kill_thread && !dsp_isCancelled(p_dsp_node));
 
 error_cleanup:
-  free(p_buffer);
+  dsp_endInput(p_dsp_node);
 
-  ringBufferEndBlocking(p_dsp_node->p_input_ring_buffer);
+  free(p_frame);
 
   logger_info_msg(p_dsp_node->p_logger, "ALSA, write thread finished.");
 
@@ -307,6 +394,9 @@ int free_callback_alsa_write(void *p_object)
 
   p_dsp_node = (struct s_dsp_node *)p_object;
 
+  //blocking again, so close plays out what is left like it did before.
+  snd_pcm_nonblock((snd_pcm_t *)p_dsp_node->p_data, 0);
+
   return snd_pcm_close((snd_pcm_t *)p_dsp_node->p_data);
 }
 
@@ -333,3 +423,32 @@ enum e_binary_type convert_type(snd_pcm_format_t format)
 
   return DATA_UNKNOWN;
 }
+
+//wait till the pcm can be read or written, the node is ended or a poll period passed, returns 1 ready.
+static int alsa_wait(struct s_dsp_node * const p_dsp_node)
+{
+  int num_fds = 0;
+  int num_ready = 0;
+
+  unsigned short revents = 0;
+
+  struct pollfd alsa_poll[DSP_CANCEL_POLL_MAX];
+
+  num_fds = snd_pcm_poll_descriptors_count((snd_pcm_t *)p_dsp_node->p_data);
+
+  //a plugin with more fds then fit, wait on the pcm alone and see dsp_end a poll period later.
+  if((num_fds <= 0) || (num_fds > DSP_CANCEL_POLL_MAX)) return snd_pcm_wait((snd_pcm_t *)p_dsp_node->p_data, DSP_NODE_POLL_MS) != 0;
+
+  num_fds = snd_pcm_poll_descriptors((snd_pcm_t *)p_dsp_node->p_data, alsa_poll, (unsigned int)num_fds);
+
+  num_ready = dsp_poll(p_dsp_node, alsa_poll, (unsigned int)num_fds, dsp_deadline(DSP_NODE_POLL_MS));
+
+  if(num_ready < 0) return snd_pcm_wait((snd_pcm_t *)p_dsp_node->p_data, DSP_NODE_POLL_MS) != 0;
+
+  if(!num_ready) return 0;
+
+  //a xrun shows up as a error event, ready so the read or write returns it to recover.
+  if(snd_pcm_poll_descriptors_revents((snd_pcm_t *)p_dsp_node->p_data, alsa_poll, (unsigned int)num_fds, &revents) < 0) return 1;
+
+  return revents != 0;
+}
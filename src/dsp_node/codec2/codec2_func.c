@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "dsp_node.h"
 #include "codec2_func.h"
 #include "kill_throbber.h"
 #include "logger.h"
@@ -80,6 +81,18 @@ int init_callback_codec2_mod(void *p_init_args, void *p_object)
 
   p_dsp_node->output_type = p_codec2_args->sample_type;
 
+  // a fused call takes one payload and puts out preamble, data, postamble and silence.
+  p_dsp_node->process_call = process_callback_codec2_mod;
+
+  p_dsp_node->process_input_max = (unsigned long)freedv_get_bits_per_modem_frame((struct freedv *)p_dsp_node->p_data)/8 - 2;
+
+  p_dsp_node->process_output_max = (unsigned long)freedv_get_n_tx_modem_samples((struct freedv *)p_dsp_node->p_data) * 3 + (unsigned long)(FREEDV_FS_8000*200/1000);
+
+  // input is bursts of payloads, only the modem side has a rate.
+  p_dsp_node->output_rate = freedv_get_modem_sample_rate((struct freedv *)p_dsp_node->p_data);
+
+  p_dsp_node->granularity = p_dsp_node->process_input_max;
+
   logger_info_msg(p_dsp_node->p_logger, "CODEC2, modulation node created for %p.", p_dsp_node);
 
   return 0;
@@ -108,8 +121,6 @@ void* pthread_function_codec2_mod(void *p_data)
   {
     fprintf(stderr, "ERROR: Data Struct is NULL.\n");
 
-    kill_thread = 1;
-
     goto error_cleanup;
   }
 
@@ -128,19 +139,19 @@ void* pthread_function_codec2_mod(void *p_data)
   {
     logger_error_msg(p_dsp_node->p_logger, "CODEC2, mod could not allocate p_bytes_in buffer.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto error_cleanup;
   }
 
   // this example creates a buffer large enough for the preamble, data, postamble, and silence to be held.
-  p_mod_out = malloc((n_mod_out * 3 * p_dsp_node->output_type_size) + (samples_delay * p_dsp_node->output_type_size));
+  p_mod_out = dsp_allocBuffer(p_dsp_node, (n_mod_out * 3 * p_dsp_node->output_type_size) + (samples_delay * p_dsp_node->output_type_size));
 
   if(!p_mod_out)
   {
     logger_error_msg(p_dsp_node->p_logger, "CODEC2, mod could not allocate p_mod_out buffer.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto error_cleanup;
   }
@@ -159,6 +170,14 @@ void* pthread_function_codec2_mod(void *p_data)
     memset(p_bytes_in, 0, bytes_per_modem_frame);
     memset(p_mod_out, 0, (n_mod_out * 3 * p_dsp_node->output_type_size) + (samples_delay * p_dsp_node->output_type_size));
 
+    numRead = dsp_readInputTimed(p_dsp_node, p_bytes_in, payload_bytes_per_modem_frame, dsp_deadline(DSP_NODE_POLL_MS));
+
+    //no data in time, check kill_thread and wait again.
+    if(numRead == DSP_NODE_TIMEOUT) continue;
+
+    //end of stream.
+    if(!numRead) break;
+
     // create preamble
     switch(p_dsp_node->output_type)
     {
@@ -171,10 +190,6 @@ void* pthread_function_codec2_mod(void *p_data)
         break;
     }
 
-    numRead = ringBufferBlockingRead(p_dsp_node->p_input_ring_buffer, p_bytes_in, payload_bytes_per_modem_frame, NULL);
-
-    if(numRead <= 0) continue;
-
     // generate crc
     crc16 = freedv_gen_crc16(p_bytes_in, (int)payload_bytes_per_modem_frame);
 
@@ -213,20 +228,20 @@ void* pthread_function_codec2_mod(void *p_data)
 
     p_dsp_node->total_bytes_processed += numElemRead * p_dsp_node->output_type_size;
 
-    do
-    {
-      numElemWrote += ringBufferBlockingWrite(p_dsp_node->p_output_ring_buffer, p_mod_out + (numElemWrote * p_dsp_node->output_type_size), numElemRead - numElemWrote, NULL);
-    } while(numElemWrote < numElemRead);
+    numElemWrote = dsp_writeOutputAll(p_dsp_node, p_mod_out, numElemRead, &kill_thread);
+
+    //less written then modulated means every consumer has ended.
+    if(numElemWrote < numElemRead) break;
 
-  } while((numRead > 0) && !kill_thread);
+  } while((numRead > 0) && !kill_thread && !dsp_isCancelled(p_dsp_node));
 
 error_cleanup:
-  free(p_mod_out);
+  dsp_freeBuffer(p_dsp_node, p_mod_out, (n_mod_out * 3 * p_dsp_node->output_type_size) + (samples_delay * p_dsp_node->output_type_size));
 
   free(p_bytes_in);
 
-  ringBufferEndBlocking(p_dsp_node->p_output_ring_buffer);
-  ringBufferEndBlocking(p_dsp_node->p_input_ring_buffer);
+  dsp_endOutput(p_dsp_node);
+  dsp_endInput(p_dsp_node);
 
   logger_info_msg(p_dsp_node->p_logger, "CODEC2, modulation thread finished.");
 
@@ -235,6 +250,95 @@ error_cleanup:
   return NULL;
 }
 
+//Process callback for fused modulation, one payload per call.
+int process_callback_codec2_mod(void *p_object, struct s_dsp_process *p_process)
+{
+  size_t bytes_per_modem_frame = 0;
+  size_t payload_bytes_per_modem_frame = 0;
+  size_t n_mod_out = 0;
+
+  uint16_t crc16 = 0;
+
+  uint8_t *p_bytes_in = NULL;
+
+  long unsigned int numElemRead = 0;
+  long unsigned int numElemMod  = 0;
+
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  bytes_per_modem_frame = (size_t)freedv_get_bits_per_modem_frame((struct freedv *)p_dsp_node->p_data)/8;
+
+  payload_bytes_per_modem_frame = bytes_per_modem_frame - 2;
+
+  n_mod_out = (size_t)freedv_get_n_tx_modem_samples((struct freedv *)p_dsp_node->p_data);
+
+  numElemRead = (p_process->input_size < payload_bytes_per_modem_frame ? p_process->input_size : payload_bytes_per_modem_frame);
+
+  p_process->input_size = 0;
+
+  // wait for a full payload unless the input has ended, the last one is zero padded.
+  if(!numElemRead || (p_process->output_size < p_dsp_node->process_output_max) || ((numElemRead < payload_bytes_per_modem_frame) && !p_process->end_of_input))
+  {
+    p_process->output_size = 0;
+
+    return (!numElemRead && p_process->end_of_input) || kill_thread || dsp_isCancelled(p_dsp_node);
+  }
+
+  p_bytes_in = calloc(bytes_per_modem_frame, sizeof(uint8_t));
+
+  if(!p_bytes_in)
+  {
+    logger_error_msg(p_dsp_node->p_logger, "CODEC2, mod could not allocate p_bytes_in buffer.");
+
+    dsp_statsError(p_dsp_node);
+
+    p_process->output_size = 0;
+
+    return ~0;
+  }
+
+  memcpy(p_bytes_in, p_process->p_input, numElemRead);
+
+  // clear output so the silence is zeros.
+  memset(p_process->p_output, 0, p_dsp_node->process_output_max * p_dsp_node->output_type_size);
+
+  crc16 = freedv_gen_crc16(p_bytes_in, (int)payload_bytes_per_modem_frame);
+
+  p_bytes_in[bytes_per_modem_frame-2] = (uint8_t)(crc16 >> 8);
+  p_bytes_in[bytes_per_modem_frame-1] = (uint8_t)(crc16 & 0xff);
+
+  switch(p_dsp_node->output_type)
+  {
+    case(DATA_S16):
+      numElemMod = (long unsigned int)freedv_rawdatapreambletx((struct freedv *)p_dsp_node->p_data, (short *)p_process->p_output);
+      freedv_rawdatatx((struct freedv *)p_dsp_node->p_data, (short *)p_process->p_output + numElemMod, p_bytes_in);
+      numElemMod += n_mod_out;
+      numElemMod += (long unsigned int)freedv_rawdatapostambletx((struct freedv *)p_dsp_node->p_data, (short *)p_process->p_output + numElemMod);
+      break;
+    case(DATA_CFLOAT):
+    default:
+      numElemMod = (long unsigned int)freedv_rawdatapreamblecomptx((struct freedv *)p_dsp_node->p_data, (COMP *)p_process->p_output);
+      freedv_rawdatacomptx((struct freedv *)p_dsp_node->p_data, (COMP *)p_process->p_output + numElemMod, p_bytes_in);
+      numElemMod += n_mod_out;
+      numElemMod += (long unsigned int)freedv_rawdatapostamblecomptx((struct freedv *)p_dsp_node->p_data, (COMP *)p_process->p_output + numElemMod);
+      break;
+  }
+
+  numElemMod += (long unsigned int)(FREEDV_FS_8000*200/1000);
+
+  free(p_bytes_in);
+
+  p_dsp_node->total_bytes_processed += numElemMod * p_dsp_node->output_type_size;
+
+  p_process->input_size = numElemRead;
+
+  p_process->output_size = numElemMod;
+
+  return kill_thread || dsp_isCancelled(p_dsp_node);
+}
+
 //Clean up all allocations from init_callback modulation
 int free_callback_codec2_mod(void *p_object)
 {
@@ -282,6 +386,15 @@ int init_callback_codec2_demod(void *p_init_args, void *p_object)
 
   p_dsp_node->input_type = p_codec2_args->sample_type;
 
+  p_dsp_node->process_call = process_callback_codec2_demod;
+
+  p_dsp_node->process_input_max = (unsigned long)freedv_get_n_max_modem_samples((struct freedv *)p_dsp_node->p_data);
+
+  p_dsp_node->process_output_max = (unsigned long)freedv_get_bits_per_modem_frame((struct freedv *)p_dsp_node->p_data)/8;
+
+  // freedv_nin changes every frame, process_input_max keeps a chunk at least the largest.
+  p_dsp_node->input_rate = freedv_get_modem_sample_rate((struct freedv *)p_dsp_node->p_data);
+
   logger_info_msg(p_dsp_node->p_logger, "CODEC2, demodulation node created for %p.", p_dsp_node);
 
   return 0;
@@ -307,8 +420,6 @@ void* pthread_function_codec2_demod(void *p_data)
   {
     fprintf(stderr, "ERROR: Data Struct is NULL.\n");
 
-    kill_thread = 1;
-
     goto error_cleanup;
   }
 
@@ -323,20 +434,20 @@ void* pthread_function_codec2_demod(void *p_data)
   {
     logger_error_msg(p_dsp_node->p_logger, "CODEC2, demod could not allocate raw processor buffer.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto error_cleanup;
   }
 
   max_modem_samples = (size_t)freedv_get_n_max_modem_samples((struct freedv *)p_dsp_node->p_data);
 
-  p_demod_in = malloc(max_modem_samples * p_dsp_node->input_type_size);
+  p_demod_in = dsp_allocBuffer(p_dsp_node, max_modem_samples * p_dsp_node->input_type_size);
 
   if(!p_demod_in)
   {
     logger_error_msg(p_dsp_node->p_logger, "CODEC2, demod could not allocate enc processor buffer.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto error_cleanup;
   }
@@ -354,7 +465,13 @@ void* pthread_function_codec2_demod(void *p_data)
     // number of modulated samples, is this a constant?
     nin = (size_t)freedv_nin((struct freedv *)p_dsp_node->p_data);
 
-    numRead = ringBufferBlockingRead(p_dsp_node->p_input_ring_buffer, p_demod_in, nin, NULL);
+    numRead = dsp_readInputTimed(p_dsp_node, p_demod_in, nin, dsp_deadline(DSP_NODE_POLL_MS));
+
+    //no data in time, check kill_thread and wait again.
+    if(numRead == DSP_NODE_TIMEOUT) continue;
+
+    //end of stream, the buffer still holds the last frame.
+    if(!numRead) break;
 
     // demodulate data
     switch(p_dsp_node->input_type)
@@ -369,26 +486,26 @@ void* pthread_function_codec2_demod(void *p_data)
     }
 
     // if we don't have enouch or any data don't decrament nbytes_out!
-    // ring buffer will take 0 and just exit, no need to do a continue here.
+    // no bytes out writes nothing and is not short, the loop just reads the next frame.
     if(nbytes_out >= 2) nbytes_out = nbytes_out - 2;
 
     p_dsp_node->total_bytes_processed += nbytes_out;
 
-    do
-    {
-      // write out demod bytes for file writting
-      numElemWrote += ringBufferBlockingWrite(p_dsp_node->p_output_ring_buffer, p_bytes_out + numElemWrote, nbytes_out - numElemWrote, NULL);
-    } while(numElemWrote < nbytes_out);
+    // write out demod bytes for file writting
+    numElemWrote = dsp_writeOutputAll(p_dsp_node, p_bytes_out, nbytes_out, &kill_thread);
+
+    //less written then demodulated means every consumer has ended.
+    if(numElemWrote < nbytes_out) break;
 
-  } while((numRead > 0) && !kill_thread);
+  } while((numRead > 0) && !kill_thread && !dsp_isCancelled(p_dsp_node));
 
 error_cleanup:
-  free(p_demod_in);
+  dsp_freeBuffer(p_dsp_node, p_demod_in, max_modem_samples * p_dsp_node->input_type_size);
 
   free(p_bytes_out);
 
-  ringBufferEndBlocking(p_dsp_node->p_output_ring_buffer);
-  ringBufferEndBlocking(p_dsp_node->p_input_ring_buffer);
+  dsp_endOutput(p_dsp_node);
+  dsp_endInput(p_dsp_node);
 
   logger_info_msg(p_dsp_node->p_logger, "CODEC2, demodulation thread finished.");
 
@@ -397,6 +514,51 @@ error_cleanup:
   return NULL;
 }
 
+//Process callback for fused demodulation, freedv_nin samples per call.
+int process_callback_codec2_demod(void *p_object, struct s_dsp_process *p_process)
+{
+  size_t nin = 0;
+  size_t nbytes_out = 0;
+
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  nin = (size_t)freedv_nin((struct freedv *)p_dsp_node->p_data);
+
+  // a partial frame at the end of input can not be demodulated, done.
+  if((p_process->input_size < nin) || (p_process->output_size < p_dsp_node->process_output_max))
+  {
+    p_process->input_size = 0;
+
+    p_process->output_size = 0;
+
+    return p_process->end_of_input || kill_thread || dsp_isCancelled(p_dsp_node);
+  }
+
+  switch(p_dsp_node->input_type)
+  {
+    case(DATA_S16):
+      nbytes_out = (size_t)freedv_rawdatarx((struct freedv *)p_dsp_node->p_data, (uint8_t *)p_process->p_output, (short *)p_process->p_input);
+      break;
+    case(DATA_CFLOAT):
+    default:
+      nbytes_out = (size_t)freedv_rawdatacomprx((struct freedv *)p_dsp_node->p_data, (uint8_t *)p_process->p_output, (COMP *)p_process->p_input);
+      break;
+  }
+
+  // strip the crc, same as the thread.
+  if(nbytes_out >= 2) nbytes_out = nbytes_out - 2;
+
+  p_dsp_node->total_bytes_processed += nbytes_out;
+
+  p_process->input_size = nin;
+
+  p_process->output_size = nbytes_out;
+
+  return kill_thread || dsp_isCancelled(p_dsp_node);
+}
+
 //Clean up all allocations from init_callback for demodulation
 int free_callback_codec2_demod(void *p_object)
 {
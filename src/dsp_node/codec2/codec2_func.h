@@ -68,6 +68,17 @@ int init_callback_codec2_mod(void *p_init_args, void *p_object);
   ****************************************************************************/
 void* pthread_function_codec2_mod(void *p_data);
 
+/**************************************************************************//**
+  * @brief Process callback for fused modulation, one payload per call. Waits
+  * for a full payload unless the input has ended, the last is zero padded.
+  *
+  * @param p_object codec2 mod dsp node object.
+  * @param p_process payload bytes in, modulated samples out.
+  *
+  * @return 0 more data, non-zero end of input, error or kill.
+  ****************************************************************************/
+int process_callback_codec2_mod(void *p_object, struct s_dsp_process *p_process);
+
 /**************************************************************************//**
   * @brief Clean up all allocations from init_callback
   *
@@ -98,6 +109,17 @@ int init_callback_codec2_demod(void *p_init_args, void *p_object);
   ****************************************************************************/
 void* pthread_function_codec2_demod(void *p_data);
 
+/**************************************************************************//**
+  * @brief Process callback for fused demodulation, freedv_nin samples per
+  * call.
+  *
+  * @param p_object codec2 demod dsp node object.
+  * @param p_process modulated samples in, demodulated bytes out.
+  *
+  * @return 0 more data, non-zero end of input, error or kill.
+  ****************************************************************************/
+int process_callback_codec2_demod(void *p_object, struct s_dsp_process *p_process);
+
 /**************************************************************************//**
   * @brief Clean up all allocations from init_callback demodulation
   *
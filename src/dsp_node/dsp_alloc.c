@@ -0,0 +1,196 @@
+//******************************************************************************
+/// @file     dsp_alloc.c
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Allocation policy for ring buffers and node scratch buffers.
+/// @details  Anything but the default policy maps anonymous memory so huge
+///           pages, mbind and mlock apply to the buffer alone. NUMA binding
+///           uses the mbind system call directly, no libnuma needed.
+//******************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <unistd.h>
+#include <sys/mman.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#endif
+
+#include "dsp_alloc.h"
+
+//round bytes up to the size the mapping of a policy is made with.
+static unsigned long alloc_map_size(unsigned int flags, unsigned long bytes);
+
+//bind a mapping to a NUMA node.
+static int alloc_bind(void *p_mem, unsigned long size, int numa_node);
+
+//Allocate memory with a policy.
+void *dsp_allocMem(struct s_dsp_alloc const *p_alloc, unsigned long bytes)
+{
+  void *p_mem = MAP_FAILED;
+
+  unsigned long size = 0;
+
+  unsigned long page_size = 0;
+
+  unsigned long index = 0;
+
+  unsigned int flags = 0;
+
+  if(!bytes) return NULL;
+
+  if(!p_alloc || p_alloc->flags == DSP_ALLOC_DEFAULT) return malloc(bytes);
+
+  flags = p_alloc->flags;
+
+  size = alloc_map_size(flags, bytes);
+
+#ifdef MAP_HUGETLB
+  if(flags & DSP_ALLOC_HUGETLB)
+  {
+    p_mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+    if(p_mem == MAP_FAILED)
+    {
+      fprintf(stderr, "WARNING: No huge pages reserved for %lu bytes (vm.nr_hugepages), using transparent huge pages.\n", size);
+
+      flags |= DSP_ALLOC_HUGE;
+    }
+  }
+#endif
+
+  if(p_mem == MAP_FAILED)
+  {
+    p_mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if(p_mem == MAP_FAILED)
+    {
+      fprintf(stderr, "ERROR: Could not map %lu bytes, %s.\n", size, strerror(errno));
+
+      return NULL;
+    }
+
+#ifdef MADV_HUGEPAGE
+    if(flags & (DSP_ALLOC_HUGE | DSP_ALLOC_HUGETLB))
+    {
+      if(madvise(p_mem, size, MADV_HUGEPAGE)) fprintf(stderr, "WARNING: Transparent huge pages not available, %s.\n", strerror(errno));
+    }
+#endif
+  }
+
+  //binding has to happen before the first touch places the pages.
+  if(flags & DSP_ALLOC_NUMA)
+  {
+    if(alloc_bind(p_mem, size, p_alloc->numa_node)) fprintf(stderr, "WARNING: Could not bind %lu bytes to NUMA node %d, %s.\n", size, p_alloc->numa_node, strerror(errno));
+  }
+
+  if(flags & DSP_ALLOC_MLOCK)
+  {
+    if(!mlock(p_mem, size)) return p_mem;
+
+    fprintf(stderr, "WARNING: Could not lock %lu bytes (RLIMIT_MEMLOCK), prefaulting instead, %s.\n", size, strerror(errno));
+
+    flags |= DSP_ALLOC_PREFAULT;
+  }
+
+  if(flags & DSP_ALLOC_PREFAULT)
+  {
+    page_size = (unsigned long)sysconf(_SC_PAGESIZE);
+
+    for(index = 0; index < size; index += page_size)
+    {
+      ((volatile uint8_t *)p_mem)[index] = 0;
+    }
+  }
+
+  return p_mem;
+}
+
+//Free memory from dsp_allocMem.
+void dsp_freeMem(struct s_dsp_alloc const *p_alloc, void *p_mem, unsigned long bytes)
+{
+  if(!p_mem) return;
+
+  if(!p_alloc || p_alloc->flags == DSP_ALLOC_DEFAULT)
+  {
+    free(p_mem);
+
+    return;
+  }
+
+  munmap(p_mem, alloc_map_size(p_alloc->flags, bytes));
+}
+
+//NUMA node a cpu belongs to.
+int dsp_allocCpuNode(int cpu)
+{
+  char path[128] = {0};
+
+  int index = 0;
+
+  if(cpu < 0) return -1;
+
+  //cpuN has a nodeM link for the node it is on, there are few nodes so just look.
+  for(index = 0; index < 1024; index++)
+  {
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/node%d", cpu, index);
+
+    if(!access(path, F_OK)) return index;
+  }
+
+  return -1;
+}
+
+//round bytes up to the size the mapping of a policy is made with.
+static unsigned long alloc_map_size(unsigned int flags, unsigned long bytes)
+{
+  unsigned long page_size = 0;
+
+  if(flags & (DSP_ALLOC_HUGE | DSP_ALLOC_HUGETLB))
+  {
+    page_size = DSP_ALLOC_HUGE_PAGE;
+  }
+  else
+  {
+    page_size = (unsigned long)sysconf(_SC_PAGESIZE);
+  }
+
+  return (bytes + page_size - 1) / page_size * page_size;
+}
+
+//bind a mapping to a NUMA node.
+static int alloc_bind(void *p_mem, unsigned long size, int numa_node)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+  unsigned long mask[16] = {0};
+
+  unsigned long bits = sizeof(unsigned long) * 8;
+
+  if(numa_node < 0 || (unsigned long)numa_node >= bits * 16)
+  {
+    errno = EINVAL;
+
+    return ~0;
+  }
+
+  mask[(unsigned long)numa_node / bits] = 1UL << ((unsigned long)numa_node % bits);
+
+  if(syscall(SYS_mbind, p_mem, size, MPOL_BIND, mask, bits * 16 + 1, 0)) return ~0;
+
+  return 0;
+#else
+  (void)p_mem;
+  (void)size;
+  (void)numa_node;
+
+  errno = ENOSYS;
+
+  return ~0;
+#endif
+}
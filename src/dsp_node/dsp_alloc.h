@@ -0,0 +1,117 @@
+//******************************************************************************
+/// @file     dsp_alloc.h
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Allocation policy for ring buffers and node scratch buffers.
+/// @details  Huge pages (transparent or explicit), NUMA binding, mlock and
+///           prefault for large buffers. The default policy is plain malloc.
+//******************************************************************************
+
+#ifndef __dsp_alloc
+#define __dsp_alloc
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def DSP_ALLOC_DEFAULT
+ * Plain malloc.
+ */
+#define DSP_ALLOC_DEFAULT   0
+
+/**
+ * @def DSP_ALLOC_HUGE
+ * Transparent huge pages, the mapping is advised with MADV_HUGEPAGE.
+ */
+#define DSP_ALLOC_HUGE      (1U << 0)
+
+/**
+ * @def DSP_ALLOC_HUGETLB
+ * Explicit huge pages with MAP_HUGETLB, falls back to DSP_ALLOC_HUGE when none are reserved.
+ */
+#define DSP_ALLOC_HUGETLB   (1U << 1)
+
+/**
+ * @def DSP_ALLOC_NUMA
+ * Bind the memory to a NUMA node with mbind.
+ */
+#define DSP_ALLOC_NUMA      (1U << 2)
+
+/**
+ * @def DSP_ALLOC_PREFAULT
+ * Touch every page at allocation so the data path never page faults.
+ */
+#define DSP_ALLOC_PREFAULT  (1U << 3)
+
+/**
+ * @def DSP_ALLOC_MLOCK
+ * Lock the pages in memory (implies prefault), falls back to prefault if over RLIMIT_MEMLOCK.
+ */
+#define DSP_ALLOC_MLOCK     (1U << 4)
+
+/**
+ * @def DSP_ALLOC_NUMA_CPU
+ * NUMA node of the first cpu of the node affinity, resolved by dsp_setup.
+ */
+#define DSP_ALLOC_NUMA_CPU  (-1)
+
+/**
+ * @def DSP_ALLOC_HUGE_PAGE
+ * Size in bytes huge page mappings are rounded up to.
+ */
+#define DSP_ALLOC_HUGE_PAGE (1UL << 21)
+
+/**
+ * @struct s_dsp_alloc
+ * @brief Allocation policy, zero is the default policy.
+ */
+struct s_dsp_alloc
+{
+  /**
+   * @var s_dsp_alloc::flags
+   * DSP_ALLOC_* flags or'd together, DSP_ALLOC_DEFAULT for malloc.
+   */
+  unsigned int flags;
+  /**
+   * @var s_dsp_alloc::numa_node
+   * NUMA node to bind to with DSP_ALLOC_NUMA.
+   */
+  int numa_node;
+};
+
+/**************************************************************************//**
+  * @brief Allocate memory with a policy. Parts of the policy the system can
+  * not give (no huge pages reserved, mlock limit) fall back and are reported
+  * on stderr, the allocation only fails if there is no memory.
+  *
+  * @param p_alloc policy, NULL for the default.
+  * @param bytes number of bytes.
+  *
+  * @return memory, NULL on error.
+  ****************************************************************************/
+void *dsp_allocMem(struct s_dsp_alloc const *p_alloc, unsigned long bytes);
+
+/**************************************************************************//**
+  * @brief Free memory from dsp_allocMem.
+  *
+  * @param p_alloc the same policy it was allocated with.
+  * @param p_mem memory to free, NULL is ignored.
+  * @param bytes the same number of bytes it was allocated with.
+  ****************************************************************************/
+void dsp_freeMem(struct s_dsp_alloc const *p_alloc, void *p_mem, unsigned long bytes);
+
+/**************************************************************************//**
+  * @brief NUMA node a cpu belongs to.
+  *
+  * @param cpu cpu number.
+  *
+  * @return NUMA node, -1 if unknown (no NUMA in the system or kernel).
+  ****************************************************************************/
+int dsp_allocCpuNode(int cpu);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,186 @@
+//******************************************************************************
+/// @file     dsp_cancel.c
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Cancellation token for DSP nodes and graphs.
+/// @details  The flag is set before the eventfd is written, so anything woken
+///           by the fd sees the flag. A ppoll on the eventfd is the sleep of
+///           every poll based wait, a set token ends it at once.
+//******************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include "dsp_cancel.h"
+#include "dsp_ring.h"
+
+//monotonic time in nanoseconds, the clock ring deadlines use.
+static unsigned long long cancel_now(void);
+
+//Allocate a token that is not set.
+struct s_dsp_cancel *dsp_cancelCreate(void)
+{
+  struct s_dsp_cancel *p_temp = NULL;
+
+  p_temp = malloc(sizeof(struct s_dsp_cancel));
+
+  if(!p_temp) return NULL;
+
+  //non blocking so a reset can drain it without waiting.
+  p_temp->fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+  if(p_temp->fd < 0)
+  {
+    perror("DSP Cancel eventfd failed");
+
+    free(p_temp);
+
+    return NULL;
+  }
+
+  atomic_init(&p_temp->cancelled, 0);
+
+  return p_temp;
+}
+
+//Free a token and set the pointer to NULL.
+void dsp_cancelFree(struct s_dsp_cancel **pp_cancel)
+{
+  if(!pp_cancel) return;
+
+  if(!*pp_cancel) return;
+
+  close((*pp_cancel)->fd);
+
+  free(*pp_cancel);
+
+  *pp_cancel = NULL;
+}
+
+//Set the token, every poll on its fd wakes.
+int dsp_cancelSet(struct s_dsp_cancel *p_cancel)
+{
+  uint64_t value = 1;
+
+  if(!p_cancel) return ~0;
+
+  //the flag goes first, a wait woken by the fd always sees it.
+  atomic_store(&p_cancel->cancelled, 1);
+
+  //a full counter is still readable, the write can only fail on a token set many times over.
+  if(write(p_cancel->fd, &value, sizeof(value)) != (ssize_t)sizeof(value)) return (errno == EAGAIN ? 0 : ~0);
+
+  return 0;
+}
+
+//Clear a set token so it can be used again.
+void dsp_cancelReset(struct s_dsp_cancel *p_cancel)
+{
+  uint64_t value = 0;
+
+  if(!p_cancel) return;
+
+  atomic_store(&p_cancel->cancelled, 0);
+
+  //reading a eventfd clears it, nothing to read is fine.
+  if(read(p_cancel->fd, &value, sizeof(value)) < 0) return;
+}
+
+//Check if a token is set, one atomic load.
+int dsp_cancelIsSet(struct s_dsp_cancel const *p_cancel)
+{
+  if(!p_cancel) return 0;
+
+  return atomic_load(&p_cancel->cancelled);
+}
+
+//File descriptor that is readable once the token is set.
+int dsp_cancelFd(struct s_dsp_cancel const *p_cancel)
+{
+  if(!p_cancel) return -1;
+
+  return p_cancel->fd;
+}
+
+//Poll fds and the token till one of the fds is ready, the token is set or the deadline passes.
+int dsp_cancelPoll(struct s_dsp_cancel const *p_cancel, struct pollfd *p_fds, unsigned int num_fds, unsigned long long deadline)
+{
+  unsigned int index = 0;
+
+  struct pollfd fds[DSP_CANCEL_POLL_MAX + 1];
+
+  if(!p_cancel || (num_fds > DSP_CANCEL_POLL_MAX) || (num_fds && !p_fds)) return -1;
+
+  for(index = 0; index < num_fds; index++)
+  {
+    fds[index] = p_fds[index];
+
+    fds[index].revents = 0;
+  }
+
+  //the token is last so the fds keep their order.
+  fds[num_fds].fd = p_cancel->fd;
+
+  fds[num_fds].events = POLLIN;
+
+  fds[num_fds].revents = 0;
+
+  for(;;)
+  {
+    int num_ready = 0;
+
+    unsigned long long now = 0;
+
+    struct timespec timeout;
+
+    if(atomic_load(&p_cancel->cancelled)) return 0;
+
+    if(deadline != DSP_RING_FOREVER)
+    {
+      now = cancel_now();
+
+      if(now >= deadline) return 0;
+
+      timeout.tv_sec = (time_t)((deadline - now) / 1000000000ULL);
+
+      timeout.tv_nsec = (long)((deadline - now) % 1000000000ULL);
+    }
+
+    num_ready = ppoll(fds, num_fds + 1, (deadline == DSP_RING_FOREVER ? NULL : &timeout), NULL);
+
+    //a signal only cuts the sleep short, wait out the rest.
+    if((num_ready < 0) && (errno == EINTR)) continue;
+
+    if(num_ready < 0) return -1;
+
+    if(!num_ready) return 0;
+
+    num_ready = 0;
+
+    for(index = 0; index < num_fds; index++)
+    {
+      p_fds[index].revents = fds[index].revents;
+
+      if(fds[index].revents) num_ready++;
+    }
+
+    return num_ready;
+  }
+}
+
+//monotonic time in nanoseconds, the clock ring deadlines use.
+static unsigned long long cancel_now(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec;
+}
@@ -0,0 +1,115 @@
+//******************************************************************************
+/// @file     dsp_cancel.h
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Cancellation token for DSP nodes and graphs.
+/// @details  A flag rings check in their waits and a eventfd that poll based
+///           waits (sockets, sound devices, files, sleeps) add to their fds,
+///           so a blocked node wakes as soon as it is cancelled.
+//******************************************************************************
+
+#ifndef __dsp_cancel
+#define __dsp_cancel
+
+// includes
+#include <poll.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def DSP_CANCEL_POLL_MAX
+ * Most fds dsp_cancelPoll waits on next to the token.
+ */
+#define DSP_CANCEL_POLL_MAX 16
+
+/**
+ * @struct s_dsp_cancel
+ * @brief Cancellation token, set once and seen by every wait on it.
+ */
+struct s_dsp_cancel
+{
+  /**
+   * @var s_dsp_cancel::cancelled
+   * 1 the token is set, 0 not. Rings take a pointer to it and check it before they sleep.
+   */
+  atomic_int cancelled;
+  /**
+   * @var s_dsp_cancel::fd
+   * eventfd readable once the token is set, for poll based waits.
+   */
+  int fd;
+};
+
+/**************************************************************************//**
+  * @brief Allocate a token that is not set.
+  *
+  * @return allocated token, NULL on error.
+  ****************************************************************************/
+struct s_dsp_cancel *dsp_cancelCreate(void);
+
+/**************************************************************************//**
+  * @brief Free a token and set the pointer to NULL.
+  *
+  * @param pp_cancel pointer to the token pointer.
+  ****************************************************************************/
+void dsp_cancelFree(struct s_dsp_cancel **pp_cancel);
+
+/**************************************************************************//**
+  * @brief Set the token, every poll on its fd wakes. Async signal safe, only
+  * sets the flag and writes the eventfd. Waits on rings are woken with
+  * dsp_ringInterrupt.
+  *
+  * @param p_cancel token to set.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_cancelSet(struct s_dsp_cancel *p_cancel);
+
+/**************************************************************************//**
+  * @brief Clear a set token so it can be used again.
+  *
+  * @param p_cancel token to clear.
+  ****************************************************************************/
+void dsp_cancelReset(struct s_dsp_cancel *p_cancel);
+
+/**************************************************************************//**
+  * @brief Check if a token is set, one atomic load.
+  *
+  * @param p_cancel token to check.
+  *
+  * @return 1 set, 0 not set or NULL.
+  ****************************************************************************/
+int dsp_cancelIsSet(struct s_dsp_cancel const *p_cancel);
+
+/**************************************************************************//**
+  * @brief File descriptor that is readable once the token is set, for callers
+  * with their own poll or select loop.
+  *
+  * @param p_cancel token to get the fd of.
+  *
+  * @return eventfd of the token, -1 for NULL.
+  ****************************************************************************/
+int dsp_cancelFd(struct s_dsp_cancel const *p_cancel);
+
+/**************************************************************************//**
+  * @brief Poll fds and the token till one of the fds is ready, the token is
+  * set or the deadline passes.
+  *
+  * @param p_cancel token to wake on.
+  * @param p_fds fds to poll, revents are filled in like poll. NULL for none.
+  * @param num_fds number of fds, at most DSP_CANCEL_POLL_MAX.
+  * @param deadline from dsp_ringDeadline, DSP_RING_FOREVER for none.
+  *
+  * @return number of fds with revents, 0 the token is set or the deadline
+  * passed, -1 on error.
+  ****************************************************************************/
+int dsp_cancelPoll(struct s_dsp_cancel const *p_cancel, struct pollfd *p_fds, unsigned int num_fds, unsigned long long deadline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
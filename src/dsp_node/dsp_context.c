@@ -0,0 +1,272 @@
+//******************************************************************************
+/// @file     dsp_context.c
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Context of a pipeline, the state its nodes share.
+/// @details  The only process wide state left is the default context of nodes
+///           made with dsp_create, made by the first and freed with the last.
+//******************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "dsp_node.h"
+#include "dsp_context.h"
+
+//allocate a context with its own logger, shared by create and the default context.
+static struct s_dsp_context *context_create(char const * const p_name, int is_default);
+//free a context and its logger.
+static void context_free(struct s_dsp_context *p_context);
+//add a node to the list of a context, the mutex is held.
+static int context_add(struct s_dsp_context * const p_context, struct s_dsp_node * const p_node);
+
+//process default context of nodes made with dsp_create.
+static struct s_dsp_context *gp_default_context = NULL;
+//guards creating and freeing the default context.
+static pthread_mutex_t g_default_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+//Allocate a context with its own logger.
+struct s_dsp_context *dsp_contextCreate(char const * const p_name)
+{
+  if(!p_name)
+  {
+    fprintf(stderr, "ERROR: Context needs a name for its log.\n");
+
+    return NULL;
+  }
+
+  return context_create(p_name, 0);
+}
+
+//Free a context and its logger.
+void dsp_contextFree(struct s_dsp_context **pp_context)
+{
+  if(!pp_context) return;
+
+  if(!*pp_context) return;
+
+  //the default context goes with its last node.
+  if((*pp_context)->is_default)
+  {
+    *pp_context = NULL;
+
+    return;
+  }
+
+  if((*pp_context)->num_nodes) logger_warning_msg((*pp_context)->p_logger, "DSP CONTEXT %p freed with %lu nodes left.", *pp_context, (*pp_context)->num_nodes);
+
+  context_free(*pp_context);
+
+  *pp_context = NULL;
+}
+
+//Add a node to a context and give it the next id.
+struct s_dsp_context *dsp_contextAdd(struct s_dsp_context *p_context, struct s_dsp_node * const p_node)
+{
+  int error = 0;
+
+  if(!p_node) return NULL;
+
+  if(p_context)
+  {
+    pthread_mutex_lock(&p_context->mutex);
+
+    error = context_add(p_context, p_node);
+
+    pthread_mutex_unlock(&p_context->mutex);
+
+    return (error ? NULL : p_context);
+  }
+
+  pthread_mutex_lock(&g_default_mutex);
+
+  if(!gp_default_context) gp_default_context = context_create("dsp_node", 1);
+
+  p_context = gp_default_context;
+
+  if(p_context)
+  {
+    pthread_mutex_lock(&p_context->mutex);
+
+    error = context_add(p_context, p_node);
+
+    pthread_mutex_unlock(&p_context->mutex);
+  }
+
+  pthread_mutex_unlock(&g_default_mutex);
+
+  return (error ? NULL : p_context);
+}
+
+//Remove a node from its context.
+void dsp_contextRemove(struct s_dsp_context *p_context, struct s_dsp_node const * const p_node)
+{
+  unsigned long index = 0;
+  unsigned long num_nodes = 0;
+
+  if(!p_context || !p_node) return;
+
+  if(p_context->is_default) pthread_mutex_lock(&g_default_mutex);
+
+  pthread_mutex_lock(&p_context->mutex);
+
+  for(index = 0; index < p_context->num_nodes; index++)
+  {
+    if(p_context->pp_nodes[index] != p_node) continue;
+
+    memmove(&p_context->pp_nodes[index], &p_context->pp_nodes[index + 1], (p_context->num_nodes - index - 1) * sizeof(struct s_dsp_node *));
+
+    p_context->num_nodes--;
+
+    break;
+  }
+
+  num_nodes = p_context->num_nodes;
+
+  pthread_mutex_unlock(&p_context->mutex);
+
+  if(!p_context->is_default) return;
+
+  if(!num_nodes)
+  {
+    context_free(p_context);
+
+    gp_default_context = NULL;
+  }
+
+  pthread_mutex_unlock(&g_default_mutex);
+}
+
+//Stop every node of a context with dsp_end.
+int dsp_contextStop(struct s_dsp_context * const p_context)
+{
+  int error = 0;
+
+  unsigned long index = 0;
+
+  if(!p_context) return ~0;
+
+  pthread_mutex_lock(&p_context->mutex);
+
+  error = dsp_cancelSet(p_context->p_cancel);
+
+  for(index = 0; index < p_context->num_nodes; index++)
+  {
+    error |= dsp_end(p_context->pp_nodes[index]);
+  }
+
+  logger_info_msg(p_context->p_logger, "DSP CONTEXT %p stopped, %lu nodes.", p_context, p_context->num_nodes);
+
+  pthread_mutex_unlock(&p_context->mutex);
+
+  return error;
+}
+
+//Clear a stop so the nodes of the context can be started again.
+void dsp_contextReset(struct s_dsp_context * const p_context)
+{
+  if(!p_context) return;
+
+  dsp_cancelReset(p_context->p_cancel);
+}
+
+//Check if a context was stopped.
+int dsp_contextIsStopped(struct s_dsp_context const * const p_context)
+{
+  if(!p_context) return 0;
+
+  return dsp_cancelIsSet(p_context->p_cancel);
+}
+
+//allocate a context with its own logger, shared by create and the default context.
+static struct s_dsp_context *context_create(char const * const p_name, int is_default)
+{
+  struct s_dsp_context *p_temp = NULL;
+
+  p_temp = malloc(sizeof(struct s_dsp_context));
+
+  if(!p_temp)
+  {
+    perror("DSP Context struct failed");
+
+    return NULL;
+  }
+
+  p_temp->p_logger = logger_create(p_name);
+
+  if(!p_temp->p_logger)
+  {
+    perror("Logger Creation failed");
+
+    goto error_logger;
+  }
+
+  p_temp->p_cancel = dsp_cancelCreate();
+
+  if(!p_temp->p_cancel) goto error_cancel;
+
+  pthread_mutex_init(&p_temp->mutex, NULL);
+
+  p_temp->pp_nodes = NULL;
+
+  p_temp->num_nodes = 0;
+
+  p_temp->node_count = 0;
+
+  p_temp->is_default = is_default;
+
+  logger_info_msg(p_temp->p_logger, "DSP CONTEXT %p created.", p_temp);
+
+  return p_temp;
+
+error_cancel:
+  logger_cleanup(p_temp->p_logger);
+
+error_logger:
+  free(p_temp);
+
+  return NULL;
+}
+
+//free a context and its logger.
+static void context_free(struct s_dsp_context *p_context)
+{
+  logger_info_msg(p_context->p_logger, "LOGGER FINISHED, DSP NODE CLEANUP STARTED.");
+
+  logger_cleanup(p_context->p_logger);
+
+  dsp_cancelFree(&p_context->p_cancel);
+
+  pthread_mutex_destroy(&p_context->mutex);
+
+  free(p_context->pp_nodes);
+
+  free(p_context);
+}
+
+//add a node to the list of a context, the mutex is held.
+static int context_add(struct s_dsp_context * const p_context, struct s_dsp_node * const p_node)
+{
+  struct s_dsp_node **pp_temp = NULL;
+
+  pp_temp = realloc(p_context->pp_nodes, (p_context->num_nodes + 1) * sizeof(struct s_dsp_node *));
+
+  if(!pp_temp)
+  {
+    logger_error_msg(p_context->p_logger, "DSP CONTEXT %p could not add node %p.", p_context, p_node);
+
+    return ~0;
+  }
+
+  p_context->pp_nodes = pp_temp;
+
+  p_context->pp_nodes[p_context->num_nodes] = p_node;
+
+  p_context->num_nodes++;
+
+  p_node->id_number = ++p_context->node_count;
+
+  return 0;
+}
@@ -0,0 +1,136 @@
+//******************************************************************************
+/// @file     dsp_context.h
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Context of a pipeline, the state its nodes share.
+/// @details  Holds the logger, the node ids and the stop of one pipeline, so
+///           a process can run many pipelines and stop each on its own.
+///           Nodes made with dsp_create share one process default context.
+//******************************************************************************
+
+#ifndef __dsp_context
+#define __dsp_context
+
+// includes
+#include <pthread.h>
+
+#include "dsp_cancel.h"
+#include "logger.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct s_dsp_node;
+
+/**
+ * @struct s_dsp_context
+ * @brief Logger, node ids and stop of one pipeline.
+ */
+struct s_dsp_context
+{
+  /**
+   * @var s_dsp_context::p_logger
+   * logger every node of the context writes to.
+   */
+  struct s_logger *p_logger;
+  /**
+   * @var s_dsp_context::p_cancel
+   * set by dsp_contextStop, a node started after the stop is cancelled at once.
+   */
+  struct s_dsp_cancel *p_cancel;
+  /**
+   * @var s_dsp_context::mutex
+   * guards the node list and the id count.
+   */
+  pthread_mutex_t mutex;
+  /**
+   * @var s_dsp_context::pp_nodes
+   * array of nodes in the context, in the order created.
+   */
+  struct s_dsp_node **pp_nodes;
+  /**
+   * @var s_dsp_context::num_nodes
+   * number of nodes in pp_nodes.
+   */
+  unsigned long num_nodes;
+  /**
+   * @var s_dsp_context::node_count
+   * ids handed out, the next node gets node_count + 1.
+   */
+  unsigned long node_count;
+  /**
+   * @var s_dsp_context::is_default
+   * 1 the process default context, freed with its last node. 0 freed by its owner.
+   */
+  int is_default;
+};
+
+/**************************************************************************//**
+  * @brief Allocate a context with its own logger.
+  *
+  * @param p_name name of the log file, .log is added.
+  *
+  * @return allocated context, NULL on error.
+  ****************************************************************************/
+struct s_dsp_context *dsp_contextCreate(char const * const p_name);
+
+/**************************************************************************//**
+  * @brief Free a context and its logger. Every node in it must be cleaned up
+  * first. The process default context frees itself.
+  *
+  * @param pp_context pointer to the context pointer, set to NULL.
+  ****************************************************************************/
+void dsp_contextFree(struct s_dsp_context **pp_context);
+
+/**************************************************************************//**
+  * @brief Add a node to a context and give it the next id.
+  *
+  * @param p_context context to add to, NULL for the process default context,
+  * created by its first node.
+  * @param p_node node to add.
+  *
+  * @return context the node was added to, NULL on error.
+  ****************************************************************************/
+struct s_dsp_context *dsp_contextAdd(struct s_dsp_context *p_context, struct s_dsp_node * const p_node);
+
+/**************************************************************************//**
+  * @brief Remove a node from its context. The process default context is
+  * freed with its last node.
+  *
+  * @param p_context context of the node.
+  * @param p_node node to remove.
+  ****************************************************************************/
+void dsp_contextRemove(struct s_dsp_context *p_context, struct s_dsp_node const * const p_node);
+
+/**************************************************************************//**
+  * @brief Stop every node of a context with dsp_end. Nodes started after it
+  * stop at once. Only this context stops, not other pipelines of the process.
+  *
+  * @param p_context context to stop.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_contextStop(struct s_dsp_context * const p_context);
+
+/**************************************************************************//**
+  * @brief Clear a stop so the nodes of the context can be started again.
+  *
+  * @param p_context context to clear.
+  ****************************************************************************/
+void dsp_contextReset(struct s_dsp_context * const p_context);
+
+/**************************************************************************//**
+  * @brief Check if a context was stopped.
+  *
+  * @param p_context context to check.
+  *
+  * @return 1 stopped, 0 not stopped or NULL.
+  ****************************************************************************/
+int dsp_contextIsStopped(struct s_dsp_context const * const p_context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1457 @@
+//******************************************************************************
+/// @file     dsp_convert.c
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Format conversion between e_binary_type formats, and a node for it.
+/// @details  Integers are fixed point full scale, -1.0 to 1.0 as float. Hot
+///           pairs (S16, S8 to and from FLOAT, FLOAT to and from DOUBLE) have
+///           SSE2, AVX2 and NEON kernels picked at runtime, the rest is scalar.
+///           Complex types convert component by component.
+//******************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "dsp_node.h"
+#include "dsp_convert.h"
+
+//converts count components, p_input and p_output do not overlap.
+typedef void (*convert_kernel)(void const *p_input, void *p_output, unsigned long count);
+
+//tags forwarded per call of dsp_getInputTags.
+#define CONVERT_TAGS 16
+
+//component pairs with their own kernel, index into a kernel table.
+enum e_convert_kernel {CONVERT_S16_F32=0, CONVERT_F32_S16, CONVERT_S8_F32, CONVERT_F32_S8, CONVERT_F32_F64, CONVERT_F64_F32, CONVERT_SIGN8, CONVERT_SIGN16, CONVERT_KERNELS};
+
+//pick the kernel table for the best instruction set of the cpu.
+static void convert_init(void);
+//forward the tags on the next size input elements to the output, elements map one to one.
+static void convert_tags(struct s_dsp_node * const p_dsp_node, unsigned long size);
+//name of a instruction set for the log.
+static char const *convert_isa_name(enum e_dsp_convert_isa isa);
+//component type of a type, complex types have two of them.
+static enum e_binary_type convert_base(enum e_binary_type type, unsigned int *p_components);
+//size in bits of a component type.
+static unsigned int convert_bits(enum e_binary_type base);
+//kernel of a component pair, CONVERT_KERNELS if it has none.
+static enum e_convert_kernel convert_fast(enum e_binary_type input_base, enum e_binary_type output_base);
+//convert any component pair one at a time, through fixed point for integers or double for the rest.
+static void convert_generic(enum e_binary_type input_base, enum e_binary_type output_base, int byte_swap, void const *p_input, void *p_output, unsigned long count);
+//read a component as a unsigned value, byte swapped if asked.
+static uint64_t convert_read(void const *p_input, unsigned long index, unsigned int bytes, int byte_swap);
+//write a component from a unsigned value.
+static void convert_write(void *p_output, unsigned long index, unsigned int bytes, uint64_t value);
+//integer component to full scale 32 bit fixed point.
+static int32_t convert_to_q31(enum e_binary_type base, uint64_t value);
+//full scale 32 bit fixed point to a integer component, drops the low bits.
+static uint64_t convert_from_q31(enum e_binary_type base, int32_t value);
+//component to double, integers are -1.0 to 1.0.
+static double convert_to_f64(enum e_binary_type base, uint64_t value);
+//double to a component, integers are rounded and saturated.
+static uint64_t convert_from_f64(enum e_binary_type base, double value);
+//scalar kernels, also the tail of every simd kernel.
+static void scalar_s16_f32(void const *p_input, void *p_output, unsigned long count);
+static void scalar_f32_s16(void const *p_input, void *p_output, unsigned long count);
+static void scalar_s8_f32(void const *p_input, void *p_output, unsigned long count);
+static void scalar_f32_s8(void const *p_input, void *p_output, unsigned long count);
+static void scalar_f32_f64(void const *p_input, void *p_output, unsigned long count);
+static void scalar_f64_f32(void const *p_input, void *p_output, unsigned long count);
+static void scalar_sign8(void const *p_input, void *p_output, unsigned long count);
+static void scalar_sign16(void const *p_input, void *p_output, unsigned long count);
+#if defined(__x86_64__)
+//sse2 kernels, every x86_64 cpu has sse2.
+static void sse2_s16_f32(void const *p_input, void *p_output, unsigned long count);
+static void sse2_f32_s16(void const *p_input, void *p_output, unsigned long count);
+static void sse2_s8_f32(void const *p_input, void *p_output, unsigned long count);
+static void sse2_f32_s8(void const *p_input, void *p_output, unsigned long count);
+static void sse2_f32_f64(void const *p_input, void *p_output, unsigned long count);
+static void sse2_f64_f32(void const *p_input, void *p_output, unsigned long count);
+static void sse2_sign8(void const *p_input, void *p_output, unsigned long count);
+static void sse2_sign16(void const *p_input, void *p_output, unsigned long count);
+//avx2 kernels, only called after the cpu says it has avx2.
+__attribute__((target("avx2"))) static void avx2_s16_f32(void const *p_input, void *p_output, unsigned long count);
+__attribute__((target("avx2"))) static void avx2_f32_s16(void const *p_input, void *p_output, unsigned long count);
+__attribute__((target("avx2"))) static void avx2_s8_f32(void const *p_input, void *p_output, unsigned long count);
+__attribute__((target("avx2"))) static void avx2_f32_s8(void const *p_input, void *p_output, unsigned long count);
+__attribute__((target("avx2"))) static void avx2_f32_f64(void const *p_input, void *p_output, unsigned long count);
+__attribute__((target("avx2"))) static void avx2_f64_f32(void const *p_input, void *p_output, unsigned long count);
+__attribute__((target("avx2"))) static void avx2_sign8(void const *p_input, void *p_output, unsigned long count);
+__attribute__((target("avx2"))) static void avx2_sign16(void const *p_input, void *p_output, unsigned long count);
+#elif defined(__aarch64__)
+//neon kernels, every aarch64 cpu has neon.
+static void neon_s16_f32(void const *p_input, void *p_output, unsigned long count);
+static void neon_f32_s16(void const *p_input, void *p_output, unsigned long count);
+static void neon_s8_f32(void const *p_input, void *p_output, unsigned long count);
+static void neon_f32_s8(void const *p_input, void *p_output, unsigned long count);
+static void neon_f32_f64(void const *p_input, void *p_output, unsigned long count);
+static void neon_f64_f32(void const *p_input, void *p_output, unsigned long count);
+static void neon_sign8(void const *p_input, void *p_output, unsigned long count);
+static void neon_sign16(void const *p_input, void *p_output, unsigned long count);
+#endif
+//kernel tables in e_convert_kernel order.
+static convert_kernel const g_scalar_kernels[CONVERT_KERNELS] = {scalar_s16_f32, scalar_f32_s16, scalar_s8_f32, scalar_f32_s8, scalar_f32_f64, scalar_f64_f32, scalar_sign8, scalar_sign16};
+#if defined(__x86_64__)
+static convert_kernel const g_sse2_kernels[CONVERT_KERNELS] = {sse2_s16_f32, sse2_f32_s16, sse2_s8_f32, sse2_f32_s8, sse2_f32_f64, sse2_f64_f32, sse2_sign8, sse2_sign16};
+static convert_kernel const g_avx2_kernels[CONVERT_KERNELS] = {avx2_s16_f32, avx2_f32_s16, avx2_s8_f32, avx2_f32_s8, avx2_f32_f64, avx2_f64_f32, avx2_sign8, avx2_sign16};
+#elif defined(__aarch64__)
+static convert_kernel const g_neon_kernels[CONVERT_KERNELS] = {neon_s16_f32, neon_f32_s16, neon_s8_f32, neon_f32_s8, neon_f32_f64, neon_f64_f32, neon_sign8, neon_sign16};
+#endif
+//kernel table in use, set once by convert_init.
+static convert_kernel const *gp_kernels = g_scalar_kernels;
+//instruction set of the kernel table in use.
+static enum e_dsp_convert_isa g_isa = DSP_CONVERT_SCALAR;
+//detect the cpu once.
+static pthread_once_t g_convert_once = PTHREAD_ONCE_INIT;
+
+//Check if a pair of types can be converted.
+int dsp_convertSupported(enum e_binary_type input_type, enum e_binary_type output_type)
+{
+  unsigned int input_components = 0;
+  unsigned int output_components = 0;
+
+  if(convert_base(input_type, &input_components) == DATA_INVALID) return 0;
+
+  if(convert_base(output_type, &output_components) == DATA_INVALID) return 0;
+
+  //real to complex has no one right answer, leave it to a node that knows.
+  return input_components == output_components;
+}
+
+//Convert a buffer of elements from one type to another.
+unsigned long dsp_convertBuffer(enum e_binary_type input_type, enum e_binary_type output_type, int byte_swap, void const *p_input, void *p_output, unsigned long size)
+{
+  unsigned int components = 0;
+
+  unsigned long count = 0;
+
+  enum e_binary_type input_base = DATA_INVALID;
+  enum e_binary_type output_base = DATA_INVALID;
+
+  enum e_convert_kernel kernel = CONVERT_KERNELS;
+
+  if(!p_input || !p_output) return 0;
+
+  if(!dsp_convertSupported(input_type, output_type)) return 0;
+
+  input_base = convert_base(input_type, &components);
+
+  output_base = convert_base(output_type, &components);
+
+  count = size * components;
+
+  pthread_once(&g_convert_once, convert_init);
+
+  if(!byte_swap)
+  {
+    if(input_base == output_base)
+    {
+      memcpy(p_output, p_input, count * (convert_bits(input_base) / 8));
+
+      return size;
+    }
+
+    kernel = convert_fast(input_base, output_base);
+
+    if(kernel != CONVERT_KERNELS)
+    {
+      gp_kernels[kernel](p_input, p_output, count);
+
+      return size;
+    }
+  }
+
+  convert_generic(input_base, output_base, byte_swap, p_input, p_output, count);
+
+  return size;
+}
+
+//Instruction set the kernels run with.
+enum e_dsp_convert_isa dsp_convertGetIsa(void)
+{
+  pthread_once(&g_convert_once, convert_init);
+
+  return g_isa;
+}
+
+//Force the instruction set the kernels run with.
+int dsp_convertSetIsa(enum e_dsp_convert_isa isa)
+{
+  pthread_once(&g_convert_once, convert_init);
+
+  switch(isa)
+  {
+    case(DSP_CONVERT_SCALAR):
+      gp_kernels = g_scalar_kernels;
+      break;
+#if defined(__x86_64__)
+    case(DSP_CONVERT_SSE2):
+      gp_kernels = g_sse2_kernels;
+      break;
+    case(DSP_CONVERT_AVX2):
+      if(!__builtin_cpu_supports("avx2")) return ~0;
+
+      gp_kernels = g_avx2_kernels;
+      break;
+#elif defined(__aarch64__)
+    case(DSP_CONVERT_NEON):
+      gp_kernels = g_neon_kernels;
+      break;
+#endif
+    default:
+      return ~0;
+  }
+
+  g_isa = isa;
+
+  return 0;
+}
+
+//Setup convert arg struct
+struct s_dsp_convert_args *create_convert_args(enum e_binary_type input_type, enum e_binary_type output_type, int byte_swap)
+{
+  struct s_dsp_convert_args *p_temp = NULL;
+
+  p_temp = malloc(sizeof(struct s_dsp_convert_args));
+
+  if(!p_temp) return NULL;
+
+  p_temp->input_type = input_type;
+
+  p_temp->output_type = output_type;
+
+  p_temp->byte_swap = byte_swap;
+
+  return p_temp;
+}
+
+//Free args struct created from create convert args
+void free_convert_args(struct s_dsp_convert_args *p_init_args)
+{
+  free(p_init_args);
+}
+
+//Setup convert node, args are copied.
+int init_callback_convert(void *p_init_args, void *p_object)
+{
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_dsp_convert_args *p_convert_args = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_convert_args = (struct s_dsp_convert_args *)p_init_args;
+
+  if(!p_dsp_node || !p_convert_args)
+  {
+    fprintf(stderr, "ERROR: Arguments null.\n");
+
+    return ~0;
+  }
+
+  if(!dsp_convertSupported(p_convert_args->input_type, p_convert_args->output_type))
+  {
+    logger_error_msg(p_dsp_node->p_logger, "CONVERT can not convert type %d to type %d.", p_convert_args->input_type, p_convert_args->output_type);
+
+    return ~0;
+  }
+
+  p_dsp_node->p_data = malloc(sizeof(struct s_dsp_convert_args));
+
+  if(!p_dsp_node->p_data)
+  {
+    logger_error_msg(p_dsp_node->p_logger, "CONVERT Malloc failed for args.");
+
+    return ~0;
+  }
+
+  memcpy(p_dsp_node->p_data, p_convert_args, sizeof(struct s_dsp_convert_args));
+
+  p_dsp_node->input_type = p_convert_args->input_type;
+
+  p_dsp_node->output_type = p_convert_args->output_type;
+
+  p_dsp_node->process_call = process_callback_convert;
+
+  logger_info_msg(p_dsp_node->p_logger, "CONVERT node created for %p, type %d to type %d with %s kernels.", p_dsp_node, p_convert_args->input_type, p_convert_args->output_type, convert_isa_name(dsp_convertGetIsa()));
+
+  return 0;
+}
+
+//Pthread function for threading convert
+void* pthread_function_convert(void *p_data)
+{
+  unsigned long num_read = 0;
+  unsigned long num_done = 0;
+
+  void const *p_input = NULL;
+
+  struct s_dsp_convert_args *p_convert_args = NULL;
+
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_data;
+
+  if(!p_dsp_node)
+  {
+    fprintf(stderr, "ERROR: Data Struct is NULL.\n");
+
+    return NULL;
+  }
+
+  p_dsp_node->active = 1;
+
+  p_convert_args = (struct s_dsp_convert_args *)p_dsp_node->p_data;
+
+  p_dsp_node->total_bytes_processed = 0;
+
+  logger_info_msg(p_dsp_node->p_logger, "CONVERT thread started.");
+
+  do
+  {
+    num_done = 0;
+
+    //convert straight from the input ring into the output ring, no staging buffer.
+    num_read = dsp_peekInput(p_dsp_node, &p_input, p_dsp_node->chunk_size);
+
+    convert_tags(p_dsp_node, num_read);
+
+    while(num_done < num_read)
+    {
+      unsigned long num_reserved = 0;
+
+      void *p_output = NULL;
+
+      num_reserved = dsp_reserveOutput(p_dsp_node, &p_output, num_read - num_done);
+
+      //no one left to read the output.
+      if(!num_reserved) break;
+
+      dsp_convertBuffer(p_convert_args->input_type, p_convert_args->output_type, p_convert_args->byte_swap, (uint8_t const *)p_input + (num_done * p_dsp_node->input_type_size), p_output, num_reserved);
+
+      dsp_commitOutput(p_dsp_node, num_reserved);
+
+      num_done += num_reserved;
+    }
+
+    p_dsp_node->total_bytes_processed += num_done * p_dsp_node->output_type_size;
+
+    dsp_releaseInput(p_dsp_node, num_done);
+
+  } while((num_read > 0) && (num_done == num_read) && !dsp_isCancelled(p_dsp_node));
+
+  dsp_endOutput(p_dsp_node);
+  dsp_endInput(p_dsp_node);
+
+  logger_info_msg(p_dsp_node->p_logger, "CONVERT thread finished.");
+
+  p_dsp_node->active = 0;
+
+  return NULL;
+}
+
+//Process callback for fused or pooled convert.
+int process_callback_convert(void *p_object, struct s_dsp_process *p_process)
+{
+  unsigned long num_input = 0;
+
+  struct s_dsp_convert_args *p_convert_args = NULL;
+
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_convert_args = (struct s_dsp_convert_args *)p_dsp_node->p_data;
+
+  num_input = p_process->input_size;
+
+  if(p_process->input_size > p_process->output_size) p_process->input_size = p_process->output_size;
+
+  p_process->output_size = dsp_convertBuffer(p_convert_args->input_type, p_convert_args->output_type, p_convert_args->byte_swap, p_process->p_input, p_process->p_output, p_process->input_size);
+
+  p_dsp_node->total_bytes_processed += p_process->output_size * p_dsp_node->output_type_size;
+
+  return (p_process->end_of_input && (p_process->input_size == num_input)) || dsp_isCancelled(p_dsp_node);
+}
+
+//clean up all allocations from init_callback
+int free_callback_convert(void *p_object)
+{
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  free(p_dsp_node->p_data);
+
+  p_dsp_node->p_data = NULL;
+
+  return 0;
+}
+
+//pick the kernel table for the best instruction set of the cpu.
+static void convert_init(void)
+{
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+
+  if(__builtin_cpu_supports("avx2"))
+  {
+    gp_kernels = g_avx2_kernels;
+
+    g_isa = DSP_CONVERT_AVX2;
+
+    return;
+  }
+
+  gp_kernels = g_sse2_kernels;
+
+  g_isa = DSP_CONVERT_SSE2;
+#elif defined(__aarch64__)
+  gp_kernels = g_neon_kernels;
+
+  g_isa = DSP_CONVERT_NEON;
+#else
+  gp_kernels = g_scalar_kernels;
+
+  g_isa = DSP_CONVERT_SCALAR;
+#endif
+}
+
+//forward the tags on the next size input elements to the output, elements map one to one.
+static void convert_tags(struct s_dsp_node * const p_dsp_node, unsigned long size)
+{
+  unsigned long index = 0;
+  unsigned long num_tags = 0;
+  unsigned long input_offset = 0;
+  unsigned long output_offset = 0;
+
+  struct s_dsp_tag tags[CONVERT_TAGS];
+
+  num_tags = dsp_getInputTags(p_dsp_node, size, tags, CONVERT_TAGS);
+
+  //no tags is the common case, skip looking up the offsets.
+  if(!num_tags) return;
+
+  input_offset = dsp_getInputOffset(p_dsp_node, 0);
+
+  output_offset = dsp_getOutputOffset(p_dsp_node);
+
+  do
+  {
+    for(index = 0; index < num_tags; index++)
+    {
+      tags[index].offset = tags[index].offset - input_offset + output_offset;
+
+      dsp_addOutputTag(p_dsp_node, &tags[index]);
+    }
+
+    if(num_tags < CONVERT_TAGS) break;
+
+    num_tags = dsp_getInputTags(p_dsp_node, size, tags, CONVERT_TAGS);
+
+  } while(num_tags);
+}
+
+//name of a instruction set for the log.
+static char const *convert_isa_name(enum e_dsp_convert_isa isa)
+{
+  switch(isa)
+  {
+    case(DSP_CONVERT_SSE2):
+      return "SSE2";
+    case(DSP_CONVERT_AVX2):
+      return "AVX2";
+    case(DSP_CONVERT_NEON):
+      return "NEON";
+    default:
+      return "scalar";
+  }
+}
+
+//component type of a type, complex types have two of them.
+static enum e_binary_type convert_base(enum e_binary_type type, unsigned int *p_components)
+{
+  *p_components = 1;
+
+  switch(type)
+  {
+    case(DATA_S8):
+    case(DATA_U8):
+    case(DATA_S16):
+    case(DATA_U16):
+    case(DATA_S32):
+    case(DATA_U32):
+    case(DATA_FLOAT):
+    case(DATA_DOUBLE):
+      return type;
+    case(DATA_CS8):
+      *p_components = 2;
+      return DATA_S8;
+    case(DATA_CS16):
+      *p_components = 2;
+      return DATA_S16;
+    case(DATA_CFLOAT):
+      *p_components = 2;
+      return DATA_FLOAT;
+    case(DATA_CDOUBLE):
+      *p_components = 2;
+      return DATA_DOUBLE;
+    default:
+      *p_components = 0;
+      return DATA_INVALID;
+  }
+}
+
+//size in bits of a component type.
+static unsigned int convert_bits(enum e_binary_type base)
+{
+  switch(base)
+  {
+    case(DATA_S8):
+    case(DATA_U8):
+      return 8;
+    case(DATA_S16):
+    case(DATA_U16):
+      return 16;
+    case(DATA_S32):
+    case(DATA_U32):
+    case(DATA_FLOAT):
+      return 32;
+    default:
+      return 64;
+  }
+}
+
+//kernel of a component pair, CONVERT_KERNELS if it has none.
+static enum e_convert_kernel convert_fast(enum e_binary_type input_base, enum e_binary_type output_base)
+{
+  if((input_base == DATA_S16) && (output_base == DATA_FLOAT)) return CONVERT_S16_F32;
+
+  if((input_base == DATA_FLOAT) && (output_base == DATA_S16)) return CONVERT_F32_S16;
+
+  if((input_base == DATA_S8) && (output_base == DATA_FLOAT)) return CONVERT_S8_F32;
+
+  if((input_base == DATA_FLOAT) && (output_base == DATA_S8)) return CONVERT_F32_S8;
+
+  if((input_base == DATA_FLOAT) && (output_base == DATA_DOUBLE)) return CONVERT_F32_F64;
+
+  if((input_base == DATA_DOUBLE) && (output_base == DATA_FLOAT)) return CONVERT_F64_F32;
+
+  //same width signed to unsigned or back only flips the top bit.
+  if(((input_base == DATA_S8) && (output_base == DATA_U8)) || ((input_base == DATA_U8) && (output_base == DATA_S8))) return CONVERT_SIGN8;
+
+  if(((input_base == DATA_S16) && (output_base == DATA_U16)) || ((input_base == DATA_U16) && (output_base == DATA_S16))) return CONVERT_SIGN16;
+
+  return CONVERT_KERNELS;
+}
+
+//convert any component pair one at a time, through fixed point for integers or double for the rest.
+static void convert_generic(enum e_binary_type input_base, enum e_binary_type output_base, int byte_swap, void const *p_input, void *p_output, unsigned long count)
+{
+  int fixed = 0;
+
+  unsigned int input_bytes = 0;
+  unsigned int output_bytes = 0;
+
+  unsigned long index = 0;
+
+  input_bytes = convert_bits(input_base) / 8;
+
+  output_bytes = convert_bits(output_base) / 8;
+
+  //integer to integer stays in fixed point so 32 bit values are exact.
+  fixed = (input_base != DATA_FLOAT) && (input_base != DATA_DOUBLE) && (output_base != DATA_FLOAT) && (output_base != DATA_DOUBLE);
+
+  for(index = 0; index < count; index++)
+  {
+    uint64_t value = 0;
+
+    value = convert_read(p_input, index, input_bytes, byte_swap);
+
+    if(fixed)
+    {
+      value = convert_from_q31(output_base, convert_to_q31(input_base, value));
+    }
+    else
+    {
+      value = convert_from_f64(output_base, convert_to_f64(input_base, value));
+    }
+
+    convert_write(p_output, index, output_bytes, value);
+  }
+}
+
+//read a component as a unsigned value, byte swapped if asked.
+static uint64_t convert_read(void const *p_input, unsigned long index, unsigned int bytes, int byte_swap)
+{
+  uint8_t const *p_component = (uint8_t const *)p_input + (index * bytes);
+
+  switch(bytes)
+  {
+    case(1):
+      return *p_component;
+    case(2):
+    {
+      uint16_t value = 0;
+
+      memcpy(&value, p_component, sizeof(value));
+
+      return byte_swap ? __builtin_bswap16(value) : value;
+    }
+    case(4):
+    {
+      uint32_t value = 0;
+
+      memcpy(&value, p_component, sizeof(value));
+
+      return byte_swap ? __builtin_bswap32(value) : value;
+    }
+    default:
+    {
+      uint64_t value = 0;
+
+      memcpy(&value, p_component, sizeof(value));
+
+      return byte_swap ? __builtin_bswap64(value) : value;
+    }
+  }
+}
+
+//write a component from a unsigned value.
+static void convert_write(void *p_output, unsigned long index, unsigned int bytes, uint64_t value)
+{
+  uint8_t *p_component = (uint8_t *)p_output + (index * bytes);
+
+  switch(bytes)
+  {
+    case(1):
+      *p_component = (uint8_t)value;
+      break;
+    case(2):
+    {
+      uint16_t temp = (uint16_t)value;
+
+      memcpy(p_component, &temp, sizeof(temp));
+      break;
+    }
+    case(4):
+    {
+      uint32_t temp = (uint32_t)value;
+
+      memcpy(p_component, &temp, sizeof(temp));
+      break;
+    }
+    default:
+      memcpy(p_component, &value, sizeof(value));
+      break;
+  }
+}
+
+//integer component to full scale 32 bit fixed point.
+static int32_t convert_to_q31(enum e_binary_type base, uint64_t value)
+{
+  unsigned int bits = convert_bits(base);
+
+  uint32_t temp = (uint32_t)value;
+
+  //unsigned is offset binary, flipping the top bit makes it two's complement.
+  if((base == DATA_U8) || (base == DATA_U16) || (base == DATA_U32)) temp ^= 1U << (bits - 1);
+
+  return (int32_t)(temp << (32 - bits));
+}
+
+//full scale 32 bit fixed point to a integer component, drops the low bits.
+static uint64_t convert_from_q31(enum e_binary_type base, int32_t value)
+{
+  unsigned int bits = convert_bits(base);
+
+  uint32_t temp = (uint32_t)value >> (32 - bits);
+
+  if((base == DATA_U8) || (base == DATA_U16) || (base == DATA_U32)) temp ^= 1U << (bits - 1);
+
+  return temp;
+}
+
+//component to double, integers are -1.0 to 1.0.
+static double convert_to_f64(enum e_binary_type base, uint64_t value)
+{
+  switch(base)
+  {
+    case(DATA_FLOAT):
+    {
+      float temp = 0;
+
+      uint32_t bits = (uint32_t)value;
+
+      memcpy(&temp, &bits, sizeof(temp));
+
+      return temp;
+    }
+    case(DATA_DOUBLE):
+    {
+      double temp = 0;
+
+      memcpy(&temp, &value, sizeof(temp));
+
+      return temp;
+    }
+    default:
+      return (double)convert_to_q31(base, value) * (1.0 / 2147483648.0);
+  }
+}
+
+//double to a component, integers are rounded and saturated.
+static uint64_t convert_from_f64(enum e_binary_type base, double value)
+{
+  switch(base)
+  {
+    case(DATA_FLOAT):
+    {
+      float temp = (float)value;
+
+      uint32_t bits = 0;
+
+      memcpy(&bits, &temp, sizeof(bits));
+
+      return bits;
+    }
+    case(DATA_DOUBLE):
+    {
+      uint64_t bits = 0;
+
+      memcpy(&bits, &value, sizeof(bits));
+
+      return bits;
+    }
+    default:
+    {
+      unsigned int bits = convert_bits(base);
+
+      double scale = ldexp(1.0, (int)bits - 1);
+
+      uint32_t temp = 0;
+
+      value *= scale;
+
+      //nan goes to the bottom like the simd kernels.
+      if(!(value > -scale)) value = -scale;
+
+      if(value > scale - 1) value = scale - 1;
+
+      temp = (uint32_t)(int32_t)llrint(value) & (uint32_t)(~0ULL >> (64 - bits));
+
+      if((base == DATA_U8) || (base == DATA_U16) || (base == DATA_U32)) temp ^= 1U << (bits - 1);
+
+      return temp;
+    }
+  }
+}
+
+//scalar S16 to FLOAT.
+static void scalar_s16_f32(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  int16_t const *p_in = (int16_t const *)p_input;
+
+  float *p_out = (float *)p_output;
+
+  for(index = 0; index < count; index++)
+  {
+    p_out[index] = (float)p_in[index] * (1.0f / 32768.0f);
+  }
+}
+
+//scalar FLOAT to S16, rounded and saturated.
+static void scalar_f32_s16(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  float const *p_in = (float const *)p_input;
+
+  int16_t *p_out = (int16_t *)p_output;
+
+  for(index = 0; index < count; index++)
+  {
+    float value = p_in[index] * 32768.0f;
+
+    if(!(value > -32768.0f)) value = -32768.0f;
+
+    if(value > 32767.0f) value = 32767.0f;
+
+    p_out[index] = (int16_t)lrintf(value);
+  }
+}
+
+//scalar S8 to FLOAT.
+static void scalar_s8_f32(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  int8_t const *p_in = (int8_t const *)p_input;
+
+  float *p_out = (float *)p_output;
+
+  for(index = 0; index < count; index++)
+  {
+    p_out[index] = (float)p_in[index] * (1.0f / 128.0f);
+  }
+}
+
+//scalar FLOAT to S8, rounded and saturated.
+static void scalar_f32_s8(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  float const *p_in = (float const *)p_input;
+
+  int8_t *p_out = (int8_t *)p_output;
+
+  for(index = 0; index < count; index++)
+  {
+    float value = p_in[index] * 128.0f;
+
+    if(!(value > -128.0f)) value = -128.0f;
+
+    if(value > 127.0f) value = 127.0f;
+
+    p_out[index] = (int8_t)lrintf(value);
+  }
+}
+
+//scalar FLOAT to DOUBLE.
+static void scalar_f32_f64(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  float const *p_in = (float const *)p_input;
+
+  double *p_out = (double *)p_output;
+
+  for(index = 0; index < count; index++)
+  {
+    p_out[index] = p_in[index];
+  }
+}
+
+//scalar DOUBLE to FLOAT.
+static void scalar_f64_f32(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  double const *p_in = (double const *)p_input;
+
+  float *p_out = (float *)p_output;
+
+  for(index = 0; index < count; index++)
+  {
+    p_out[index] = (float)p_in[index];
+  }
+}
+
+//scalar S8 to U8 or back.
+static void scalar_sign8(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  uint8_t const *p_in = (uint8_t const *)p_input;
+
+  uint8_t *p_out = (uint8_t *)p_output;
+
+  for(index = 0; index < count; index++)
+  {
+    p_out[index] = p_in[index] ^ 0x80;
+  }
+}
+
+//scalar S16 to U16 or back.
+static void scalar_sign16(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  uint16_t const *p_in = (uint16_t const *)p_input;
+
+  uint16_t *p_out = (uint16_t *)p_output;
+
+  for(index = 0; index < count; index++)
+  {
+    p_out[index] = p_in[index] ^ 0x8000;
+  }
+}
+
+#if defined(__x86_64__)
+//sse2 S16 to FLOAT, 8 at a time.
+static void sse2_s16_f32(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+
+  int16_t const *p_in = (int16_t const *)p_input;
+
+  float *p_out = (float *)p_output;
+
+  for(index = 0; index + 8 <= count; index += 8)
+  {
+    __m128i value = _mm_loadu_si128((__m128i const *)(p_in + index));
+
+    //each value in the top half of a 32 bit lane, the shift sign extends it down.
+    __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16);
+
+    __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(value, value), 16);
+
+    _mm_storeu_ps(p_out + index, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+
+    _mm_storeu_ps(p_out + index + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+  }
+
+  scalar_s16_f32(p_in + index, p_out + index, count - index);
+}
+
+//sse2 FLOAT to S16, 8 at a time.
+static void sse2_f32_s16(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  __m128 scale = _mm_set1_ps(32768.0f);
+  __m128 min = _mm_set1_ps(-32768.0f);
+  __m128 max = _mm_set1_ps(32767.0f);
+
+  float const *p_in = (float const *)p_input;
+
+  int16_t *p_out = (int16_t *)p_output;
+
+  for(index = 0; index + 8 <= count; index += 8)
+  {
+    //max returns its second operand for nan, so nan goes to the bottom.
+    __m128 low = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(p_in + index), scale), min), max);
+
+    __m128 high = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(p_in + index + 4), scale), min), max);
+
+    _mm_storeu_si128((__m128i *)(p_out + index), _mm_packs_epi32(_mm_cvtps_epi32(low), _mm_cvtps_epi32(high)));
+  }
+
+  scalar_f32_s16(p_in + index, p_out + index, count - index);
+}
+
+//sse2 S8 to FLOAT, 16 at a time.
+static void sse2_s8_f32(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  __m128 scale = _mm_set1_ps(1.0f / 128.0f);
+
+  int8_t const *p_in = (int8_t const *)p_input;
+
+  float *p_out = (float *)p_output;
+
+  for(index = 0; index + 16 <= count; index += 16)
+  {
+    __m128i value = _mm_loadu_si128((__m128i const *)(p_in + index));
+
+    __m128i low = _mm_unpacklo_epi8(value, value);
+
+    __m128i high = _mm_unpackhi_epi8(value, value);
+
+    //each value in the top byte of a 32 bit lane, the shift sign extends it down.
+    _mm_storeu_ps(p_out + index, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(low, low), 24)), scale));
+
+    _mm_storeu_ps(p_out + index + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(low, low), 24)), scale));
+
+    _mm_storeu_ps(p_out + index + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(high, high), 24)), scale));
+
+    _mm_storeu_ps(p_out + index + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(high, high), 24)), scale));
+  }
+
+  scalar_s8_f32(p_in + index, p_out + index, count - index);
+}
+
+//sse2 FLOAT to S8, 16 at a time.
+static void sse2_f32_s8(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  __m128 scale = _mm_set1_ps(128.0f);
+  __m128 min = _mm_set1_ps(-128.0f);
+  __m128 max = _mm_set1_ps(127.0f);
+
+  float const *p_in = (float const *)p_input;
+
+  int8_t *p_out = (int8_t *)p_output;
+
+  for(index = 0; index + 16 <= count; index += 16)
+  {
+    __m128i value[4];
+
+    unsigned int lane = 0;
+
+    for(lane = 0; lane < 4; lane++)
+    {
+      value[lane] = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(p_in + index + (lane * 4)), scale), min), max));
+    }
+
+    _mm_storeu_si128((__m128i *)(p_out + index), _mm_packs_epi16(_mm_packs_epi32(value[0], value[1]), _mm_packs_epi32(value[2], value[3])));
+  }
+
+  scalar_f32_s8(p_in + index, p_out + index, count - index);
+}
+
+//sse2 FLOAT to DOUBLE, 4 at a time.
+static void sse2_f32_f64(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  float const *p_in = (float const *)p_input;
+
+  double *p_out = (double *)p_output;
+
+  for(index = 0; index + 4 <= count; index += 4)
+  {
+    __m128 value = _mm_loadu_ps(p_in + index);
+
+    _mm_storeu_pd(p_out + index, _mm_cvtps_pd(value));
+
+    _mm_storeu_pd(p_out + index + 2, _mm_cvtps_pd(_mm_movehl_ps(value, value)));
+  }
+
+  scalar_f32_f64(p_in + index, p_out + index, count - index);
+}
+
+//sse2 DOUBLE to FLOAT, 4 at a time.
+static void sse2_f64_f32(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  double const *p_in = (double const *)p_input;
+
+  float *p_out = (float *)p_output;
+
+  for(index = 0; index + 4 <= count; index += 4)
+  {
+    __m128 low = _mm_cvtpd_ps(_mm_loadu_pd(p_in + index));
+
+    __m128 high = _mm_cvtpd_ps(_mm_loadu_pd(p_in + index + 2));
+
+    _mm_storeu_ps(p_out + index, _mm_movelh_ps(low, high));
+  }
+
+  scalar_f64_f32(p_in + index, p_out + index, count - index);
+}
+
+//sse2 S8 to U8 or back, 16 at a time.
+static void sse2_sign8(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  __m128i sign = _mm_set1_epi8((char)0x80);
+
+  uint8_t const *p_in = (uint8_t const *)p_input;
+
+  uint8_t *p_out = (uint8_t *)p_output;
+
+  for(index = 0; index + 16 <= count; index += 16)
+  {
+    _mm_storeu_si128((__m128i *)(p_out + index), _mm_xor_si128(_mm_loadu_si128((__m128i const *)(p_in + index)), sign));
+  }
+
+  scalar_sign8(p_in + index, p_out + index, count - index);
+}
+
+//sse2 S16 to U16 or back, 8 at a time.
+static void sse2_sign16(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  __m128i sign = _mm_set1_epi16((short)0x8000);
+
+  uint16_t const *p_in = (uint16_t const *)p_input;
+
+  uint16_t *p_out = (uint16_t *)p_output;
+
+  for(index = 0; index + 8 <= count; index += 8)
+  {
+    _mm_storeu_si128((__m128i *)(p_out + index), _mm_xor_si128(_mm_loadu_si128((__m128i const *)(p_in + index)), sign));
+  }
+
+  scalar_sign16(p_in + index, p_out + index, count - index);
+}
+
+//avx2 S16 to FLOAT, 16 at a time.
+__attribute__((target("avx2"))) static void avx2_s16_f32(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  __m256 scale = _mm256_set1_ps(1.0f / 32768.0f);
+
+  int16_t const *p_in = (int16_t const *)p_input;
+
+  float *p_out = (float *)p_output;
+
+  for(index = 0; index + 16 <= count; index += 16)
+  {
+    __m256i low = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i const *)(p_in + index)));
+
+    __m256i high = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i const *)(p_in + index + 8)));
+
+    _mm256_storeu_ps(p_out + index, _mm256_mul_ps(_mm256_cvtepi32_ps(low), scale));
+
+    _mm256_storeu_ps(p_out + index + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(high), scale));
+  }
+
+  scalar_s16_f32(p_in + index, p_out + index, count - index);
+}
+
+//avx2 FLOAT to S16, 16 at a time.
+__attribute__((target("avx2"))) static void avx2_f32_s16(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  __m256 scale = _mm256_set1_ps(32768.0f);
+  __m256 min = _mm256_set1_ps(-32768.0f);
+  __m256 max = _mm256_set1_ps(32767.0f);
+
+  float const *p_in = (float const *)p_input;
+
+  int16_t *p_out = (int16_t *)p_output;
+
+  for(index = 0; index + 16 <= count; index += 16)
+  {
+    __m256i low = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(p_in + index), scale), min), max));
+
+    __m256i high = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(p_in + index + 8), scale), min), max));
+
+    //pack works per 128 bit lane, put the 64 bit quarters back in order.
+    _mm256_storeu_si256((__m256i *)(p_out + index), _mm256_permute4x64_epi64(_mm256_packs_epi32(low, high), 0xD8));
+  }
+
+  scalar_f32_s16(p_in + index, p_out + index, count - index);
+}
+
+//avx2 S8 to FLOAT, 16 at a time.
+__attribute__((target("avx2"))) static void avx2_s8_f32(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  __m256 scale = _mm256_set1_ps(1.0f / 128.0f);
+
+  int8_t const *p_in = (int8_t const *)p_input;
+
+  float *p_out = (float *)p_output;
+
+  for(index = 0; index + 16 <= count; index += 16)
+  {
+    __m128i value = _mm_loadu_si128((__m128i const *)(p_in + index));
+
+    _mm256_storeu_ps(p_out + index, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(value)), scale));
+
+    _mm256_storeu_ps(p_out + index + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(value, 8))), scale));
+  }
+
+  scalar_s8_f32(p_in + index, p_out + index, count - index);
+}
+
+//avx2 FLOAT to S8, 32 at a time.
+__attribute__((target("avx2"))) static void avx2_f32_s8(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  __m256 scale = _mm256_set1_ps(128.0f);
+  __m256 min = _mm256_set1_ps(-128.0f);
+  __m256 max = _mm256_set1_ps(127.0f);
+
+  __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+  float const *p_in = (float const *)p_input;
+
+  int8_t *p_out = (int8_t *)p_output;
+
+  for(index = 0; index + 32 <= count; index += 32)
+  {
+    __m256i value[4];
+
+    unsigned int lane = 0;
+
+    for(lane = 0; lane < 4; lane++)
+    {
+      value[lane] = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(p_in + index + (lane * 8)), scale), min), max));
+    }
+
+    //both packs work per 128 bit lane, leaving 32 bit groups interleaved by lane.
+    _mm256_storeu_si256((__m256i *)(p_out + index), _mm256_permutevar8x32_epi32(_mm256_packs_epi16(_mm256_packs_epi32(value[0], value[1]), _mm256_packs_epi32(value[2], value[3])), order));
+  }
+
+  scalar_f32_s8(p_in + index, p_out + index, count - index);
+}
+
+//avx2 FLOAT to DOUBLE, 8 at a time.
+__attribute__((target("avx2"))) static void avx2_f32_f64(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  float const *p_in = (float const *)p_input;
+
+  double *p_out = (double *)p_output;
+
+  for(index = 0; index + 8 <= count; index += 8)
+  {
+    _mm256_storeu_pd(p_out + index, _mm256_cvtps_pd(_mm_loadu_ps(p_in + index)));
+
+    _mm256_storeu_pd(p_out + index + 4, _mm256_cvtps_pd(_mm_loadu_ps(p_in + index + 4)));
+  }
+
+  scalar_f32_f64(p_in + index, p_out + index, count - index);
+}
+
+//avx2 DOUBLE to FLOAT, 8 at a time.
+__attribute__((target("avx2"))) static void avx2_f64_f32(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  double const *p_in = (double const *)p_input;
+
+  float *p_out = (float *)p_output;
+
+  for(index = 0; index + 8 <= count; index += 8)
+  {
+    _mm_storeu_ps(p_out + index, _mm256_cvtpd_ps(_mm256_loadu_pd(p_in + index)));
+
+    _mm_storeu_ps(p_out + index + 4, _mm256_cvtpd_ps(_mm256_loadu_pd(p_in + index + 4)));
+  }
+
+  scalar_f64_f32(p_in + index, p_out + index, count - index);
+}
+
+//avx2 S8 to U8 or back, 32 at a time.
+__attribute__((target("avx2"))) static void avx2_sign8(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  __m256i sign = _mm256_set1_epi8((char)0x80);
+
+  uint8_t const *p_in = (uint8_t const *)p_input;
+
+  uint8_t *p_out = (uint8_t *)p_output;
+
+  for(index = 0; index + 32 <= count; index += 32)
+  {
+    _mm256_storeu_si256((__m256i *)(p_out + index), _mm256_xor_si256(_mm256_loadu_si256((__m256i const *)(p_in + index)), sign));
+  }
+
+  scalar_sign8(p_in + index, p_out + index, count - index);
+}
+
+//avx2 S16 to U16 or back, 16 at a time.
+__attribute__((target("avx2"))) static void avx2_sign16(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  __m256i sign = _mm256_set1_epi16((short)0x8000);
+
+  uint16_t const *p_in = (uint16_t const *)p_input;
+
+  uint16_t *p_out = (uint16_t *)p_output;
+
+  for(index = 0; index + 16 <= count; index += 16)
+  {
+    _mm256_storeu_si256((__m256i *)(p_out + index), _mm256_xor_si256(_mm256_loadu_si256((__m256i const *)(p_in + index)), sign));
+  }
+
+  scalar_sign16(p_in + index, p_out + index, count - index);
+}
+#elif defined(__aarch64__)
+//neon S16 to FLOAT, 8 at a time.
+static void neon_s16_f32(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  float32x4_t scale = vdupq_n_f32(1.0f / 32768.0f);
+
+  int16_t const *p_in = (int16_t const *)p_input;
+
+  float *p_out = (float *)p_output;
+
+  for(index = 0; index + 8 <= count; index += 8)
+  {
+    int16x8_t value = vld1q_s16(p_in + index);
+
+    vst1q_f32(p_out + index, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(value))), scale));
+
+    vst1q_f32(p_out + index + 4, vmulq_f32(vcvtq_f32_s32(vmovl_high_s16(value)), scale));
+  }
+
+  scalar_s16_f32(p_in + index, p_out + index, count - index);
+}
+
+//neon FLOAT to S16, 8 at a time.
+static void neon_f32_s16(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  float32x4_t scale = vdupq_n_f32(32768.0f);
+  float32x4_t min = vdupq_n_f32(-32768.0f);
+  float32x4_t max = vdupq_n_f32(32767.0f);
+
+  float const *p_in = (float const *)p_input;
+
+  int16_t *p_out = (int16_t *)p_output;
+
+  for(index = 0; index + 8 <= count; index += 8)
+  {
+    //maxnm returns the number for nan, so nan goes to the bottom.
+    int32x4_t low = vcvtnq_s32_f32(vminq_f32(vmaxnmq_f32(vmulq_f32(vld1q_f32(p_in + index), scale), min), max));
+
+    int32x4_t high = vcvtnq_s32_f32(vminq_f32(vmaxnmq_f32(vmulq_f32(vld1q_f32(p_in + index + 4), scale), min), max));
+
+    vst1q_s16(p_out + index, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+  }
+
+  scalar_f32_s16(p_in + index, p_out + index, count - index);
+}
+
+//neon S8 to FLOAT, 16 at a time.
+static void neon_s8_f32(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  float32x4_t scale = vdupq_n_f32(1.0f / 128.0f);
+
+  int8_t const *p_in = (int8_t const *)p_input;
+
+  float *p_out = (float *)p_output;
+
+  for(index = 0; index + 16 <= count; index += 16)
+  {
+    int8x16_t value = vld1q_s8(p_in + index);
+
+    int16x8_t low = vmovl_s8(vget_low_s8(value));
+
+    int16x8_t high = vmovl_high_s8(value);
+
+    vst1q_f32(p_out + index, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(low))), scale));
+
+    vst1q_f32(p_out + index + 4, vmulq_f32(vcvtq_f32_s32(vmovl_high_s16(low)), scale));
+
+    vst1q_f32(p_out + index + 8, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(high))), scale));
+
+    vst1q_f32(p_out + index + 12, vmulq_f32(vcvtq_f32_s32(vmovl_high_s16(high)), scale));
+  }
+
+  scalar_s8_f32(p_in + index, p_out + index, count - index);
+}
+
+//neon FLOAT to S8, 16 at a time.
+static void neon_f32_s8(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  float32x4_t scale = vdupq_n_f32(128.0f);
+  float32x4_t min = vdupq_n_f32(-128.0f);
+  float32x4_t max = vdupq_n_f32(127.0f);
+
+  float const *p_in = (float const *)p_input;
+
+  int8_t *p_out = (int8_t *)p_output;
+
+  for(index = 0; index + 16 <= count; index += 16)
+  {
+    int16x4_t value[4];
+
+    unsigned int lane = 0;
+
+    for(lane = 0; lane < 4; lane++)
+    {
+      value[lane] = vqmovn_s32(vcvtnq_s32_f32(vminq_f32(vmaxnmq_f32(vmulq_f32(vld1q_f32(p_in + index + (lane * 4)), scale), min), max)));
+    }
+
+    vst1q_s8(p_out + index, vcombine_s8(vqmovn_s16(vcombine_s16(value[0], value[1])), vqmovn_s16(vcombine_s16(value[2], value[3]))));
+  }
+
+  scalar_f32_s8(p_in + index, p_out + index, count - index);
+}
+
+//neon FLOAT to DOUBLE, 4 at a time.
+static void neon_f32_f64(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  float const *p_in = (float const *)p_input;
+
+  double *p_out = (double *)p_output;
+
+  for(index = 0; index + 4 <= count; index += 4)
+  {
+    float32x4_t value = vld1q_f32(p_in + index);
+
+    vst1q_f64(p_out + index, vcvt_f64_f32(vget_low_f32(value)));
+
+    vst1q_f64(p_out + index + 2, vcvt_high_f64_f32(value));
+  }
+
+  scalar_f32_f64(p_in + index, p_out + index, count - index);
+}
+
+//neon DOUBLE to FLOAT, 4 at a time.
+static void neon_f64_f32(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  double const *p_in = (double const *)p_input;
+
+  float *p_out = (float *)p_output;
+
+  for(index = 0; index + 4 <= count; index += 4)
+  {
+    vst1q_f32(p_out + index, vcvt_high_f32_f64(vcvt_f32_f64(vld1q_f64(p_in + index)), vld1q_f64(p_in + index + 2)));
+  }
+
+  scalar_f64_f32(p_in + index, p_out + index, count - index);
+}
+
+//neon S8 to U8 or back, 16 at a time.
+static void neon_sign8(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  uint8x16_t sign = vdupq_n_u8(0x80);
+
+  uint8_t const *p_in = (uint8_t const *)p_input;
+
+  uint8_t *p_out = (uint8_t *)p_output;
+
+  for(index = 0; index + 16 <= count; index += 16)
+  {
+    vst1q_u8(p_out + index, veorq_u8(vld1q_u8(p_in + index), sign));
+  }
+
+  scalar_sign8(p_in + index, p_out + index, count - index);
+}
+
+//neon S16 to U16 or back, 8 at a time.
+static void neon_sign16(void const *p_input, void *p_output, unsigned long count)
+{
+  unsigned long index = 0;
+
+  uint16x8_t sign = vdupq_n_u16(0x8000);
+
+  uint16_t const *p_in = (uint16_t const *)p_input;
+
+  uint16_t *p_out = (uint16_t *)p_output;
+
+  for(index = 0; index + 8 <= count; index += 8)
+  {
+    vst1q_u16(p_out + index, veorq_u16(vld1q_u16(p_in + index), sign));
+  }
+
+  scalar_sign16(p_in + index, p_out + index, count - index);
+}
+#endif
@@ -0,0 +1,154 @@
+//******************************************************************************
+/// @file     dsp_convert.h
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Format conversion between e_binary_type formats, and a node for it.
+/// @details  Integers are fixed point full scale, -1.0 to 1.0 as float. Hot
+///           pairs (S16, S8 to and from FLOAT, FLOAT to and from DOUBLE) have
+///           SSE2, AVX2 and NEON kernels picked at runtime, the rest is scalar.
+///           Complex types convert component by component.
+//******************************************************************************
+
+#ifndef __dsp_convert
+#define __dsp_convert
+
+// includes
+#include "dsp_node_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @enum e_dsp_convert_isa
+ * Instruction set the conversion kernels run with.
+ */
+enum e_dsp_convert_isa {DSP_CONVERT_SCALAR=0, DSP_CONVERT_SSE2, DSP_CONVERT_AVX2, DSP_CONVERT_NEON};
+
+/**
+ * @struct s_dsp_convert_args
+ * @brief Contains argument data for convert node creation (pass to p_init_args for init_callback).
+ */
+struct s_dsp_convert_args
+{
+  /**
+   * @var s_dsp_convert_args::input_type
+   * input data format
+   */
+  enum e_binary_type input_type;
+  /**
+   * @var s_dsp_convert_args::output_type
+   * output data format
+   */
+  enum e_binary_type output_type;
+  /**
+   * @var s_dsp_convert_args::byte_swap
+   * 1 input is the other endian and each component is byte swapped, 0 native.
+   */
+  int byte_swap;
+};
+
+/**************************************************************************//**
+  * @brief Check if a pair of types can be converted. Real converts to real and
+  * complex to complex, every width and sign to every other.
+  *
+  * @param input_type format converted from
+  * @param output_type format converted to
+  *
+  * @return 1 supported, 0 not.
+  ****************************************************************************/
+int dsp_convertSupported(enum e_binary_type input_type, enum e_binary_type output_type);
+
+/**************************************************************************//**
+  * @brief Convert a buffer of elements from one type to another.
+  *
+  * @param input_type format of p_input
+  * @param output_type format of p_output
+  * @param byte_swap 1 byte swap every input component first, 0 native.
+  * @param p_input elements to convert
+  * @param p_output space for size elements of output_type, may not overlap p_input.
+  * @param size number of elements (a complex element is two components).
+  *
+  * @return number of elements converted, 0 if the pair is not supported.
+  ****************************************************************************/
+unsigned long dsp_convertBuffer(enum e_binary_type input_type, enum e_binary_type output_type, int byte_swap, void const *p_input, void *p_output, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Instruction set the kernels run with, detected on first use.
+  *
+  * @return e_dsp_convert_isa in use.
+  ****************************************************************************/
+enum e_dsp_convert_isa dsp_convertGetIsa(void);
+
+/**************************************************************************//**
+  * @brief Force the instruction set the kernels run with, for benchmarks and
+  * checking a kernel against scalar. Call before any node runs.
+  *
+  * @param isa e_dsp_convert_isa to use, must be supported by the cpu.
+  *
+  * @return 0 no error, non-zero the cpu does not support it.
+  ****************************************************************************/
+int dsp_convertSetIsa(enum e_dsp_convert_isa isa);
+
+/**************************************************************************//**
+  * @brief Setup convert arg struct
+  *
+  * @param input_type input format
+  * @param output_type output format
+  * @param byte_swap 1 input is the other endian, 0 native.
+  *
+  * @return Arg struct
+  ****************************************************************************/
+struct s_dsp_convert_args *create_convert_args(enum e_binary_type input_type, enum e_binary_type output_type, int byte_swap);
+
+/**************************************************************************//**
+  * @brief Free args struct created from create convert args
+  *
+  * @param p_init_args convert args struct to free
+  ****************************************************************************/
+void free_convert_args(struct s_dsp_convert_args *p_init_args);
+
+/**************************************************************************//**
+  * @brief Setup convert node, args are copied so they may be freed after setup.
+  *
+  * @param p_init_args pass struct s_dsp_convert_args
+  * @param p_object A dsp_node struct used to change various settings.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int init_callback_convert(void *p_init_args, void *p_object);
+
+/**************************************************************************//**
+  * @brief Pthread function for threading convert, converts from the input
+  * ring straight into the output ring.
+  *
+  * @param p_data This will contain dsp_node struct so all data is available.
+  *
+  * @return NULL
+  ****************************************************************************/
+void* pthread_function_convert(void *p_data);
+
+/**************************************************************************//**
+  * @brief Process callback for fused or pooled convert.
+  *
+  * @param p_object convert dsp node object.
+  * @param p_process elements in, converted elements out.
+  *
+  * @return 0 more data, non-zero input ended and all of it converted.
+  ****************************************************************************/
+int process_callback_convert(void *p_object, struct s_dsp_process *p_process);
+
+/**************************************************************************//**
+  * @brief Clean up all allocations from init_callback
+  *
+  * @param p_object convert dsp node object to free
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int free_callback_convert(void *p_object);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
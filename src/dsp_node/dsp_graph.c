@@ -0,0 +1,1367 @@
+//******************************************************************************
+/// @file     dsp_graph.c
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Graph of DSP nodes, owns node lifecycle from create to cleanup.
+/// @details  Nodes are added and connected, the graph checks types once,
+///           starts sinks first and joins/cleans up in topological order.
+//******************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "dsp_graph.h"
+#include "dsp_convert.h"
+
+//scratch block between two fused nodes, or between a chain and its rings.
+struct s_graph_scratch
+{
+  uint8_t *p_buffer;
+  unsigned long size;
+  unsigned long fill;
+  unsigned long type_size;
+};
+
+//logger of the nodes in the graph, NULL if there are none.
+static struct s_logger *graph_logger(struct s_dsp_graph const * const p_graph);
+
+//index of a node in the graph, num_nodes if it is not in the graph.
+static unsigned int graph_find(struct s_dsp_graph const * const p_graph, struct s_dsp_node const * const p_node);
+
+//fill p_order with the nodes in topological order, sources first.
+static int graph_sort(struct s_dsp_graph * const p_graph);
+
+//check every input port is connected and warn of outputs no one reads.
+static int graph_check(struct s_dsp_graph const * const p_graph);
+
+//find linear chains of nodes with a process_call and fuse them, fills p_node_chain.
+static int graph_fuse(struct s_dsp_graph * const p_graph);
+
+//next node a chain can be fused to, NULL if the chain ends at p_node.
+static struct s_dsp_node *graph_fuse_next(struct s_dsp_graph const * const p_graph, struct s_dsp_node const * const p_node);
+
+//pthread function running every node of a fused chain.
+static void *graph_chain_thread(void *p_data);
+
+//1 if a node runs as a task on the graph pool, 0 if it has its own thread.
+static int graph_pooled(struct s_dsp_graph const * const p_graph, unsigned int node);
+
+//check the graph can be rewired, every node runs in its own thread and all or none are started.
+static int graph_editable(struct s_dsp_graph * const p_graph);
+
+//make room for one more node and edge, the arrays of a running graph included.
+static int graph_grow(struct s_dsp_graph * const p_graph);
+
+//Allocate a empty graph.
+struct s_dsp_graph *dsp_graphCreate(void)
+{
+  struct s_dsp_graph *p_temp = NULL;
+
+  p_temp = malloc(sizeof(struct s_dsp_graph));
+
+  if(!p_temp)
+  {
+    perror("DSP Graph struct failed");
+
+    return NULL;
+  }
+
+  p_temp->pp_nodes = NULL;
+
+  p_temp->num_nodes = 0;
+
+  p_temp->p_edges = NULL;
+
+  p_temp->num_edges = 0;
+
+  p_temp->p_order = NULL;
+
+  p_temp->num_started = 0;
+
+  p_temp->fusion = 0;
+
+  p_temp->p_chains = NULL;
+
+  p_temp->num_chains = 0;
+
+  p_temp->p_node_chain = NULL;
+
+  p_temp->pool_workers = 0;
+
+  p_temp->p_pool = NULL;
+
+  p_temp->p_context = NULL;
+
+  p_temp->p_cancel = dsp_cancelCreate();
+
+  if(!p_temp->p_cancel)
+  {
+    free(p_temp);
+
+    return NULL;
+  }
+
+  return p_temp;
+}
+
+//Allocate a empty graph with a context of its own.
+struct s_dsp_graph *dsp_graphCreateNamed(char const * const p_name)
+{
+  struct s_dsp_graph *p_temp = NULL;
+
+  p_temp = dsp_graphCreate();
+
+  if(!p_temp) return NULL;
+
+  p_temp->p_context = dsp_contextCreate(p_name);
+
+  if(!p_temp->p_context)
+  {
+    dsp_graphCleanup(p_temp);
+
+    return NULL;
+  }
+
+  return p_temp;
+}
+
+//Add a node to the graph, the graph owns it from here.
+int dsp_graphAddNode(struct s_dsp_graph * const p_graph, struct s_dsp_node * const p_node)
+{
+  struct s_dsp_node **pp_temp = NULL;
+
+  if(!p_graph || !p_node) return ~0;
+
+  if(graph_find(p_graph, p_node) != p_graph->num_nodes)
+  {
+    logger_error_msg(p_node->p_logger, "DSP GRAPH %p already has node %p.", p_graph, p_node);
+
+    return ~0;
+  }
+
+  pp_temp = realloc(p_graph->pp_nodes, (p_graph->num_nodes + 1) * sizeof(struct s_dsp_node *));
+
+  if(!pp_temp)
+  {
+    logger_error_msg(p_node->p_logger, "DSP GRAPH %p could not add node %p.", p_graph, p_node);
+
+    return ~0;
+  }
+
+  p_graph->pp_nodes = pp_temp;
+
+  p_graph->pp_nodes[p_graph->num_nodes] = p_node;
+
+  p_graph->num_nodes++;
+
+  if(p_graph->p_context && (p_node->p_context != p_graph->p_context)) logger_warning_msg(p_node->p_logger, "DSP GRAPH %p node %p is in context %p, not the graph context %p.", p_graph, p_node, p_node->p_context, p_graph->p_context);
+
+  logger_info_msg(p_node->p_logger, "DSP GRAPH %p added node %p.", p_graph, p_node);
+
+  return 0;
+}
+
+//Create and setup a node owned by the graph.
+struct s_dsp_node *dsp_graphAdd(struct s_dsp_graph * const p_graph, unsigned long buffer_size, unsigned long chunk_size, init_callback init_call, pthread_function thread_func, free_callback free_call, void *p_init_args)
+{
+  struct s_dsp_node *p_node = NULL;
+
+  if(!p_graph) return NULL;
+
+  //NULL is the process default context of a graph from dsp_graphCreate.
+  p_node = dsp_createInContext(p_graph->p_context, buffer_size, chunk_size);
+
+  if(!p_node) return NULL;
+
+  if(dsp_setup(p_node, init_call, thread_func, free_call, p_init_args)) goto error_cleanup;
+
+  if(dsp_graphAddNode(p_graph, p_node)) goto error_cleanup;
+
+  return p_node;
+
+error_cleanup:
+  dsp_cleanup(p_node);
+
+  return NULL;
+}
+
+//Connect the output of a node to a input port of another node.
+int dsp_graphConnect(struct s_dsp_graph * const p_graph, struct s_dsp_node * const p_src, struct s_dsp_node * const p_dst, unsigned int port)
+{
+  struct s_dsp_graph_edge *p_temp = NULL;
+
+  if(!p_graph || !p_src || !p_dst) return ~0;
+
+  if((graph_find(p_graph, p_src) == p_graph->num_nodes) || (graph_find(p_graph, p_dst) == p_graph->num_nodes))
+  {
+    logger_error_msg(p_src->p_logger, "DSP GRAPH %p does not have node %p or %p.", p_graph, p_src, p_dst);
+
+    return ~0;
+  }
+
+  if(port >= p_dst->num_input_ports)
+  {
+    logger_error_msg(p_dst->p_logger, "DSP GRAPH %p node %p has no input port %u.", p_graph, p_dst, port);
+
+    return ~0;
+  }
+
+  //a node that asked for converters gets one the graph owns, so it can be fused or pooled like any node.
+  if((p_src->output_type != p_dst->input_ports[port].type) && p_dst->auto_convert && dsp_convertSupported(p_src->output_type, p_dst->input_ports[port].type))
+  {
+    struct s_dsp_convert_args convert_args;
+
+    struct s_dsp_node *p_convert = NULL;
+
+    convert_args.input_type = p_src->output_type;
+
+    convert_args.output_type = p_dst->input_ports[port].type;
+
+    convert_args.byte_swap = 0;
+
+    p_convert = dsp_graphAdd(p_graph, p_dst->buffer_size, p_dst->chunk_size, init_callback_convert, pthread_function_convert, free_callback_convert, &convert_args);
+
+    if(!p_convert)
+    {
+      logger_error_msg(p_dst->p_logger, "DSP GRAPH %p could not add converter from %p type %d to %p port %u type %d.", p_graph, p_src, p_src->output_type, p_dst, port, p_dst->input_ports[port].type);
+
+      return ~0;
+    }
+
+    //converting does not change the rate.
+    if(dsp_setRate(p_convert, p_src->output_rate, p_src->output_rate)) return ~0;
+
+    if(dsp_graphConnect(p_graph, p_src, p_convert, 0)) return ~0;
+
+    return dsp_graphConnect(p_graph, p_convert, p_dst, port);
+  }
+
+  //types are checked once here, a mismatch is a error for the graph.
+  if((p_src->output_type == DATA_INVALID) || (p_dst->input_ports[port].type == DATA_INVALID) || (p_src->output_type != p_dst->input_ports[port].type))
+  {
+    logger_error_msg(p_dst->p_logger, "DSP GRAPH %p can not connect %p output type %d to %p port %u type %d.", p_graph, p_src, p_src->output_type, p_dst, port, p_dst->input_ports[port].type);
+
+    return ~0;
+  }
+
+  p_temp = realloc(p_graph->p_edges, (p_graph->num_edges + 1) * sizeof(struct s_dsp_graph_edge));
+
+  if(!p_temp)
+  {
+    logger_error_msg(p_dst->p_logger, "DSP GRAPH %p could not add edge.", p_graph);
+
+    return ~0;
+  }
+
+  p_graph->p_edges = p_temp;
+
+  if(dsp_setInputPort(p_dst, port, p_src)) return ~0;
+
+  p_graph->p_edges[p_graph->num_edges].p_src = p_src;
+
+  p_graph->p_edges[p_graph->num_edges].p_dst = p_dst;
+
+  p_graph->p_edges[p_graph->num_edges].port = port;
+
+  p_graph->num_edges++;
+
+  return 0;
+}
+
+//Replace a node of the graph with a new one, hot if the graph is running.
+int dsp_graphReplace(struct s_dsp_graph * const p_graph, struct s_dsp_node * const p_old, struct s_dsp_node * const p_new, unsigned long timeout_ms)
+{
+  int error = 0;
+
+  unsigned int index = 0;
+  unsigned int node  = 0;
+
+  if(!p_graph || !p_old || !p_new) return ~0;
+
+  node = graph_find(p_graph, p_old);
+
+  if((node == p_graph->num_nodes) || (graph_find(p_graph, p_new) != p_graph->num_nodes))
+  {
+    logger_error_msg(p_new->p_logger, "DSP GRAPH %p does not have node %p or already has %p.", p_graph, p_old, p_new);
+
+    return ~0;
+  }
+
+  if(graph_editable(p_graph)) return ~0;
+
+  error = dsp_replace(p_old, p_new, timeout_ms);
+
+  if(error) return error;
+
+  p_graph->pp_nodes[node] = p_new;
+
+  for(index = 0; index < p_graph->num_edges; index++)
+  {
+    if(p_graph->p_edges[index].p_src == p_old) p_graph->p_edges[index].p_src = p_new;
+
+    if(p_graph->p_edges[index].p_dst == p_old) p_graph->p_edges[index].p_dst = p_new;
+  }
+
+  logger_info_msg(graph_logger(p_graph), "DSP GRAPH %p replaced node %p with %p.", p_graph, p_old, p_new);
+
+  dsp_cleanup(p_old);
+
+  return 0;
+}
+
+//Insert a node in front of a input port of a node in the graph, hot if the graph is running.
+int dsp_graphInsert(struct s_dsp_graph * const p_graph, struct s_dsp_node * const p_new, struct s_dsp_node * const p_dst, unsigned int port, unsigned long timeout_ms)
+{
+  int error = 0;
+
+  unsigned int index = 0;
+  unsigned int edge  = 0;
+  unsigned int node  = 0;
+
+  if(!p_graph || !p_new || !p_dst) return ~0;
+
+  if((graph_find(p_graph, p_dst) == p_graph->num_nodes) || (graph_find(p_graph, p_new) != p_graph->num_nodes))
+  {
+    logger_error_msg(p_new->p_logger, "DSP GRAPH %p does not have node %p or already has %p.", p_graph, p_dst, p_new);
+
+    return ~0;
+  }
+
+  for(edge = 0; edge < p_graph->num_edges; edge++)
+  {
+    if((p_graph->p_edges[edge].p_dst == p_dst) && (p_graph->p_edges[edge].port == port)) break;
+  }
+
+  if(edge == p_graph->num_edges)
+  {
+    logger_error_msg(p_dst->p_logger, "DSP GRAPH %p node %p port %u is not connected, nothing to insert %p in.", p_graph, p_dst, port, p_new);
+
+    return ~0;
+  }
+
+  if(graph_editable(p_graph)) return ~0;
+
+  //everything that can fail is allocated before the pipeline is touched.
+  if(graph_grow(p_graph)) return ~0;
+
+  error = dsp_insert(p_new, p_dst, port, timeout_ms);
+
+  if(error) return error;
+
+  node = p_graph->num_nodes;
+
+  p_graph->pp_nodes[node] = p_new;
+
+  p_graph->num_nodes++;
+
+  p_graph->p_edges[p_graph->num_edges].p_src = p_new;
+
+  p_graph->p_edges[p_graph->num_edges].p_dst = p_dst;
+
+  p_graph->p_edges[p_graph->num_edges].port = port;
+
+  p_graph->num_edges++;
+
+  p_graph->p_edges[edge].p_dst = p_new;
+
+  p_graph->p_edges[edge].port = 0;
+
+  if(p_graph->num_started)
+  {
+    //the new node is joined before the node it feeds.
+    for(index = 0; p_graph->p_order[index] != graph_find(p_graph, p_dst); index++);
+
+    memmove(&p_graph->p_order[index + 1], &p_graph->p_order[index], (node - index) * sizeof(unsigned int));
+
+    p_graph->p_order[index] = node;
+
+    p_graph->p_node_chain[node] = DSP_GRAPH_NO_CHAIN;
+
+    p_graph->num_started++;
+  }
+
+  if(p_graph->p_context && (p_new->p_context != p_graph->p_context)) logger_warning_msg(p_new->p_logger, "DSP GRAPH %p node %p is in context %p, not the graph context %p.", p_graph, p_new, p_new->p_context, p_graph->p_context);
+
+  logger_info_msg(graph_logger(p_graph), "DSP GRAPH %p inserted node %p in front of %p port %u.", p_graph, p_new, p_dst, port);
+
+  return 0;
+}
+
+//Remove a node with one input and one consumer from the graph, hot if the graph is running.
+int dsp_graphRemove(struct s_dsp_graph * const p_graph, struct s_dsp_node * const p_old, unsigned long timeout_ms)
+{
+  int error = 0;
+
+  unsigned int index    = 0;
+  unsigned int node     = 0;
+  unsigned int edge_in  = 0;
+  unsigned int edge_out = 0;
+  unsigned int num_in   = 0;
+  unsigned int num_out  = 0;
+
+  if(!p_graph || !p_old) return ~0;
+
+  node = graph_find(p_graph, p_old);
+
+  if(node == p_graph->num_nodes)
+  {
+    logger_error_msg(p_old->p_logger, "DSP GRAPH %p does not have node %p.", p_graph, p_old);
+
+    return ~0;
+  }
+
+  for(index = 0; index < p_graph->num_edges; index++)
+  {
+    if(p_graph->p_edges[index].p_dst == p_old)
+    {
+      edge_in = index;
+
+      num_in++;
+    }
+
+    if(p_graph->p_edges[index].p_src == p_old)
+    {
+      edge_out = index;
+
+      num_out++;
+    }
+  }
+
+  //the input edge is carried on to the consumer, there has to be exactly one of each.
+  if((num_in != 1) || (num_out != 1))
+  {
+    logger_error_msg(p_old->p_logger, "DSP GRAPH %p node %p has %u inputs and %u consumers, only a node with one of each can be removed.", p_graph, p_old, num_in, num_out);
+
+    return ~0;
+  }
+
+  if(graph_editable(p_graph)) return ~0;
+
+  error = dsp_remove(p_old, p_graph->p_edges[edge_out].p_dst, p_graph->p_edges[edge_out].port, timeout_ms);
+
+  if(error) return error;
+
+  p_graph->p_edges[edge_in].p_dst = p_graph->p_edges[edge_out].p_dst;
+
+  p_graph->p_edges[edge_in].port = p_graph->p_edges[edge_out].port;
+
+  memmove(&p_graph->p_edges[edge_out], &p_graph->p_edges[edge_out + 1], (p_graph->num_edges - edge_out - 1) * sizeof(struct s_dsp_graph_edge));
+
+  p_graph->num_edges--;
+
+  memmove(&p_graph->pp_nodes[node], &p_graph->pp_nodes[node + 1], (p_graph->num_nodes - node - 1) * sizeof(struct s_dsp_node *));
+
+  if(p_graph->num_started)
+  {
+    unsigned int order = 0;
+
+    //indexes after the removed node move down one.
+    for(index = 0; index < p_graph->num_nodes; index++)
+    {
+      if(p_graph->p_order[index] == node) continue;
+
+      p_graph->p_order[order++] = p_graph->p_order[index] - (p_graph->p_order[index] > node ? 1 : 0);
+    }
+
+    memmove(&p_graph->p_node_chain[node], &p_graph->p_node_chain[node + 1], (p_graph->num_nodes - node - 1) * sizeof(unsigned int));
+
+    p_graph->num_started--;
+  }
+
+  p_graph->num_nodes--;
+
+  logger_info_msg(graph_logger(p_graph), "DSP GRAPH %p removed node %p.", p_graph, p_old);
+
+  dsp_cleanup(p_old);
+
+  return 0;
+}
+
+//Set fusion mode, call before dsp_graphStart.
+int dsp_graphSetFusion(struct s_dsp_graph * const p_graph, int fusion)
+{
+  if(!p_graph) return ~0;
+
+  if(p_graph->num_started)
+  {
+    logger_error_msg(graph_logger(p_graph), "DSP GRAPH %p fusion must be set before start.", p_graph);
+
+    return ~0;
+  }
+
+  p_graph->fusion = fusion;
+
+  return 0;
+}
+
+//Set the worker pool, call before dsp_graphStart.
+int dsp_graphSetPool(struct s_dsp_graph * const p_graph, unsigned int num_workers)
+{
+  if(!p_graph) return ~0;
+
+  if(p_graph->num_started)
+  {
+    logger_error_msg(graph_logger(p_graph), "DSP GRAPH %p pool must be set before start.", p_graph);
+
+    return ~0;
+  }
+
+  p_graph->pool_workers = num_workers;
+
+  return 0;
+}
+
+//Check the graph and start every node, sinks first.
+int dsp_graphStart(struct s_dsp_graph * const p_graph)
+{
+  int error = 0;
+
+  unsigned int index = 0;
+
+  if(!p_graph) return ~0;
+
+  if(!p_graph->num_nodes)
+  {
+    fprintf(stderr, "ERROR: DSP Graph has no nodes to start.\n");
+
+    return ~0;
+  }
+
+  if(p_graph->num_started)
+  {
+    logger_error_msg(graph_logger(p_graph), "DSP GRAPH %p already started.", p_graph);
+
+    return ~0;
+  }
+
+  if(graph_check(p_graph)) return ~0;
+
+  if(graph_sort(p_graph)) return ~0;
+
+  if(graph_fuse(p_graph)) return ~0;
+
+  //a graph cancelled before is started again with clear tokens, chains and pool tasks have no dsp_start to do it.
+  dsp_cancelReset(p_graph->p_cancel);
+
+  dsp_contextReset(p_graph->p_context);
+
+  for(index = 0; index < p_graph->num_nodes; index++)
+  {
+    dsp_cancelReset(p_graph->pp_nodes[index]->p_cancel);
+
+    //a node in the stopped default context stays stopped, like it did on kill_thread.
+    if(dsp_contextIsStopped(p_graph->pp_nodes[index]->p_context)) dsp_cancelSet(p_graph->pp_nodes[index]->p_cancel);
+  }
+
+  if(p_graph->pool_workers)
+  {
+    p_graph->p_pool = dsp_poolCreate(p_graph->pool_workers);
+
+    if(!p_graph->p_pool) return ~0;
+
+    for(index = 0; index < p_graph->num_nodes; index++)
+    {
+      if(!graph_pooled(p_graph, index)) continue;
+
+      if(dsp_poolAddNode(p_graph->p_pool, p_graph->pp_nodes[index])) goto error_pool;
+    }
+
+    //the pool ends the edges of its tasks if it fails, nothing else is running yet.
+    if(dsp_poolStart(p_graph->p_pool)) goto error_pool;
+  }
+
+  //sinks first, every ring has its consumer running before the producer writes.
+  for(index = p_graph->num_nodes; index > 0; index--)
+  {
+    unsigned int node  = p_graph->p_order[index-1];
+    unsigned int chain = p_graph->p_node_chain[node];
+
+    struct s_dsp_graph_chain *p_chain = NULL;
+
+    if(graph_pooled(p_graph, node))
+    {
+      //already running on the pool.
+    }
+    else if(chain == DSP_GRAPH_NO_CHAIN)
+    {
+      error = dsp_start(p_graph->pp_nodes[node]);
+    }
+    else
+    {
+      p_chain = &p_graph->p_chains[chain];
+
+      //a chain starts at its tail, the rest of its nodes are already running when they come up.
+      if(p_chain->pp_nodes[p_chain->num_nodes-1] == p_graph->pp_nodes[node])
+      {
+        error = pthread_create(&p_chain->chain_thread, NULL, graph_chain_thread, p_chain);
+
+        logger_info_msg(graph_logger(p_graph), "DSP GRAPH %p chain %u started.", p_graph, chain);
+      }
+    }
+
+    if(error) break;
+
+    p_graph->num_started++;
+  }
+
+  if(!error)
+  {
+    logger_info_msg(graph_logger(p_graph), "DSP GRAPH %p started %u nodes.", p_graph, p_graph->num_started);
+
+    return 0;
+  }
+
+  logger_error_msg(graph_logger(p_graph), "DSP GRAPH %p could not start node %p, stopping graph.", p_graph, p_graph->pp_nodes[p_graph->p_order[index-1]]);
+
+  //nodes that never started end their edges so the started ones drain and exit.
+  for(; index > 0; index--)
+  {
+    dsp_endOutput(p_graph->pp_nodes[p_graph->p_order[index-1]]);
+
+    dsp_endInput(p_graph->pp_nodes[p_graph->p_order[index-1]]);
+  }
+
+  dsp_graphWait(p_graph);
+
+  return ~0;
+
+error_pool:
+  dsp_poolFree(p_graph->p_pool);
+
+  p_graph->p_pool = NULL;
+
+  return ~0;
+}
+
+//Wait for every started node to finish, in topological order.
+int dsp_graphWait(struct s_dsp_graph * const p_graph)
+{
+  int error = 0;
+
+  unsigned int index = 0;
+
+  if(!p_graph) return ~0;
+
+  if(!p_graph->num_started) return 0;
+
+  for(index = p_graph->num_nodes - p_graph->num_started; index < p_graph->num_nodes; index++)
+  {
+    unsigned int node  = p_graph->p_order[index];
+    unsigned int chain = p_graph->p_node_chain[node];
+
+    struct s_dsp_graph_chain *p_chain = NULL;
+
+    if(graph_pooled(p_graph, node)) continue;
+
+    if(chain == DSP_GRAPH_NO_CHAIN)
+    {
+      error |= dsp_wait(p_graph->pp_nodes[node]);
+
+      continue;
+    }
+
+    p_chain = &p_graph->p_chains[chain];
+
+    //the tail is the last node of a chain in topological order, join the chain there.
+    if(p_chain->pp_nodes[p_chain->num_nodes-1] == p_graph->pp_nodes[node]) error |= pthread_join(p_chain->chain_thread, NULL);
+  }
+
+  if(p_graph->p_pool)
+  {
+    error |= dsp_poolWait(p_graph->p_pool);
+
+    dsp_poolFree(p_graph->p_pool);
+
+    p_graph->p_pool = NULL;
+  }
+
+  p_graph->num_started = 0;
+
+  logger_info_msg(graph_logger(p_graph), "DSP GRAPH %p joined.", p_graph);
+
+  return error;
+}
+
+//Cancel every node of the graph.
+int dsp_graphCancel(struct s_dsp_graph * const p_graph)
+{
+  int error = 0;
+
+  unsigned int index = 0;
+
+  if(!p_graph) return ~0;
+
+  error = dsp_cancelSet(p_graph->p_cancel);
+
+  for(index = 0; index < p_graph->num_nodes; index++)
+  {
+    error |= dsp_end(p_graph->pp_nodes[index]);
+  }
+
+  logger_info_msg(graph_logger(p_graph), "DSP GRAPH %p cancelled.", p_graph);
+
+  return error;
+}
+
+//File descriptor that is readable once the graph is cancelled.
+int dsp_graphGetCancelFd(struct s_dsp_graph const * const p_graph)
+{
+  if(!p_graph) return -1;
+
+  return dsp_cancelFd(p_graph->p_cancel);
+}
+
+//Start the graph and wait for it to finish.
+int dsp_graphRun(struct s_dsp_graph * const p_graph)
+{
+  int error = 0;
+
+  error = dsp_graphStart(p_graph);
+
+  if(error) return error;
+
+  return dsp_graphWait(p_graph);
+}
+
+//Cleanup every node in topological order and free the graph.
+void dsp_graphCleanup(struct s_dsp_graph *p_graph)
+{
+  unsigned int index = 0;
+
+  if(!p_graph) return;
+
+  for(index = 0; index < p_graph->num_nodes; index++)
+  {
+    dsp_cleanup(p_graph->pp_nodes[(p_graph->p_order ? p_graph->p_order[index] : index)]);
+  }
+
+  for(index = 0; index < p_graph->num_chains; index++)
+  {
+    free(p_graph->p_chains[index].pp_nodes);
+  }
+
+  free(p_graph->p_chains);
+
+  free(p_graph->p_node_chain);
+
+  dsp_poolFree(p_graph->p_pool);
+
+  free(p_graph->p_order);
+
+  free(p_graph->p_edges);
+
+  free(p_graph->pp_nodes);
+
+  dsp_cancelFree(&p_graph->p_cancel);
+
+  //after the nodes, they log to it till they are cleaned up.
+  dsp_contextFree(&p_graph->p_context);
+
+  free(p_graph);
+}
+
+//logger of the nodes in the graph, NULL if there are none.
+static struct s_logger *graph_logger(struct s_dsp_graph const * const p_graph)
+{
+  if(p_graph->p_context) return p_graph->p_context->p_logger;
+
+  if(!p_graph->num_nodes) return NULL;
+
+  return p_graph->pp_nodes[0]->p_logger;
+}
+
+//index of a node in the graph, num_nodes if it is not in the graph.
+static unsigned int graph_find(struct s_dsp_graph const * const p_graph, struct s_dsp_node const * const p_node)
+{
+  unsigned int index = 0;
+
+  for(index = 0; index < p_graph->num_nodes; index++)
+  {
+    if(p_graph->pp_nodes[index] == p_node) break;
+  }
+
+  return index;
+}
+
+//fill p_order with the nodes in topological order, sources first.
+static int graph_sort(struct s_dsp_graph * const p_graph)
+{
+  unsigned int index      = 0;
+  unsigned int num_sorted = 0;
+
+  unsigned int *p_in_degree = NULL;
+
+  free(p_graph->p_order);
+
+  p_graph->p_order = malloc(p_graph->num_nodes * sizeof(unsigned int));
+
+  p_in_degree = calloc(p_graph->num_nodes, sizeof(unsigned int));
+
+  if(!p_graph->p_order || !p_in_degree)
+  {
+    logger_error_msg(graph_logger(p_graph), "DSP GRAPH %p could not allocate sort.", p_graph);
+
+    goto error_cleanup;
+  }
+
+  for(index = 0; index < p_graph->num_edges; index++)
+  {
+    p_in_degree[graph_find(p_graph, p_graph->p_edges[index].p_dst)]++;
+  }
+
+  for(index = 0; index < p_graph->num_nodes; index++)
+  {
+    if(!p_in_degree[index]) p_graph->p_order[num_sorted++] = index;
+  }
+
+  //p_order doubles as the queue, everything before num_sorted has no inputs left.
+  for(index = 0; index < num_sorted; index++)
+  {
+    unsigned int edge = 0;
+
+    for(edge = 0; edge < p_graph->num_edges; edge++)
+    {
+      unsigned int dst = 0;
+
+      if(p_graph->p_edges[edge].p_src != p_graph->pp_nodes[p_graph->p_order[index]]) continue;
+
+      dst = graph_find(p_graph, p_graph->p_edges[edge].p_dst);
+
+      if(!--p_in_degree[dst]) p_graph->p_order[num_sorted++] = dst;
+    }
+  }
+
+  if(num_sorted != p_graph->num_nodes)
+  {
+    logger_error_msg(graph_logger(p_graph), "DSP GRAPH %p has a cycle, %u of %u nodes sorted.", p_graph, num_sorted, p_graph->num_nodes);
+
+    goto error_cleanup;
+  }
+
+  free(p_in_degree);
+
+  return 0;
+
+error_cleanup:
+  free(p_in_degree);
+
+  free(p_graph->p_order);
+
+  p_graph->p_order = NULL;
+
+  return ~0;
+}
+
+//check every input port is connected and warn of outputs no one reads.
+static int graph_check(struct s_dsp_graph const * const p_graph)
+{
+  int error = 0;
+
+  unsigned int index = 0;
+
+  for(index = 0; index < p_graph->num_nodes; index++)
+  {
+    unsigned int port = 0;
+    unsigned int edge = 0;
+
+    struct s_dsp_node *p_node = p_graph->pp_nodes[index];
+
+    for(port = 0; (p_node->input_type != DATA_INVALID) && (port < p_node->num_input_ports); port++)
+    {
+      if(p_node->input_ports[port].p_ring_buffer) continue;
+
+      //a start before fused the edge into a scratch block and freed its ring, the same chain is fused again.
+      if(p_graph->fusion && p_graph->p_node_chain && (p_graph->p_node_chain[index] != DSP_GRAPH_NO_CHAIN)) continue;
+
+      logger_error_msg(p_node->p_logger, "DSP GRAPH %p node %p input port %u is not connected.", p_graph, p_node, port);
+
+      error = ~0;
+    }
+
+    if(p_node->output_type == DATA_INVALID) continue;
+
+    for(edge = 0; edge < p_graph->num_edges; edge++)
+    {
+      if(p_graph->p_edges[edge].p_src == p_node) break;
+    }
+
+    if(edge == p_graph->num_edges) logger_warning_msg(p_node->p_logger, "DSP GRAPH %p node %p output is not connected, it will stop at its first write.", p_graph, p_node);
+  }
+
+  return error;
+}
+
+//find linear chains of nodes with a process_call and fuse them, fills p_node_chain.
+static int graph_fuse(struct s_dsp_graph * const p_graph)
+{
+  unsigned int index = 0;
+
+  //a graph started again fuses again, the chains of the last start go first.
+  for(index = 0; index < p_graph->num_chains; index++)
+  {
+    free(p_graph->p_chains[index].pp_nodes);
+  }
+
+  free(p_graph->p_chains);
+
+  p_graph->p_chains = NULL;
+
+  p_graph->num_chains = 0;
+
+  free(p_graph->p_node_chain);
+
+  p_graph->p_node_chain = malloc(p_graph->num_nodes * sizeof(unsigned int));
+
+  if(!p_graph->p_node_chain)
+  {
+    logger_error_msg(graph_logger(p_graph), "DSP GRAPH %p could not allocate chains.", p_graph);
+
+    return ~0;
+  }
+
+  for(index = 0; index < p_graph->num_nodes; index++)
+  {
+    p_graph->p_node_chain[index] = DSP_GRAPH_NO_CHAIN;
+  }
+
+  if(!p_graph->fusion) return 0;
+
+  //topological order means a chain is always found from its head.
+  for(index = 0; index < p_graph->num_nodes; index++)
+  {
+    unsigned int node   = p_graph->p_order[index];
+    unsigned int length = 0;
+    unsigned int link   = 0;
+
+    struct s_dsp_node *p_next = NULL;
+
+    struct s_dsp_graph_chain *p_temp = NULL;
+
+    if(p_graph->p_node_chain[node] != DSP_GRAPH_NO_CHAIN) continue;
+
+    for(p_next = p_graph->pp_nodes[node], length = 0; p_next; p_next = graph_fuse_next(p_graph, p_next))
+    {
+      length++;
+    }
+
+    if(length < 2) continue;
+
+    p_temp = realloc(p_graph->p_chains, (p_graph->num_chains + 1) * sizeof(struct s_dsp_graph_chain));
+
+    if(!p_temp)
+    {
+      logger_error_msg(graph_logger(p_graph), "DSP GRAPH %p could not allocate chain.", p_graph);
+
+      return ~0;
+    }
+
+    p_graph->p_chains = p_temp;
+
+    p_temp = &p_graph->p_chains[p_graph->num_chains];
+
+    p_temp->pp_nodes = malloc(length * sizeof(struct s_dsp_node *));
+
+    if(!p_temp->pp_nodes)
+    {
+      logger_error_msg(graph_logger(p_graph), "DSP GRAPH %p could not allocate chain.", p_graph);
+
+      return ~0;
+    }
+
+    p_temp->num_nodes = length;
+
+    for(p_next = p_graph->pp_nodes[node], link = 0; link < length; p_next = graph_fuse_next(p_graph, p_next), link++)
+    {
+      p_temp->pp_nodes[link] = p_next;
+
+      p_graph->p_node_chain[graph_find(p_graph, p_next)] = p_graph->num_chains;
+    }
+
+    //edges inside the chain are scratch blocks now, their rings are not needed.
+    for(link = 0; link < length - 1; link++)
+    {
+      dsp_ringFree(&p_temp->pp_nodes[link]->p_output_ring_buffer);
+
+      p_temp->pp_nodes[link+1]->input_ports[0].p_ring_buffer = NULL;
+    }
+
+    logger_info_msg(graph_logger(p_graph), "DSP GRAPH %p fused %u nodes from %p into chain %u.", p_graph, length, p_temp->pp_nodes[0], p_graph->num_chains);
+
+    p_graph->num_chains++;
+  }
+
+  return 0;
+}
+
+//next node a chain can be fused to, NULL if the chain ends at p_node.
+static struct s_dsp_node *graph_fuse_next(struct s_dsp_graph const * const p_graph, struct s_dsp_node const * const p_node)
+{
+  unsigned int index     = 0;
+  unsigned int num_edges = 0;
+
+  struct s_dsp_node *p_dst = NULL;
+
+  if(!p_node->process_call) return NULL;
+
+  for(index = 0; index < p_graph->num_edges; index++)
+  {
+    if(p_graph->p_edges[index].p_src != p_node) continue;
+
+    p_dst = p_graph->p_edges[index].p_dst;
+
+    num_edges++;
+  }
+
+  //fan out needs the ring, so does a node with more then one input.
+  if(num_edges != 1) return NULL;
+
+  if(!p_dst->process_call || (p_dst->num_input_ports != 1)) return NULL;
+
+  return p_dst;
+}
+
+//pthread function running every node of a fused chain.
+static void *graph_chain_thread(void *p_data)
+{
+  int input_ended = 0;
+  int stop        = 0;
+
+  unsigned int index = 0;
+
+  int *p_finished = NULL;
+
+  struct s_graph_scratch *p_scratch = NULL;
+
+  struct s_dsp_node *p_head = NULL;
+  struct s_dsp_node *p_tail = NULL;
+
+  struct s_dsp_graph_chain *p_chain = NULL;
+
+  p_chain = (struct s_dsp_graph_chain *)p_data;
+
+  p_head = p_chain->pp_nodes[0];
+
+  p_tail = p_chain->pp_nodes[p_chain->num_nodes-1];
+
+  for(index = 0; index < p_chain->num_nodes; index++)
+  {
+    p_chain->pp_nodes[index]->active = 1;
+
+    p_chain->pp_nodes[index]->total_bytes_processed = 0;
+
+    dsp_statsStart(p_chain->pp_nodes[index]);
+
+    dsp_setState(p_chain->pp_nodes[index], DSP_NODE_RUNNING);
+  }
+
+  p_finished = calloc(p_chain->num_nodes, sizeof(int));
+
+  //scratch 0 feeds the head from its input ring, scratch num_nodes drains the tail to its output ring.
+  p_scratch = calloc(p_chain->num_nodes + 1, sizeof(struct s_graph_scratch));
+
+  if(!p_finished || !p_scratch)
+  {
+    logger_error_msg(p_head->p_logger, "DSP GRAPH chain %p could not allocate scratch.", p_chain);
+
+    goto error_cleanup;
+  }
+
+  for(index = 0; index <= p_chain->num_nodes; index++)
+  {
+    unsigned long needed = 0;
+
+    if(!index)
+    {
+      if(p_head->input_type == DATA_INVALID) continue;
+
+      p_scratch[index].type_size = p_head->input_type_size;
+    }
+    else if(index == p_chain->num_nodes)
+    {
+      if(p_tail->output_type == DATA_INVALID) continue;
+
+      p_scratch[index].type_size = p_tail->output_type_size;
+    }
+    else
+    {
+      p_scratch[index].type_size = p_chain->pp_nodes[index-1]->output_type_size;
+    }
+
+    if(!p_scratch[index].type_size) continue;
+
+    p_scratch[index].size = DSP_GRAPH_FUSE_BLOCK / p_scratch[index].type_size;
+
+    //a block must fit a full output of the producer on top of a partial input of the consumer.
+    if(index) needed += p_chain->pp_nodes[index-1]->process_output_max;
+
+    if(index < p_chain->num_nodes) needed += p_chain->pp_nodes[index]->process_input_max;
+
+    if(p_scratch[index].size < needed) p_scratch[index].size = needed;
+
+    if(!p_scratch[index].size) p_scratch[index].size = 1;
+
+    p_scratch[index].p_buffer = dsp_allocBuffer(p_head, p_scratch[index].size * p_scratch[index].type_size);
+
+    if(!p_scratch[index].p_buffer)
+    {
+      logger_error_msg(p_head->p_logger, "DSP GRAPH chain %p could not allocate scratch.", p_chain);
+
+      goto error_cleanup;
+    }
+  }
+
+  logger_info_msg(p_head->p_logger, "DSP GRAPH chain %p thread started.", p_chain);
+
+  while(!stop)
+  {
+    int progress = 0;
+
+    struct s_graph_scratch *p_head_in  = &p_scratch[0];
+    struct s_graph_scratch *p_tail_out = &p_scratch[p_chain->num_nodes];
+
+    //ending any node of a chain ends the thread they share, what is in the blocks is dropped.
+    for(index = 0; index < p_chain->num_nodes; index++)
+    {
+      if(dsp_isCancelled(p_chain->pp_nodes[index])) stop = 1;
+    }
+
+    if(stop) break;
+
+    //top up the head from its input ring, waits a poll period for the block to fill or the input to end.
+    if(p_head_in->p_buffer && !input_ended && (p_head_in->fill < p_head_in->size))
+    {
+      unsigned long num_read = 0;
+
+      num_read = dsp_readInputTimed(p_head, p_head_in->p_buffer + (p_head_in->fill * p_head_in->type_size), p_head_in->size - p_head_in->fill, dsp_deadline(DSP_NODE_POLL_MS));
+
+      //out of time, the nodes still get a pass so their process callbacks can stop the chain.
+      if(num_read == DSP_NODE_TIMEOUT)
+      {
+        num_read = 0;
+      }
+      else if(!num_read)
+      {
+        input_ended = 1;
+      }
+
+      p_head_in->fill += num_read;
+
+#ifdef DSP_NODE_LATENCY
+      //to latency a chain is one node, from the head input to the tail output.
+      if(p_tail->latency.pending_ns == 0) p_tail->latency.pending_ns = p_head->latency.pending_ns;
+
+      p_head->latency.pending_ns = 0;
+#endif
+
+      progress = 1;
+    }
+
+    for(index = 0; index < p_chain->num_nodes; index++)
+    {
+      int finished = 0;
+
+      struct s_dsp_process process;
+
+      struct s_graph_scratch *p_in  = &p_scratch[index];
+      struct s_graph_scratch *p_out = &p_scratch[index+1];
+
+      if(p_finished[index]) continue;
+
+      process.p_input = p_in->p_buffer;
+
+      process.input_size = p_in->fill;
+
+      process.p_output = (p_out->p_buffer ? p_out->p_buffer + (p_out->fill * p_out->type_size) : NULL);
+
+      process.output_size = p_out->size - p_out->fill;
+
+      process.end_of_input = (index ? p_finished[index-1] : input_ended);
+
+      finished = dsp_process(p_chain->pp_nodes[index], &process);
+
+      //the head input and tail output are counted by the ring reads and writes.
+      dsp_statsAdd(p_chain->pp_nodes[index], (index ? process.input_size : 0), (index < p_chain->num_nodes-1 ? process.output_size : 0));
+
+      if(process.input_size)
+      {
+        p_in->fill -= process.input_size;
+
+        memmove(p_in->p_buffer, p_in->p_buffer + (process.input_size * p_in->type_size), p_in->fill * p_in->type_size);
+
+        progress = 1;
+      }
+
+      if(process.output_size)
+      {
+        p_out->fill += process.output_size;
+
+        progress = 1;
+      }
+
+      if(!finished) continue;
+
+      p_finished[index] = 1;
+
+      progress = 1;
+
+      //a node finished before its input ended will never consume again, stop the chain.
+      if(index ? !p_finished[index-1] : (p_head_in->p_buffer && !input_ended)) stop = 1;
+    }
+
+    if(p_tail_out->fill)
+    {
+      unsigned long num_wrote = 0;
+
+      //a finished tail flushes what is left, a running one waits a poll period so the nodes get another pass.
+      num_wrote = dsp_writeOutputTimed(p_tail, p_tail_out->p_buffer, p_tail_out->fill, (p_finished[p_chain->num_nodes-1] ? DSP_RING_FOREVER : dsp_deadline(DSP_NODE_POLL_MS)));
+
+      //nothing written in time means every consumer has ended.
+      if(num_wrote == DSP_NODE_TIMEOUT)
+      {
+        num_wrote = 0;
+      }
+      else if(!num_wrote)
+      {
+        stop = 1;
+      }
+
+      p_tail_out->fill -= num_wrote;
+
+      memmove(p_tail_out->p_buffer, p_tail_out->p_buffer + (num_wrote * p_tail_out->type_size), p_tail_out->fill * p_tail_out->type_size);
+
+      //a stopped chain drops what it could not write.
+      if(stop) p_tail_out->fill = 0;
+
+      progress = 1;
+    }
+
+    if(p_finished[p_chain->num_nodes-1]) break;
+
+    if(!progress)
+    {
+      logger_error_msg(p_head->p_logger, "DSP GRAPH chain %p stalled, no node made progress.", p_chain);
+
+      break;
+    }
+  }
+
+error_cleanup:
+  if(p_scratch)
+  {
+    for(index = 0; index <= p_chain->num_nodes; index++)
+    {
+      dsp_freeBuffer(p_head, p_scratch[index].p_buffer, p_scratch[index].size * p_scratch[index].type_size);
+    }
+  }
+
+  free(p_scratch);
+
+  free(p_finished);
+
+  dsp_endInput(p_head);
+
+  dsp_endOutput(p_tail);
+
+  logger_info_msg(p_head->p_logger, "DSP GRAPH chain %p thread finished.", p_chain);
+
+  for(index = 0; index < p_chain->num_nodes; index++)
+  {
+    dsp_statsStop(p_chain->pp_nodes[index]);
+
+    dsp_setState(p_chain->pp_nodes[index], DSP_NODE_STOPPED);
+
+    p_chain->pp_nodes[index]->active = 0;
+  }
+
+  return NULL;
+}
+
+//1 if a node runs as a task on the graph pool, 0 if it has its own thread.
+static int graph_pooled(struct s_dsp_graph const * const p_graph, unsigned int node)
+{
+  if(!p_graph->p_pool) return 0;
+
+  if(p_graph->p_node_chain[node] != DSP_GRAPH_NO_CHAIN) return 0;
+
+  return p_graph->pp_nodes[node]->process_call && (p_graph->pp_nodes[node]->num_input_ports == 1);
+}
+
+//check the graph can be rewired, every node runs in its own thread and all or none are started.
+static int graph_editable(struct s_dsp_graph * const p_graph)
+{
+  //fused chains freed the rings between their nodes and pool tasks never read through a pause.
+  if(p_graph->num_chains || p_graph->p_pool)
+  {
+    logger_error_msg(graph_logger(p_graph), "DSP GRAPH %p has fused chains or a pool, its nodes can not be swapped.", p_graph);
+
+    return ~0;
+  }
+
+  if(p_graph->num_started && (p_graph->num_started != p_graph->num_nodes))
+  {
+    logger_error_msg(graph_logger(p_graph), "DSP GRAPH %p is partly started, %u of %u nodes.", p_graph, p_graph->num_started, p_graph->num_nodes);
+
+    return ~0;
+  }
+
+  //not running, start sorts the graph again.
+  if(!p_graph->num_started)
+  {
+    free(p_graph->p_order);
+
+    p_graph->p_order = NULL;
+
+    free(p_graph->p_node_chain);
+
+    p_graph->p_node_chain = NULL;
+  }
+
+  return 0;
+}
+
+//make room for one more node and edge, the arrays of a running graph included.
+static int graph_grow(struct s_dsp_graph * const p_graph)
+{
+  struct s_dsp_node **pp_nodes = NULL;
+
+  struct s_dsp_graph_edge *p_edges = NULL;
+
+  pp_nodes = realloc(p_graph->pp_nodes, (p_graph->num_nodes + 1) * sizeof(struct s_dsp_node *));
+
+  if(!pp_nodes) goto error_alloc;
+
+  p_graph->pp_nodes = pp_nodes;
+
+  p_edges = realloc(p_graph->p_edges, (p_graph->num_edges + 1) * sizeof(struct s_dsp_graph_edge));
+
+  if(!p_edges) goto error_alloc;
+
+  p_graph->p_edges = p_edges;
+
+  if(p_graph->num_started)
+  {
+    unsigned int *p_temp = NULL;
+
+    p_temp = realloc(p_graph->p_order, (p_graph->num_nodes + 1) * sizeof(unsigned int));
+
+    if(!p_temp) goto error_alloc;
+
+    p_graph->p_order = p_temp;
+
+    p_temp = realloc(p_graph->p_node_chain, (p_graph->num_nodes + 1) * sizeof(unsigned int));
+
+    if(!p_temp) goto error_alloc;
+
+    p_graph->p_node_chain = p_temp;
+  }
+
+  return 0;
+
+error_alloc:
+  logger_error_msg(graph_logger(p_graph), "DSP GRAPH %p could not allocate a new node.", p_graph);
+
+  return ~0;
+}
@@ -0,0 +1,348 @@
+//******************************************************************************
+/// @file     dsp_graph.h
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Graph of DSP nodes, owns node lifecycle from create to cleanup.
+/// @details  Nodes are added and connected, the graph checks types once,
+///           starts sinks first and joins/cleans up in topological order.
+//******************************************************************************
+
+#ifndef __dsp_graph
+#define __dsp_graph
+
+// includes
+#include "dsp_node.h"
+#include "dsp_pool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct s_dsp_graph_edge
+ * @brief Connection of a node output to a input port of another node.
+ */
+struct s_dsp_graph_edge
+{
+  /**
+   * @var s_dsp_graph_edge::p_src
+   * node that writes the edge.
+   */
+  struct s_dsp_node *p_src;
+  /**
+   * @var s_dsp_graph_edge::p_dst
+   * node that reads the edge.
+   */
+  struct s_dsp_node *p_dst;
+  /**
+   * @var s_dsp_graph_edge::port
+   * input port of p_dst the edge is connected to.
+   */
+  unsigned int port;
+};
+
+/**
+ * @def DSP_GRAPH_NO_CHAIN
+ * Chain index of a node that is not fused.
+ */
+#define DSP_GRAPH_NO_CHAIN (~0U)
+
+/**
+ * @def DSP_GRAPH_FUSE_BLOCK
+ * Size in bytes of the scratch blocks passed between fused nodes, sized to stay in cache.
+ */
+#define DSP_GRAPH_FUSE_BLOCK (1 << 15)
+
+/**
+ * @struct s_dsp_graph_chain
+ * @brief Linear chain of nodes fused into a single thread.
+ */
+struct s_dsp_graph_chain
+{
+  /**
+   * @var s_dsp_graph_chain::pp_nodes
+   * nodes of the chain, head (source side) first.
+   */
+  struct s_dsp_node **pp_nodes;
+  /**
+   * @var s_dsp_graph_chain::num_nodes
+   * number of nodes in pp_nodes.
+   */
+  unsigned int num_nodes;
+  /**
+   * @var s_dsp_graph_chain::chain_thread
+   * pthread running every node of the chain.
+   */
+  pthread_t chain_thread;
+};
+
+/**
+ * @struct s_dsp_graph
+ * @brief Contains the nodes and edges of a processing graph.
+ */
+struct s_dsp_graph
+{
+  /**
+   * @var s_dsp_graph::pp_nodes
+   * array of nodes owned by the graph, in the order added.
+   */
+  struct s_dsp_node **pp_nodes;
+  /**
+   * @var s_dsp_graph::num_nodes
+   * number of nodes in pp_nodes.
+   */
+  unsigned int num_nodes;
+  /**
+   * @var s_dsp_graph::p_edges
+   * array of edges between nodes.
+   */
+  struct s_dsp_graph_edge *p_edges;
+  /**
+   * @var s_dsp_graph::num_edges
+   * number of edges in p_edges.
+   */
+  unsigned int num_edges;
+  /**
+   * @var s_dsp_graph::p_order
+   * index of nodes in topological order, sources first. Filled in by start.
+   */
+  unsigned int *p_order;
+  /**
+   * @var s_dsp_graph::num_started
+   * number of nodes started, counted from the end (sinks) of p_order.
+   */
+  unsigned int num_started;
+  /**
+   * @var s_dsp_graph::fusion
+   * 1 fuse linear chains of nodes with a process_call into one thread, 0 thread per node.
+   */
+  int fusion;
+  /**
+   * @var s_dsp_graph::p_chains
+   * array of fused chains, filled in by start when fusion is set.
+   */
+  struct s_dsp_graph_chain *p_chains;
+  /**
+   * @var s_dsp_graph::num_chains
+   * number of chains in p_chains.
+   */
+  unsigned int num_chains;
+  /**
+   * @var s_dsp_graph::p_node_chain
+   * chain index of each node in pp_nodes, DSP_GRAPH_NO_CHAIN if it runs in its own thread.
+   */
+  unsigned int *p_node_chain;
+  /**
+   * @var s_dsp_graph::pool_workers
+   * number of pool workers, 0 thread per node. DSP_POOL_CORES for one per core.
+   */
+  unsigned int pool_workers;
+  /**
+   * @var s_dsp_graph::p_pool
+   * pool running nodes with a process_call as tasks, created by start when pool_workers is set.
+   */
+  struct s_dsp_pool *p_pool;
+  /**
+   * @var s_dsp_graph::p_cancel
+   * cancellation token of the graph, set by dsp_graphCancel with the token of every node.
+   */
+  struct s_dsp_cancel *p_cancel;
+  /**
+   * @var s_dsp_graph::p_context
+   * context the graph owns from dsp_graphCreateNamed, NULL for the process default context.
+   */
+  struct s_dsp_context *p_context;
+};
+
+/**************************************************************************//**
+  * @brief Allocate a empty graph.
+  *
+  * @return allocated graph, NULL on error.
+  ****************************************************************************/
+struct s_dsp_graph *dsp_graphCreate(void);
+
+/**************************************************************************//**
+  * @brief Allocate a empty graph with a context of its own: its own log file,
+  * node ids and stop. For a process running many graphs, a node that kills
+  * its context stops only this graph. dsp_graphCreate graphs share the
+  * process default context and dsp_node.log.
+  *
+  * @param p_name name of the log file of the graph, .log is added.
+  *
+  * @return allocated graph, NULL on error.
+  ****************************************************************************/
+struct s_dsp_graph *dsp_graphCreateNamed(char const * const p_name);
+
+/**************************************************************************//**
+  * @brief Add a node to the graph, the graph owns it from here and cleans it
+  * up. For nodes that need settings between dsp_create and dsp_setup.
+  *
+  * @param p_graph struct s_dsp_graph object from dsp_graphCreate
+  * @param p_node struct s_dsp_node object from dsp_create, setup or not.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_graphAddNode(struct s_dsp_graph * const p_graph, struct s_dsp_node * const p_node);
+
+/**************************************************************************//**
+  * @brief Create and setup a node owned by the graph.
+  *
+  * @param p_graph struct s_dsp_graph object from dsp_graphCreate
+  * @param buffer_size size of ringbuffer total
+  * @param chunk_size size to read or write from ringbuffer
+  * @param init_call callback function for initialization of specific DSP functions
+  * @param thread_func callback function for input/output processing specific to the DSP
+  * @param free_call callback function for deallocating DSP specific items.
+  * @param p_init_args node specific initialization arguments for init_call.
+  *
+  * @return node that was added, NULL on error.
+  ****************************************************************************/
+struct s_dsp_node *dsp_graphAdd(struct s_dsp_graph * const p_graph, unsigned long buffer_size, unsigned long chunk_size, init_callback init_call, pthread_function thread_func, free_callback free_call, void *p_init_args);
+
+/**************************************************************************//**
+  * @brief Connect the output of a node to a input port of another node. Both
+  * must be in the graph and the types must match.
+  *
+  * @param p_graph struct s_dsp_graph object
+  * @param p_src node to read from.
+  * @param p_dst node to connect the input of.
+  * @param port input port of p_dst, 0 for single input nodes.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_graphConnect(struct s_dsp_graph * const p_graph, struct s_dsp_node * const p_src, struct s_dsp_node * const p_dst, unsigned int port);
+
+/**************************************************************************//**
+  * @brief Replace a node of the graph with a new one, see dsp_replace. In a
+  * running graph the nodes around it keep running, nothing on the edges is
+  * lost. The graph owns the new node and cleans up the old one. Not for
+  * graphs with fusion or a pool.
+  *
+  * @param p_graph struct s_dsp_graph object
+  * @param p_old node of the graph to replace.
+  * @param p_new node from dsp_createInContext with the graph context and
+  * dsp_setup, not in the graph, with the same port and output types.
+  * @param timeout_ms max time to wait for the old node to pause.
+  *
+  * @return 0 no error, non-zero indicates error and the graph is unchanged.
+  ****************************************************************************/
+int dsp_graphReplace(struct s_dsp_graph * const p_graph, struct s_dsp_node * const p_old, struct s_dsp_node * const p_new, unsigned long timeout_ms);
+
+/**************************************************************************//**
+  * @brief Insert a node in front of a connected input port, see dsp_insert.
+  * The graph owns the new node. Not for graphs with fusion or a pool.
+  *
+  * @param p_graph struct s_dsp_graph object
+  * @param p_new node from dsp_createInContext with the graph context and
+  * dsp_setup, not in the graph, with one input port and a output of the
+  * port type.
+  * @param p_dst node of the graph with the port.
+  * @param port input port of p_dst.
+  * @param timeout_ms max time to wait for p_dst to pause.
+  *
+  * @return 0 no error, non-zero indicates error and the graph is unchanged.
+  ****************************************************************************/
+int dsp_graphInsert(struct s_dsp_graph * const p_graph, struct s_dsp_node * const p_new, struct s_dsp_node * const p_dst, unsigned int port, unsigned long timeout_ms);
+
+/**************************************************************************//**
+  * @brief Remove a node with one input and one consumer from the graph, its
+  * input goes to the consumer, see dsp_remove. The graph cleans up the node.
+  * Not for graphs with fusion or a pool.
+  *
+  * @param p_graph struct s_dsp_graph object
+  * @param p_old node of the graph to remove.
+  * @param timeout_ms max time to wait for each node to pause and the
+  * consumer to read what is left.
+  *
+  * @return 0 no error, non-zero indicates error and the graph is unchanged.
+  ****************************************************************************/
+int dsp_graphRemove(struct s_dsp_graph * const p_graph, struct s_dsp_node * const p_old, unsigned long timeout_ms);
+
+/**************************************************************************//**
+  * @brief Set fusion mode, call before dsp_graphStart. Linear chains of nodes
+  * that have a process_call (one consumer, one input port) run in a single
+  * thread and pass cache sized scratch blocks, no ring buffers between them.
+  *
+  * @param p_graph struct s_dsp_graph object
+  * @param fusion 1 fuse chains, 0 thread per node (default).
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_graphSetFusion(struct s_dsp_graph * const p_graph, int fusion);
+
+/**************************************************************************//**
+  * @brief Set the worker pool, call before dsp_graphStart. Nodes that have a
+  * process_call and are not fused run as tasks on a fixed pool of workers.
+  * Nodes without one (drivers that block, UHD, ALSA) keep their own thread.
+  *
+  * @param p_graph struct s_dsp_graph object
+  * @param num_workers number of workers, DSP_POOL_CORES one per core, 0 thread
+  * per node (default).
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_graphSetPool(struct s_dsp_graph * const p_graph, unsigned int num_workers);
+
+/**************************************************************************//**
+  * @brief Check the graph and start every node, sinks first so no producer
+  * writes into a ring without a running consumer.
+  *
+  * @param p_graph struct s_dsp_graph object
+  *
+  * @return 0 no error, non-zero indicates error. On error any started nodes
+  * are ended and joined.
+  ****************************************************************************/
+int dsp_graphStart(struct s_dsp_graph * const p_graph);
+
+/**************************************************************************//**
+  * @brief Wait for every started node to finish, in topological order.
+  *
+  * @param p_graph struct s_dsp_graph object
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_graphWait(struct s_dsp_graph * const p_graph);
+
+/**************************************************************************//**
+  * @brief Cancel every node of the graph, safe to call from any thread while
+  * it runs. Each node is ended with dsp_end, its waits on rings and fds wake
+  * at once so dsp_graphWait returns in milliseconds. Fused chains and pool
+  * tasks stop at the next block.
+  *
+  * @param p_graph struct s_dsp_graph object
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_graphCancel(struct s_dsp_graph * const p_graph);
+
+/**************************************************************************//**
+  * @brief File descriptor that is readable once the graph is cancelled, for
+  * supervisors with a poll loop of their own.
+  *
+  * @param p_graph struct s_dsp_graph object
+  *
+  * @return eventfd of the graph cancellation token, -1 on error.
+  ****************************************************************************/
+int dsp_graphGetCancelFd(struct s_dsp_graph const * const p_graph);
+
+/**************************************************************************//**
+  * @brief Start the graph and wait for it to finish.
+  *
+  * @param p_graph struct s_dsp_graph object
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_graphRun(struct s_dsp_graph * const p_graph);
+
+/**************************************************************************//**
+  * @brief Cleanup every node in topological order and free the graph.
+  *
+  * @param p_graph struct s_dsp_graph object
+  ****************************************************************************/
+void dsp_graphCleanup(struct s_dsp_graph *p_graph);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
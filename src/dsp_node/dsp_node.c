@@ -9,26 +9,70 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
-#include <signal.h>
 #include <pthread.h>
 #include <unistd.h>
 #include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+#include <math.h>
 
 #include "dsp_node.h"
+#include "dsp_convert.h"
 
 //return the size of the type in bytes.
 unsigned int get_type_size(enum e_binary_type type);
-//global logger
-static struct s_logger *gp_logger = NULL;
-//global node count
-static unsigned long int g_node_count = 0;
-
+//run the thread function of a node between its start and stop stamps.
+static void *node_thread(void *p_data);
+//create a converter node reading p_input_object with the type of a input port of p_object.
+static struct s_dsp_node *node_convert(struct s_dsp_node const * const p_object, unsigned int port, struct s_dsp_node const * const p_input_object);
+//auto chunk size from the declared rate the node reads at (writes at for sources).
+static unsigned long node_size_chunk(struct s_dsp_node const * const p_object);
+//auto output ring size from the declared output rate, the chunk size and the memory budget.
+static unsigned long node_size_buffer(struct s_dsp_node const * const p_object);
+//hold the node thread at a chunk boundary while dsp_pause asks, 1 if the node was ended instead.
+static int node_park(struct s_dsp_node * const p_object);
+//wait till a node has read what it can of a port, the writer of it is paused.
+static void node_drain(struct s_dsp_node const * const p_object, unsigned int port, unsigned long timeout_ms);
+//absolute CLOCK_MONOTONIC time timeout_ms from now, for the timed waits on state_cond.
+static void node_timespec(unsigned long timeout_ms, struct timespec *p_time);
+//add to a counter only the node thread stores to, relaxed so it stays off the bus.
+static void stats_add(atomic_ulong *p_counter, unsigned long value);
+//monotonic time in nanoseconds for the start and stop stamps.
+static unsigned long long stats_now(void);
+//raw monotonic time in nanoseconds, not slewed by NTP, for the compute and wait split.
+static unsigned long long stats_raw(void);
+//time entering a input or output call, the time since the last one of a node thread is compute.
+static unsigned long long stats_enter(struct s_dsp_node * const p_object);
+//time leaving a input or output call, the time in it is added to p_wait, NULL for none.
+static void stats_leave(struct s_dsp_node * const p_object, atomic_ullong *p_wait, unsigned long long enter_ns);
+#ifdef DSP_NODE_LATENCY
+//mark the time the oldest pending input of a port entered the ring, behind counts back from the read position.
+static void latency_input(struct s_dsp_node * const p_object, unsigned int port, unsigned long behind);
+//record the pending input as output, from the ring to now.
+static void latency_output(struct s_dsp_node * const p_object);
+//histogram bucket of a latency.
+static unsigned int latency_bucket(unsigned long long latency_ns);
+//largest latency in a histogram bucket.
+static unsigned long long latency_bucket_max(unsigned int bucket);
+#endif
 //Allocate the dsp_node struct with defined buffer size.
 struct s_dsp_node * dsp_create(unsigned long buffer_size, unsigned long chunk_size)
 {
+  return dsp_createInContext(NULL, buffer_size, chunk_size);
+}
+
+//Allocate the dsp_node struct in the context of a pipeline.
+struct s_dsp_node *dsp_createInContext(struct s_dsp_context * const p_context, unsigned long buffer_size, unsigned long chunk_size)
+{
+  unsigned int index = 0;
+
+  pthread_condattr_t cond_attr;
+
   struct s_dsp_node *p_temp = NULL;
 
-  p_temp = malloc(sizeof(struct s_dsp_node));
+  //the counters sit on their own cache lines, sizeof is a multiple of the line.
+  p_temp = aligned_alloc(DSP_NODE_CACHE_LINE, sizeof(struct s_dsp_node));
 
   if(!p_temp)
   {
@@ -37,20 +81,15 @@ struct s_dsp_node * dsp_create(unsigned long buffer_size, unsigned long chunk_si
     return NULL;
   }
 
-  if(!gp_logger)
-  {
-    gp_logger = logger_create("dsp_node");
+  p_temp->p_cancel = dsp_cancelCreate();
 
-    if(!gp_logger)
-    {
-      perror("Logger Creation failed");
+  if(!p_temp->p_cancel)
+  {
+    free(p_temp);
 
-      return NULL;
-    }
+    return NULL;
   }
 
-  p_temp->p_logger = gp_logger;
-
   p_temp->input_type = DATA_U8;
 
   p_temp->input_type_size = 1;
@@ -59,7 +98,44 @@ struct s_dsp_node * dsp_create(unsigned long buffer_size, unsigned long chunk_si
 
   p_temp->output_type_size = 1;
 
-  p_temp->p_input_ring_buffer = NULL;
+  p_temp->num_input_ports = 1;
+
+  for(index = 0; index < DSP_NODE_MAX_INPUTS; index++)
+  {
+    p_temp->input_ports[index].p_ring_buffer = NULL;
+
+    p_temp->input_ports[index].reader = 0;
+
+    p_temp->input_ports[index].type = DATA_U8;
+
+    p_temp->input_ports[index].type_size = 1;
+
+    p_temp->input_ports[index].p_convert = NULL;
+
+    p_temp->input_ports[index].tag_cursor = 0;
+
+#ifdef DSP_NODE_LATENCY
+    p_temp->input_ports[index].stamp_cursor = 0;
+#endif
+  }
+
+  p_temp->ring_type = DSP_RING_LOCKED;
+
+  p_temp->alloc.flags = DSP_ALLOC_DEFAULT;
+
+  p_temp->alloc.numa_node = 0;
+
+  CPU_ZERO(&p_temp->affinity);
+
+  p_temp->affinity_set = 0;
+
+  p_temp->sched_policy = SCHED_OTHER;
+
+  p_temp->sched_priority = 0;
+
+  p_temp->sched_set = 0;
+
+  p_temp->auto_convert = 0;
 
   p_temp->p_output_ring_buffer = NULL;
 
@@ -67,21 +143,109 @@ struct s_dsp_node * dsp_create(unsigned long buffer_size, unsigned long chunk_si
 
   p_temp->buffer_size = buffer_size;
 
+  p_temp->auto_chunk = (chunk_size == DSP_SIZE_AUTO);
+
+  p_temp->auto_buffer = (buffer_size == DSP_SIZE_AUTO);
+
+  p_temp->latency_us = DSP_SIZE_LATENCY_US;
+
+  p_temp->memory_budget = 0;
+
+  p_temp->input_rate = 0;
+
+  p_temp->output_rate = 0;
+
+  p_temp->granularity = 0;
+
   p_temp->init_call = NULL;
 
   p_temp->thread_func = NULL;
 
   p_temp->free_call = NULL;
 
+  p_temp->process_call = NULL;
+
+  p_temp->process_input_max = 0;
+
+  p_temp->process_output_max = 0;
+
   p_temp->p_data = NULL;
 
   p_temp->total_bytes_processed = 0;
 
   p_temp->active = 0;
 
-  p_temp->id_number = ++g_node_count;
+  p_temp->state = DSP_NODE_CREATED;
+
+  atomic_init(&p_temp->pause, 0);
+
+  p_temp->paused = 0;
+
+  pthread_mutex_init(&p_temp->state_mutex, NULL);
+
+  //timeouts are monotonic so a clock change can not stretch a wait.
+  pthread_condattr_init(&cond_attr);
+
+  pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+
+  pthread_cond_init(&p_temp->state_cond, &cond_attr);
+
+  pthread_condattr_destroy(&cond_attr);
+
+  atomic_init(&p_temp->counters.items_in, 0);
+
+  atomic_init(&p_temp->counters.items_out, 0);
+
+  atomic_init(&p_temp->counters.chunks_in, 0);
+
+  atomic_init(&p_temp->counters.chunks_out, 0);
+
+  atomic_init(&p_temp->counters.errors, 0);
+
+  atomic_init(&p_temp->counters.start_ns, 0);
+
+  atomic_init(&p_temp->counters.stop_ns, 0);
+
+  atomic_init(&p_temp->counters.input_wait_ns, 0);
+
+  atomic_init(&p_temp->counters.output_wait_ns, 0);
+
+  atomic_init(&p_temp->counters.compute_ns, 0);
+
+  atomic_init(&p_temp->counters.clock_ns, 0);
+
+#ifdef DSP_NODE_LATENCY
+  p_temp->latency.pending_ns = 0;
+
+  atomic_init(&p_temp->latency.count, 0);
+
+  atomic_init(&p_temp->latency.max_ns, 0);
+
+  for(index = 0; index < DSP_LATENCY_BUCKETS; index++)
+  {
+    atomic_init(&p_temp->latency.buckets[index], 0);
+  }
+#endif
+
+  //added last, a stop of the context only ever sees whole nodes. NULL is the process default context.
+  p_temp->p_context = dsp_contextAdd(p_context, p_temp);
+
+  if(!p_temp->p_context)
+  {
+    pthread_cond_destroy(&p_temp->state_cond);
+
+    pthread_mutex_destroy(&p_temp->state_mutex);
+
+    dsp_cancelFree(&p_temp->p_cancel);
+
+    free(p_temp);
+
+    return NULL;
+  }
+
+  p_temp->p_logger = p_temp->p_context->p_logger;
 
-  logger_info_msg(gp_logger, "DSP NODE %p created.", p_temp);
+  logger_info_msg(p_temp->p_logger, "DSP NODE %p created.", p_temp);
 
   return p_temp;
 }
@@ -91,16 +255,18 @@ int dsp_setup(struct s_dsp_node * const p_object, init_callback init_call, pthre
 {
   int error = 0;
 
+  unsigned int index = 0;
+
   if(!p_object)
   {
-    logger_error_msg(gp_logger, "Object is NULL for setup.");
+    fprintf(stderr, "ERROR: Object is NULL for setup.\n");
 
     return ~0;
   }
 
   if(!init_call || !thread_func || !free_call)
   {
-    logger_error_msg(gp_logger, "Callback functions can not be null.");
+    logger_error_msg(p_object->p_logger, "Callback functions can not be null.");
 
     return ~0;
   }
@@ -111,171 +277,2137 @@ int dsp_setup(struct s_dsp_node * const p_object, init_callback init_call, pthre
 
   p_object->free_call = free_call;
 
+  //resolve the NUMA node before init callback allocates with it.
+  if((p_object->alloc.flags & DSP_ALLOC_NUMA) && (p_object->alloc.numa_node == DSP_ALLOC_NUMA_CPU))
+  {
+    p_object->alloc.numa_node = -1;
+
+    for(index = 0; p_object->affinity_set && (index < CPU_SETSIZE); index++)
+    {
+      if(!CPU_ISSET(index, &p_object->affinity)) continue;
+
+      p_object->alloc.numa_node = dsp_allocCpuNode((int)index);
+
+      break;
+    }
+
+    if(p_object->alloc.numa_node < 0)
+    {
+      logger_warning_msg(p_object->p_logger, "DSP NODE %p has no affinity or NUMA node to bind memory to, not binding.", p_object);
+
+      p_object->alloc.flags &= ~DSP_ALLOC_NUMA;
+    }
+  }
+
   error = p_object->init_call(p_init_args, p_object);
 
   p_object->input_type_size = get_type_size(p_object->input_type);
 
+  if(!p_object->num_input_ports || p_object->num_input_ports > DSP_NODE_MAX_INPUTS)
+  {
+    logger_error_msg(p_object->p_logger, "Number of input ports %u is not between 1 and %d.", p_object->num_input_ports, DSP_NODE_MAX_INPUTS);
+
+    return ~0;
+  }
+
+  //port 0 is the input type, init callback sets any other port types.
+  p_object->input_ports[0].type = p_object->input_type;
+
+  for(index = 0; index < p_object->num_input_ports; index++)
+  {
+    p_object->input_ports[index].type_size = get_type_size(p_object->input_ports[index].type);
+  }
+
   p_object->output_type_size = get_type_size(p_object->output_type);
 
+  //init callback has declared its rates and granularity, size anything left to auto.
+  if(p_object->auto_chunk) p_object->chunk_size = node_size_chunk(p_object);
+
+  if(p_object->auto_buffer) p_object->buffer_size = node_size_buffer(p_object);
+
+  if(p_object->auto_chunk || p_object->auto_buffer)
+  {
+    logger_info_msg(p_object->p_logger, "DSP NODE %p sized to buffer %lu chunk %lu for rates %f in %f out, latency %lu us.", p_object, p_object->buffer_size, p_object->chunk_size, p_object->input_rate, p_object->output_rate, p_object->latency_us);
+  }
+
   //data invalid means no output ring buffer is used.
-  if(p_object->output_type == DATA_INVALID) return error;
+  if(p_object->output_type != DATA_INVALID)
+  {
+    //whole frames never straddle the wrap, a reserve or peek always returns whole frames.
+    if(p_object->granularity > 1) p_object->buffer_size = (p_object->buffer_size + p_object->granularity - 1) / p_object->granularity * p_object->granularity;
 
-  p_object->p_output_ring_buffer = initRingBuffer(p_object->buffer_size, p_object->output_type_size);
+    p_object->p_output_ring_buffer = dsp_ringCreate(p_object->buffer_size, p_object->output_type_size, p_object->ring_type, &p_object->alloc);
 
-  if(!p_object->p_output_ring_buffer)
+    if(!p_object->p_output_ring_buffer)
+    {
+      logger_error_msg(p_object->p_logger, "Output ringbuffer init failed.");
+
+      return ~0;
+    }
+  }
+
+  if(!error) dsp_setState(p_object, DSP_NODE_SETUP);
+
+  return error;
+}
+
+//Set the backend of the output ring buffer, call before dsp_setup.
+int dsp_setRingType(struct s_dsp_node * const p_object, enum e_dsp_ring_type ring_type)
+{
+  if(!p_object)
   {
-    logger_error_msg(gp_logger, "Output ringbuffer init failed.");
+    fprintf(stderr, "ERROR: Object is NULL for setRingType.\n");
 
     return ~0;
   }
 
-  return error;
+  if(p_object->p_output_ring_buffer)
+  {
+    logger_error_msg(p_object->p_logger, "DSP NODE %p ring type must be set before setup.", p_object);
+
+    return ~0;
+  }
+
+  p_object->ring_type = ring_type;
+
+  return 0;
 }
 
-//Set an input node to the current node specified by p_object.
-int dsp_setInput(struct s_dsp_node * const p_object, struct s_dsp_node const * const p_input_object)
+//Set the latency target and memory budget auto sizes are computed from.
+int dsp_setSizing(struct s_dsp_node * const p_object, unsigned long latency_us, unsigned long memory_budget)
 {
   if(!p_object)
   {
-    logger_error_msg(gp_logger, "Object is NULL for setInput.");
+    fprintf(stderr, "ERROR: Object is NULL for setSizing.\n");
 
     return ~0;
   }
 
-  if(!p_input_object)
+  if(p_object->p_output_ring_buffer)
   {
-    logger_error_msg(gp_logger, "Input object is NULL for setInput.");
+    logger_error_msg(p_object->p_logger, "DSP NODE %p sizing must be set before setup.", p_object);
 
     return ~0;
   }
 
-  //check data types to make sure they are the same. Also check if the input is set to something valid.
-  if(p_input_object->output_type == DATA_INVALID)
+  if(!latency_us)
   {
-    logger_warning_msg(gp_logger, "Data type is invalid for input node output. This node does not output data from its output ringbuffer.");
+    logger_error_msg(p_object->p_logger, "DSP NODE %p latency target must be non-zero.", p_object);
+
+    return ~0;
   }
 
-  if(p_object->input_type == DATA_INVALID)
+  p_object->latency_us = latency_us;
+
+  p_object->memory_budget = memory_budget;
+
+  return 0;
+}
+
+//Declare the nominal input and output rates of a node.
+int dsp_setRate(struct s_dsp_node * const p_object, double input_rate, double output_rate)
+{
+  if(!p_object)
   {
-      logger_warning_msg(gp_logger, "Data type is invalid, no input needed or error has occured in init callback.");
+    fprintf(stderr, "ERROR: Object is NULL for setRate.\n");
+
+    return ~0;
   }
 
-  if(p_object->input_type != p_input_object->output_type)
+  if((input_rate < 0) || (output_rate < 0))
   {
-    logger_warning_msg(gp_logger, "Formats between nodes do not match. Input needed is %d to node. Output is %d from input node.", p_object->input_type, p_input_object->output_type);
+    logger_error_msg(p_object->p_logger, "DSP NODE %p rates %f in %f out can not be negative.", p_object, input_rate, output_rate);
+
+    return ~0;
   }
 
-  p_object->p_input_ring_buffer = p_input_object->p_output_ring_buffer;
+  p_object->input_rate = input_rate;
 
-  logger_info_msg(gp_logger, "DSP NODE %p has input from %p.", p_object, p_input_object);
+  p_object->output_rate = output_rate;
 
   return 0;
 }
 
-//Start the thread using pthread function passed to create.
-int dsp_start(struct s_dsp_node * const p_object)
+//Set the allocation policy of the output ring and scratch buffers.
+int dsp_setAllocPolicy(struct s_dsp_node * const p_object, unsigned int flags, int numa_node)
 {
   if(!p_object)
   {
-    logger_error_msg(gp_logger, "Object is NULL for wait.");
+    fprintf(stderr, "ERROR: Object is NULL for setAllocPolicy.\n");
+
+    return ~0;
+  }
+
+  if(p_object->p_output_ring_buffer)
+  {
+    logger_error_msg(p_object->p_logger, "DSP NODE %p allocation policy must be set before setup.", p_object);
+
+    return ~0;
+  }
+
+  if((flags & DSP_ALLOC_NUMA) && (numa_node < 0) && (numa_node != DSP_ALLOC_NUMA_CPU))
+  {
+    logger_error_msg(p_object->p_logger, "DSP NODE %p NUMA node %d is not valid.", p_object, numa_node);
 
     return ~0;
   }
 
-  logger_info_msg(gp_logger, "DSP NODE %p started.", p_object);
+  p_object->alloc.flags = flags;
 
-  return pthread_create(&p_object->dsp_thread, NULL, p_object->thread_func, p_object);
+  p_object->alloc.numa_node = numa_node;
+
+  return 0;
 }
 
-//Wait for the pthread to finish
-int dsp_wait(struct s_dsp_node const * const p_object)
+//Allocate a scratch buffer with the allocation policy of the node.
+void *dsp_allocBuffer(struct s_dsp_node * const p_object, unsigned long bytes)
 {
-  int error = 0;
+  if(!p_object) return NULL;
+
+  return dsp_allocMem(&p_object->alloc, bytes);
+}
+
+//Free a scratch buffer from dsp_allocBuffer.
+void dsp_freeBuffer(struct s_dsp_node * const p_object, void *p_buffer, unsigned long bytes)
+{
+  if(!p_object) return;
+
+  dsp_freeMem(&p_object->alloc, p_buffer, bytes);
+}
 
+//Set the cpus the node thread may run on.
+int dsp_setAffinity(struct s_dsp_node * const p_object, cpu_set_t const * const p_cpuset)
+{
   if(!p_object)
   {
-    logger_error_msg(gp_logger, "Object is NULL for wait.");
+    fprintf(stderr, "ERROR: Object is NULL for setAffinity.\n");
 
     return ~0;
   }
 
-  error = pthread_join(p_object->dsp_thread, NULL);
+  p_object->affinity_set = 0;
 
-  logger_info_msg(gp_logger, "DSP NODE %p joined.", p_object);
+  if(!p_cpuset) return 0;
 
-  return error;
+  if(!CPU_COUNT(p_cpuset))
+  {
+    logger_error_msg(p_object->p_logger, "DSP NODE %p affinity has no cpus set.", p_object);
+
+    return ~0;
+  }
+
+  memcpy(&p_object->affinity, p_cpuset, sizeof(cpu_set_t));
+
+  p_object->affinity_set = 1;
+
+  return 0;
 }
 
-//Force the pthread to end
-int dsp_end(struct s_dsp_node const * const p_object)
+//Set the scheduling policy and priority of the node thread.
+int dsp_setSched(struct s_dsp_node * const p_object, int policy, int priority)
 {
   if(!p_object)
   {
-    logger_error_msg(gp_logger, "Object is NULL for end.");
+    fprintf(stderr, "ERROR: Object is NULL for setSched.\n");
 
     return ~0;
   }
 
-  return pthread_kill(p_object->dsp_thread, SIGUSR1);
+  if((policy != SCHED_FIFO) && (policy != SCHED_RR) && (policy != SCHED_OTHER))
+  {
+    logger_error_msg(p_object->p_logger, "DSP NODE %p sched policy %d is not SCHED_FIFO, SCHED_RR or SCHED_OTHER.", p_object, policy);
+
+    return ~0;
+  }
+
+  if((priority < sched_get_priority_min(policy)) || (priority > sched_get_priority_max(policy)))
+  {
+    logger_error_msg(p_object->p_logger, "DSP NODE %p sched priority %d out of range %d to %d.", p_object, priority, sched_get_priority_min(policy), sched_get_priority_max(policy));
+
+    return ~0;
+  }
+
+  p_object->sched_policy = policy;
+
+  p_object->sched_priority = priority;
+
+  p_object->sched_set = 1;
+
+  return 0;
 }
 
-//remove all allocations from create
-void dsp_cleanup(struct s_dsp_node *p_object)
+//Insert a converter when a input is set with a different type.
+int dsp_setAutoConvert(struct s_dsp_node * const p_object, int enable)
 {
   if(!p_object)
   {
-    logger_error_msg(gp_logger, "Object is NULL for cleanup.");
+    fprintf(stderr, "ERROR: Object is NULL for setAutoConvert.\n");
 
-    return;
+    return ~0;
   }
 
-  while(p_object->active);
+  p_object->auto_convert = (enable != 0);
 
-  if(p_object->free_call)
+  return 0;
+}
+
+//Set an input node to the current node specified by p_object.
+int dsp_setInput(struct s_dsp_node * const p_object, struct s_dsp_node const * const p_input_object)
+{
+  return dsp_setInputPort(p_object, 0, p_input_object);
+}
+
+//Set an input node to a input port of the current node specified by p_object.
+int dsp_setInputPort(struct s_dsp_node * const p_object, unsigned int port, struct s_dsp_node const * const p_input_object)
+{
+  struct s_dsp_node const *p_source = p_input_object;
+
+  struct s_dsp_node *p_convert = NULL;
+
+  struct s_dsp_input_port *p_port = NULL;
+
+  if(!p_object)
   {
-    p_object->free_call(p_object);
+    fprintf(stderr, "ERROR: Object is NULL for setInput.\n");
+
+    return ~0;
   }
 
-  g_node_count--;
+  if(!p_input_object)
+  {
+    logger_error_msg(p_object->p_logger, "Input object is NULL for setInput.");
+
+    return ~0;
+  }
 
-  if(gp_logger && !g_node_count)
+  if(port >= p_object->num_input_ports)
   {
-    logger_info_msg(gp_logger, "LOGGER FINISHED, DSP NODE CLEANUP STARTED.");
+    logger_error_msg(p_object->p_logger, "DSP NODE %p has no input port %u, it has %u ports.", p_object, port, p_object->num_input_ports);
 
-    logger_cleanup(gp_logger);
+    return ~0;
+  }
+
+  p_port = &p_object->input_ports[port];
+
+  //check data types to make sure they are the same. Also check if the input is set to something valid.
+  if(p_input_object->output_type == DATA_INVALID)
+  {
+    logger_warning_msg(p_object->p_logger, "Data type is invalid for input node output. This node does not output data from its output ringbuffer.");
+  }
 
-    gp_logger = NULL;
+  if(p_port->type == DATA_INVALID)
+  {
+      logger_warning_msg(p_object->p_logger, "Data type is invalid, no input needed or error has occured in init callback.");
   }
 
-  if(p_object->output_type != DATA_INVALID) freeRingBuffer(&p_object->p_output_ring_buffer);
+  if((p_port->type != p_input_object->output_type) && p_object->auto_convert && dsp_convertSupported(p_input_object->output_type, p_port->type))
+  {
+    p_convert = node_convert(p_object, port, p_input_object);
 
-  free(p_object);
-}
+    if(!p_convert) return ~0;
 
-//return the size of the type in bytes.
-unsigned int get_type_size(enum e_binary_type type)
-{
-  switch(type)
+    p_source = p_convert;
+  }
+  else if(p_port->type != p_input_object->output_type)
   {
-    case(DATA_S8):
-    case(DATA_U8):
-      return 1;
-    case(DATA_CS8):
-    case(DATA_S16):
-    case(DATA_U16):
-      return 2;
-    case(DATA_CS16):
-    case(DATA_FLOAT):
-      return 4;
-    case(DATA_CFLOAT):
-      return 8;
-    case(DATA_DOUBLE):
-      return 8;
-    case(DATA_CDOUBLE):
-      return 16;
-    default:
-      return 0;
+    logger_warning_msg(p_object->p_logger, "Formats between nodes do not match. Input needed is %d to node port %u. Output is %d from input node.", p_port->type, port, p_input_object->output_type);
   }
 
-  return 0;
+  //setting a new input releases the read cursor held on the old one.
+  if(p_port->p_ring_buffer) dsp_ringEndRead(p_port->p_ring_buffer, p_port->reader);
+
+  //a converter of the old input goes with it, nothing has started it yet.
+  if(p_port->p_convert)
+  {
+    dsp_endInput(p_port->p_convert);
+
+    dsp_cleanup(p_port->p_convert);
+  }
+
+  p_port->p_convert = p_convert;
+
+  p_port->tag_cursor = 0;
+
+  p_port->p_ring_buffer = p_source->p_output_ring_buffer;
+
+  //every consumer gets its own read cursor, more then one consumer fans out the output.
+  if(p_port->p_ring_buffer)
+  {
+    if(dsp_ringAddReader(p_port->p_ring_buffer, &p_port->reader))
+    {
+      if(p_source->ring_type == DSP_RING_SPSC)
+      {
+        logger_error_msg(p_object->p_logger, "DSP NODE %p could not add reader to %p output, single consumer ring already has a reader.", p_object, p_source);
+      }
+      else
+      {
+        logger_error_msg(p_object->p_logger, "DSP NODE %p could not add reader to %p output.", p_object, p_source);
+      }
+
+      p_port->p_ring_buffer = NULL;
+
+      return ~0;
+    }
+  }
+
+  //a node with no declared input rate runs at the rate of its input, only the chunk can follow it now.
+  if((port == 0) && (p_object->input_rate <= 0) && (p_source->output_rate > 0))
+  {
+    p_object->input_rate = p_source->output_rate;
+
+    if(p_object->output_rate <= 0) p_object->output_rate = p_object->input_rate;
+
+    if(p_object->auto_chunk)
+    {
+      p_object->chunk_size = node_size_chunk(p_object);
+
+      logger_info_msg(p_object->p_logger, "DSP NODE %p chunk sized to %lu for input rate %f.", p_object, p_object->chunk_size, p_object->input_rate);
+    }
+  }
+
+  //a auto chunk never waits on more then half the ring it reads, the writer and reader would run in lock step.
+  if(p_object->auto_chunk && p_port->p_ring_buffer && (p_object->chunk_size > p_port->p_ring_buffer->buffer_size / 2))
+  {
+    unsigned long half_size = p_port->p_ring_buffer->buffer_size / 2;
+
+    if(p_object->granularity > 1) half_size = half_size / p_object->granularity * p_object->granularity;
+
+    if(half_size && (half_size >= p_object->process_input_max))
+    {
+      p_object->chunk_size = half_size;
+
+      logger_info_msg(p_object->p_logger, "DSP NODE %p chunk sized to %lu, half of the input ring.", p_object, p_object->chunk_size);
+    }
+  }
+
+  if(p_convert) logger_info_msg(p_object->p_logger, "DSP NODE %p port %u converts type %d to %d with %p.", p_object, port, p_input_object->output_type, p_port->type, p_convert);
+
+  logger_info_msg(p_object->p_logger, "DSP NODE %p port %u has input from %p, reader %u.", p_object, port, p_source, p_port->reader);
+
+  return 0;
+}
+
+//Read from the input ring buffer of the node.
+unsigned long dsp_readInput(struct s_dsp_node * const p_object, void *p_buffer, unsigned long size)
+{
+  return dsp_readInputPort(p_object, 0, p_buffer, size);
+}
+
+//Deadline for the timed read, write, reserve and peek calls.
+unsigned long long dsp_deadline(unsigned long timeout_ms)
+{
+  if(timeout_ms == DSP_NODE_WAIT_FOREVER) return DSP_RING_FOREVER;
+
+  return dsp_ringDeadline((unsigned long long)timeout_ms * 1000000ULL);
+}
+
+//Read from the input ring buffer of the node, or nothing if the deadline passes first.
+unsigned long dsp_readInputTimed(struct s_dsp_node * const p_object, void *p_buffer, unsigned long size, unsigned long long deadline)
+{
+  return dsp_readInputPortTimed(p_object, 0, p_buffer, size, deadline);
+}
+
+//Read from the input ring buffer of a input port of the node.
+unsigned long dsp_readInputPort(struct s_dsp_node * const p_object, unsigned int port, void *p_buffer, unsigned long size)
+{
+  unsigned long num_read = 0;
+
+  num_read = dsp_readInputPortTimed(p_object, port, p_buffer, size, DSP_RING_FOREVER);
+
+  //with no deadline only a cancel comes back early, to the node that is the end of the stream.
+  return (num_read == DSP_NODE_TIMEOUT ? 0 : num_read);
+}
+
+//Read from the input ring buffer of a input port of the node, or nothing if the deadline passes first.
+unsigned long dsp_readInputPortTimed(struct s_dsp_node * const p_object, unsigned int port, void *p_buffer, unsigned long size, unsigned long long deadline)
+{
+  unsigned long num_read = 0;
+
+  unsigned long long enter_ns = 0;
+
+  if(!p_object) return 0;
+
+  if(port >= p_object->num_input_ports) return 0;
+
+  //a chunk boundary, a pause holds the node here before it touches its ports.
+  if(atomic_load_explicit(&p_object->pause, memory_order_acquire) && node_park(p_object)) return DSP_NODE_TIMEOUT;
+
+#ifdef DSP_NODE_LATENCY
+  //a sink coming back for more is done with what it read before.
+  if(!p_object->p_output_ring_buffer) latency_output(p_object);
+#endif
+
+  enter_ns = stats_enter(p_object);
+
+  num_read = dsp_ringTimedRead(p_object->input_ports[port].p_ring_buffer, p_object->input_ports[port].reader, p_buffer, size, deadline, &p_object->p_cancel->cancelled);
+
+  stats_leave(p_object, &p_object->counters.input_wait_ns, enter_ns);
+
+  if(num_read == DSP_RING_TIMEOUT) return DSP_NODE_TIMEOUT;
+
+  //a read only comes back empty in time at the end of the stream.
+  if(!num_read)
+  {
+    if(size) dsp_setState(p_object, DSP_NODE_DRAINING);
+
+    return 0;
+  }
+
+  dsp_statsAdd(p_object, num_read, 0);
+
+#ifdef DSP_NODE_LATENCY
+  latency_input(p_object, port, num_read);
+#endif
+
+  return num_read;
+}
+
+//Read the same number of elements from every connected input port.
+unsigned long dsp_readInputAll(struct s_dsp_node * const p_object, void * const *pp_buffers, unsigned long size)
+{
+  unsigned long num_read = 0;
+
+  num_read = dsp_readInputAllTimed(p_object, pp_buffers, size, DSP_RING_FOREVER);
+
+  return (num_read == DSP_NODE_TIMEOUT ? 0 : num_read);
+}
+
+//Read the same number of elements from every connected input port, or nothing if the deadline passes first.
+unsigned long dsp_readInputAllTimed(struct s_dsp_node * const p_object, void * const *pp_buffers, unsigned long size, unsigned long long deadline)
+{
+  unsigned int  index     = 0;
+  unsigned long available = 0;
+
+  unsigned long long enter_ns = 0;
+
+  if(!p_object || !pp_buffers) return 0;
+
+  if(atomic_load_explicit(&p_object->pause, memory_order_acquire) && node_park(p_object)) return DSP_NODE_TIMEOUT;
+
+  available = size;
+
+  enter_ns = stats_enter(p_object);
+
+  //wait on each port in turn, the least available is what every port can read without blocking.
+  for(index = 0; index < p_object->num_input_ports; index++)
+  {
+    unsigned long port_available = 0;
+
+    if(!p_object->input_ports[index].p_ring_buffer) continue;
+
+    port_available = dsp_ringTimedWaitRead(p_object->input_ports[index].p_ring_buffer, p_object->input_ports[index].reader, available, deadline, &p_object->p_cancel->cancelled);
+
+    //ports already waited on keep their data for the next call.
+    if(port_available == DSP_RING_TIMEOUT)
+    {
+      stats_leave(p_object, &p_object->counters.input_wait_ns, enter_ns);
+
+      return DSP_NODE_TIMEOUT;
+    }
+
+    if(port_available < available) available = port_available;
+  }
+
+  stats_leave(p_object, &p_object->counters.input_wait_ns, enter_ns);
+
+  if(!available)
+  {
+    if(size) dsp_setState(p_object, DSP_NODE_DRAINING);
+
+    return 0;
+  }
+
+#ifdef DSP_NODE_LATENCY
+  if(!p_object->p_output_ring_buffer) latency_output(p_object);
+#endif
+
+  for(index = 0; index < p_object->num_input_ports; index++)
+  {
+    if(!p_object->input_ports[index].p_ring_buffer) continue;
+
+    dsp_ringBlockingRead(p_object->input_ports[index].p_ring_buffer, p_object->input_ports[index].reader, pp_buffers[index], available);
+
+    dsp_statsAdd(p_object, available, 0);
+
+#ifdef DSP_NODE_LATENCY
+    latency_input(p_object, index, available);
+#endif
+  }
+
+  return available;
+}
+
+//Write to the output ring buffer of the node.
+unsigned long dsp_writeOutput(struct s_dsp_node * const p_object, void const *p_buffer, unsigned long size)
+{
+  unsigned long num_wrote = 0;
+
+  num_wrote = dsp_writeOutputTimed(p_object, p_buffer, size, DSP_RING_FOREVER);
+
+  return (num_wrote == DSP_NODE_TIMEOUT ? 0 : num_wrote);
+}
+
+//Write to the output ring buffer of the node, or nothing if the deadline passes first.
+unsigned long dsp_writeOutputTimed(struct s_dsp_node * const p_object, void const *p_buffer, unsigned long size, unsigned long long deadline)
+{
+  unsigned long num_wrote = 0;
+
+  unsigned long long enter_ns = 0;
+
+  if(!p_object) return 0;
+
+  enter_ns = stats_enter(p_object);
+
+  num_wrote = dsp_ringTimedWrite(p_object->p_output_ring_buffer, p_buffer, size, deadline, &p_object->p_cancel->cancelled);
+
+  stats_leave(p_object, &p_object->counters.output_wait_ns, enter_ns);
+
+  if(num_wrote == DSP_RING_TIMEOUT) return DSP_NODE_TIMEOUT;
+
+  if(!num_wrote) return 0;
+
+  dsp_statsAdd(p_object, 0, num_wrote);
+
+#ifdef DSP_NODE_LATENCY
+  latency_output(p_object);
+#endif
+
+  return num_wrote;
+}
+
+//Write all elements to the output ring buffer of the node, a poll period at a time.
+unsigned long dsp_writeOutputAll(struct s_dsp_node * const p_object, void const *p_buffer, unsigned long size, volatile sig_atomic_t const *p_kill)
+{
+  unsigned long num_wrote = 0;
+
+  if(!p_object) return 0;
+
+  while((num_wrote < size) && !(p_kill && *p_kill) && !dsp_isCancelled(p_object))
+  {
+    unsigned long num_chunk = 0;
+
+    num_chunk = dsp_writeOutputTimed(p_object, (uint8_t const *)p_buffer + (num_wrote * p_object->output_type_size), size - num_wrote, dsp_deadline(DSP_NODE_POLL_MS));
+
+    if(num_chunk == DSP_NODE_TIMEOUT) continue;
+
+    if(!num_chunk) break;
+
+    num_wrote += num_chunk;
+  }
+
+  return num_wrote;
+}
+
+//Reserve space in the output ring buffer of the node to write into directly.
+unsigned long dsp_reserveOutput(struct s_dsp_node * const p_object, void **pp_buffer, unsigned long size)
+{
+  unsigned long num_reserved = 0;
+
+  num_reserved = dsp_reserveOutputTimed(p_object, pp_buffer, size, DSP_RING_FOREVER);
+
+  return (num_reserved == DSP_NODE_TIMEOUT ? 0 : num_reserved);
+}
+
+//Reserve space in the output ring buffer of the node, or nothing if the deadline passes first.
+unsigned long dsp_reserveOutputTimed(struct s_dsp_node * const p_object, void **pp_buffer, unsigned long size, unsigned long long deadline)
+{
+  unsigned long num_reserved = 0;
+
+  unsigned long long enter_ns = 0;
+
+  if(!p_object) return 0;
+
+  enter_ns = stats_enter(p_object);
+
+  num_reserved = dsp_ringTimedReserve(p_object->p_output_ring_buffer, pp_buffer, size, deadline, &p_object->p_cancel->cancelled);
+
+  stats_leave(p_object, &p_object->counters.output_wait_ns, enter_ns);
+
+  return num_reserved;
+}
+
+//Commit elements written to reserved output space.
+void dsp_commitOutput(struct s_dsp_node * const p_object, unsigned long size)
+{
+  if(!p_object) return;
+
+  dsp_ringCommit(p_object->p_output_ring_buffer, size);
+
+  if(!size) return;
+
+  dsp_statsAdd(p_object, 0, size);
+
+#ifdef DSP_NODE_LATENCY
+  latency_output(p_object);
+#endif
+}
+
+//Peek at elements in the input ring buffer of the node without copying them.
+unsigned long dsp_peekInput(struct s_dsp_node * const p_object, void const **pp_buffer, unsigned long size)
+{
+  return dsp_peekInputPort(p_object, 0, pp_buffer, size);
+}
+
+//Peek at elements in the input ring buffer of the node, or nothing if the deadline passes first.
+unsigned long dsp_peekInputTimed(struct s_dsp_node * const p_object, void const **pp_buffer, unsigned long size, unsigned long long deadline)
+{
+  return dsp_peekInputPortTimed(p_object, 0, pp_buffer, size, deadline);
+}
+
+//Peek at elements in the input ring buffer of a input port without copying them.
+unsigned long dsp_peekInputPort(struct s_dsp_node * const p_object, unsigned int port, void const **pp_buffer, unsigned long size)
+{
+  unsigned long num_peek = 0;
+
+  num_peek = dsp_peekInputPortTimed(p_object, port, pp_buffer, size, DSP_RING_FOREVER);
+
+  return (num_peek == DSP_NODE_TIMEOUT ? 0 : num_peek);
+}
+
+//Peek at elements in the input ring buffer of a input port, or nothing if the deadline passes first.
+unsigned long dsp_peekInputPortTimed(struct s_dsp_node * const p_object, unsigned int port, void const **pp_buffer, unsigned long size, unsigned long long deadline)
+{
+  unsigned long num_peek = 0;
+
+  unsigned long long enter_ns = 0;
+
+  if(!p_object) return 0;
+
+  if(port >= p_object->num_input_ports) return 0;
+
+  //the release of the last peek is done, a pause holds the node here.
+  if(atomic_load_explicit(&p_object->pause, memory_order_acquire) && node_park(p_object)) return DSP_NODE_TIMEOUT;
+
+  enter_ns = stats_enter(p_object);
+
+  num_peek = dsp_ringTimedPeek(p_object->input_ports[port].p_ring_buffer, p_object->input_ports[port].reader, pp_buffer, size, deadline, &p_object->p_cancel->cancelled);
+
+  stats_leave(p_object, &p_object->counters.input_wait_ns, enter_ns);
+
+  if(num_peek == DSP_RING_TIMEOUT) return DSP_NODE_TIMEOUT;
+
+  //a peek only comes back empty in time at the end of the stream.
+  if(!num_peek)
+  {
+    if(size) dsp_setState(p_object, DSP_NODE_DRAINING);
+
+    return 0;
+  }
+
+#ifdef DSP_NODE_LATENCY
+  latency_input(p_object, port, 0);
+#endif
+
+  return num_peek;
+}
+
+//Release elements from a input peek.
+void dsp_releaseInput(struct s_dsp_node * const p_object, unsigned long size)
+{
+  dsp_releaseInputPort(p_object, 0, size);
+}
+
+//Release elements from a input port peek.
+void dsp_releaseInputPort(struct s_dsp_node * const p_object, unsigned int port, unsigned long size)
+{
+  if(!p_object) return;
+
+  if(port >= p_object->num_input_ports) return;
+
+  dsp_ringRelease(p_object->input_ports[port].p_ring_buffer, p_object->input_ports[port].reader, size);
+
+  if(!size) return;
+
+  //a peek is counted once it is released, a node can peek the same elements twice.
+  dsp_statsAdd(p_object, size, 0);
+
+#ifdef DSP_NODE_LATENCY
+  //a sink is done with a peek once it releases it.
+  if(!p_object->p_output_ring_buffer) latency_output(p_object);
+#endif
+}
+
+//End reading all input ports, upstream no longer waits on this node.
+void dsp_endInput(struct s_dsp_node * const p_object)
+{
+  unsigned int index = 0;
+
+  if(!p_object) return;
+
+  for(index = 0; index < p_object->num_input_ports; index++)
+  {
+    dsp_endInputPort(p_object, index);
+  }
+}
+
+//End reading a input port, upstream of that port no longer waits on this node.
+void dsp_endInputPort(struct s_dsp_node * const p_object, unsigned int port)
+{
+  if(!p_object) return;
+
+  if(port >= p_object->num_input_ports) return;
+
+  dsp_ringEndRead(p_object->input_ports[port].p_ring_buffer, p_object->input_ports[port].reader);
+
+  dsp_setState(p_object, DSP_NODE_DRAINING);
+}
+
+//End writing the output, downstream nodes read what is left then stop.
+void dsp_endOutput(struct s_dsp_node * const p_object)
+{
+  if(!p_object) return;
+
+  dsp_ringEndWrite(p_object->p_output_ring_buffer);
+
+  dsp_setState(p_object, DSP_NODE_DRAINING);
+}
+
+//Snapshot of the latency histogram of a node.
+int dsp_getLatency(struct s_dsp_node const * const p_object, struct s_dsp_latency_stats * const p_stats)
+{
+#ifdef DSP_NODE_LATENCY
+  unsigned int index = 0;
+
+  unsigned long long total = 0;
+  unsigned long long p50   = 0;
+  unsigned long long p99   = 0;
+  unsigned long long p999  = 0;
+#endif
+
+  if(!p_object || !p_stats)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for getLatency.\n");
+
+    return ~0;
+  }
+
+  memset(p_stats, 0, sizeof(struct s_dsp_latency_stats));
+
+#ifdef DSP_NODE_LATENCY
+  //buckets are read one at a time while the node records, the sum of them is the count of this snapshot.
+  for(index = 0; index < DSP_LATENCY_BUCKETS; index++)
+  {
+    total += atomic_load_explicit(&p_object->latency.buckets[index], memory_order_relaxed);
+  }
+
+  p_stats->count = total;
+
+  p_stats->max_ns = atomic_load_explicit(&p_object->latency.max_ns, memory_order_relaxed);
+
+  if(!total) return 0;
+
+  //rank of each percentile, rounded up so a small count still lands on a recorded bucket.
+  p50  = (total * 500 + 999) / 1000;
+  p99  = (total * 990 + 999) / 1000;
+  p999 = (total * 999 + 999) / 1000;
+
+  for(index = 0, total = 0; index < DSP_LATENCY_BUCKETS; index++)
+  {
+    total += atomic_load_explicit(&p_object->latency.buckets[index], memory_order_relaxed);
+
+    if(!p_stats->p50_ns && (total >= p50)) p_stats->p50_ns = latency_bucket_max(index);
+
+    if(!p_stats->p99_ns && (total >= p99)) p_stats->p99_ns = latency_bucket_max(index);
+
+    if(total >= p999)
+    {
+      p_stats->p999_ns = latency_bucket_max(index);
+
+      break;
+    }
+  }
+
+  //the bucket top can be past the largest value recorded.
+  if(p_stats->p50_ns > p_stats->max_ns) p_stats->p50_ns = p_stats->max_ns;
+
+  if(p_stats->p99_ns > p_stats->max_ns) p_stats->p99_ns = p_stats->max_ns;
+
+  if(p_stats->p999_ns > p_stats->max_ns) p_stats->p999_ns = p_stats->max_ns;
+
+  return 0;
+#else
+  logger_error_msg(p_object->p_logger, "DSP NODE %p latency is not compiled in, build with DSP_NODE_LATENCY.", p_object);
+
+  return ~0;
+#endif
+}
+
+//Move a node to a later lifecycle state and wake anyone waiting on it.
+void dsp_setState(struct s_dsp_node * const p_object, enum e_dsp_node_state state)
+{
+  if(!p_object) return;
+
+  pthread_mutex_lock(&p_object->state_mutex);
+
+  //only a running node drains, a node ended before it ran has nothing to finish.
+  if((state == DSP_NODE_DRAINING) && (p_object->state != DSP_NODE_RUNNING)) state = p_object->state;
+
+  if((state > p_object->state) || (state == DSP_NODE_RUNNING))
+  {
+    p_object->state = state;
+
+    pthread_cond_broadcast(&p_object->state_cond);
+  }
+
+  pthread_mutex_unlock(&p_object->state_mutex);
+}
+
+//Current lifecycle state of a node.
+enum e_dsp_node_state dsp_getState(struct s_dsp_node * const p_object)
+{
+  enum e_dsp_node_state state = DSP_NODE_STOPPED;
+
+  if(!p_object) return state;
+
+  pthread_mutex_lock(&p_object->state_mutex);
+
+  state = p_object->state;
+
+  pthread_mutex_unlock(&p_object->state_mutex);
+
+  return state;
+}
+
+//Sleep till a node reaches a lifecycle state or any state after it.
+int dsp_waitState(struct s_dsp_node * const p_object, enum e_dsp_node_state state, unsigned long timeout_ms)
+{
+  int error = 0;
+
+  struct timespec timeout;
+
+  if(!p_object)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for waitState.\n");
+
+    return ~0;
+  }
+
+  node_timespec(timeout_ms, &timeout);
+
+  pthread_mutex_lock(&p_object->state_mutex);
+
+  while((p_object->state < state) && !error)
+  {
+    if(timeout_ms == DSP_NODE_WAIT_FOREVER)
+    {
+      error = pthread_cond_wait(&p_object->state_cond, &p_object->state_mutex);
+    }
+    else
+    {
+      error = pthread_cond_timedwait(&p_object->state_cond, &p_object->state_mutex, &timeout);
+    }
+  }
+
+  //the state can land right as the timeout does.
+  if(p_object->state >= state) error = 0;
+
+  pthread_mutex_unlock(&p_object->state_mutex);
+
+  return error;
+}
+
+//Snapshot of the counters of a node.
+int dsp_getStats(struct s_dsp_node const * const p_object, struct s_dsp_stats * const p_stats)
+{
+  unsigned int index = 0;
+
+  if(!p_object || !p_stats)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for getStats.\n");
+
+    return ~0;
+  }
+
+  memset(p_stats, 0, sizeof(struct s_dsp_stats));
+
+  p_stats->items_in = atomic_load_explicit(&p_object->counters.items_in, memory_order_relaxed);
+
+  p_stats->items_out = atomic_load_explicit(&p_object->counters.items_out, memory_order_relaxed);
+
+  p_stats->chunks_in = atomic_load_explicit(&p_object->counters.chunks_in, memory_order_relaxed);
+
+  p_stats->chunks_out = atomic_load_explicit(&p_object->counters.chunks_out, memory_order_relaxed);
+
+  p_stats->errors = atomic_load_explicit(&p_object->counters.errors, memory_order_relaxed);
+
+  p_stats->start_ns = atomic_load_explicit(&p_object->counters.start_ns, memory_order_relaxed);
+
+  p_stats->stop_ns = atomic_load_explicit(&p_object->counters.stop_ns, memory_order_relaxed);
+
+  p_stats->input_wait_ns = atomic_load_explicit(&p_object->counters.input_wait_ns, memory_order_relaxed);
+
+  p_stats->output_wait_ns = atomic_load_explicit(&p_object->counters.output_wait_ns, memory_order_relaxed);
+
+  p_stats->compute_ns = atomic_load_explicit(&p_object->counters.compute_ns, memory_order_relaxed);
+
+  //blocked events are counted by the rings where the wait happens.
+  for(index = 0; index < p_object->num_input_ports; index++)
+  {
+    if(!p_object->input_ports[index].p_ring_buffer) continue;
+
+    p_stats->blocked_input += dsp_ringReadBlocked(p_object->input_ports[index].p_ring_buffer, p_object->input_ports[index].reader);
+  }
+
+  if(p_object->output_type != DATA_INVALID) p_stats->blocked_output = dsp_ringWriteBlocked(p_object->p_output_ring_buffer);
+
+  return 0;
+}
+
+//Fill level telemetry of the edge feeding a input port.
+int dsp_getInputFill(struct s_dsp_node const * const p_object, unsigned int port, struct s_dsp_ring_fill * const p_fill)
+{
+  if(!p_object || !p_fill)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for getInputFill.\n");
+
+    return ~0;
+  }
+
+  memset(p_fill, 0, sizeof(struct s_dsp_ring_fill));
+
+  if(port >= p_object->num_input_ports) return ~0;
+
+  if(!p_object->input_ports[port].p_ring_buffer) return ~0;
+
+  return dsp_ringFill(p_object->input_ports[port].p_ring_buffer, p_object->input_ports[port].reader, p_fill);
+}
+
+//Fill level telemetry of the output ring for one of its readers.
+int dsp_getOutputFill(struct s_dsp_node const * const p_object, unsigned int reader, struct s_dsp_ring_fill * const p_fill)
+{
+  if(!p_object || !p_fill)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for getOutputFill.\n");
+
+    return ~0;
+  }
+
+  memset(p_fill, 0, sizeof(struct s_dsp_ring_fill));
+
+  if(p_object->output_type == DATA_INVALID) return ~0;
+
+  return dsp_ringFill(p_object->p_output_ring_buffer, reader, p_fill);
+}
+
+//Tag a element of the output stream.
+int dsp_addOutputTag(struct s_dsp_node * const p_object, struct s_dsp_tag const * const p_tag)
+{
+  if(!p_object || !p_tag) return ~0;
+
+  if(!p_object->p_output_ring_buffer)
+  {
+    logger_error_msg(p_object->p_logger, "DSP NODE %p has no output to tag.", p_object);
+
+    return ~0;
+  }
+
+  if(dsp_ringAddTag(p_object->p_output_ring_buffer, p_tag))
+  {
+    logger_error_msg(p_object->p_logger, "DSP NODE %p tag key %u at offset %lu is before the last tag.", p_object, p_tag->key, p_tag->offset);
+
+    return ~0;
+  }
+
+  return 0;
+}
+
+//Absolute offset of the next element the node writes or commits.
+unsigned long dsp_getOutputOffset(struct s_dsp_node * const p_object)
+{
+  if(!p_object) return 0;
+
+  return dsp_ringWriteOffset(p_object->p_output_ring_buffer);
+}
+
+//Get the tags on the next size elements of input port 0.
+unsigned long dsp_getInputTags(struct s_dsp_node * const p_object, unsigned long size, struct s_dsp_tag * const p_tags, unsigned long max)
+{
+  return dsp_getInputPortTags(p_object, 0, size, p_tags, max);
+}
+
+//Get the tags on the next size elements of a input port.
+unsigned long dsp_getInputPortTags(struct s_dsp_node * const p_object, unsigned int port, unsigned long size, struct s_dsp_tag * const p_tags, unsigned long max)
+{
+  if(!p_object) return 0;
+
+  if(port >= p_object->num_input_ports) return 0;
+
+  return dsp_ringGetTags(p_object->input_ports[port].p_ring_buffer, p_object->input_ports[port].reader, size, &p_object->input_ports[port].tag_cursor, p_tags, max);
+}
+
+//Absolute offset of the next element a input port reads.
+unsigned long dsp_getInputOffset(struct s_dsp_node * const p_object, unsigned int port)
+{
+  if(!p_object) return 0;
+
+  if(port >= p_object->num_input_ports) return 0;
+
+  return dsp_ringReadOffset(p_object->input_ports[port].p_ring_buffer, p_object->input_ports[port].reader);
+}
+
+//Count elements moved by a node outside of the read and write calls.
+void dsp_statsAdd(struct s_dsp_node * const p_object, unsigned long items_in, unsigned long items_out)
+{
+  if(!p_object) return;
+
+  if(items_in)
+  {
+    stats_add(&p_object->counters.items_in, items_in);
+
+    stats_add(&p_object->counters.chunks_in, 1);
+  }
+
+  if(items_out)
+  {
+    stats_add(&p_object->counters.items_out, items_out);
+
+    stats_add(&p_object->counters.chunks_out, 1);
+  }
+}
+
+//Count a error hit by a node while running.
+void dsp_statsError(struct s_dsp_node * const p_object)
+{
+  if(!p_object) return;
+
+  stats_add(&p_object->counters.errors, 1);
+}
+
+//Stamp the time a node started running.
+void dsp_statsStart(struct s_dsp_node * const p_object)
+{
+  if(!p_object) return;
+
+  atomic_store_explicit(&p_object->counters.stop_ns, 0, memory_order_relaxed);
+
+  atomic_store_explicit(&p_object->counters.start_ns, stats_now(), memory_order_relaxed);
+}
+
+//Stamp the time a node stopped running.
+void dsp_statsStop(struct s_dsp_node * const p_object)
+{
+  if(!p_object) return;
+
+  atomic_store_explicit(&p_object->counters.stop_ns, stats_now(), memory_order_relaxed);
+}
+
+//Run the process_call of a node and count the time in it as compute.
+int dsp_process(struct s_dsp_node * const p_object, struct s_dsp_process * const p_process)
+{
+  int finished = 0;
+
+  unsigned long long enter_ns = 0;
+
+  if(!p_object || !p_object->process_call) return ~0;
+
+  enter_ns = stats_raw();
+
+  finished = p_object->process_call(p_object, p_process);
+
+  atomic_store_explicit(&p_object->counters.compute_ns, atomic_load_explicit(&p_object->counters.compute_ns, memory_order_relaxed) + (stats_raw() - enter_ns), memory_order_relaxed);
+
+  return finished;
+}
+
+//Start the thread using pthread function passed to create.
+int dsp_start(struct s_dsp_node * const p_object)
+{
+  int error = 0;
+
+  unsigned int index = 0;
+
+  pthread_attr_t attr;
+
+  if(!p_object)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for wait.\n");
+
+    return ~0;
+  }
+
+  //converters of the input ports run with the placement of the node they feed.
+  for(index = 0; index < p_object->num_input_ports; index++)
+  {
+    struct s_dsp_node *p_convert = p_object->input_ports[index].p_convert;
+
+    if(!p_convert) continue;
+
+    //a converter handed over by dsp_replace or dsp_insert is already running.
+    if(dsp_getState(p_convert) == DSP_NODE_RUNNING) continue;
+
+    memcpy(&p_convert->affinity, &p_object->affinity, sizeof(cpu_set_t));
+
+    p_convert->affinity_set = p_object->affinity_set;
+
+    p_convert->sched_policy = p_object->sched_policy;
+
+    p_convert->sched_priority = p_object->sched_priority;
+
+    p_convert->sched_set = p_object->sched_set;
+
+    error = dsp_start(p_convert);
+
+    if(error) return error;
+  }
+
+  pthread_attr_init(&attr);
+
+  //a node ended before is started again with a clear token.
+  dsp_cancelReset(p_object->p_cancel);
+
+  //a node started after its context was stopped stops at once.
+  if(dsp_contextIsStopped(p_object->p_context)) dsp_cancelSet(p_object->p_cancel);
+
+  //running before the thread exists, cleanup waits on it even if the thread has not been scheduled yet.
+  dsp_setState(p_object, DSP_NODE_RUNNING);
+
+  if(p_object->affinity_set)
+  {
+    error = pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &p_object->affinity);
+
+    if(error) logger_error_msg(p_object->p_logger, "DSP NODE %p could not set affinity, %s.", p_object, strerror(error));
+  }
+
+  if(p_object->sched_set)
+  {
+    struct sched_param param;
+
+    param.sched_priority = p_object->sched_priority;
+
+    error = pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+
+    if(!error) error = pthread_attr_setschedpolicy(&attr, p_object->sched_policy);
+
+    if(!error) error = pthread_attr_setschedparam(&attr, &param);
+
+    if(error) logger_error_msg(p_object->p_logger, "DSP NODE %p could not set sched policy %d priority %d, %s.", p_object, p_object->sched_policy, p_object->sched_priority, strerror(error));
+  }
+
+  error = pthread_create(&p_object->dsp_thread, &attr, node_thread, p_object);
+
+  //no permission for the policy, run the node anyway with the inherited one.
+  if((error == EPERM) && p_object->sched_set)
+  {
+    logger_error_msg(p_object->p_logger, "DSP NODE %p no permission for sched policy %d priority %d, starting with inherited scheduling.", p_object, p_object->sched_policy, p_object->sched_priority);
+
+    pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+
+    error = pthread_create(&p_object->dsp_thread, &attr, node_thread, p_object);
+  }
+
+  pthread_attr_destroy(&attr);
+
+  if(error)
+  {
+    logger_error_msg(p_object->p_logger, "DSP NODE %p could not start, %s.", p_object, strerror(error));
+
+    dsp_setState(p_object, DSP_NODE_STOPPED);
+
+    return error;
+  }
+
+  logger_info_msg(p_object->p_logger, "DSP NODE %p started.", p_object);
+
+  return 0;
+}
+
+//Wait for the pthread to finish
+int dsp_wait(struct s_dsp_node const * const p_object)
+{
+  int error = 0;
+
+  unsigned int index = 0;
+
+  if(!p_object)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for wait.\n");
+
+    return ~0;
+  }
+
+  error = pthread_join(p_object->dsp_thread, NULL);
+
+  logger_info_msg(p_object->p_logger, "DSP NODE %p joined.", p_object);
+
+  for(index = 0; index < p_object->num_input_ports; index++)
+  {
+    if(p_object->input_ports[index].p_convert) dsp_wait(p_object->input_ports[index].p_convert);
+  }
+
+  return error;
+}
+
+//Force the pthread to end
+int dsp_end(struct s_dsp_node const * const p_object)
+{
+  int error = 0;
+
+  unsigned int index = 0;
+
+  if(!p_object)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for end.\n");
+
+    return ~0;
+  }
+
+  for(index = 0; index < p_object->num_input_ports; index++)
+  {
+    if(p_object->input_ports[index].p_convert) dsp_end(p_object->input_ports[index].p_convert);
+  }
+
+  //the flag is set before the rings are woken, a wait that wakes always sees it.
+  error = dsp_cancelSet(p_object->p_cancel);
+
+  for(index = 0; index < p_object->num_input_ports; index++)
+  {
+    dsp_ringInterrupt(p_object->input_ports[index].p_ring_buffer);
+  }
+
+  dsp_ringInterrupt(p_object->p_output_ring_buffer);
+
+  logger_info_msg(p_object->p_logger, "DSP NODE %p cancelled.", p_object);
+
+  return error;
+}
+
+//Stop every node in the context of a node.
+int dsp_kill(struct s_dsp_node const * const p_object)
+{
+  if(!p_object)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for kill.\n");
+
+    return ~0;
+  }
+
+  logger_warning_msg(p_object->p_logger, "DSP NODE %p stopping its context %p.", p_object, p_object->p_context);
+
+  return dsp_contextStop(p_object->p_context);
+}
+
+//Check if a node was ended with dsp_end.
+int dsp_isCancelled(struct s_dsp_node const * const p_object)
+{
+  if(!p_object) return 0;
+
+  return dsp_cancelIsSet(p_object->p_cancel);
+}
+
+//File descriptor that is readable once the node is cancelled.
+int dsp_getCancelFd(struct s_dsp_node const * const p_object)
+{
+  if(!p_object) return -1;
+
+  return dsp_cancelFd(p_object->p_cancel);
+}
+
+//Poll fds of a node till one is ready, the node is cancelled or the deadline passes.
+int dsp_poll(struct s_dsp_node const * const p_object, struct pollfd *p_fds, unsigned int num_fds, unsigned long long deadline)
+{
+  if(!p_object) return -1;
+
+  return dsp_cancelPoll(p_object->p_cancel, p_fds, num_fds, deadline);
+}
+
+//Hold a running node at its next input read or peek, a chunk boundary.
+int dsp_pause(struct s_dsp_node * const p_object, unsigned long timeout_ms)
+{
+  int error  = 0;
+  int paused = 0;
+
+  struct timespec timeout;
+
+  if(!p_object)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for pause.\n");
+
+    return ~0;
+  }
+
+  if(dsp_getState(p_object) != DSP_NODE_RUNNING)
+  {
+    logger_error_msg(p_object->p_logger, "DSP NODE %p is not running, it can not be paused.", p_object);
+
+    return ~0;
+  }
+
+  node_timespec(timeout_ms, &timeout);
+
+  atomic_store_explicit(&p_object->pause, 1, memory_order_release);
+
+  pthread_mutex_lock(&p_object->state_mutex);
+
+  //a node that ends its stream instead never comes back for input.
+  while(!p_object->paused && (p_object->state == DSP_NODE_RUNNING) && !error)
+  {
+    if(timeout_ms == DSP_NODE_WAIT_FOREVER)
+    {
+      error = pthread_cond_wait(&p_object->state_cond, &p_object->state_mutex);
+    }
+    else
+    {
+      error = pthread_cond_timedwait(&p_object->state_cond, &p_object->state_mutex, &timeout);
+    }
+  }
+
+  paused = p_object->paused;
+
+  pthread_mutex_unlock(&p_object->state_mutex);
+
+  if(!paused)
+  {
+    logger_error_msg(p_object->p_logger, "DSP NODE %p did not reach a chunk boundary in %lu ms, not paused.", p_object, timeout_ms);
+
+    dsp_resume(p_object);
+
+    return ~0;
+  }
+
+  logger_info_msg(p_object->p_logger, "DSP NODE %p paused.", p_object);
+
+  return 0;
+}
+
+//Let a node held by dsp_pause go on.
+int dsp_resume(struct s_dsp_node * const p_object)
+{
+  if(!p_object)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for resume.\n");
+
+    return ~0;
+  }
+
+  pthread_mutex_lock(&p_object->state_mutex);
+
+  atomic_store_explicit(&p_object->pause, 0, memory_order_release);
+
+  pthread_cond_broadcast(&p_object->state_cond);
+
+  pthread_mutex_unlock(&p_object->state_mutex);
+
+  return 0;
+}
+
+//Replace a node with a new one that takes over its edges, the nodes around it keep running.
+int dsp_replace(struct s_dsp_node * const p_old, struct s_dsp_node * const p_new, unsigned long timeout_ms)
+{
+  int error   = 0;
+  int running = 0;
+
+  unsigned int index = 0;
+
+  enum e_dsp_node_state state = DSP_NODE_CREATED;
+
+  struct s_dsp_ring *p_new_ring = NULL;
+
+  if(!p_old || !p_new)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for replace.\n");
+
+    return ~0;
+  }
+
+  if(dsp_getState(p_new) != DSP_NODE_SETUP)
+  {
+    logger_error_msg(p_new->p_logger, "DSP NODE %p must be setup and not started to replace %p.", p_new, p_old);
+
+    return ~0;
+  }
+
+  //the edges are handed over as they are, the new node has to read and write the same types.
+  if((p_new->num_input_ports != p_old->num_input_ports) || (p_new->output_type != p_old->output_type))
+  {
+    logger_error_msg(p_new->p_logger, "DSP NODE %p can not replace %p, %u ports output type %d for %u ports output type %d.", p_new, p_old, p_new->num_input_ports, p_new->output_type, p_old->num_input_ports, p_old->output_type);
+
+    return ~0;
+  }
+
+  for(index = 0; index < p_new->num_input_ports; index++)
+  {
+    if((p_new->input_ports[index].type == p_old->input_ports[index].type) && !p_new->input_ports[index].p_ring_buffer) continue;
+
+    logger_error_msg(p_new->p_logger, "DSP NODE %p can not replace %p, port %u is type %d for %d or already connected.", p_new, p_old, index, p_new->input_ports[index].type, p_old->input_ports[index].type);
+
+    return ~0;
+  }
+
+  state = dsp_getState(p_old);
+
+  //a node past running may already be joined, there is no thread to hand over from.
+  if(state > DSP_NODE_RUNNING)
+  {
+    logger_error_msg(p_old->p_logger, "DSP NODE %p is draining or stopped, not replaced.", p_old);
+
+    return ~0;
+  }
+
+  running = (state == DSP_NODE_RUNNING);
+
+  if(running && dsp_pause(p_old, timeout_ms)) return ~0;
+
+  //the new node takes the read cursors of the old one, upstream never sees a new reader.
+  for(index = 0; index < p_old->num_input_ports; index++)
+  {
+    p_new->input_ports[index] = p_old->input_ports[index];
+
+    p_old->input_ports[index].p_ring_buffer = NULL;
+
+    p_old->input_ports[index].p_convert = NULL;
+  }
+
+  //and writes the ring the old one wrote, downstream keeps reading where it was.
+  p_new_ring = p_new->p_output_ring_buffer;
+
+  p_new->p_output_ring_buffer = p_old->p_output_ring_buffer;
+
+  p_old->p_output_ring_buffer = NULL;
+
+  if(running)
+  {
+    //the old node is still held, it takes everything back if the new one can not start.
+    error = dsp_start(p_new);
+
+    if(error)
+    {
+      for(index = 0; index < p_old->num_input_ports; index++)
+      {
+        p_old->input_ports[index] = p_new->input_ports[index];
+
+        p_new->input_ports[index].p_ring_buffer = NULL;
+
+        p_new->input_ports[index].p_convert = NULL;
+      }
+
+      p_old->p_output_ring_buffer = p_new->p_output_ring_buffer;
+
+      p_new->p_output_ring_buffer = p_new_ring;
+
+      dsp_resume(p_old);
+
+      logger_error_msg(p_old->p_logger, "DSP NODE %p could not start %p, not replaced.", p_old, p_new);
+
+      return error;
+    }
+
+    //the old node wakes with no edges, ending it can not touch the stream it gave up.
+    dsp_end(p_old);
+
+    dsp_resume(p_old);
+
+    error = dsp_wait(p_old);
+  }
+
+  dsp_ringFree(&p_new_ring);
+
+  if(p_new->p_output_ring_buffer) p_new->buffer_size = p_new->p_output_ring_buffer->buffer_size;
+
+  logger_info_msg(p_new->p_logger, "DSP NODE %p replaced %p.", p_new, p_old);
+
+  return error;
+}
+
+//Insert a node in front of a input port, the node of the port is paused while it is rewired.
+int dsp_insert(struct s_dsp_node * const p_new, struct s_dsp_node * const p_dst, unsigned int port, unsigned long timeout_ms)
+{
+  int error   = 0;
+  int running = 0;
+
+  unsigned int reader = 0;
+
+  enum e_dsp_node_state state = DSP_NODE_CREATED;
+
+  struct s_dsp_input_port dst_port;
+
+  if(!p_new || !p_dst)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for insert.\n");
+
+    return ~0;
+  }
+
+  if(dsp_getState(p_new) != DSP_NODE_SETUP)
+  {
+    logger_error_msg(p_new->p_logger, "DSP NODE %p must be setup and not started to insert.", p_new);
+
+    return ~0;
+  }
+
+  if((port >= p_dst->num_input_ports) || !p_dst->input_ports[port].p_ring_buffer)
+  {
+    logger_error_msg(p_dst->p_logger, "DSP NODE %p port %u is not connected, nothing to insert %p in.", p_dst, port, p_new);
+
+    return ~0;
+  }
+
+  //the stream on the edge keeps its type, only a node that reads and writes it fits.
+  if((p_new->num_input_ports != 1) || p_new->input_ports[0].p_ring_buffer || (p_new->input_ports[0].type != p_dst->input_ports[port].type) || (p_new->output_type != p_dst->input_ports[port].type))
+  {
+    logger_error_msg(p_new->p_logger, "DSP NODE %p can not be inserted in %p port %u of type %d, it needs one unconnected input and a output of that type.", p_new, p_dst, port, p_dst->input_ports[port].type);
+
+    return ~0;
+  }
+
+  state = dsp_getState(p_dst);
+
+  if(state > DSP_NODE_RUNNING)
+  {
+    logger_error_msg(p_dst->p_logger, "DSP NODE %p is draining or stopped, nothing inserted.", p_dst);
+
+    return ~0;
+  }
+
+  running = (state == DSP_NODE_RUNNING);
+
+  if(running && dsp_pause(p_dst, timeout_ms)) return ~0;
+
+  //the port reads the new node from its first element.
+  if(dsp_ringAddReader(p_new->p_output_ring_buffer, &reader))
+  {
+    logger_error_msg(p_dst->p_logger, "DSP NODE %p could not add reader to %p output, nothing inserted.", p_dst, p_new);
+
+    if(running) dsp_resume(p_dst);
+
+    return ~0;
+  }
+
+  dst_port = p_dst->input_ports[port];
+
+  //the new node takes the read cursor and converter of the port, upstream never sees a new reader.
+  p_new->input_ports[0] = dst_port;
+
+  p_dst->input_ports[port].p_ring_buffer = p_new->p_output_ring_buffer;
+
+  p_dst->input_ports[port].reader = reader;
+
+  p_dst->input_ports[port].p_convert = NULL;
+
+  p_dst->input_ports[port].tag_cursor = 0;
+
+#ifdef DSP_NODE_LATENCY
+  p_dst->input_ports[port].stamp_cursor = 0;
+#endif
+
+  if(running) error = dsp_start(p_new);
+
+  if(error)
+  {
+    p_dst->input_ports[port] = dst_port;
+
+    p_new->input_ports[0].p_ring_buffer = NULL;
+
+    p_new->input_ports[0].p_convert = NULL;
+
+    dsp_ringEndRead(p_new->p_output_ring_buffer, reader);
+
+    dsp_resume(p_dst);
+
+    logger_error_msg(p_dst->p_logger, "DSP NODE %p could not start %p, nothing inserted.", p_dst, p_new);
+
+    return error;
+  }
+
+  if(running) dsp_resume(p_dst);
+
+  logger_info_msg(p_new->p_logger, "DSP NODE %p inserted in front of %p port %u.", p_new, p_dst, port);
+
+  return 0;
+}
+
+//Remove a node with one input from between its input and the port it feeds.
+int dsp_remove(struct s_dsp_node * const p_old, struct s_dsp_node * const p_dst, unsigned int port, unsigned long timeout_ms)
+{
+  int error   = 0;
+  int running = 0;
+
+  enum e_dsp_node_state state = DSP_NODE_CREATED;
+
+  struct s_dsp_input_port old_port;
+
+  if(!p_old || !p_dst)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for remove.\n");
+
+    return ~0;
+  }
+
+  if((port >= p_dst->num_input_ports) || !p_old->p_output_ring_buffer || (p_dst->input_ports[port].p_ring_buffer != p_old->p_output_ring_buffer) || p_dst->input_ports[port].p_convert)
+  {
+    logger_error_msg(p_dst->p_logger, "DSP NODE %p port %u does not read %p directly, not removed.", p_dst, port, p_old);
+
+    return ~0;
+  }
+
+  //what fed the old node goes straight to the port, it has to be the type the port reads.
+  if((p_old->num_input_ports != 1) || !p_old->input_ports[0].p_ring_buffer || (p_old->input_ports[0].type != p_dst->input_ports[port].type))
+  {
+    logger_error_msg(p_old->p_logger, "DSP NODE %p can not be removed from %p port %u of type %d, it needs one connected input of that type.", p_old, p_dst, port, p_dst->input_ports[port].type);
+
+    return ~0;
+  }
+
+  state = dsp_getState(p_old);
+
+  if((state > DSP_NODE_RUNNING) || (dsp_getState(p_dst) > DSP_NODE_RUNNING))
+  {
+    logger_error_msg(p_old->p_logger, "DSP NODE %p or %p is draining or stopped, not removed.", p_old, p_dst);
+
+    return ~0;
+  }
+
+  running = (state == DSP_NODE_RUNNING);
+
+  //the port is rewired under a running reader only while both are held.
+  if(running != (dsp_getState(p_dst) == DSP_NODE_RUNNING))
+  {
+    logger_error_msg(p_old->p_logger, "DSP NODE %p and %p must both be running or both not started, not removed.", p_old, p_dst);
+
+    return ~0;
+  }
+
+  if(running)
+  {
+    if(dsp_pause(p_old, timeout_ms)) return ~0;
+
+    //what the old node already wrote still goes downstream.
+    node_drain(p_dst, port, timeout_ms);
+
+    if(dsp_pause(p_dst, timeout_ms))
+    {
+      dsp_resume(p_old);
+
+      return ~0;
+    }
+  }
+
+  old_port = p_dst->input_ports[port];
+
+  //the port takes the read cursor and converter of the old node, upstream never sees a new reader.
+  p_dst->input_ports[port] = p_old->input_ports[0];
+
+  p_old->input_ports[0].p_ring_buffer = NULL;
+
+  p_old->input_ports[0].p_convert = NULL;
+
+  //less then one read of the port can be left, it goes with the old node.
+  dsp_ringEndRead(old_port.p_ring_buffer, old_port.reader);
+
+  if(running)
+  {
+    dsp_end(p_old);
+
+    dsp_resume(p_old);
+
+    dsp_resume(p_dst);
+
+    error = dsp_wait(p_old);
+  }
+
+  logger_info_msg(p_dst->p_logger, "DSP NODE %p removed from in front of port %u of %p.", p_old, port, p_dst);
+
+  return error;
+}
+
+//remove all allocations from create
+void dsp_cleanup(struct s_dsp_node *p_object)
+{
+  unsigned int index = 0;
+
+  if(!p_object)
+  {
+    fprintf(stderr, "ERROR: Object is NULL for cleanup.\n");
+
+    return;
+  }
+
+  //sleep till the node thread is out, a node never started has nothing to wait on.
+  if(dsp_getState(p_object) >= DSP_NODE_RUNNING) dsp_waitState(p_object, DSP_NODE_STOPPED, DSP_NODE_WAIT_FOREVER);
+
+  //converters go first, the node keeps the context and its logger alive for them.
+  for(index = 0; index < p_object->num_input_ports; index++)
+  {
+    if(p_object->input_ports[index].p_convert) dsp_cleanup(p_object->input_ports[index].p_convert);
+
+    p_object->input_ports[index].p_convert = NULL;
+  }
+
+  if(p_object->free_call)
+  {
+    p_object->free_call(p_object);
+  }
+
+  //the default context and its logger go with the last node.
+  dsp_contextRemove(p_object->p_context, p_object);
+
+  if(p_object->output_type != DATA_INVALID) dsp_ringFree(&p_object->p_output_ring_buffer);
+
+  pthread_cond_destroy(&p_object->state_cond);
+
+  pthread_mutex_destroy(&p_object->state_mutex);
+
+  dsp_cancelFree(&p_object->p_cancel);
+
+  free(p_object);
+}
+
+//run the thread function of a node between its start and stop stamps.
+static void *node_thread(void *p_data)
+{
+  void *p_return = NULL;
+
+  struct s_dsp_node *p_object = (struct s_dsp_node *)p_data;
+
+  dsp_statsStart(p_object);
+
+  //a node thread is timed between its calls, everything else it does is compute.
+  atomic_store_explicit(&p_object->counters.clock_ns, stats_raw(), memory_order_relaxed);
+
+  p_return = p_object->thread_func(p_object);
+
+  stats_enter(p_object);
+
+  atomic_store_explicit(&p_object->counters.clock_ns, 0, memory_order_relaxed);
+
+  dsp_statsStop(p_object);
+
+  dsp_setState(p_object, DSP_NODE_STOPPED);
+
+  return p_return;
+}
+
+//create a converter node reading p_input_object with the type of a input port of p_object.
+static struct s_dsp_node *node_convert(struct s_dsp_node const * const p_object, unsigned int port, struct s_dsp_node const * const p_input_object)
+{
+  struct s_dsp_convert_args convert_args;
+
+  struct s_dsp_node *p_convert = NULL;
+
+  convert_args.input_type = p_input_object->output_type;
+
+  convert_args.output_type = p_object->input_ports[port].type;
+
+  convert_args.byte_swap = 0;
+
+  p_convert = dsp_createInContext(p_object->p_context, p_object->buffer_size, p_object->chunk_size);
+
+  if(!p_convert) return NULL;
+
+  //only the node it feeds ever reads the converter.
+  if(dsp_setRingType(p_convert, DSP_RING_SPSC)) goto error_cleanup;
+
+  //its ring is read by the node it feeds, so it lives where that node's memory does.
+  if(dsp_setAllocPolicy(p_convert, p_object->alloc.flags, p_object->alloc.numa_node)) goto error_cleanup;
+
+  //converting does not change the rate.
+  if(dsp_setRate(p_convert, p_input_object->output_rate, p_input_object->output_rate)) goto error_cleanup;
+
+  if(dsp_setup(p_convert, init_callback_convert, pthread_function_convert, free_callback_convert, &convert_args)) goto error_cleanup;
+
+  if(dsp_setInput(p_convert, p_input_object)) goto error_cleanup;
+
+  return p_convert;
+
+error_cleanup:
+  logger_error_msg(p_object->p_logger, "DSP NODE %p could not create converter for port %u, type %d to %d.", p_object, port, convert_args.input_type, convert_args.output_type);
+
+  dsp_cleanup(p_convert);
+
+  return NULL;
+}
+
+//auto chunk size from the declared rate the node reads at (writes at for sources).
+static unsigned long node_size_chunk(struct s_dsp_node const * const p_object)
+{
+  unsigned long chunk_size = DSP_SIZE_FALLBACK;
+
+  double rate = (p_object->input_rate > 0 ? p_object->input_rate : p_object->output_rate);
+
+  if(rate > 0) chunk_size = (unsigned long)ceil(rate * (double)p_object->latency_us / 1000000.0 / DSP_SIZE_CHUNKS);
+
+  //never less then one process call needs to make progress.
+  if(chunk_size < p_object->process_input_max) chunk_size = p_object->process_input_max;
+
+  if(!chunk_size) chunk_size = 1;
+
+  if(p_object->granularity > 1) chunk_size = (chunk_size + p_object->granularity - 1) / p_object->granularity * p_object->granularity;
+
+  return chunk_size;
+}
+
+//auto output ring size from the declared output rate, the chunk size and the memory budget.
+static unsigned long node_size_buffer(struct s_dsp_node const * const p_object)
+{
+  unsigned long output_chunk = p_object->chunk_size;
+
+  unsigned long buffer_size = 0;
+
+  double rate = (p_object->output_rate > 0 ? p_object->output_rate : p_object->input_rate);
+
+  //one chunk in is more or less then one chunk out when the node changes the rate.
+  if((p_object->input_rate > 0) && (p_object->output_rate > 0))
+  {
+    output_chunk = (unsigned long)ceil((double)p_object->chunk_size * p_object->output_rate / p_object->input_rate);
+  }
+
+  if(output_chunk < p_object->process_output_max) output_chunk = p_object->process_output_max;
+
+  if(!output_chunk) output_chunk = 1;
+
+  buffer_size = output_chunk * DSP_SIZE_CHUNKS;
+
+  if(rate > 0)
+  {
+    unsigned long latency_size = (unsigned long)ceil(rate * (double)p_object->latency_us / 1000000.0);
+
+    if(latency_size > buffer_size) buffer_size = latency_size;
+  }
+
+  if(p_object->memory_budget && p_object->output_type_size && (buffer_size > p_object->memory_budget / p_object->output_type_size))
+  {
+    buffer_size = p_object->memory_budget / p_object->output_type_size;
+
+    //less then two chunks and the writer and reader run in lock step.
+    if(buffer_size < output_chunk * 2)
+    {
+      logger_warning_msg(p_object->p_logger, "DSP NODE %p memory budget %lu bytes is less then two chunks, using %lu elements.", p_object, p_object->memory_budget, output_chunk * 2);
+
+      buffer_size = output_chunk * 2;
+    }
+  }
+
+  return buffer_size;
+}
+
+//hold the node thread at a chunk boundary while dsp_pause asks, 1 if the node was ended instead.
+static int node_park(struct s_dsp_node * const p_object)
+{
+  int cancelled = 0;
+
+  unsigned long long enter_ns = 0;
+
+  struct timespec timeout;
+
+  //held is neither work nor a wait on a edge, it is left out of both.
+  enter_ns = stats_enter(p_object);
+
+  pthread_mutex_lock(&p_object->state_mutex);
+
+  p_object->paused = 1;
+
+  pthread_cond_broadcast(&p_object->state_cond);
+
+  //dsp_end can not signal the condition, the token is checked every poll.
+  while(atomic_load_explicit(&p_object->pause, memory_order_acquire) && !dsp_cancelIsSet(p_object->p_cancel))
+  {
+    node_timespec(DSP_NODE_POLL_MS, &timeout);
+
+    pthread_cond_timedwait(&p_object->state_cond, &p_object->state_mutex, &timeout);
+  }
+
+  p_object->paused = 0;
+
+  cancelled = dsp_cancelIsSet(p_object->p_cancel);
+
+  pthread_mutex_unlock(&p_object->state_mutex);
+
+  stats_leave(p_object, NULL, enter_ns);
+
+  return cancelled;
+}
+
+//wait till a node has read what it can of a port, the writer of it is paused.
+static void node_drain(struct s_dsp_node const * const p_object, unsigned int port, unsigned long timeout_ms)
+{
+  int ended = 0;
+
+  unsigned long available = 0;
+  unsigned long last      = 0;
+
+  unsigned long long deadline = 0;
+  unsigned long long changed  = 0;
+
+  struct timespec sleep_time = {0, 1000000L};
+
+  deadline = dsp_deadline(timeout_ms);
+
+  changed = stats_now();
+
+  last = dsp_ringAvailable(p_object->input_ports[port].p_ring_buffer, p_object->input_ports[port].reader, &ended);
+
+  //a locked read waits for its whole size, a tail shorter then one read never drains.
+  while(last && !ended && (stats_now() < deadline) && (stats_now() - changed < DSP_NODE_POLL_MS * 1000000ULL))
+  {
+    nanosleep(&sleep_time, NULL);
+
+    available = dsp_ringAvailable(p_object->input_ports[port].p_ring_buffer, p_object->input_ports[port].reader, &ended);
+
+    if(available != last) changed = stats_now();
+
+    last = available;
+  }
+}
+
+//absolute CLOCK_MONOTONIC time timeout_ms from now, for the timed waits on state_cond.
+static void node_timespec(unsigned long timeout_ms, struct timespec *p_time)
+{
+  clock_gettime(CLOCK_MONOTONIC, p_time);
+
+  if(timeout_ms == DSP_NODE_WAIT_FOREVER) return;
+
+  p_time->tv_sec += (time_t)(timeout_ms / 1000);
+
+  p_time->tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+
+  if(p_time->tv_nsec >= 1000000000L)
+  {
+    p_time->tv_sec++;
+
+    p_time->tv_nsec -= 1000000000L;
+  }
+}
+
+//add to a counter only the node thread stores to, relaxed so it stays off the bus.
+static void stats_add(atomic_ulong *p_counter, unsigned long value)
+{
+  atomic_store_explicit(p_counter, atomic_load_explicit(p_counter, memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+//monotonic time in nanoseconds for the start and stop stamps.
+static unsigned long long stats_now(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec;
+}
+
+//raw monotonic time in nanoseconds, not slewed by NTP, for the compute and wait split.
+static unsigned long long stats_raw(void)
+{
+  struct timespec now;
+
+  //read in the vDSO like CLOCK_MONOTONIC, no system call on the data path.
+  clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+
+  return (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec;
+}
+
+//time entering a input or output call, the time since the last one of a node thread is compute.
+static unsigned long long stats_enter(struct s_dsp_node * const p_object)
+{
+  unsigned long long now_ns   = 0;
+  unsigned long long clock_ns = 0;
+
+  now_ns = stats_raw();
+
+  clock_ns = atomic_load_explicit(&p_object->counters.clock_ns, memory_order_relaxed);
+
+  //pool tasks and fused chains have no clock, dsp_process times their work.
+  if(clock_ns && (now_ns > clock_ns)) atomic_store_explicit(&p_object->counters.compute_ns, atomic_load_explicit(&p_object->counters.compute_ns, memory_order_relaxed) + (now_ns - clock_ns), memory_order_relaxed);
+
+  return now_ns;
+}
+
+//time leaving a input or output call, the time in it is added to p_wait, NULL for none.
+static void stats_leave(struct s_dsp_node * const p_object, atomic_ullong *p_wait, unsigned long long enter_ns)
+{
+  unsigned long long now_ns = 0;
+
+  now_ns = stats_raw();
+
+  if(p_wait) atomic_store_explicit(p_wait, atomic_load_explicit(p_wait, memory_order_relaxed) + (now_ns - enter_ns), memory_order_relaxed);
+
+  if(atomic_load_explicit(&p_object->counters.clock_ns, memory_order_relaxed)) atomic_store_explicit(&p_object->counters.clock_ns, now_ns, memory_order_relaxed);
+}
+
+//return the size of the type in bytes.
+unsigned int get_type_size(enum e_binary_type type)
+{
+  switch(type)
+  {
+    case(DATA_S8):
+    case(DATA_U8):
+      return 1;
+    case(DATA_CS8):
+    case(DATA_S16):
+    case(DATA_U16):
+      return 2;
+    case(DATA_CS16):
+    case(DATA_S32):
+    case(DATA_U32):
+    case(DATA_FLOAT):
+      return 4;
+    case(DATA_CFLOAT):
+      return 8;
+    case(DATA_DOUBLE):
+      return 8;
+    case(DATA_CDOUBLE):
+      return 16;
+    default:
+      return 0;
+  }
+
+  return 0;
+}
+
+#ifdef DSP_NODE_LATENCY
+//mark the time the oldest pending input of a port entered the ring, behind counts back from the read position.
+static void latency_input(struct s_dsp_node * const p_object, unsigned int port, unsigned long behind)
+{
+  unsigned long long stamp_ns = 0;
+
+  stamp_ns = dsp_ringStampTime(p_object->input_ports[port].p_ring_buffer, p_object->input_ports[port].reader, behind, &p_object->input_ports[port].stamp_cursor);
+
+  if(!p_object->latency.pending_ns || (stamp_ns && (stamp_ns < p_object->latency.pending_ns))) p_object->latency.pending_ns = stamp_ns;
+}
+
+//record the pending input as output, from the ring to now.
+static void latency_output(struct s_dsp_node * const p_object)
+{
+  unsigned int bucket = 0;
+
+  unsigned long long latency_ns = 0;
+
+  if(!p_object->latency.pending_ns) return;
+
+  latency_ns = dsp_ringStampNow() - p_object->latency.pending_ns;
+
+  p_object->latency.pending_ns = 0;
+
+  bucket = latency_bucket(latency_ns);
+
+  //single writer, a plain load and store is enough and keeps the lock prefix out of the hot loop.
+  atomic_store_explicit(&p_object->latency.buckets[bucket], atomic_load_explicit(&p_object->latency.buckets[bucket], memory_order_relaxed) + 1, memory_order_relaxed);
+
+  atomic_store_explicit(&p_object->latency.count, atomic_load_explicit(&p_object->latency.count, memory_order_relaxed) + 1, memory_order_relaxed);
+
+  if(latency_ns > atomic_load_explicit(&p_object->latency.max_ns, memory_order_relaxed)) atomic_store_explicit(&p_object->latency.max_ns, latency_ns, memory_order_relaxed);
+}
+
+//histogram bucket of a latency.
+static unsigned int latency_bucket(unsigned long long latency_ns)
+{
+  unsigned int exponent = 0;
+
+  //small values get a bucket each.
+  if(latency_ns < (1ULL << DSP_LATENCY_SUB_BITS)) return (unsigned int)latency_ns;
+
+  exponent = 63U - (unsigned int)__builtin_clzll(latency_ns);
+
+  return ((exponent - DSP_LATENCY_SUB_BITS + 1U) << DSP_LATENCY_SUB_BITS) | (unsigned int)((latency_ns >> (exponent - DSP_LATENCY_SUB_BITS)) & ((1U << DSP_LATENCY_SUB_BITS) - 1U));
+}
+
+//largest latency in a histogram bucket.
+static unsigned long long latency_bucket_max(unsigned int bucket)
+{
+  unsigned int exponent = 0;
+
+  if(bucket < (1U << DSP_LATENCY_SUB_BITS)) return bucket;
+
+  exponent = (bucket >> DSP_LATENCY_SUB_BITS) + DSP_LATENCY_SUB_BITS - 1U;
+
+  return (1ULL << exponent) + ((unsigned long long)((bucket & ((1U << DSP_LATENCY_SUB_BITS) - 1U)) + 1U) << (exponent - DSP_LATENCY_SUB_BITS)) - 1ULL;
 }
+#endif
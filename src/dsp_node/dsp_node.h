@@ -10,6 +10,8 @@
 #define __dsp_node
 
 // includes
+#include <signal.h>
+
 #include "dsp_node_types.h"
 
 #ifdef __cplusplus
@@ -19,13 +21,29 @@ extern "C" {
 /**************************************************************************//**
   * @brief Allocate the dsp_node struct.
   *
-  * @param buffer_size size of ringbuffer total
-  * @param chunk_size size to read or write from ringbuffer
+  * @param buffer_size size of ringbuffer total, DSP_SIZE_AUTO to size it at
+  * setup from the declared output rate and the latency target.
+  * @param chunk_size size to read or write from ringbuffer, DSP_SIZE_AUTO to
+  * size it at setup from the declared rates and granularity.
   *
   * @return allocated base dsp node in need of setup.
   ****************************************************************************/
 struct s_dsp_node * dsp_create(unsigned long buffer_size, unsigned long chunk_size);
 
+/**************************************************************************//**
+  * @brief Allocate the dsp_node struct in the context of a pipeline. It logs
+  * to the logger of the context and dsp_kill stops only that context.
+  * dsp_create is this with the process default context.
+  *
+  * @param p_context context from dsp_contextCreate, NULL for the default.
+  * @param buffer_size size of ringbuffer total, DSP_SIZE_AUTO as dsp_create.
+  * @param chunk_size size to read or write from ringbuffer, DSP_SIZE_AUTO as
+  * dsp_create.
+  *
+  * @return allocated base dsp node in need of setup.
+  ****************************************************************************/
+struct s_dsp_node *dsp_createInContext(struct s_dsp_context * const p_context, unsigned long buffer_size, unsigned long chunk_size);
+
 /**************************************************************************//**
   * @brief Setup dsp_node with specifics to it's processing functionality.
   *
@@ -39,6 +57,118 @@ struct s_dsp_node * dsp_create(unsigned long buffer_size, unsigned long chunk_si
   ****************************************************************************/
 int dsp_setup(struct s_dsp_node * const p_object, init_callback init_call, pthread_function thread_func, free_callback free_call, void *p_init_args);
 
+/**************************************************************************//**
+  * @brief Set the backend of the output ring buffer, call before dsp_setup.
+  * DSP_RING_LOCKED (default) allows any number of consumers. DSP_RING_SPSC is
+  * lock free and allows a single consumer, for edges with one producer and one
+  * consumer thread.
+  *
+  * @param p_object struct s_dsp_node object from dsp_create
+  * @param ring_type DSP_RING_LOCKED or DSP_RING_SPSC
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_setRingType(struct s_dsp_node * const p_object, enum e_dsp_ring_type ring_type);
+
+/**************************************************************************//**
+  * @brief Set the latency target and memory budget DSP_SIZE_AUTO sizes are
+  * computed from, call before dsp_setup. The output ring holds latency_us of
+  * output and a chunk is a DSP_SIZE_CHUNKS fraction of it.
+  *
+  * @param p_object struct s_dsp_node object from dsp_create
+  * @param latency_us latency target in microseconds, DSP_SIZE_LATENCY_US by default.
+  * @param memory_budget most bytes the output ring may use, 0 for no limit.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_setSizing(struct s_dsp_node * const p_object, unsigned long latency_us, unsigned long memory_budget);
+
+/**************************************************************************//**
+  * @brief Declare the nominal rates of a node that can not know them itself
+  * (file, tcp), call before dsp_setup. init_callback may set them instead.
+  * A node with no input rate takes the output rate of its port 0 input.
+  *
+  * @param p_object struct s_dsp_node object from dsp_create
+  * @param input_rate input elements per second, 0 unknown.
+  * @param output_rate output elements per second, 0 unknown.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_setRate(struct s_dsp_node * const p_object, double input_rate, double output_rate);
+
+/**************************************************************************//**
+  * @brief Set the cpus the node thread may run on, applied by dsp_start before
+  * the thread runs.
+  *
+  * @param p_object struct s_dsp_node object from dsp_create
+  * @param p_cpuset cpus to pin to, NULL to inherit from the creating thread.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_setAffinity(struct s_dsp_node * const p_object, cpu_set_t const * const p_cpuset);
+
+/**************************************************************************//**
+  * @brief Set the scheduling policy and priority of the node thread, applied
+  * by dsp_start before the thread runs. Real time policies need permission
+  * (CAP_SYS_NICE or rtprio limits), without it the thread starts with the
+  * inherited policy and the failure is logged.
+  *
+  * @param p_object struct s_dsp_node object from dsp_create
+  * @param policy SCHED_FIFO, SCHED_RR or SCHED_OTHER
+  * @param priority priority in the range of the policy, 0 for SCHED_OTHER.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_setSched(struct s_dsp_node * const p_object, int policy, int priority);
+
+/**************************************************************************//**
+  * @brief Set the allocation policy of the output ring and the scratch buffers
+  * the node allocates with dsp_allocBuffer, call before dsp_setup. Huge pages,
+  * NUMA binding and mlock or prefault keep large buffers out of the TLB and
+  * page fault path. DSP_ALLOC_NUMA_CPU binds to the node of the first cpu
+  * from dsp_setAffinity, which must then be called before dsp_setup too.
+  *
+  * @param p_object struct s_dsp_node object from dsp_create
+  * @param flags DSP_ALLOC_* flags or'd together, DSP_ALLOC_DEFAULT for malloc.
+  * @param numa_node NUMA node for DSP_ALLOC_NUMA, or DSP_ALLOC_NUMA_CPU.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_setAllocPolicy(struct s_dsp_node * const p_object, unsigned int flags, int numa_node);
+
+/**************************************************************************//**
+  * @brief Allocate a scratch buffer with the allocation policy of the node,
+  * for init_callback buffers that live as long as the node.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param bytes number of bytes.
+  *
+  * @return memory, NULL on error.
+  ****************************************************************************/
+void *dsp_allocBuffer(struct s_dsp_node * const p_object, unsigned long bytes);
+
+/**************************************************************************//**
+  * @brief Free a scratch buffer from dsp_allocBuffer.
+  *
+  * @param p_object struct s_dsp_node object it was allocated with.
+  * @param p_buffer buffer to free, NULL is ignored.
+  * @param bytes number of bytes it was allocated with.
+  ****************************************************************************/
+void dsp_freeBuffer(struct s_dsp_node * const p_object, void *p_buffer, unsigned long bytes);
+
+/**************************************************************************//**
+  * @brief Insert a converter when a input is set with a different type, call
+  * before dsp_setInput. The converter belongs to the node, dsp_start, dsp_wait,
+  * dsp_end and dsp_cleanup of the node include it. In a graph it is added to
+  * the graph as a node instead, so it can be fused or pooled.
+  *
+  * @param p_object struct s_dsp_node object from dsp_create
+  * @param enable 1 insert converters, 0 only warn on a mismatch (default).
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_setAutoConvert(struct s_dsp_node * const p_object, int enable);
+
 /**************************************************************************//**
   * @brief Set an input node to the current node specified by p_object.
   *
@@ -49,6 +179,483 @@ int dsp_setup(struct s_dsp_node * const p_object, init_callback init_call, pthre
   ****************************************************************************/
 int dsp_setInput(struct s_dsp_node * const p_object, struct s_dsp_node const * const p_input_object);
 
+/**************************************************************************//**
+  * @brief Set an input node to a input port of the current node specified by
+  * p_object. Port 0 is the same as dsp_setInput.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param port input port number, less then num_input_ports set by init_callback.
+  * @param p_input_object struct s_dsp_node object to set as a input to the port.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_setInputPort(struct s_dsp_node * const p_object, unsigned int port, struct s_dsp_node const * const p_input_object);
+
+/**************************************************************************//**
+  * @brief Read from the input ring buffer of the node. Blocks till size
+  * elements are available or the input has ended.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param p_buffer buffer to read elements into
+  * @param size number of elements to read
+  *
+  * @return number of elements read, 0 at end of stream.
+  ****************************************************************************/
+unsigned long dsp_readInput(struct s_dsp_node * const p_object, void *p_buffer, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Deadline for the timed read, write, reserve and peek calls. A node
+  * cancelled with dsp_end does not wait for it, its timed calls return
+  * DSP_NODE_TIMEOUT at once.
+  *
+  * @param timeout_ms milliseconds from now, DSP_NODE_WAIT_FOREVER never passes.
+  *
+  * @return absolute deadline on the monotonic clock.
+  ****************************************************************************/
+unsigned long long dsp_deadline(unsigned long timeout_ms);
+
+/**************************************************************************//**
+  * @brief Read from the input ring buffer of the node. Blocks till size
+  * elements are available, the input has ended or the deadline passes.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param p_buffer buffer to read elements into
+  * @param size number of elements to read
+  * @param deadline from dsp_deadline
+  *
+  * @return number of elements read, 0 at end of stream, DSP_NODE_TIMEOUT if
+  * the deadline passed first (nothing is read).
+  ****************************************************************************/
+unsigned long dsp_readInputTimed(struct s_dsp_node * const p_object, void *p_buffer, unsigned long size, unsigned long long deadline);
+
+/**************************************************************************//**
+  * @brief Read from the input ring buffer of a input port of the node. Blocks
+  * till size elements are available or the input has ended.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param port input port number
+  * @param p_buffer buffer to read elements into
+  * @param size number of elements to read
+  *
+  * @return number of elements read, 0 at end of stream.
+  ****************************************************************************/
+unsigned long dsp_readInputPort(struct s_dsp_node * const p_object, unsigned int port, void *p_buffer, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Read from the input ring buffer of a input port of the node. Blocks
+  * till size elements are available, the input has ended or the deadline passes.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param port input port number
+  * @param p_buffer buffer to read elements into
+  * @param size number of elements to read
+  * @param deadline from dsp_deadline
+  *
+  * @return number of elements read, 0 at end of stream, DSP_NODE_TIMEOUT if
+  * the deadline passed first (nothing is read).
+  ****************************************************************************/
+unsigned long dsp_readInputPortTimed(struct s_dsp_node * const p_object, unsigned int port, void *p_buffer, unsigned long size, unsigned long long deadline);
+
+/**************************************************************************//**
+  * @brief Read the same number of elements from every connected input port.
+  * Blocks till every port has size elements or one of them has ended, so the
+  * chunks of all ports line up.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param pp_buffers array of num_input_ports buffers, one per port, each
+  * holding size elements of the port type.
+  * @param size number of elements to read from each port
+  *
+  * @return number of elements read from each port, 0 when any port has ended.
+  ****************************************************************************/
+unsigned long dsp_readInputAll(struct s_dsp_node * const p_object, void * const *pp_buffers, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Read the same number of elements from every connected input port,
+  * or nothing if the deadline passes first.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param pp_buffers array of num_input_ports buffers, one per port.
+  * @param size number of elements to read from each port
+  * @param deadline from dsp_deadline
+  *
+  * @return number of elements read from each port, 0 when any port has ended,
+  * DSP_NODE_TIMEOUT if the deadline passed first (nothing is read).
+  ****************************************************************************/
+unsigned long dsp_readInputAllTimed(struct s_dsp_node * const p_object, void * const *pp_buffers, unsigned long size, unsigned long long deadline);
+
+/**************************************************************************//**
+  * @brief Write to the output ring buffer of the node. Blocks till all
+  * elements fit, the slowest consumer sets the pace.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param p_buffer buffer of elements to write
+  * @param size number of elements to write
+  *
+  * @return number of elements written, less then size if no consumers are left.
+  ****************************************************************************/
+unsigned long dsp_writeOutput(struct s_dsp_node * const p_object, void const *p_buffer, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Write to the output ring buffer of the node. Blocks till all
+  * elements fit or the deadline passes.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param p_buffer buffer of elements to write
+  * @param size number of elements to write
+  * @param deadline from dsp_deadline
+  *
+  * @return number of elements written, less then size if no consumers are
+  * left or the deadline passed part way (write the rest again).
+  * DSP_NODE_TIMEOUT if the deadline passed before any was written.
+  ****************************************************************************/
+unsigned long dsp_writeOutputTimed(struct s_dsp_node * const p_object, void const *p_buffer, unsigned long size, unsigned long long deadline);
+
+/**************************************************************************//**
+  * @brief Write all elements to the output ring buffer of the node, a poll
+  * period at a time so the node sees p_kill and its cancel between tries.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param p_buffer buffer of elements to write
+  * @param size number of elements to write
+  * @param p_kill flag that stops the write when set (kill_thread), NULL for none
+  *
+  * @return number of elements written, less then size if no consumers are
+  * left, the node was cancelled or p_kill was set.
+  ****************************************************************************/
+unsigned long dsp_writeOutputAll(struct s_dsp_node * const p_object, void const *p_buffer, unsigned long size, volatile sig_atomic_t const *p_kill);
+
+/**************************************************************************//**
+  * @brief Reserve space in the output ring buffer of the node to write into
+  * directly, no staging buffer or copy. Blocks till the space is free.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param pp_buffer returns a pointer into the output ring buffer
+  * @param size max number of elements to reserve
+  *
+  * @return number of elements reserved, can be less then size at the wrap of
+  * the ring. 0 if no consumers are left.
+  ****************************************************************************/
+unsigned long dsp_reserveOutput(struct s_dsp_node * const p_object, void **pp_buffer, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Reserve space in the output ring buffer of the node to write into
+  * directly. Blocks till the space is free or the deadline passes.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param pp_buffer returns a pointer into the output ring buffer
+  * @param size max number of elements to reserve
+  * @param deadline from dsp_deadline
+  *
+  * @return number of elements reserved, 0 if no consumers are left,
+  * DSP_NODE_TIMEOUT if the deadline passed first.
+  ****************************************************************************/
+unsigned long dsp_reserveOutputTimed(struct s_dsp_node * const p_object, void **pp_buffer, unsigned long size, unsigned long long deadline);
+
+/**************************************************************************//**
+  * @brief Commit elements written to reserved output space, consumers can
+  * read them after this.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param size number of elements to commit, no more then reserved.
+  ****************************************************************************/
+void dsp_commitOutput(struct s_dsp_node * const p_object, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Peek at elements in the input ring buffer of the node without
+  * copying them. Blocks till they are available or the input has ended.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param pp_buffer returns a pointer into the input ring buffer
+  * @param size max number of elements to peek at
+  *
+  * @return number of elements available, can be less then size at the wrap of
+  * the ring. 0 at end of stream.
+  ****************************************************************************/
+unsigned long dsp_peekInput(struct s_dsp_node * const p_object, void const **pp_buffer, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Peek at elements in the input ring buffer of the node without
+  * copying them. Blocks till they are available, the input has ended or the
+  * deadline passes.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param pp_buffer returns a pointer into the input ring buffer
+  * @param size max number of elements to peek at
+  * @param deadline from dsp_deadline
+  *
+  * @return number of elements available, 0 at end of stream,
+  * DSP_NODE_TIMEOUT if the deadline passed first.
+  ****************************************************************************/
+unsigned long dsp_peekInputTimed(struct s_dsp_node * const p_object, void const **pp_buffer, unsigned long size, unsigned long long deadline);
+
+/**************************************************************************//**
+  * @brief Peek at elements in the input ring buffer of a input port without
+  * copying them.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param port input port number
+  * @param pp_buffer returns a pointer into the input ring buffer
+  * @param size max number of elements to peek at
+  *
+  * @return number of elements available, 0 at end of stream.
+  ****************************************************************************/
+unsigned long dsp_peekInputPort(struct s_dsp_node * const p_object, unsigned int port, void const **pp_buffer, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Peek at elements in the input ring buffer of a input port without
+  * copying them, or nothing if the deadline passes first.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param port input port number
+  * @param pp_buffer returns a pointer into the input ring buffer
+  * @param size max number of elements to peek at
+  * @param deadline from dsp_deadline
+  *
+  * @return number of elements available, 0 at end of stream,
+  * DSP_NODE_TIMEOUT if the deadline passed first.
+  ****************************************************************************/
+unsigned long dsp_peekInputPortTimed(struct s_dsp_node * const p_object, unsigned int port, void const **pp_buffer, unsigned long size, unsigned long long deadline);
+
+/**************************************************************************//**
+  * @brief Release elements from a input peek, the input node can reuse the space.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param size number of elements to release, no more then peeked at.
+  ****************************************************************************/
+void dsp_releaseInput(struct s_dsp_node * const p_object, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Release elements from a input port peek.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param port input port number
+  * @param size number of elements to release, no more then peeked at.
+  ****************************************************************************/
+void dsp_releaseInputPort(struct s_dsp_node * const p_object, unsigned int port, unsigned long size);
+
+/**************************************************************************//**
+  * @brief End reading the input, releases this nodes read cursor on every
+  * input port so the input nodes no longer wait on it. Other consumers are
+  * not effected.
+  *
+  * @param p_object struct s_dsp_node object
+  ****************************************************************************/
+void dsp_endInput(struct s_dsp_node * const p_object);
+
+/**************************************************************************//**
+  * @brief End reading a single input port, releases this nodes read cursor
+  * on that port only.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param port input port number
+  ****************************************************************************/
+void dsp_endInputPort(struct s_dsp_node * const p_object, unsigned int port);
+
+/**************************************************************************//**
+  * @brief End writing the output, consumers read what is left then stop.
+  *
+  * @param p_object struct s_dsp_node object
+  ****************************************************************************/
+void dsp_endOutput(struct s_dsp_node * const p_object);
+
+/**************************************************************************//**
+  * @brief Snapshot of the latency histogram of a node, safe to call while the
+  * node runs. Needs the library built with DSP_NODE_LATENCY.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param p_stats returns count, p50, p99, p999 and max in nanoseconds.
+  *
+  * @return 0 no error, non-zero indicates error or latency compiled out.
+  ****************************************************************************/
+int dsp_getLatency(struct s_dsp_node const * const p_object, struct s_dsp_latency_stats * const p_stats);
+
+/**************************************************************************//**
+  * @brief Move a node to a later lifecycle state and wake anyone waiting on it.
+  * A state before the current one is ignored, except DSP_NODE_RUNNING so a
+  * stopped node can be started again. DSP_NODE_DRAINING is only taken from
+  * DSP_NODE_RUNNING. dsp_setup, dsp_start and the node
+  * reads and writes do this, for schedulers that run the node without its
+  * own thread (pool, fused chains).
+  *
+  * @param p_object struct s_dsp_node object
+  * @param state state to move to.
+  ****************************************************************************/
+void dsp_setState(struct s_dsp_node * const p_object, enum e_dsp_node_state state);
+
+/**************************************************************************//**
+  * @brief Current lifecycle state of a node.
+  *
+  * @param p_object struct s_dsp_node object
+  *
+  * @return state of the node, DSP_NODE_STOPPED if p_object is NULL.
+  ****************************************************************************/
+enum e_dsp_node_state dsp_getState(struct s_dsp_node * const p_object);
+
+/**************************************************************************//**
+  * @brief Sleep till a node reaches a lifecycle state or any state after it.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param state state to wait for.
+  * @param timeout_ms max time to wait in milliseconds, DSP_NODE_WAIT_FOREVER
+  * for no timeout.
+  *
+  * @return 0 state reached, ETIMEDOUT on timeout, non-zero on error.
+  ****************************************************************************/
+int dsp_waitState(struct s_dsp_node * const p_object, enum e_dsp_node_state state, unsigned long timeout_ms);
+
+/**************************************************************************//**
+  * @brief Snapshot of the counters of a node, safe to call from any thread
+  * while the node runs. Only relaxed loads, the node thread is never slowed.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param p_stats returns items, chunks, blocked events, errors, start/stop
+  * times and the time split between compute and waiting on input and output.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_getStats(struct s_dsp_node const * const p_object, struct s_dsp_stats * const p_stats);
+
+/**************************************************************************//**
+  * @brief Fill level telemetry of the edge feeding a input port, safe to call
+  * from any thread while the node runs. A edge with a high full fraction has
+  * a slow consumer (this node), a high empty fraction a starved producer.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param port input port of the edge, 0 for single input nodes.
+  * @param p_fill returns size, fill, high water, full, empty and elapsed time.
+  *
+  * @return 0 no error, non-zero indicates error or no edge on the port.
+  ****************************************************************************/
+int dsp_getInputFill(struct s_dsp_node const * const p_object, unsigned int port, struct s_dsp_ring_fill * const p_fill);
+
+/**************************************************************************//**
+  * @brief Fill level telemetry of the output ring for one of its readers,
+  * safe to call from any thread while the node runs. Full time is shared by
+  * every reader, the writer waits on the slowest.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param reader reader of the output ring, 0 for the first consumer.
+  * @param p_fill returns size, fill, high water, full, empty and elapsed time.
+  *
+  * @return 0 no error, non-zero indicates error or no output consumer.
+  ****************************************************************************/
+int dsp_getOutputFill(struct s_dsp_node const * const p_object, unsigned int reader, struct s_dsp_ring_fill * const p_fill);
+
+/**************************************************************************//**
+  * @brief Tag a element of the output stream. Called by the node thread
+  * before the tagged element is written or committed, tags are in offset order.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param p_tag tag to add, offset from dsp_getOutputOffset.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_addOutputTag(struct s_dsp_node * const p_object, struct s_dsp_tag const * const p_tag);
+
+/**************************************************************************//**
+  * @brief Absolute offset of the next element the node writes or commits.
+  *
+  * @param p_object struct s_dsp_node object
+  *
+  * @return output offset, elements after a reserve are this plus their index.
+  ****************************************************************************/
+unsigned long dsp_getOutputOffset(struct s_dsp_node * const p_object);
+
+/**************************************************************************//**
+  * @brief Get the tags on the next size elements of input port 0.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param size number of elements from the read position, the size of the next read or peek.
+  * @param p_tags returns the tags in offset order.
+  * @param max number of tags p_tags holds.
+  *
+  * @return number of tags returned, each tag is returned once.
+  ****************************************************************************/
+unsigned long dsp_getInputTags(struct s_dsp_node * const p_object, unsigned long size, struct s_dsp_tag * const p_tags, unsigned long max);
+
+/**************************************************************************//**
+  * @brief Get the tags on the next size elements of a input port.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param port input port number.
+  * @param size number of elements from the read position, the size of the next read or peek.
+  * @param p_tags returns the tags in offset order.
+  * @param max number of tags p_tags holds.
+  *
+  * @return number of tags returned, each tag is returned once.
+  ****************************************************************************/
+unsigned long dsp_getInputPortTags(struct s_dsp_node * const p_object, unsigned int port, unsigned long size, struct s_dsp_tag * const p_tags, unsigned long max);
+
+/**************************************************************************//**
+  * @brief Absolute offset of the next element a input port reads, element i
+  * of a read or peek is at this plus i.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param port input port number.
+  *
+  * @return input offset.
+  ****************************************************************************/
+unsigned long dsp_getInputOffset(struct s_dsp_node * const p_object, unsigned int port);
+
+/**************************************************************************//**
+  * @brief Count elements moved by a node outside of the read and write calls,
+  * for schedulers that pass blocks between nodes without rings (fused chains).
+  * Call from the thread running the node only.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param items_in number of elements consumed, 0 for none.
+  * @param items_out number of elements produced, 0 for none.
+  ****************************************************************************/
+void dsp_statsAdd(struct s_dsp_node * const p_object, unsigned long items_in, unsigned long items_out);
+
+/**************************************************************************//**
+  * @brief Count a error hit by a node while running. Call from the thread
+  * running the node only.
+  *
+  * @param p_object struct s_dsp_node object
+  ****************************************************************************/
+void dsp_statsError(struct s_dsp_node * const p_object);
+
+/**************************************************************************//**
+  * @brief Stamp the time a node started running. dsp_start does this, for
+  * schedulers that run the node without its own thread (pool, fused chains).
+  *
+  * @param p_object struct s_dsp_node object
+  ****************************************************************************/
+void dsp_statsStart(struct s_dsp_node * const p_object);
+
+/**************************************************************************//**
+  * @brief Stamp the time a node stopped running. dsp_start does this when the
+  * thread function returns, for schedulers that run the node without its own
+  * thread (pool, fused chains).
+  *
+  * @param p_object struct s_dsp_node object
+  ****************************************************************************/
+void dsp_statsStop(struct s_dsp_node * const p_object);
+
+/**************************************************************************//**
+  * @brief Run the process_call of a node and count the time in it as compute,
+  * for schedulers that run the node without its own thread (pool, fused
+  * chains). A node thread is timed between its input and output calls.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param p_process input and output of the call.
+  *
+  * @return 0 call again, non-zero the node is finished or has no process_call.
+  ****************************************************************************/
+int dsp_process(struct s_dsp_node * const p_object, struct s_dsp_process * const p_process);
+
+/**************************************************************************//**
+  * @brief Size of a data type, for init callbacks that size buffers before
+  * dsp_setup fills in input_type_size and output_type_size.
+  *
+  * @param type data type.
+  *
+  * @return size in bytes, 0 for DATA_INVALID or DATA_UNKNOWN.
+  ****************************************************************************/
+unsigned int get_type_size(enum e_binary_type type);
+
 /**************************************************************************//**
   * @brief Start the thread using pthread function passed to create.
   *
@@ -68,7 +675,10 @@ int dsp_start(struct s_dsp_node * const p_object);
 int dsp_wait(struct s_dsp_node const * const p_object);
 
 /**************************************************************************//**
-  * @brief Force the pthread to end
+  * @brief Force the pthread to end. Sets the cancellation token of the node
+  * and wakes its waits on rings and fds, timed calls return DSP_NODE_TIMEOUT
+  * and untimed ones 0 (end of stream) so the thread leaves its loop at once.
+  * Converters of the input ports are ended with it.
   *
   * @param p_object struct s_dsp_node object
   *
@@ -76,6 +686,128 @@ int dsp_wait(struct s_dsp_node const * const p_object);
   ****************************************************************************/
 int dsp_end(struct s_dsp_node const * const p_object);
 
+/**************************************************************************//**
+  * @brief Stop every node in the context of a node, for a node that hit a
+  * error the pipeline can not go on from. Other pipelines keep running,
+  * kill_thread is only for ctrl+c of the whole process.
+  *
+  * @param p_object struct s_dsp_node object
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_kill(struct s_dsp_node const * const p_object);
+
+/**************************************************************************//**
+  * @brief Check if a node was ended with dsp_end, for the loop of a node
+  * thread or process callback. One atomic load.
+  *
+  * @param p_object struct s_dsp_node object
+  *
+  * @return 1 cancelled, 0 not.
+  ****************************************************************************/
+int dsp_isCancelled(struct s_dsp_node const * const p_object);
+
+/**************************************************************************//**
+  * @brief File descriptor that is readable once the node is cancelled, for
+  * nodes with a poll or select loop of their own.
+  *
+  * @param p_object struct s_dsp_node object
+  *
+  * @return eventfd of the cancellation token, -1 on error.
+  ****************************************************************************/
+int dsp_getCancelFd(struct s_dsp_node const * const p_object);
+
+/**************************************************************************//**
+  * @brief Poll fds of a node (sockets, sound devices, files) till one is
+  * ready, the node is cancelled or the deadline passes. With no fds it
+  * sleeps till the deadline unless cancelled first.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param p_fds fds to poll, revents are filled in like poll. NULL for none.
+  * @param num_fds number of fds, at most DSP_CANCEL_POLL_MAX.
+  * @param deadline from dsp_deadline
+  *
+  * @return number of fds with revents, 0 cancelled or the deadline passed,
+  * -1 on error.
+  ****************************************************************************/
+int dsp_poll(struct s_dsp_node const * const p_object, struct pollfd *p_fds, unsigned int num_fds, unsigned long long deadline);
+
+/**************************************************************************//**
+  * @brief Hold a running node at its next input read or peek, a chunk
+  * boundary, and wait till it is there. Its last output is written and it
+  * holds no peek, so its edges can be rewired. Sources have no input read
+  * and can not be paused. dsp_end still ends a paused node.
+  *
+  * @param p_object struct s_dsp_node object
+  * @param timeout_ms max time to wait in milliseconds, DSP_NODE_WAIT_FOREVER
+  * waits till the node gets there.
+  *
+  * @return 0 paused, non-zero the node was not running, ended its stream or
+  * timed out, it is not held.
+  ****************************************************************************/
+int dsp_pause(struct s_dsp_node * const p_object, unsigned long timeout_ms);
+
+/**************************************************************************//**
+  * @brief Let a node held by dsp_pause go on, it reads from the ports it has
+  * now.
+  *
+  * @param p_object struct s_dsp_node object
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_resume(struct s_dsp_node * const p_object);
+
+/**************************************************************************//**
+  * @brief Replace a node with a new one, the nodes around it keep running.
+  * The old node is paused, the new one takes its input read cursors and
+  * converters and writes its output ring, so neither side sees a new edge
+  * and nothing on the edges is lost. Only what the old node kept inside it
+  * (filter state) is. The old node is then ended and joined, it is left
+  * with no edges for the caller to dsp_cleanup. A node not running is only
+  * rewired.
+  *
+  * @param p_old node to replace, a thread node running or not started.
+  * @param p_new node made with dsp_createInContext and dsp_setup, not
+  * connected or started, with the same input port types and output type.
+  * @param timeout_ms max time to wait for the old node to pause.
+  *
+  * @return 0 no error, non-zero indicates error and the old node runs on.
+  ****************************************************************************/
+int dsp_replace(struct s_dsp_node * const p_old, struct s_dsp_node * const p_new, unsigned long timeout_ms);
+
+/**************************************************************************//**
+  * @brief Insert a node in front of a input port. The node of the port is
+  * paused, the new node takes the read cursor of the port and the port
+  * reads the new node from its first element, nothing is lost.
+  *
+  * @param p_new node made with dsp_createInContext and dsp_setup, not
+  * connected or started, with one input port and a output of the port type.
+  * @param p_dst node with the connected input port, a thread node.
+  * @param port input port of p_dst.
+  * @param timeout_ms max time to wait for p_dst to pause.
+  *
+  * @return 0 no error, non-zero indicates error and nothing changed.
+  ****************************************************************************/
+int dsp_insert(struct s_dsp_node * const p_new, struct s_dsp_node * const p_dst, unsigned int port, unsigned long timeout_ms);
+
+/**************************************************************************//**
+  * @brief Remove a node with one input from in front of the port it feeds,
+  * the port reads its input instead. The old node is paused and the port
+  * reads what it wrote first, a tail shorter then one read of the port and
+  * the state inside the old node are lost. The old node is ended and
+  * joined, it is left with no edges for the caller to dsp_cleanup. Its
+  * output must feed only p_dst.
+  *
+  * @param p_old node to remove, a thread node running or not started.
+  * @param p_dst node reading the output of p_old.
+  * @param port input port of p_dst reading p_old.
+  * @param timeout_ms max time to wait for each node to pause and the port
+  * to read what is left.
+  *
+  * @return 0 no error, non-zero indicates error and nothing changed.
+  ****************************************************************************/
+int dsp_remove(struct s_dsp_node * const p_old, struct s_dsp_node * const p_dst, unsigned int port, unsigned long timeout_ms);
+
 /**************************************************************************//**
   * @brief remove all allocations from create
   *
@@ -10,12 +10,21 @@
 #define __dsp_node_types
 
 // includes
-#include "ringBuffer.h"
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "dsp_ring.h"
+#include "dsp_cancel.h"
+#include "dsp_context.h"
 #include "logger.h"
 
+struct s_dsp_process;
+
 typedef int (*init_callback)(void *p_init_args, void *p_object);
 typedef void* (*pthread_function)(void *p_data);
 typedef int (*free_callback)(void *p_object);
+typedef int (*process_callback)(void *p_object, struct s_dsp_process *p_process);
 
 /**
  * @enum e_binary_type
@@ -23,6 +32,356 @@ typedef int (*free_callback)(void *p_object);
  */
 enum e_binary_type {DATA_INVALID=-1, DATA_S8=0, DATA_U8, DATA_CS8, DATA_S16, DATA_U16, DATA_CS16, DATA_S32, DATA_U32, DATA_FLOAT, DATA_CFLOAT, DATA_DOUBLE, DATA_CDOUBLE, DATA_UNKNOWN};
 
+/**
+ * @enum e_dsp_node_state
+ * Lifecycle of a node, in order. DRAINING means the stream ended and the node is finishing what is left.
+ */
+enum e_dsp_node_state {DSP_NODE_CREATED=0, DSP_NODE_SETUP, DSP_NODE_RUNNING, DSP_NODE_DRAINING, DSP_NODE_STOPPED};
+
+/**
+ * @def DSP_NODE_WAIT_FOREVER
+ * Timeout for dsp_waitState that never times out.
+ */
+#define DSP_NODE_WAIT_FOREVER (~0UL)
+
+/**
+ * @def DSP_NODE_TIMEOUT
+ * Returned by the timed read, write, reserve and peek calls when the deadline passed first.
+ */
+#define DSP_NODE_TIMEOUT DSP_RING_TIMEOUT
+
+/**
+ * @def DSP_NODE_POLL_MS
+ * Longest a node thread waits on a edge before it checks kill_thread and does periodic work.
+ * A node cancelled with dsp_end does not wait it out, its waits wake at once.
+ */
+#define DSP_NODE_POLL_MS 100
+
+/**
+ * @def DSP_SIZE_AUTO
+ * Buffer or chunk size for dsp_create that is computed at setup from the declared rates.
+ */
+#define DSP_SIZE_AUTO 0
+
+/**
+ * @def DSP_SIZE_LATENCY_US
+ * Default latency target in microseconds a auto sized output ring holds.
+ */
+#define DSP_SIZE_LATENCY_US 100000
+
+/**
+ * @def DSP_SIZE_CHUNKS
+ * Number of chunks a auto sized ring holds, a chunk is the latency target over this.
+ */
+#define DSP_SIZE_CHUNKS 4
+
+/**
+ * @def DSP_SIZE_FALLBACK
+ * Auto chunk size in elements of a node with no declared rate.
+ */
+#define DSP_SIZE_FALLBACK (1 << 16)
+
+/**
+ * @struct s_dsp_process
+ * @brief Input and output of a single process_callback call, used when nodes
+ * are fused into one thread and pass scratch blocks instead of ring buffers.
+ */
+struct s_dsp_process
+{
+  /**
+   * @var s_dsp_process::p_input
+   * input elements, NULL for nodes without input.
+   */
+  void const *p_input;
+  /**
+   * @var s_dsp_process::input_size
+   * number of elements in p_input, the callback sets it to the number consumed.
+   */
+  unsigned long input_size;
+  /**
+   * @var s_dsp_process::p_output
+   * space for output elements, NULL for nodes without output.
+   */
+  void *p_output;
+  /**
+   * @var s_dsp_process::output_size
+   * number of elements p_output can hold, the callback sets it to the number produced.
+   */
+  unsigned long output_size;
+  /**
+   * @var s_dsp_process::end_of_input
+   * 1 no more input will come, process what is left. 0 more input may come.
+   */
+  int end_of_input;
+};
+
+/**
+ * @def DSP_NODE_MAX_INPUTS
+ * Max number of input ports a node can have.
+ */
+#define DSP_NODE_MAX_INPUTS 8
+
+/**
+ * @struct s_dsp_input_port
+ * @brief Contains data for a single input of a DSP node.
+ */
+struct s_dsp_input_port
+{
+  /**
+   * @var s_dsp_input_port::p_ring_buffer
+   * input data ring buffer set by set input port.
+   */
+  struct s_dsp_ring *p_ring_buffer;
+  /**
+   * @var s_dsp_input_port::reader
+   * read cursor of this port in the input ring buffer, each consumer of a node has its own.
+   */
+  unsigned int reader;
+  /**
+   * @var s_dsp_input_port::type
+   * enum that specifies the port data type, port 0 is always input_type.
+   */
+  enum e_binary_type type;
+  /**
+   * @var s_dsp_input_port::type_size
+   * size in bytes of the port type
+   */
+  unsigned int type_size;
+  /**
+   * @var s_dsp_input_port::p_convert
+   * converter inserted by set input port when auto_convert is on and the types differ, NULL for none.
+   */
+  struct s_dsp_node *p_convert;
+  /**
+   * @var s_dsp_input_port::tag_cursor
+   * cursor into the tags of the input ring buffer.
+   */
+  unsigned long tag_cursor;
+#ifdef DSP_NODE_LATENCY
+  /**
+   * @var s_dsp_input_port::stamp_cursor
+   * cursor into the write timestamps of the input ring buffer.
+   */
+  unsigned long stamp_cursor;
+#endif
+};
+
+/**
+ * @struct s_dsp_latency_stats
+ * @brief Snapshot of the latency histogram of a node, from dsp_getLatency.
+ */
+struct s_dsp_latency_stats
+{
+  /**
+   * @var s_dsp_latency_stats::count
+   * number of chunks recorded.
+   */
+  unsigned long long count;
+  /**
+   * @var s_dsp_latency_stats::p50_ns
+   * median latency in nanoseconds.
+   */
+  unsigned long long p50_ns;
+  /**
+   * @var s_dsp_latency_stats::p99_ns
+   * 99th percentile latency in nanoseconds.
+   */
+  unsigned long long p99_ns;
+  /**
+   * @var s_dsp_latency_stats::p999_ns
+   * 99.9th percentile latency in nanoseconds.
+   */
+  unsigned long long p999_ns;
+  /**
+   * @var s_dsp_latency_stats::max_ns
+   * largest latency in nanoseconds.
+   */
+  unsigned long long max_ns;
+};
+
+/**
+ * @struct s_dsp_stats
+ * @brief Snapshot of the counters of a node, from dsp_getStats.
+ */
+struct s_dsp_stats
+{
+  /**
+   * @var s_dsp_stats::items_in
+   * number of elements read from every input port.
+   */
+  unsigned long items_in;
+  /**
+   * @var s_dsp_stats::items_out
+   * number of elements written to the output.
+   */
+  unsigned long items_out;
+  /**
+   * @var s_dsp_stats::chunks_in
+   * number of reads (or releases of a peek) that returned elements.
+   */
+  unsigned long chunks_in;
+  /**
+   * @var s_dsp_stats::chunks_out
+   * number of writes (or commits of a reserve) that wrote elements.
+   */
+  unsigned long chunks_out;
+  /**
+   * @var s_dsp_stats::blocked_input
+   * number of reads that had to wait on upstream for data.
+   */
+  unsigned long blocked_input;
+  /**
+   * @var s_dsp_stats::blocked_output
+   * number of writes that had to wait on downstream for space.
+   */
+  unsigned long blocked_output;
+  /**
+   * @var s_dsp_stats::errors
+   * number of errors the node hit while running.
+   */
+  unsigned long errors;
+  /**
+   * @var s_dsp_stats::start_ns
+   * monotonic time in nanoseconds the node started running, 0 not started.
+   */
+  unsigned long long start_ns;
+  /**
+   * @var s_dsp_stats::stop_ns
+   * monotonic time in nanoseconds the node stopped running, 0 still running.
+   */
+  unsigned long long stop_ns;
+  /**
+   * @var s_dsp_stats::input_wait_ns
+   * nanoseconds spent in input reads and peeks, waiting on upstream (the copy of a read included).
+   */
+  unsigned long long input_wait_ns;
+  /**
+   * @var s_dsp_stats::output_wait_ns
+   * nanoseconds spent in output writes and reserves, waiting on downstream (the copy of a write included).
+   */
+  unsigned long long output_wait_ns;
+  /**
+   * @var s_dsp_stats::compute_ns
+   * nanoseconds spent outside the input and output calls, the work of the node. Up to date at its last call.
+   */
+  unsigned long long compute_ns;
+};
+
+/**
+ * @def DSP_NODE_CACHE_LINE
+ * Bytes in a cache line, keeps the node counters from false sharing.
+ */
+#define DSP_NODE_CACHE_LINE 64
+
+/**
+ * @struct s_dsp_counters
+ * @brief Counters of a node. Only the thread running the node stores to them
+ * (relaxed load and store, no locked add), anyone can read them with
+ * dsp_getStats.
+ */
+struct s_dsp_counters
+{
+  /**
+   * @var s_dsp_counters::items_in
+   * number of elements read from every input port.
+   */
+  atomic_ulong items_in;
+  /**
+   * @var s_dsp_counters::items_out
+   * number of elements written to the output.
+   */
+  atomic_ulong items_out;
+  /**
+   * @var s_dsp_counters::chunks_in
+   * number of reads that returned elements.
+   */
+  atomic_ulong chunks_in;
+  /**
+   * @var s_dsp_counters::chunks_out
+   * number of writes that wrote elements.
+   */
+  atomic_ulong chunks_out;
+  /**
+   * @var s_dsp_counters::errors
+   * number of errors counted with dsp_statsError.
+   */
+  atomic_ulong errors;
+  /**
+   * @var s_dsp_counters::start_ns
+   * monotonic time in nanoseconds the node started running.
+   */
+  atomic_ullong start_ns;
+  /**
+   * @var s_dsp_counters::stop_ns
+   * monotonic time in nanoseconds the node stopped running.
+   */
+  atomic_ullong stop_ns;
+  /**
+   * @var s_dsp_counters::input_wait_ns
+   * raw monotonic nanoseconds in input reads and peeks.
+   */
+  atomic_ullong input_wait_ns;
+  /**
+   * @var s_dsp_counters::output_wait_ns
+   * raw monotonic nanoseconds in output writes and reserves.
+   */
+  atomic_ullong output_wait_ns;
+  /**
+   * @var s_dsp_counters::compute_ns
+   * raw monotonic nanoseconds between the input and output calls, or in dsp_process.
+   */
+  atomic_ullong compute_ns;
+  /**
+   * @var s_dsp_counters::clock_ns
+   * raw monotonic time the last input or output call of a node thread returned, the time since is compute. 0 for pool tasks and fused chains, dsp_process times them.
+   */
+  atomic_ullong clock_ns;
+};
+
+#ifdef DSP_NODE_LATENCY
+/**
+ * @def DSP_LATENCY_SUB_BITS
+ * Bits of sub bucket per power of two, 3 keeps every bucket within 12.5% of its value.
+ */
+#define DSP_LATENCY_SUB_BITS 3
+
+/**
+ * @def DSP_LATENCY_BUCKETS
+ * Number of buckets to cover every 64 bit nanosecond value.
+ */
+#define DSP_LATENCY_BUCKETS (64 << DSP_LATENCY_SUB_BITS)
+
+/**
+ * @struct s_dsp_latency
+ * @brief Log linear (HDR style) histogram of the time from a chunk entering a
+ * node input ring to its output being committed. Written by the node thread,
+ * read by anyone.
+ */
+struct s_dsp_latency
+{
+  /**
+   * @var s_dsp_latency::pending_ns
+   * time the oldest input not yet in a output entered the ring, 0 none. Node thread only.
+   */
+  unsigned long long pending_ns;
+  /**
+   * @var s_dsp_latency::count
+   * number of chunks recorded.
+   */
+  atomic_ullong count;
+  /**
+   * @var s_dsp_latency::max_ns
+   * largest latency recorded.
+   */
+  atomic_ullong max_ns;
+  /**
+   * @var s_dsp_latency::buckets
+   * number of chunks recorded in each bucket.
+   */
+  atomic_ullong buckets[DSP_LATENCY_BUCKETS];
+};
+#endif
+
 /**
  * @struct s_dsp_node
  * @brief Contains data for DSP nodes, such as callbacks and private data.
@@ -34,19 +393,49 @@ struct s_dsp_node
    * is the node active 0 = no 1 = yes?
    */
   volatile unsigned long active;
+  /**
+   * @var s_dsp_node::state
+   * lifecycle state, changed with dsp_setState and waited on with dsp_waitState.
+   */
+  enum e_dsp_node_state state;
+  /**
+   * @var s_dsp_node::state_mutex
+   * protects state and paused.
+   */
+  pthread_mutex_t state_mutex;
+  /**
+   * @var s_dsp_node::state_cond
+   * signaled when state or paused changes, uses CLOCK_MONOTONIC for timeouts.
+   */
+  pthread_cond_t state_cond;
+  /**
+   * @var s_dsp_node::pause
+   * 1 dsp_pause holds the node at its next input read or peek, a chunk boundary.
+   */
+  atomic_int pause;
+  /**
+   * @var s_dsp_node::paused
+   * 1 the node thread is held by dsp_pause and does not touch its edges, protected by state_mutex.
+   */
+  int paused;
   /**
    * @var s_dsp_node::id_number
-   * node id number
+   * node id number, counted per context.
    */
   unsigned long id_number;
   /**
    * @var s_dsp_node::p_logger
-   * global logger pointer
+   * logger of the context of the node.
    */
   struct s_logger *p_logger;
+  /**
+   * @var s_dsp_node::p_context
+   * context (pipeline) the node belongs to, dsp_kill stops every node in it.
+   */
+  struct s_dsp_context *p_context;
   /**
    * @var s_dsp_node::total_bytes_processed
-   * number of bytes output by the node.
+   * number of bytes output by the node, written by the node thread only. Use dsp_getStats from other threads.
    */
   unsigned long total_bytes_processed;
   /**
@@ -59,14 +448,49 @@ struct s_dsp_node
    * size to read/write from ringbuffer
    */
   unsigned long chunk_size;
+  /**
+   * @var s_dsp_node::auto_buffer
+   * 1 buffer_size was DSP_SIZE_AUTO and is computed at setup, 0 fixed.
+   */
+  int auto_buffer;
+  /**
+   * @var s_dsp_node::auto_chunk
+   * 1 chunk_size was DSP_SIZE_AUTO and is computed at setup (and set input for sinks), 0 fixed.
+   */
+  int auto_chunk;
+  /**
+   * @var s_dsp_node::latency_us
+   * latency target in microseconds for auto sizes, set with dsp_setSizing.
+   */
+  unsigned long latency_us;
+  /**
+   * @var s_dsp_node::memory_budget
+   * most bytes a auto sized output ring may use, 0 no limit. Set with dsp_setSizing.
+   */
+  unsigned long memory_budget;
+  /**
+   * @var s_dsp_node::input_rate
+   * nominal input rate in elements per second, set by init_callback or dsp_setRate. 0 unknown.
+   */
+  double input_rate;
+  /**
+   * @var s_dsp_node::output_rate
+   * nominal output rate in elements per second, set by init_callback or dsp_setRate. 0 unknown.
+   */
+  double output_rate;
+  /**
+   * @var s_dsp_node::granularity
+   * elements a auto chunk and the output ring are a multiple of (frame size), set by init_callback. 0 any.
+   */
+  unsigned long granularity;
   /**
    * @var s_dsp_node::input_type
-   * enum set by init_callback that specifies the input data type.
+   * enum set by init_callback that specifies the input data type (port 0).
    */
   enum e_binary_type input_type;
   /**
    * @var s_dsp_node::input_type_size
-   * size in bytes of the input type
+   * size in bytes of the input type (port 0)
    */
   unsigned int input_type_size;
   /**
@@ -80,20 +504,71 @@ struct s_dsp_node
    */
   unsigned int output_type_size;
   /**
-   * @var s_dsp_node::p_input_ring_buffer
-   * input data ring buffer set by set input.
+   * @var s_dsp_node::num_input_ports
+   * number of input ports, 1 by default. Set by init_callback for nodes with more inputs.
+   */
+  unsigned int num_input_ports;
+  /**
+   * @var s_dsp_node::input_ports
+   * input ports, port 0 is the input set by set input and has the type input_type.
+   * init_callback sets the type of any other port.
    */
-  struct s_ringBuffer *p_input_ring_buffer;
+  struct s_dsp_input_port input_ports[DSP_NODE_MAX_INPUTS];
+  /**
+   * @var s_dsp_node::ring_type
+   * backend of the output ring buffer, set with dsp_setRingType before setup.
+   */
+  enum e_dsp_ring_type ring_type;
+  /**
+   * @var s_dsp_node::alloc
+   * allocation policy of the output ring and scratch buffers, set with dsp_setAllocPolicy before setup.
+   */
+  struct s_dsp_alloc alloc;
+  /**
+   * @var s_dsp_node::affinity
+   * cpus the node thread may run on, set with dsp_setAffinity. Used if affinity_set.
+   */
+  cpu_set_t affinity;
+  /**
+   * @var s_dsp_node::affinity_set
+   * 1 apply affinity at start, 0 inherit.
+   */
+  int affinity_set;
+  /**
+   * @var s_dsp_node::sched_policy
+   * SCHED_FIFO, SCHED_RR or SCHED_OTHER, set with dsp_setSched. Used if sched_set.
+   */
+  int sched_policy;
+  /**
+   * @var s_dsp_node::sched_priority
+   * priority for sched_policy.
+   */
+  int sched_priority;
+  /**
+   * @var s_dsp_node::sched_set
+   * 1 apply sched_policy and sched_priority at start, 0 inherit.
+   */
+  int sched_set;
+  /**
+   * @var s_dsp_node::auto_convert
+   * 1 set input inserts a converter on a type mismatch, 0 only warn. Set with dsp_setAutoConvert.
+   */
+  int auto_convert;
   /**
    * @var s_dsp_node::p_output_ring_buffer
    * output data ring buffer created by the node that creates this struct.
    */
-  struct s_ringBuffer *p_output_ring_buffer;
+  struct s_dsp_ring *p_output_ring_buffer;
   /**
    * @var s_dsp_node::dsp_thread
    * pthread thread
    */
   pthread_t dsp_thread;
+  /**
+   * @var s_dsp_node::p_cancel
+   * cancellation token set by dsp_end, waits of the node on its rings and fds wake on it.
+   */
+  struct s_dsp_cancel *p_cancel;
   /**
    * @var s_dsp_node::init_call
    * Callback to initialize node specific functionality.
@@ -109,11 +584,39 @@ struct s_dsp_node
    * Callback to free initialization callback allocations.
    */
   free_callback free_call;
+  /**
+   * @var s_dsp_node::process_call
+   * Callback to process one chunk, set by init_callback for nodes that can be fused. NULL if not.
+   * Returns 0 to be called again, non-zero when the node is finished (end of stream or error).
+   */
+  process_callback process_call;
+  /**
+   * @var s_dsp_node::process_input_max
+   * most input elements process_call needs to make progress, 0 for any amount. Set by init_callback.
+   */
+  unsigned long process_input_max;
+  /**
+   * @var s_dsp_node::process_output_max
+   * most output elements one process_call can produce, 0 for any amount. Set by init_callback.
+   */
+  unsigned long process_output_max;
   /**
    * @var s_dsp_node::p_data
    * void pointer for init/free callbacks to use for data storage.
    */
   void *p_data;
+#ifdef DSP_NODE_LATENCY
+  /**
+   * @var s_dsp_node::latency
+   * latency histogram, read with dsp_getLatency.
+   */
+  struct s_dsp_latency latency;
+#endif
+  /**
+   * @var s_dsp_node::counters
+   * counters read with dsp_getStats, on cache lines of their own.
+   */
+  _Alignas(DSP_NODE_CACHE_LINE) struct s_dsp_counters counters;
 };
 
 #endif
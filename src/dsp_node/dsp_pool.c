@@ -0,0 +1,652 @@
+//******************************************************************************
+/// @file     dsp_pool.c
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Fixed pool of worker threads that run nodes as tasks.
+/// @details  Nodes with a process_call become tasks, a task runs when its
+///           input has data or its output has space. Each worker has its own
+///           queue of tasks and steals from the others when it runs dry.
+//******************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include <unistd.h>
+
+#include "dsp_pool.h"
+
+//run one step of a task, moves data between its rings and process_call, returns 1 on progress.
+static int pool_step(struct s_dsp_pool_task * const p_task);
+
+//end the edges of a task and take it out of the pool.
+static void pool_task_done(struct s_dsp_pool_task * const p_task);
+
+//take a task from the front of a workers queue, NULL if empty.
+static struct s_dsp_pool_task *pool_pop(struct s_dsp_pool_worker * const p_worker);
+
+//take a task from the back of another workers queue, NULL if every queue is empty.
+static struct s_dsp_pool_task *pool_steal(struct s_dsp_pool * const p_pool, unsigned int index);
+
+//put a task on the back of a workers queue.
+static void pool_push(struct s_dsp_pool_worker * const p_worker, struct s_dsp_pool_task * const p_task);
+
+//sleep a worker for DSP_POOL_IDLE_US or till work is signaled, returns 0 when every task is done.
+static int pool_idle(struct s_dsp_pool * const p_pool);
+
+//pthread function of a worker.
+static void *pool_worker_thread(void *p_data);
+
+//Allocate a pool of workers, no threads are created till start.
+struct s_dsp_pool *dsp_poolCreate(unsigned int num_workers)
+{
+  long num_cores = 0;
+
+  unsigned int index = 0;
+
+  struct s_dsp_pool *p_temp = NULL;
+
+  if(num_workers == DSP_POOL_CORES)
+  {
+    num_cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+    num_workers = (num_cores > 0 ? (unsigned int)num_cores : 1);
+  }
+
+  if(!num_workers)
+  {
+    fprintf(stderr, "ERROR: DSP Pool needs at least one worker.\n");
+
+    return NULL;
+  }
+
+  p_temp = malloc(sizeof(struct s_dsp_pool));
+
+  if(!p_temp)
+  {
+    perror("DSP Pool struct failed");
+
+    return NULL;
+  }
+
+  p_temp->p_workers = calloc(num_workers, sizeof(struct s_dsp_pool_worker));
+
+  if(!p_temp->p_workers)
+  {
+    perror("DSP Pool workers failed");
+
+    free(p_temp);
+
+    return NULL;
+  }
+
+  for(index = 0; index < num_workers; index++)
+  {
+    p_temp->p_workers[index].p_pool = p_temp;
+
+    p_temp->p_workers[index].index = index;
+
+    p_temp->p_workers[index].pp_queue = NULL;
+
+    p_temp->p_workers[index].head = 0;
+
+    p_temp->p_workers[index].count = 0;
+
+    pthread_mutex_init(&p_temp->p_workers[index].mutex, NULL);
+  }
+
+  p_temp->num_workers = num_workers;
+
+  p_temp->num_running = 0;
+
+  p_temp->p_tasks = NULL;
+
+  p_temp->num_tasks = 0;
+
+  p_temp->tasks_left = 0;
+
+  atomic_init(&p_temp->num_sleeping, 0);
+
+  pthread_mutex_init(&p_temp->mutex, NULL);
+
+  pthread_cond_init(&p_temp->work_cond, NULL);
+
+  p_temp->p_logger = NULL;
+
+  return p_temp;
+}
+
+//Add a node to the pool as a task.
+int dsp_poolAddNode(struct s_dsp_pool * const p_pool, struct s_dsp_node * const p_node)
+{
+  struct s_dsp_pool_task *p_temp = NULL;
+
+  if(!p_pool || !p_node) return ~0;
+
+  if(p_pool->num_running)
+  {
+    logger_error_msg(p_node->p_logger, "DSP POOL %p already started, can not add node %p.", p_pool, p_node);
+
+    return ~0;
+  }
+
+  if(!p_node->process_call || (p_node->num_input_ports != 1))
+  {
+    logger_error_msg(p_node->p_logger, "DSP POOL %p node %p needs a process_call and one input port.", p_pool, p_node);
+
+    return ~0;
+  }
+
+  p_temp = realloc(p_pool->p_tasks, (p_pool->num_tasks + 1) * sizeof(struct s_dsp_pool_task));
+
+  if(!p_temp)
+  {
+    logger_error_msg(p_node->p_logger, "DSP POOL %p could not add node %p.", p_pool, p_node);
+
+    return ~0;
+  }
+
+  p_pool->p_tasks = p_temp;
+
+  p_temp = &p_pool->p_tasks[p_pool->num_tasks];
+
+  memset(p_temp, 0, sizeof(struct s_dsp_pool_task));
+
+  p_temp->p_node = p_node;
+
+  if(!p_pool->p_logger) p_pool->p_logger = p_node->p_logger;
+
+  p_pool->num_tasks++;
+
+  logger_info_msg(p_node->p_logger, "DSP POOL %p added node %p.", p_pool, p_node);
+
+  return 0;
+}
+
+//Deal the tasks out to the workers and start the worker threads.
+int dsp_poolStart(struct s_dsp_pool * const p_pool)
+{
+  int error = 0;
+
+  unsigned int index = 0;
+
+  if(!p_pool) return ~0;
+
+  if(p_pool->num_running)
+  {
+    logger_error_msg(p_pool->p_logger, "DSP POOL %p already started.", p_pool);
+
+    return ~0;
+  }
+
+  if(!p_pool->num_tasks) return 0;
+
+  for(index = 0; index < p_pool->num_workers; index++)
+  {
+    p_pool->p_workers[index].pp_queue = malloc(p_pool->num_tasks * sizeof(struct s_dsp_pool_task *));
+
+    if(!p_pool->p_workers[index].pp_queue)
+    {
+      logger_error_msg(p_pool->p_logger, "DSP POOL %p could not allocate worker queue.", p_pool);
+
+      goto error_cleanup;
+    }
+  }
+
+  for(index = 0; index < p_pool->num_tasks; index++)
+  {
+    struct s_dsp_pool_task *p_task = &p_pool->p_tasks[index];
+
+    struct s_dsp_node *p_node = p_task->p_node;
+
+    //blocks are the chunk size, grown to what process_call needs to make progress.
+    if(p_node->input_ports[0].p_ring_buffer)
+    {
+      p_task->input_size = (p_node->chunk_size > p_node->process_input_max ? p_node->chunk_size : p_node->process_input_max);
+
+      p_task->p_input = dsp_allocBuffer(p_node, p_task->input_size * p_node->input_type_size);
+
+      if(!p_task->p_input) error = ~0;
+    }
+
+    if(p_node->p_output_ring_buffer)
+    {
+      p_task->output_size = (p_node->chunk_size > p_node->process_output_max ? p_node->chunk_size : p_node->process_output_max);
+
+      p_task->p_output = dsp_allocBuffer(p_node, p_task->output_size * p_node->output_type_size);
+
+      if(!p_task->p_output) error = ~0;
+    }
+
+    if(error)
+    {
+      logger_error_msg(p_pool->p_logger, "DSP POOL %p could not allocate blocks for node %p.", p_pool, p_node);
+
+      goto error_cleanup;
+    }
+
+    p_node->active = 1;
+
+    p_node->total_bytes_processed = 0;
+
+    dsp_statsStart(p_node);
+
+    dsp_setState(p_node, DSP_NODE_RUNNING);
+
+    //deal the tasks out round robin, stealing evens it out from here.
+    pool_push(&p_pool->p_workers[index % p_pool->num_workers], p_task);
+  }
+
+  p_pool->tasks_left = p_pool->num_tasks;
+
+  for(index = 0; index < p_pool->num_workers; index++)
+  {
+    error = pthread_create(&p_pool->p_workers[index].worker_thread, NULL, pool_worker_thread, &p_pool->p_workers[index]);
+
+    if(error)
+    {
+      logger_error_msg(p_pool->p_logger, "DSP POOL %p could not start worker %u.", p_pool, index);
+
+      goto error_cleanup;
+    }
+
+    p_pool->num_running++;
+  }
+
+  logger_info_msg(p_pool->p_logger, "DSP POOL %p started %u workers for %u tasks.", p_pool, p_pool->num_workers, p_pool->num_tasks);
+
+  return 0;
+
+error_cleanup:
+  //tasks end their edges so the nodes around them drain and exit.
+  for(index = 0; index < p_pool->num_tasks; index++)
+  {
+    dsp_endOutput(p_pool->p_tasks[index].p_node);
+
+    dsp_endInput(p_pool->p_tasks[index].p_node);
+  }
+
+  dsp_poolWait(p_pool);
+
+  //the workers are joined, tasks none of them finished are stopped here.
+  for(index = 0; index < p_pool->num_tasks; index++)
+  {
+    if(!p_pool->p_tasks[index].done) pool_task_done(&p_pool->p_tasks[index]);
+  }
+
+  return ~0;
+}
+
+//Wait for every task to be done and join the workers.
+int dsp_poolWait(struct s_dsp_pool * const p_pool)
+{
+  int error = 0;
+
+  unsigned int index = 0;
+
+  if(!p_pool) return ~0;
+
+  for(index = 0; index < p_pool->num_running; index++)
+  {
+    error |= pthread_join(p_pool->p_workers[index].worker_thread, NULL);
+  }
+
+  p_pool->num_running = 0;
+
+  logger_info_msg(p_pool->p_logger, "DSP POOL %p joined.", p_pool);
+
+  return error;
+}
+
+//Free the pool, the nodes are not cleaned up.
+void dsp_poolFree(struct s_dsp_pool *p_pool)
+{
+  unsigned int index = 0;
+
+  if(!p_pool) return;
+
+  for(index = 0; index < p_pool->num_tasks; index++)
+  {
+    struct s_dsp_pool_task *p_task = &p_pool->p_tasks[index];
+
+    dsp_freeBuffer(p_task->p_node, p_task->p_input, p_task->input_size * p_task->p_node->input_type_size);
+
+    dsp_freeBuffer(p_task->p_node, p_task->p_output, p_task->output_size * p_task->p_node->output_type_size);
+  }
+
+  for(index = 0; index < p_pool->num_workers; index++)
+  {
+    free(p_pool->p_workers[index].pp_queue);
+
+    pthread_mutex_destroy(&p_pool->p_workers[index].mutex);
+  }
+
+  pthread_cond_destroy(&p_pool->work_cond);
+
+  pthread_mutex_destroy(&p_pool->mutex);
+
+  free(p_pool->p_tasks);
+
+  free(p_pool->p_workers);
+
+  free(p_pool);
+}
+
+//run one step of a task, moves data between its rings and process_call, returns 1 on progress.
+static int pool_step(struct s_dsp_pool_task * const p_task)
+{
+  int ended    = 0;
+  int progress = 0;
+
+  unsigned long num_elem = 0;
+
+  struct s_dsp_node *p_node = p_task->p_node;
+
+  struct s_dsp_ring *p_input_ring  = p_node->input_ports[0].p_ring_buffer;
+  struct s_dsp_ring *p_output_ring = p_node->p_output_ring_buffer;
+
+  //a ended task drops what it holds, its edges end so the nodes around it finish.
+  if(dsp_isCancelled(p_node))
+  {
+    pool_task_done(p_task);
+
+    return 1;
+  }
+
+  //drain what fits, a write of no more then the free space never blocks. The node wrappers keep latency stamps.
+  if(p_task->output_fill)
+  {
+    num_elem = dsp_ringSpace(p_output_ring, &ended);
+
+    //every consumer has ended, nothing left to do.
+    if(ended)
+    {
+      pool_task_done(p_task);
+
+      return 1;
+    }
+
+    if(num_elem > p_task->output_fill) num_elem = p_task->output_fill;
+
+    if(num_elem)
+    {
+      dsp_writeOutput(p_node, p_task->p_output, num_elem);
+
+      p_task->output_fill -= num_elem;
+
+      memmove(p_task->p_output, p_task->p_output + (num_elem * p_node->output_type_size), p_task->output_fill * p_node->output_type_size);
+
+      progress = 1;
+    }
+  }
+
+  //top up what is available, a read of no more then available never blocks.
+  if(p_input_ring && !p_task->input_ended && (p_task->input_fill < p_task->input_size))
+  {
+    num_elem = dsp_ringAvailable(p_input_ring, p_node->input_ports[0].reader, &ended);
+
+    if(num_elem > p_task->input_size - p_task->input_fill) num_elem = p_task->input_size - p_task->input_fill;
+
+    if(num_elem)
+    {
+      p_task->input_fill += dsp_readInput(p_node, p_task->p_input + (p_task->input_fill * p_node->input_type_size), num_elem);
+
+      progress = 1;
+    }
+    else if(ended)
+    {
+      p_task->input_ended = 1;
+
+      progress = 1;
+    }
+  }
+
+  //run only with input to work on (or its end) and room for output.
+  if(!p_task->finished && (!p_input_ring || p_task->input_fill || p_task->input_ended) && (!p_output_ring || (p_task->output_fill < p_task->output_size)))
+  {
+    int finished = 0;
+
+    struct s_dsp_process process;
+
+    process.p_input = p_task->p_input;
+
+    process.input_size = p_task->input_fill;
+
+    process.p_output = (p_task->p_output ? p_task->p_output + (p_task->output_fill * p_node->output_type_size) : NULL);
+
+    process.output_size = p_task->output_size - p_task->output_fill;
+
+    process.end_of_input = p_task->input_ended;
+
+    finished = dsp_process(p_node, &process);
+
+    if(process.input_size)
+    {
+      p_task->input_fill -= process.input_size;
+
+      memmove(p_task->p_input, p_task->p_input + (process.input_size * p_node->input_type_size), p_task->input_fill * p_node->input_type_size);
+
+      progress = 1;
+    }
+
+    if(process.output_size)
+    {
+      p_task->output_fill += process.output_size;
+
+      progress = 1;
+    }
+
+    if(finished)
+    {
+      p_task->finished = 1;
+
+      progress = 1;
+    }
+  }
+
+  if(p_task->finished && !p_task->output_fill) pool_task_done(p_task);
+
+  return progress;
+}
+
+//end the edges of a task and take it out of the pool.
+static void pool_task_done(struct s_dsp_pool_task * const p_task)
+{
+  dsp_endInput(p_task->p_node);
+
+  dsp_endOutput(p_task->p_node);
+
+  p_task->done = 1;
+
+  dsp_statsStop(p_task->p_node);
+
+  dsp_setState(p_task->p_node, DSP_NODE_STOPPED);
+
+  p_task->p_node->active = 0;
+
+  logger_info_msg(p_task->p_node->p_logger, "DSP POOL task for node %p finished.", p_task->p_node);
+}
+
+//take a task from the front of a workers queue, NULL if empty.
+static struct s_dsp_pool_task *pool_pop(struct s_dsp_pool_worker * const p_worker)
+{
+  struct s_dsp_pool_task *p_task = NULL;
+
+  pthread_mutex_lock(&p_worker->mutex);
+
+  if(p_worker->count)
+  {
+    p_task = p_worker->pp_queue[p_worker->head];
+
+    p_worker->head = (p_worker->head + 1) % p_worker->p_pool->num_tasks;
+
+    p_worker->count--;
+  }
+
+  pthread_mutex_unlock(&p_worker->mutex);
+
+  return p_task;
+}
+
+//take a task from the back of another workers queue, NULL if every queue is empty.
+static struct s_dsp_pool_task *pool_steal(struct s_dsp_pool * const p_pool, unsigned int index)
+{
+  unsigned int victim = 0;
+
+  struct s_dsp_pool_task *p_task = NULL;
+
+  for(victim = (index + 1) % p_pool->num_workers; victim != index; victim = (victim + 1) % p_pool->num_workers)
+  {
+    struct s_dsp_pool_worker *p_worker = &p_pool->p_workers[victim];
+
+    pthread_mutex_lock(&p_worker->mutex);
+
+    if(p_worker->count)
+    {
+      p_worker->count--;
+
+      p_task = p_worker->pp_queue[(p_worker->head + p_worker->count) % p_pool->num_tasks];
+    }
+
+    pthread_mutex_unlock(&p_worker->mutex);
+
+    if(p_task) break;
+  }
+
+  return p_task;
+}
+
+//put a task on the back of a workers queue.
+static void pool_push(struct s_dsp_pool_worker * const p_worker, struct s_dsp_pool_task * const p_task)
+{
+  pthread_mutex_lock(&p_worker->mutex);
+
+  //every task is in at most one queue, count never passes num_tasks.
+  p_worker->pp_queue[(p_worker->head + p_worker->count) % p_worker->p_pool->num_tasks] = p_task;
+
+  p_worker->count++;
+
+  pthread_mutex_unlock(&p_worker->mutex);
+}
+
+//sleep a worker for DSP_POOL_IDLE_US or till work is signaled, returns 0 when every task is done.
+static int pool_idle(struct s_dsp_pool * const p_pool)
+{
+  int tasks_left = 0;
+
+  struct timespec wait_time;
+
+  //nodes outside the pool do not signal work_cond, the timeout picks up their data.
+  clock_gettime(CLOCK_REALTIME, &wait_time);
+
+  wait_time.tv_nsec += DSP_POOL_IDLE_US * 1000;
+
+  if(wait_time.tv_nsec >= 1000000000)
+  {
+    wait_time.tv_sec++;
+
+    wait_time.tv_nsec -= 1000000000;
+  }
+
+  pthread_mutex_lock(&p_pool->mutex);
+
+  if(p_pool->tasks_left)
+  {
+    atomic_fetch_add(&p_pool->num_sleeping, 1);
+
+    pthread_cond_timedwait(&p_pool->work_cond, &p_pool->mutex, &wait_time);
+
+    atomic_fetch_sub(&p_pool->num_sleeping, 1);
+  }
+
+  tasks_left = (p_pool->tasks_left != 0);
+
+  pthread_mutex_unlock(&p_pool->mutex);
+
+  return tasks_left;
+}
+
+//pthread function of a worker.
+static void *pool_worker_thread(void *p_data)
+{
+  unsigned int idle = 0;
+
+  struct s_dsp_pool *p_pool = NULL;
+
+  struct s_dsp_pool_worker *p_worker = NULL;
+
+  p_worker = (struct s_dsp_pool_worker *)p_data;
+
+  p_pool = p_worker->p_pool;
+
+  logger_info_msg(p_pool->p_logger, "DSP POOL %p worker %u started.", p_pool, p_worker->index);
+
+  for(;;)
+  {
+    int progress = 0;
+
+    struct s_dsp_pool_task *p_task = NULL;
+
+    p_task = pool_pop(p_worker);
+
+    if(!p_task) p_task = pool_steal(p_pool, p_worker->index);
+
+    //every task is done, or running on another worker.
+    if(!p_task)
+    {
+      if(!pool_idle(p_pool)) break;
+
+      continue;
+    }
+
+    progress = pool_step(p_task);
+
+    if(p_task->done)
+    {
+      pthread_mutex_lock(&p_pool->mutex);
+
+      p_pool->tasks_left--;
+
+      pthread_cond_broadcast(&p_pool->work_cond);
+
+      pthread_mutex_unlock(&p_pool->mutex);
+
+      idle = 0;
+
+      continue;
+    }
+
+    pool_push(p_worker, p_task);
+
+    if(progress)
+    {
+      idle = 0;
+
+      //data moved, a sleeping worker may have a task that can run now.
+      if(atomic_load(&p_pool->num_sleeping))
+      {
+        pthread_mutex_lock(&p_pool->mutex);
+
+        pthread_cond_broadcast(&p_pool->work_cond);
+
+        pthread_mutex_unlock(&p_pool->mutex);
+      }
+
+      continue;
+    }
+
+    //a pass over every task without progress, wait for data.
+    if(++idle > p_pool->num_tasks)
+    {
+      idle = 0;
+
+      if(!pool_idle(p_pool)) break;
+    }
+  }
+
+  logger_info_msg(p_pool->p_logger, "DSP POOL %p worker %u finished.", p_pool, p_worker->index);
+
+  return NULL;
+}
@@ -0,0 +1,247 @@
+//******************************************************************************
+/// @file     dsp_pool.h
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Fixed pool of worker threads that run nodes as tasks.
+/// @details  Nodes with a process_call become tasks, a task runs when its
+///           input has data or its output has space. Each worker has its own
+///           queue of tasks and steals from the others when it runs dry.
+//******************************************************************************
+
+#ifndef __dsp_pool
+#define __dsp_pool
+
+// includes
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "dsp_node.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def DSP_POOL_CORES
+ * Number of workers that sizes the pool to the number of online cores.
+ */
+#define DSP_POOL_CORES (~0U)
+
+/**
+ * @def DSP_POOL_IDLE_US
+ * Time in microseconds a worker sleeps after a pass over its tasks made no progress.
+ */
+#define DSP_POOL_IDLE_US 200
+
+/**
+ * @struct s_dsp_pool_task
+ * @brief Node run by the pool, with staging blocks between its rings and its process_call.
+ */
+struct s_dsp_pool_task
+{
+  /**
+   * @var s_dsp_pool_task::p_node
+   * node the task runs, has a process_call and one input port.
+   */
+  struct s_dsp_node *p_node;
+  /**
+   * @var s_dsp_pool_task::p_input
+   * input block read from the input ring, NULL for sources.
+   */
+  uint8_t *p_input;
+  /**
+   * @var s_dsp_pool_task::input_size
+   * size of p_input in elements.
+   */
+  unsigned long input_size;
+  /**
+   * @var s_dsp_pool_task::input_fill
+   * elements in p_input waiting on process_call.
+   */
+  unsigned long input_fill;
+  /**
+   * @var s_dsp_pool_task::p_output
+   * output block written to the output ring, NULL for sinks.
+   */
+  uint8_t *p_output;
+  /**
+   * @var s_dsp_pool_task::output_size
+   * size of p_output in elements.
+   */
+  unsigned long output_size;
+  /**
+   * @var s_dsp_pool_task::output_fill
+   * elements in p_output waiting on ring space.
+   */
+  unsigned long output_fill;
+  /**
+   * @var s_dsp_pool_task::input_ended
+   * 1 the input ring ended and is drained, 0 more input may come.
+   */
+  int input_ended;
+  /**
+   * @var s_dsp_pool_task::finished
+   * 1 process_call returned non-zero, only the output is left to drain.
+   */
+  int finished;
+  /**
+   * @var s_dsp_pool_task::done
+   * 1 the task ended its edges and is out of the pool.
+   */
+  int done;
+};
+
+/**
+ * @struct s_dsp_pool_worker
+ * @brief Worker thread and its queue of tasks, the owner takes from the front, thieves from the back.
+ */
+struct s_dsp_pool_worker
+{
+  /**
+   * @var s_dsp_pool_worker::p_pool
+   * pool the worker belongs to.
+   */
+  struct s_dsp_pool *p_pool;
+  /**
+   * @var s_dsp_pool_worker::index
+   * index of the worker in the pool.
+   */
+  unsigned int index;
+  /**
+   * @var s_dsp_pool_worker::worker_thread
+   * pthread of the worker.
+   */
+  pthread_t worker_thread;
+  /**
+   * @var s_dsp_pool_worker::pp_queue
+   * circular queue of tasks, sized to hold every task of the pool.
+   */
+  struct s_dsp_pool_task **pp_queue;
+  /**
+   * @var s_dsp_pool_worker::head
+   * index of the front of pp_queue.
+   */
+  unsigned int head;
+  /**
+   * @var s_dsp_pool_worker::count
+   * number of tasks in pp_queue.
+   */
+  unsigned int count;
+  /**
+   * @var s_dsp_pool_worker::mutex
+   * protects pp_queue, head and count.
+   */
+  pthread_mutex_t mutex;
+};
+
+/**
+ * @struct s_dsp_pool
+ * @brief Fixed pool of workers and the tasks they run.
+ */
+struct s_dsp_pool
+{
+  /**
+   * @var s_dsp_pool::p_workers
+   * array of workers.
+   */
+  struct s_dsp_pool_worker *p_workers;
+  /**
+   * @var s_dsp_pool::num_workers
+   * number of workers in p_workers.
+   */
+  unsigned int num_workers;
+  /**
+   * @var s_dsp_pool::num_running
+   * number of worker threads created by start.
+   */
+  unsigned int num_running;
+  /**
+   * @var s_dsp_pool::p_tasks
+   * array of tasks.
+   */
+  struct s_dsp_pool_task *p_tasks;
+  /**
+   * @var s_dsp_pool::num_tasks
+   * number of tasks in p_tasks.
+   */
+  unsigned int num_tasks;
+  /**
+   * @var s_dsp_pool::tasks_left
+   * number of tasks not done, workers exit at 0.
+   */
+  unsigned int tasks_left;
+  /**
+   * @var s_dsp_pool::num_sleeping
+   * number of workers waiting on work_cond.
+   */
+  atomic_uint num_sleeping;
+  /**
+   * @var s_dsp_pool::mutex
+   * protects tasks_left and work_cond.
+   */
+  pthread_mutex_t mutex;
+  /**
+   * @var s_dsp_pool::work_cond
+   * signaled when a task made progress or is done.
+   */
+  pthread_cond_t work_cond;
+  /**
+   * @var s_dsp_pool::p_logger
+   * logger of the first node added.
+   */
+  struct s_logger *p_logger;
+};
+
+/**************************************************************************//**
+  * @brief Allocate a pool of workers, no threads are created till start.
+  *
+  * @param num_workers number of worker threads, DSP_POOL_CORES for the number
+  * of online cores.
+  *
+  * @return allocated pool, NULL on error.
+  ****************************************************************************/
+struct s_dsp_pool *dsp_poolCreate(unsigned int num_workers);
+
+/**************************************************************************//**
+  * @brief Add a node to the pool as a task. The node must be setup, have a
+  * process_call and a single input port. It is not started with dsp_start.
+  *
+  * @param p_pool struct s_dsp_pool object from dsp_poolCreate
+  * @param p_node struct s_dsp_node object to run as a task.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_poolAddNode(struct s_dsp_pool * const p_pool, struct s_dsp_node * const p_node);
+
+/**************************************************************************//**
+  * @brief Deal the tasks out to the workers and start the worker threads.
+  *
+  * @param p_pool struct s_dsp_pool object
+  *
+  * @return 0 no error, non-zero indicates error. On error every task ends its
+  * edges and any started workers are joined.
+  ****************************************************************************/
+int dsp_poolStart(struct s_dsp_pool * const p_pool);
+
+/**************************************************************************//**
+  * @brief Wait for every task to be done and join the workers.
+  *
+  * @param p_pool struct s_dsp_pool object
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_poolWait(struct s_dsp_pool * const p_pool);
+
+/**************************************************************************//**
+  * @brief Free the pool, the nodes are not cleaned up.
+  *
+  * @param p_pool struct s_dsp_pool object
+  ****************************************************************************/
+void dsp_poolFree(struct s_dsp_pool *p_pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
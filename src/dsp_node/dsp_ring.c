@@ -0,0 +1,1549 @@
+//******************************************************************************
+/// @file     dsp_ring.c
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Ring buffer for DSP node edges, one writer with N readers.
+/// @details  Each reader has its own read cursor, the slowest reader sets
+///           how much space the writer has available. DSP_RING_SPSC rings
+///           have a single reader and use lock free indexes instead.
+//******************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <errno.h>
+
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+#include "dsp_ring.h"
+
+//bytes in a cache line, keeps the writer and reader indexes from false sharing.
+#define DSP_RING_CACHE_LINE 64
+
+//number of times a spsc wait polls before it goes to sleep.
+#define DSP_RING_SPSC_SPIN  1024
+
+//lock free state of a spsc ring, each side owns its own cache line.
+struct s_dsp_ring_spsc
+{
+  //polls before sleeping, 0 on a single cpu where spinning only delays the other side.
+  unsigned int spin_limit;
+  //written only by the writer
+  _Alignas(DSP_RING_CACHE_LINE) atomic_ulong write_index;
+  atomic_int write_alive;
+  atomic_ulong write_blocked;
+  atomic_ulong high_water;
+  atomic_ullong full_ns;
+  atomic_ullong full_since;
+  //written only by the reader
+  _Alignas(DSP_RING_CACHE_LINE) atomic_ulong read_index;
+  atomic_int read_alive;
+  atomic_ulong read_blocked;
+  atomic_ullong empty_ns;
+  atomic_ullong empty_since;
+  atomic_ullong added_ns;
+  //reader sleeps on data_seq, writer bumps it when the reader is sleeping.
+  _Alignas(DSP_RING_CACHE_LINE) atomic_uint data_seq;
+  atomic_int data_sleeping;
+  //writer sleeps on space_seq, reader bumps it when the writer is sleeping.
+  _Alignas(DSP_RING_CACHE_LINE) atomic_uint space_seq;
+  atomic_int space_sleeping;
+};
+
+//tags in write order, the writer fills them in order and readers walk them with their own cursor.
+struct s_dsp_ring_tags
+{
+  //number of tags ever added, the newest is num_tags-1.
+  atomic_ulong num_tags;
+  struct
+  {
+    atomic_ulong offset;
+    atomic_uint key;
+    atomic_llong value_int;
+    _Atomic double value_real;
+  } tags[DSP_RING_TAGS];
+};
+
+#ifdef DSP_NODE_LATENCY
+//write timestamps, the writer fills them in order and readers walk them with their own cursor.
+struct s_dsp_ring_stamps
+{
+  //number of stamps ever written, the newest is num_stamps-1.
+  atomic_ulong num_stamps;
+  struct
+  {
+    //write index at the end of the write.
+    atomic_ulong index;
+    atomic_ullong time_ns;
+  } stamps[DSP_RING_STAMPS];
+};
+
+//stamp a write that ends at end_index, called by the writer before the index is published.
+static void ring_stamp(struct s_dsp_ring * const p_ring, unsigned long end_index);
+#endif
+
+//monotonic time in nanoseconds, for fill telemetry, latency stamps and deadlines.
+static unsigned long long ring_now(void);
+
+//absolute monotonic time in nanoseconds to a timespec.
+static void ring_timespec(unsigned long long time_ns, struct timespec *p_time);
+
+//mark the high water of every alive reader, called by the writer with the mutex held.
+static void fill_mark(struct s_dsp_ring * const p_ring);
+
+//spsc, mark the high water of the reader, called by the writer after the index is published.
+static void spsc_fill_mark(struct s_dsp_ring_spsc * const p_spsc, unsigned long write_index);
+
+//spsc, add the time since a wait started to its total and clear the start.
+static void spsc_wait_done(atomic_ullong *p_total, atomic_ullong *p_since);
+
+#ifdef DSP_NODE_LATENCY
+//Monotonic time in nanoseconds, the clock ring timestamps use.
+unsigned long long dsp_ringStampNow(void)
+{
+  return ring_now();
+}
+
+//Time the write holding a element of a reader entered the ring.
+unsigned long long dsp_ringStampTime(struct s_dsp_ring *p_ring, unsigned int reader, unsigned long behind, unsigned long *p_cursor)
+{
+  unsigned long read_index = 0;
+  unsigned long num_stamps = 0;
+  unsigned long cursor     = 0;
+
+  unsigned long long time_ns = 0;
+
+  if(!p_ring || !p_cursor) return 0;
+
+  if(reader >= atomic_load_explicit(&p_ring->num_readers, memory_order_acquire)) return 0;
+
+  if(p_ring->p_spsc)
+  {
+    read_index = atomic_load_explicit(&p_ring->p_spsc->read_index, memory_order_relaxed);
+  }
+  else
+  {
+    pthread_mutex_lock(&p_ring->mutex);
+
+    read_index = p_ring->p_readers[reader].read_index;
+
+    pthread_mutex_unlock(&p_ring->mutex);
+  }
+
+  read_index -= behind;
+
+  num_stamps = atomic_load_explicit(&p_ring->p_stamps->num_stamps, memory_order_acquire);
+
+  cursor = *p_cursor;
+
+  //the writer lapped this reader, the oldest stamp left is the best guess.
+  if(num_stamps - cursor > DSP_RING_STAMPS) cursor = num_stamps - DSP_RING_STAMPS;
+
+  //skip writes that end at or before the element.
+  while((cursor < num_stamps) && (atomic_load_explicit(&p_ring->p_stamps->stamps[cursor % DSP_RING_STAMPS].index, memory_order_relaxed) <= read_index))
+  {
+    cursor++;
+  }
+
+  *p_cursor = cursor;
+
+  if(cursor == num_stamps) return 0;
+
+  time_ns = atomic_load_explicit(&p_ring->p_stamps->stamps[cursor % DSP_RING_STAMPS].time_ns, memory_order_relaxed);
+
+  //rewritten while it was read, a lapping writer is so far ahead the time is no good anyway.
+  if(atomic_load_explicit(&p_ring->p_stamps->num_stamps, memory_order_acquire) - cursor > DSP_RING_STAMPS) return 0;
+
+  return time_ns;
+}
+
+//stamp a write that ends at end_index, called by the writer before the index is published.
+static void ring_stamp(struct s_dsp_ring * const p_ring, unsigned long end_index)
+{
+  unsigned long num_stamps = 0;
+
+  num_stamps = atomic_load_explicit(&p_ring->p_stamps->num_stamps, memory_order_relaxed);
+
+  atomic_store_explicit(&p_ring->p_stamps->stamps[num_stamps % DSP_RING_STAMPS].index, end_index, memory_order_relaxed);
+
+  atomic_store_explicit(&p_ring->p_stamps->stamps[num_stamps % DSP_RING_STAMPS].time_ns, dsp_ringStampNow(), memory_order_relaxed);
+
+  atomic_store_explicit(&p_ring->p_stamps->num_stamps, num_stamps + 1, memory_order_release);
+}
+#endif
+
+//number of elements between the writer and the slowest alive reader, returns 0 readers alive in p_alive.
+static unsigned long used_space(struct s_dsp_ring const * const p_ring, unsigned int *p_alive);
+
+//wait with the mutex held till size elements are free, the stream ended, the deadline passed or p_cancel is set, returns 0 readers alive in p_alive and 1 on a passed deadline or cancel.
+static int wait_space(struct s_dsp_ring * const p_ring, unsigned long size, unsigned int *p_alive, unsigned long long deadline, atomic_int const *p_cancel);
+
+//wait with the mutex held till a reader has size elements, the stream ended, the deadline passed or p_cancel is set, returns available (max of size) or DSP_RING_TIMEOUT.
+static unsigned long wait_data(struct s_dsp_ring * const p_ring, struct s_dsp_ring_reader * const p_reader, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel);
+
+//wait on a cond with the mutex held till it is signaled or the deadline passed, returns 1 on a passed deadline.
+static int wait_cond(struct s_dsp_ring * const p_ring, pthread_cond_t *p_cond, unsigned long long deadline);
+
+//copy size elements in or out of the ring at absolute index, handles the wrap.
+static void ring_copy(struct s_dsp_ring const * const p_ring, unsigned long index, void *p_data, unsigned long size, int to_ring);
+
+//spsc, spin then sleep till size elements are free, the deadline passed or p_cancel is set, returns 1 free, 0 if the reader or writer ended, -1 on a passed deadline or cancel.
+static int spsc_wait_space(struct s_dsp_ring_spsc * const p_spsc, unsigned long buffer_size, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel);
+
+//spsc, spin then sleep till size elements are available, the writer ended, the deadline passed or p_cancel is set, returns available (max of size) or DSP_RING_TIMEOUT.
+static unsigned long spsc_wait_data(struct s_dsp_ring_spsc * const p_spsc, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel);
+
+//spsc, wake the other side if it is sleeping on p_seq.
+static void spsc_wake(atomic_uint *p_seq, atomic_int *p_sleeping);
+
+//spsc, sleep on p_seq if it still equals seq, no longer then the deadline.
+static void spsc_sleep(atomic_uint *p_seq, unsigned int seq, unsigned long long deadline);
+
+//spsc, cpu hint while spinning.
+static void spsc_relax(void);
+
+//1 if a wait was cancelled, p_cancel may be NULL.
+static int ring_cancelled(atomic_int const *p_cancel);
+
+//Allocate a ring buffer.
+struct s_dsp_ring *dsp_ringCreate(unsigned long buffer_size, unsigned long type_size, enum e_dsp_ring_type type, struct s_dsp_alloc const *p_alloc)
+{
+  struct s_dsp_ring *p_temp = NULL;
+
+  pthread_condattr_t cond_attr;
+
+  if(!buffer_size || !type_size)
+  {
+    fprintf(stderr, "ERROR: Ring buffer size and type size must be non-zero.\n");
+
+    return NULL;
+  }
+
+  p_temp = malloc(sizeof(struct s_dsp_ring));
+
+  if(!p_temp) return NULL;
+
+  p_temp->alloc.flags = (p_alloc ? p_alloc->flags : DSP_ALLOC_DEFAULT);
+
+  p_temp->alloc.numa_node = (p_alloc ? p_alloc->numa_node : 0);
+
+  p_temp->p_buffer = dsp_allocMem(&p_temp->alloc, buffer_size * type_size);
+
+  if(!p_temp->p_buffer)
+  {
+    free(p_temp);
+
+    return NULL;
+  }
+
+  p_temp->type = type;
+
+  p_temp->p_spsc = NULL;
+
+  if(type == DSP_RING_SPSC)
+  {
+    p_temp->p_spsc = aligned_alloc(DSP_RING_CACHE_LINE, sizeof(struct s_dsp_ring_spsc));
+
+    if(!p_temp->p_spsc)
+    {
+      dsp_freeMem(&p_temp->alloc, p_temp->p_buffer, buffer_size * type_size);
+
+      free(p_temp);
+
+      return NULL;
+    }
+
+    p_temp->p_spsc->spin_limit = (sysconf(_SC_NPROCESSORS_ONLN) > 1 ? DSP_RING_SPSC_SPIN : 0);
+
+    atomic_init(&p_temp->p_spsc->write_index, 0);
+    atomic_init(&p_temp->p_spsc->write_alive, 1);
+    atomic_init(&p_temp->p_spsc->write_blocked, 0);
+    atomic_init(&p_temp->p_spsc->high_water, 0);
+    atomic_init(&p_temp->p_spsc->full_ns, 0);
+    atomic_init(&p_temp->p_spsc->full_since, 0);
+    atomic_init(&p_temp->p_spsc->read_index, 0);
+    atomic_init(&p_temp->p_spsc->read_alive, 0);
+    atomic_init(&p_temp->p_spsc->read_blocked, 0);
+    atomic_init(&p_temp->p_spsc->empty_ns, 0);
+    atomic_init(&p_temp->p_spsc->empty_since, 0);
+    atomic_init(&p_temp->p_spsc->added_ns, 0);
+    atomic_init(&p_temp->p_spsc->data_seq, 0);
+    atomic_init(&p_temp->p_spsc->data_sleeping, 0);
+    atomic_init(&p_temp->p_spsc->space_seq, 0);
+    atomic_init(&p_temp->p_spsc->space_sleeping, 0);
+  }
+
+  p_temp->p_tags = calloc(1, sizeof(struct s_dsp_ring_tags));
+
+  if(!p_temp->p_tags)
+  {
+    free(p_temp->p_spsc);
+
+    dsp_freeMem(&p_temp->alloc, p_temp->p_buffer, buffer_size * type_size);
+
+    free(p_temp);
+
+    return NULL;
+  }
+
+#ifdef DSP_NODE_LATENCY
+  p_temp->p_stamps = calloc(1, sizeof(struct s_dsp_ring_stamps));
+
+  if(!p_temp->p_stamps)
+  {
+    free(p_temp->p_tags);
+
+    free(p_temp->p_spsc);
+
+    dsp_freeMem(&p_temp->alloc, p_temp->p_buffer, buffer_size * type_size);
+
+    free(p_temp);
+
+    return NULL;
+  }
+#endif
+
+  p_temp->p_readers = NULL;
+
+  //readers wait on the cursor in place, the slots are fixed so adding a reader never moves them.
+  if(!p_temp->p_spsc)
+  {
+    p_temp->p_readers = calloc(DSP_RING_READERS, sizeof(struct s_dsp_ring_reader));
+
+    if(!p_temp->p_readers)
+    {
+#ifdef DSP_NODE_LATENCY
+      free(p_temp->p_stamps);
+#endif
+
+      free(p_temp->p_tags);
+
+      dsp_freeMem(&p_temp->alloc, p_temp->p_buffer, buffer_size * type_size);
+
+      free(p_temp);
+
+      return NULL;
+    }
+  }
+
+  p_temp->buffer_size = buffer_size;
+
+  p_temp->type_size = type_size;
+
+  p_temp->write_index = 0;
+
+  p_temp->write_alive = 1;
+
+  atomic_init(&p_temp->write_blocked, 0);
+
+  p_temp->full_ns = 0;
+
+  p_temp->full_since = 0;
+
+  atomic_init(&p_temp->num_readers, 0);
+
+  pthread_mutex_init(&p_temp->mutex, NULL);
+
+  //deadlines are on the monotonic clock, a wall clock step must not stretch a timed wait.
+  pthread_condattr_init(&cond_attr);
+
+  pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+
+  pthread_cond_init(&p_temp->data_cond, &cond_attr);
+
+  pthread_cond_init(&p_temp->space_cond, &cond_attr);
+
+  pthread_condattr_destroy(&cond_attr);
+
+  return p_temp;
+}
+
+//Free a ring buffer and set the pointer to NULL.
+void dsp_ringFree(struct s_dsp_ring **pp_ring)
+{
+  if(!pp_ring) return;
+
+  if(!*pp_ring) return;
+
+  pthread_cond_destroy(&(*pp_ring)->space_cond);
+
+  pthread_cond_destroy(&(*pp_ring)->data_cond);
+
+  pthread_mutex_destroy(&(*pp_ring)->mutex);
+
+  free((*pp_ring)->p_readers);
+
+  free((*pp_ring)->p_spsc);
+
+  free((*pp_ring)->p_tags);
+
+#ifdef DSP_NODE_LATENCY
+  free((*pp_ring)->p_stamps);
+#endif
+
+  dsp_freeMem(&(*pp_ring)->alloc, (*pp_ring)->p_buffer, (*pp_ring)->buffer_size * (*pp_ring)->type_size);
+
+  free(*pp_ring);
+
+  *pp_ring = NULL;
+}
+
+//Add a read cursor, starts at the current write position.
+int dsp_ringAddReader(struct s_dsp_ring *p_ring, unsigned int *p_reader)
+{
+  unsigned int reader = 0;
+
+  if(!p_ring || !p_reader) return ~0;
+
+  //one reader at a time, a ended reader can be replaced.
+  if(p_ring->p_spsc)
+  {
+    if(atomic_load(&p_ring->p_spsc->read_alive)) return ~0;
+
+    atomic_store(&p_ring->p_spsc->read_index, atomic_load(&p_ring->p_spsc->write_index));
+
+    atomic_store(&p_ring->p_spsc->added_ns, ring_now());
+
+    atomic_store(&p_ring->p_spsc->read_alive, 1);
+
+    *p_reader = 0;
+
+    atomic_store_explicit(&p_ring->num_readers, 1, memory_order_release);
+
+    return 0;
+  }
+
+  pthread_mutex_lock(&p_ring->mutex);
+
+  reader = atomic_load_explicit(&p_ring->num_readers, memory_order_relaxed);
+
+  if(reader >= DSP_RING_READERS)
+  {
+    pthread_mutex_unlock(&p_ring->mutex);
+
+    fprintf(stderr, "ERROR: Ring buffer %p already has %d readers.\n", (void *)p_ring, DSP_RING_READERS);
+
+    return ~0;
+  }
+
+  p_ring->p_readers[reader].read_index = p_ring->write_index;
+
+  p_ring->p_readers[reader].alive = 1;
+
+  atomic_store_explicit(&p_ring->p_readers[reader].blocked, 0, memory_order_relaxed);
+
+  p_ring->p_readers[reader].high_water = 0;
+
+  p_ring->p_readers[reader].empty_ns = 0;
+
+  p_ring->p_readers[reader].empty_since = 0;
+
+  p_ring->p_readers[reader].added_ns = ring_now();
+
+  *p_reader = reader;
+
+  //the slot is filled in before the count covers it, a thread checking a reader without the mutex sees it whole.
+  atomic_store_explicit(&p_ring->num_readers, reader + 1, memory_order_release);
+
+  pthread_mutex_unlock(&p_ring->mutex);
+
+  return 0;
+}
+
+//Write elements, blocks till all of them fit past the slowest reader.
+unsigned long dsp_ringBlockingWrite(struct s_dsp_ring *p_ring, void const *p_data, unsigned long size)
+{
+  return dsp_ringTimedWrite(p_ring, p_data, size, DSP_RING_FOREVER, NULL);
+}
+
+//Read elements, blocks till size elements are available or the writer ended.
+unsigned long dsp_ringBlockingRead(struct s_dsp_ring *p_ring, unsigned int reader, void *p_data, unsigned long size)
+{
+  return dsp_ringTimedRead(p_ring, reader, p_data, size, DSP_RING_FOREVER, NULL);
+}
+
+//Wait till size elements are available to a reader without reading them.
+unsigned long dsp_ringWaitRead(struct s_dsp_ring *p_ring, unsigned int reader, unsigned long size)
+{
+  return dsp_ringTimedWaitRead(p_ring, reader, size, DSP_RING_FOREVER, NULL);
+}
+
+//Deadline for the timed calls, timeout_ns from now on the monotonic clock.
+unsigned long long dsp_ringDeadline(unsigned long long timeout_ns)
+{
+  unsigned long long now = 0;
+
+  if(timeout_ns == DSP_RING_FOREVER) return DSP_RING_FOREVER;
+
+  now = ring_now();
+
+  //a timeout past the end of the clock is forever.
+  if(timeout_ns >= DSP_RING_FOREVER - now) return DSP_RING_FOREVER;
+
+  return now + timeout_ns;
+}
+
+//Write elements, blocks till all of them fit past the slowest reader or the deadline passes.
+unsigned long dsp_ringTimedWrite(struct s_dsp_ring *p_ring, void const *p_data, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel)
+{
+  int timeout = 0;
+
+  unsigned long num_wrote = 0;
+
+  if(!p_ring || !p_data) return 0;
+
+  if(p_ring->p_spsc)
+  {
+    while(num_wrote < size)
+    {
+      int           space = 0;
+      unsigned long chunk = 0;
+      unsigned long index = 0;
+
+      chunk = size - num_wrote;
+
+      if(chunk > p_ring->buffer_size) chunk = p_ring->buffer_size;
+
+      space = spsc_wait_space(p_ring->p_spsc, p_ring->buffer_size, chunk, deadline, p_cancel);
+
+      timeout = (space < 0);
+
+      if(space <= 0) break;
+
+      index = atomic_load_explicit(&p_ring->p_spsc->write_index, memory_order_relaxed);
+
+      ring_copy(p_ring, index, (uint8_t *)p_data + (num_wrote * p_ring->type_size), chunk, 1);
+
+#ifdef DSP_NODE_LATENCY
+      ring_stamp(p_ring, index + chunk);
+#endif
+
+      atomic_store_explicit(&p_ring->p_spsc->write_index, index + chunk, memory_order_release);
+
+      spsc_wake(&p_ring->p_spsc->data_seq, &p_ring->p_spsc->data_sleeping);
+
+      spsc_fill_mark(p_ring->p_spsc, index + chunk);
+
+      num_wrote += chunk;
+    }
+
+    return ((timeout && !num_wrote) ? DSP_RING_TIMEOUT : num_wrote);
+  }
+
+  pthread_mutex_lock(&p_ring->mutex);
+
+  while(num_wrote < size)
+  {
+    unsigned int  num_alive = 0;
+    unsigned long chunk     = 0;
+
+    chunk = size - num_wrote;
+
+    if(chunk > p_ring->buffer_size) chunk = p_ring->buffer_size;
+
+    timeout = wait_space(p_ring, chunk, &num_alive, deadline, p_cancel);
+
+    //no one left to read, the writer was ended out from under us or out of time.
+    if(!num_alive || !p_ring->write_alive || timeout) break;
+
+    ring_copy(p_ring, p_ring->write_index, (uint8_t *)p_data + (num_wrote * p_ring->type_size), chunk, 1);
+
+#ifdef DSP_NODE_LATENCY
+    ring_stamp(p_ring, p_ring->write_index + chunk);
+#endif
+
+    p_ring->write_index += chunk;
+
+    num_wrote += chunk;
+
+    fill_mark(p_ring);
+
+    pthread_cond_broadcast(&p_ring->data_cond);
+  }
+
+  pthread_mutex_unlock(&p_ring->mutex);
+
+  return ((timeout && !num_wrote) ? DSP_RING_TIMEOUT : num_wrote);
+}
+
+//Read elements, blocks till size elements are available, the writer ended or the deadline passes.
+unsigned long dsp_ringTimedRead(struct s_dsp_ring *p_ring, unsigned int reader, void *p_data, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel)
+{
+  unsigned long available = 0;
+
+  struct s_dsp_ring_reader *p_reader = NULL;
+
+  if(!p_ring || !p_data) return 0;
+
+  if(reader >= atomic_load_explicit(&p_ring->num_readers, memory_order_acquire)) return 0;
+
+  if(size > p_ring->buffer_size) size = p_ring->buffer_size;
+
+  if(p_ring->p_spsc)
+  {
+    unsigned long index = 0;
+
+    available = spsc_wait_data(p_ring->p_spsc, size, deadline, p_cancel);
+
+    if(!available || (available == DSP_RING_TIMEOUT)) return available;
+
+    index = atomic_load_explicit(&p_ring->p_spsc->read_index, memory_order_relaxed);
+
+    ring_copy(p_ring, index, p_data, available, 0);
+
+    atomic_store_explicit(&p_ring->p_spsc->read_index, index + available, memory_order_release);
+
+    spsc_wake(&p_ring->p_spsc->space_seq, &p_ring->p_spsc->space_sleeping);
+
+    return available;
+  }
+
+  pthread_mutex_lock(&p_ring->mutex);
+
+  p_reader = &p_ring->p_readers[reader];
+
+  available = wait_data(p_ring, p_reader, size, deadline, p_cancel);
+
+  if(available && (available != DSP_RING_TIMEOUT))
+  {
+    ring_copy(p_ring, p_reader->read_index, p_data, available, 0);
+
+    p_reader->read_index += available;
+
+    pthread_cond_signal(&p_ring->space_cond);
+  }
+
+  pthread_mutex_unlock(&p_ring->mutex);
+
+  return available;
+}
+
+//Wait till size elements are available to a reader without reading them, or the deadline passes.
+unsigned long dsp_ringTimedWaitRead(struct s_dsp_ring *p_ring, unsigned int reader, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel)
+{
+  unsigned long available = 0;
+
+  struct s_dsp_ring_reader *p_reader = NULL;
+
+  if(!p_ring) return 0;
+
+  if(reader >= atomic_load_explicit(&p_ring->num_readers, memory_order_acquire)) return 0;
+
+  if(size > p_ring->buffer_size) size = p_ring->buffer_size;
+
+  if(p_ring->p_spsc) return spsc_wait_data(p_ring->p_spsc, size, deadline, p_cancel);
+
+  pthread_mutex_lock(&p_ring->mutex);
+
+  p_reader = &p_ring->p_readers[reader];
+
+  available = wait_data(p_ring, p_reader, size, deadline, p_cancel);
+
+  pthread_mutex_unlock(&p_ring->mutex);
+
+  return available;
+}
+
+//Number of elements a reader can read right now, does not block.
+unsigned long dsp_ringAvailable(struct s_dsp_ring *p_ring, unsigned int reader, int *p_ended)
+{
+  unsigned long available = 0;
+
+  if(!p_ring || !p_ended) return 0;
+
+  *p_ended = 1;
+
+  if(reader >= atomic_load_explicit(&p_ring->num_readers, memory_order_acquire)) return 0;
+
+  if(p_ring->p_spsc)
+  {
+    //alive is checked before the index, a ended writer has published everything it wrote.
+    *p_ended = !atomic_load(&p_ring->p_spsc->write_alive) || !atomic_load(&p_ring->p_spsc->read_alive);
+
+    return atomic_load_explicit(&p_ring->p_spsc->write_index, memory_order_acquire) - atomic_load_explicit(&p_ring->p_spsc->read_index, memory_order_relaxed);
+  }
+
+  pthread_mutex_lock(&p_ring->mutex);
+
+  *p_ended = !p_ring->write_alive || !p_ring->p_readers[reader].alive;
+
+  available = p_ring->write_index - p_ring->p_readers[reader].read_index;
+
+  pthread_mutex_unlock(&p_ring->mutex);
+
+  return available;
+}
+
+//Number of elements the writer can write right now, does not block.
+unsigned long dsp_ringSpace(struct s_dsp_ring *p_ring, int *p_ended)
+{
+  unsigned int  num_alive = 0;
+  unsigned long space     = 0;
+
+  if(!p_ring || !p_ended) return 0;
+
+  if(p_ring->p_spsc)
+  {
+    *p_ended = !atomic_load(&p_ring->p_spsc->read_alive) || !atomic_load(&p_ring->p_spsc->write_alive);
+
+    return p_ring->buffer_size - (atomic_load_explicit(&p_ring->p_spsc->write_index, memory_order_relaxed) - atomic_load_explicit(&p_ring->p_spsc->read_index, memory_order_acquire));
+  }
+
+  pthread_mutex_lock(&p_ring->mutex);
+
+  space = p_ring->buffer_size - used_space(p_ring, &num_alive);
+
+  *p_ended = !num_alive || !p_ring->write_alive;
+
+  pthread_mutex_unlock(&p_ring->mutex);
+
+  return space;
+}
+
+//Reserve contiguous space in ring memory for the writer, blocks till it is free.
+unsigned long dsp_ringReserve(struct s_dsp_ring *p_ring, void **pp_data, unsigned long size)
+{
+  return dsp_ringTimedReserve(p_ring, pp_data, size, DSP_RING_FOREVER, NULL);
+}
+
+//Reserve contiguous space in ring memory for the writer, blocks till it is free or the deadline passes.
+unsigned long dsp_ringTimedReserve(struct s_dsp_ring *p_ring, void **pp_data, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel)
+{
+  int           space     = 0;
+  unsigned int  num_alive = 0;
+  unsigned long offset    = 0;
+
+  if(!p_ring || !pp_data) return 0;
+
+  *pp_data = NULL;
+
+  if(p_ring->p_spsc)
+  {
+    offset = atomic_load_explicit(&p_ring->p_spsc->write_index, memory_order_relaxed) % p_ring->buffer_size;
+
+    if(size > p_ring->buffer_size - offset) size = p_ring->buffer_size - offset;
+
+    space = spsc_wait_space(p_ring->p_spsc, p_ring->buffer_size, size, deadline, p_cancel);
+
+    if(space < 0) return DSP_RING_TIMEOUT;
+
+    if(!space) return 0;
+
+    if(size) *pp_data = (uint8_t *)p_ring->p_buffer + (offset * p_ring->type_size);
+
+    return size;
+  }
+
+  pthread_mutex_lock(&p_ring->mutex);
+
+  offset = p_ring->write_index % p_ring->buffer_size;
+
+  //space past the wrap is not contiguous, the next reserve gets it.
+  if(size > p_ring->buffer_size - offset) size = p_ring->buffer_size - offset;
+
+  if(wait_space(p_ring, size, &num_alive, deadline, p_cancel))
+  {
+    size = DSP_RING_TIMEOUT;
+  }
+  else if(!num_alive || !p_ring->write_alive)
+  {
+    size = 0;
+  }
+
+  pthread_mutex_unlock(&p_ring->mutex);
+
+  if(size && (size != DSP_RING_TIMEOUT)) *pp_data = (uint8_t *)p_ring->p_buffer + (offset * p_ring->type_size);
+
+  return size;
+}
+
+//Commit elements written to reserved space, readers can now see them.
+void dsp_ringCommit(struct s_dsp_ring *p_ring, unsigned long size)
+{
+  if(!p_ring || !size) return;
+
+  if(p_ring->p_spsc)
+  {
+#ifdef DSP_NODE_LATENCY
+    ring_stamp(p_ring, atomic_load_explicit(&p_ring->p_spsc->write_index, memory_order_relaxed) + size);
+#endif
+
+    spsc_fill_mark(p_ring->p_spsc, atomic_fetch_add_explicit(&p_ring->p_spsc->write_index, size, memory_order_release) + size);
+
+    spsc_wake(&p_ring->p_spsc->data_seq, &p_ring->p_spsc->data_sleeping);
+
+    return;
+  }
+
+  pthread_mutex_lock(&p_ring->mutex);
+
+#ifdef DSP_NODE_LATENCY
+  ring_stamp(p_ring, p_ring->write_index + size);
+#endif
+
+  p_ring->write_index += size;
+
+  fill_mark(p_ring);
+
+  pthread_cond_broadcast(&p_ring->data_cond);
+
+  pthread_mutex_unlock(&p_ring->mutex);
+}
+
+//Peek at contiguous elements in ring memory for a reader, blocks till they are available.
+unsigned long dsp_ringPeek(struct s_dsp_ring *p_ring, unsigned int reader, void const **pp_data, unsigned long size)
+{
+  return dsp_ringTimedPeek(p_ring, reader, pp_data, size, DSP_RING_FOREVER, NULL);
+}
+
+//Peek at contiguous elements in ring memory for a reader, blocks till they are available or the deadline passes.
+unsigned long dsp_ringTimedPeek(struct s_dsp_ring *p_ring, unsigned int reader, void const **pp_data, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel)
+{
+  unsigned long available = 0;
+  unsigned long offset    = 0;
+
+  struct s_dsp_ring_reader *p_reader = NULL;
+
+  if(!p_ring || !pp_data) return 0;
+
+  *pp_data = NULL;
+
+  if(reader >= atomic_load_explicit(&p_ring->num_readers, memory_order_acquire)) return 0;
+
+  if(p_ring->p_spsc)
+  {
+    offset = atomic_load_explicit(&p_ring->p_spsc->read_index, memory_order_relaxed) % p_ring->buffer_size;
+
+    if(size > p_ring->buffer_size - offset) size = p_ring->buffer_size - offset;
+
+    available = spsc_wait_data(p_ring->p_spsc, size, deadline, p_cancel);
+  }
+  else
+  {
+    pthread_mutex_lock(&p_ring->mutex);
+
+    p_reader = &p_ring->p_readers[reader];
+
+    offset = p_reader->read_index % p_ring->buffer_size;
+
+    //data past the wrap is not contiguous, the next peek gets it.
+    if(size > p_ring->buffer_size - offset) size = p_ring->buffer_size - offset;
+
+    available = wait_data(p_ring, p_reader, size, deadline, p_cancel);
+
+    pthread_mutex_unlock(&p_ring->mutex);
+  }
+
+  if(available && (available != DSP_RING_TIMEOUT)) *pp_data = (uint8_t *)p_ring->p_buffer + (offset * p_ring->type_size);
+
+  return available;
+}
+
+//Release elements from a peek, the writer can now reuse the space.
+void dsp_ringRelease(struct s_dsp_ring *p_ring, unsigned int reader, unsigned long size)
+{
+  if(!p_ring || !size) return;
+
+  if(p_ring->p_spsc)
+  {
+    atomic_fetch_add_explicit(&p_ring->p_spsc->read_index, size, memory_order_release);
+
+    spsc_wake(&p_ring->p_spsc->space_seq, &p_ring->p_spsc->space_sleeping);
+
+    return;
+  }
+
+  pthread_mutex_lock(&p_ring->mutex);
+
+  if(reader < atomic_load_explicit(&p_ring->num_readers, memory_order_acquire)) p_ring->p_readers[reader].read_index += size;
+
+  pthread_cond_signal(&p_ring->space_cond);
+
+  pthread_mutex_unlock(&p_ring->mutex);
+}
+
+//Writer end of stream, readers drain what is left then read 0.
+void dsp_ringEndWrite(struct s_dsp_ring *p_ring)
+{
+  if(!p_ring) return;
+
+  if(p_ring->p_spsc)
+  {
+    atomic_store(&p_ring->p_spsc->write_alive, 0);
+
+    spsc_wake(&p_ring->p_spsc->data_seq, &p_ring->p_spsc->data_sleeping);
+
+    spsc_wake(&p_ring->p_spsc->space_seq, &p_ring->p_spsc->space_sleeping);
+
+    return;
+  }
+
+  pthread_mutex_lock(&p_ring->mutex);
+
+  p_ring->write_alive = 0;
+
+  pthread_cond_broadcast(&p_ring->data_cond);
+
+  pthread_cond_broadcast(&p_ring->space_cond);
+
+  pthread_mutex_unlock(&p_ring->mutex);
+}
+
+//Reader end of stream, the reader no longer holds back the writer.
+void dsp_ringEndRead(struct s_dsp_ring *p_ring, unsigned int reader)
+{
+  if(!p_ring) return;
+
+  if(p_ring->p_spsc)
+  {
+    if(reader >= atomic_load_explicit(&p_ring->num_readers, memory_order_acquire)) return;
+
+    atomic_store(&p_ring->p_spsc->read_alive, 0);
+
+    spsc_wake(&p_ring->p_spsc->data_seq, &p_ring->p_spsc->data_sleeping);
+
+    spsc_wake(&p_ring->p_spsc->space_seq, &p_ring->p_spsc->space_sleeping);
+
+    return;
+  }
+
+  pthread_mutex_lock(&p_ring->mutex);
+
+  if(reader < atomic_load_explicit(&p_ring->num_readers, memory_order_acquire)) p_ring->p_readers[reader].alive = 0;
+
+  pthread_cond_broadcast(&p_ring->data_cond);
+
+  pthread_cond_broadcast(&p_ring->space_cond);
+
+  pthread_mutex_unlock(&p_ring->mutex);
+}
+
+//Wake every writer and reader waiting on the ring so they check their cancel flag.
+void dsp_ringInterrupt(struct s_dsp_ring *p_ring)
+{
+  if(!p_ring) return;
+
+  //the cancel flag is already set, a spsc side checks it after it announces a sleep.
+  if(p_ring->p_spsc)
+  {
+    spsc_wake(&p_ring->p_spsc->data_seq, &p_ring->p_spsc->data_sleeping);
+
+    spsc_wake(&p_ring->p_spsc->space_seq, &p_ring->p_spsc->space_sleeping);
+
+    return;
+  }
+
+  //taking the mutex orders the broadcast after any check of the flag made with it held.
+  pthread_mutex_lock(&p_ring->mutex);
+
+  pthread_cond_broadcast(&p_ring->data_cond);
+
+  pthread_cond_broadcast(&p_ring->space_cond);
+
+  pthread_mutex_unlock(&p_ring->mutex);
+}
+
+//Number of writes that had to wait on space.
+unsigned long dsp_ringWriteBlocked(struct s_dsp_ring *p_ring)
+{
+  if(!p_ring) return 0;
+
+  if(p_ring->p_spsc) return atomic_load_explicit(&p_ring->p_spsc->write_blocked, memory_order_relaxed);
+
+  //a stats poll must not contend with the writer and readers for the mutex.
+  return atomic_load_explicit(&p_ring->write_blocked, memory_order_relaxed);
+}
+
+//Number of reads of a reader that had to wait on data.
+unsigned long dsp_ringReadBlocked(struct s_dsp_ring *p_ring, unsigned int reader)
+{
+  if(!p_ring) return 0;
+
+  if(p_ring->p_spsc) return atomic_load_explicit(&p_ring->p_spsc->read_blocked, memory_order_relaxed);
+
+  //the slots are fixed and zeroed with the ring, a slot not added yet reads 0 without the mutex.
+  if(reader >= DSP_RING_READERS) return 0;
+
+  return atomic_load_explicit(&p_ring->p_readers[reader].blocked, memory_order_relaxed);
+}
+
+//Fill level telemetry of a reader.
+int dsp_ringFill(struct s_dsp_ring *p_ring, unsigned int reader, struct s_dsp_ring_fill *p_fill)
+{
+  unsigned long long now = 0;
+  unsigned long long since = 0;
+
+  if(!p_ring || !p_fill) return ~0;
+
+  if(reader >= atomic_load_explicit(&p_ring->num_readers, memory_order_acquire)) return ~0;
+
+  now = ring_now();
+
+  p_fill->size = p_ring->buffer_size;
+
+  if(p_ring->p_spsc)
+  {
+    p_fill->fill = atomic_load_explicit(&p_ring->p_spsc->write_index, memory_order_relaxed) - atomic_load_explicit(&p_ring->p_spsc->read_index, memory_order_relaxed);
+
+    //the indexes are read apart, a reader passing in between looks like a wrap.
+    if(p_fill->fill > p_ring->buffer_size) p_fill->fill = 0;
+
+    p_fill->high_water = atomic_load_explicit(&p_ring->p_spsc->high_water, memory_order_relaxed);
+
+    //a wait still going counts up to now.
+    since = atomic_load_explicit(&p_ring->p_spsc->full_since, memory_order_relaxed);
+
+    p_fill->full_ns = atomic_load_explicit(&p_ring->p_spsc->full_ns, memory_order_relaxed) + (since && (now > since) ? now - since : 0);
+
+    since = atomic_load_explicit(&p_ring->p_spsc->empty_since, memory_order_relaxed);
+
+    p_fill->empty_ns = atomic_load_explicit(&p_ring->p_spsc->empty_ns, memory_order_relaxed) + (since && (now > since) ? now - since : 0);
+
+    p_fill->elapsed_ns = now - atomic_load_explicit(&p_ring->p_spsc->added_ns, memory_order_relaxed);
+
+    return 0;
+  }
+
+  pthread_mutex_lock(&p_ring->mutex);
+
+  p_fill->fill = p_ring->write_index - p_ring->p_readers[reader].read_index;
+
+  p_fill->high_water = p_ring->p_readers[reader].high_water;
+
+  p_fill->full_ns = p_ring->full_ns + (p_ring->full_since ? now - p_ring->full_since : 0);
+
+  p_fill->empty_ns = p_ring->p_readers[reader].empty_ns + (p_ring->p_readers[reader].empty_since ? now - p_ring->p_readers[reader].empty_since : 0);
+
+  p_fill->elapsed_ns = now - p_ring->p_readers[reader].added_ns;
+
+  pthread_mutex_unlock(&p_ring->mutex);
+
+  return 0;
+}
+
+//Absolute offset of the next element the writer commits.
+unsigned long dsp_ringWriteOffset(struct s_dsp_ring *p_ring)
+{
+  if(!p_ring) return 0;
+
+  if(p_ring->p_spsc) return atomic_load_explicit(&p_ring->p_spsc->write_index, memory_order_relaxed);
+
+  //only the writer changes it, so the writer reads it without the mutex.
+  return p_ring->write_index;
+}
+
+//Absolute offset of the next element a reader reads.
+unsigned long dsp_ringReadOffset(struct s_dsp_ring *p_ring, unsigned int reader)
+{
+  unsigned long read_index = 0;
+
+  if(!p_ring) return 0;
+
+  if(reader >= atomic_load_explicit(&p_ring->num_readers, memory_order_acquire)) return 0;
+
+  if(p_ring->p_spsc) return atomic_load_explicit(&p_ring->p_spsc->read_index, memory_order_relaxed);
+
+  pthread_mutex_lock(&p_ring->mutex);
+
+  read_index = p_ring->p_readers[reader].read_index;
+
+  pthread_mutex_unlock(&p_ring->mutex);
+
+  return read_index;
+}
+
+//Add a tag to the side channel.
+int dsp_ringAddTag(struct s_dsp_ring *p_ring, struct s_dsp_tag const *p_tag)
+{
+  unsigned long num_tags = 0;
+
+  if(!p_ring || !p_tag) return ~0;
+
+  num_tags = atomic_load_explicit(&p_ring->p_tags->num_tags, memory_order_relaxed);
+
+  //readers stop at the first tag past what they asked for, so tags must be in order.
+  if(num_tags && (p_tag->offset < atomic_load_explicit(&p_ring->p_tags->tags[(num_tags - 1) % DSP_RING_TAGS].offset, memory_order_relaxed))) return ~0;
+
+  atomic_store_explicit(&p_ring->p_tags->tags[num_tags % DSP_RING_TAGS].offset, p_tag->offset, memory_order_relaxed);
+
+  atomic_store_explicit(&p_ring->p_tags->tags[num_tags % DSP_RING_TAGS].key, p_tag->key, memory_order_relaxed);
+
+  atomic_store_explicit(&p_ring->p_tags->tags[num_tags % DSP_RING_TAGS].value_int, p_tag->value_int, memory_order_relaxed);
+
+  atomic_store_explicit(&p_ring->p_tags->tags[num_tags % DSP_RING_TAGS].value_real, p_tag->value_real, memory_order_relaxed);
+
+  atomic_store_explicit(&p_ring->p_tags->num_tags, num_tags + 1, memory_order_release);
+
+  return 0;
+}
+
+//Get the tags on the next size elements of a reader.
+unsigned long dsp_ringGetTags(struct s_dsp_ring *p_ring, unsigned int reader, unsigned long size, unsigned long *p_cursor, struct s_dsp_tag *p_tags, unsigned long max)
+{
+  unsigned long num_tags  = 0;
+  unsigned long cursor    = 0;
+  unsigned long start     = 0;
+  unsigned long num_found = 0;
+
+  if(!p_ring || !p_cursor || !p_tags) return 0;
+
+  num_tags = atomic_load_explicit(&p_ring->p_tags->num_tags, memory_order_acquire);
+
+  cursor = *p_cursor;
+
+  //nothing new, the common case never touches the read index.
+  if(cursor == num_tags) return 0;
+
+  //the writer lapped this reader, the oldest tags are gone.
+  if(num_tags - cursor > DSP_RING_TAGS) cursor = num_tags - DSP_RING_TAGS;
+
+  start = dsp_ringReadOffset(p_ring, reader);
+
+  while((cursor < num_tags) && (num_found < max))
+  {
+    struct s_dsp_tag tag;
+
+    tag.offset = atomic_load_explicit(&p_ring->p_tags->tags[cursor % DSP_RING_TAGS].offset, memory_order_relaxed);
+
+    //tags are in order, the rest are past what was asked for.
+    if((tag.offset >= start) && (tag.offset - start >= size)) break;
+
+    tag.key = atomic_load_explicit(&p_ring->p_tags->tags[cursor % DSP_RING_TAGS].key, memory_order_relaxed);
+
+    tag.value_int = atomic_load_explicit(&p_ring->p_tags->tags[cursor % DSP_RING_TAGS].value_int, memory_order_relaxed);
+
+    tag.value_real = atomic_load_explicit(&p_ring->p_tags->tags[cursor % DSP_RING_TAGS].value_real, memory_order_relaxed);
+
+    //rewritten while it was read, skip to the oldest tag left.
+    if(atomic_load_explicit(&p_ring->p_tags->num_tags, memory_order_acquire) - cursor > DSP_RING_TAGS)
+    {
+      num_tags = atomic_load_explicit(&p_ring->p_tags->num_tags, memory_order_acquire);
+
+      cursor = num_tags - DSP_RING_TAGS;
+
+      continue;
+    }
+
+    cursor++;
+
+    //tags on elements already read were meant for before this reader.
+    if(tag.offset < start) continue;
+
+    p_tags[num_found] = tag;
+
+    num_found++;
+  }
+
+  *p_cursor = cursor;
+
+  return num_found;
+}
+
+//number of elements between the writer and the slowest alive reader, returns 0 readers alive in p_alive.
+static unsigned long used_space(struct s_dsp_ring const * const p_ring, unsigned int *p_alive)
+{
+  unsigned int  index = 0;
+  unsigned int  num_readers = 0;
+  unsigned long used  = 0;
+
+  *p_alive = 0;
+
+  num_readers = atomic_load_explicit(&p_ring->num_readers, memory_order_acquire);
+
+  for(index = 0; index < num_readers; index++)
+  {
+    if(!p_ring->p_readers[index].alive) continue;
+
+    (*p_alive)++;
+
+    if(p_ring->write_index - p_ring->p_readers[index].read_index > used) used = p_ring->write_index - p_ring->p_readers[index].read_index;
+  }
+
+  return used;
+}
+
+//wait with the mutex held till size elements are free, the stream ended, the deadline passed or p_cancel is set, returns 0 readers alive in p_alive and 1 on a passed deadline or cancel.
+static int wait_space(struct s_dsp_ring * const p_ring, unsigned long size, unsigned int *p_alive, unsigned long long deadline, atomic_int const *p_cancel)
+{
+  int timeout = 0;
+
+  if((p_ring->buffer_size - used_space(p_ring, p_alive) >= size) || !*p_alive || !p_ring->write_alive) return 0;
+
+  atomic_fetch_add_explicit(&p_ring->write_blocked, 1, memory_order_relaxed);
+
+  p_ring->full_since = ring_now();
+
+  while((p_ring->buffer_size - used_space(p_ring, p_alive) < size) && *p_alive && p_ring->write_alive)
+  {
+    //checked with the mutex held, dsp_ringInterrupt takes it to broadcast so the set flag is never missed.
+    if(timeout || ring_cancelled(p_cancel))
+    {
+      timeout = 1;
+
+      break;
+    }
+
+    timeout = wait_cond(p_ring, &p_ring->space_cond, deadline);
+  }
+
+  p_ring->full_ns += ring_now() - p_ring->full_since;
+
+  p_ring->full_since = 0;
+
+  //space that came in with the deadline still counts.
+  return (timeout && (p_ring->buffer_size - used_space(p_ring, p_alive) < size) && *p_alive && p_ring->write_alive);
+}
+
+//wait with the mutex held till a reader has size elements, the stream ended, the deadline passed or p_cancel is set, returns available (max of size) or DSP_RING_TIMEOUT.
+static unsigned long wait_data(struct s_dsp_ring * const p_ring, struct s_dsp_ring_reader * const p_reader, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel)
+{
+  int           timeout   = 0;
+  unsigned long available = 0;
+
+  available = p_ring->write_index - p_reader->read_index;
+
+  if((available < size) && p_ring->write_alive && p_reader->alive)
+  {
+    atomic_fetch_add_explicit(&p_reader->blocked, 1, memory_order_relaxed);
+
+    p_reader->empty_since = ring_now();
+
+    while(((available = p_ring->write_index - p_reader->read_index) < size) && p_ring->write_alive && p_reader->alive)
+    {
+      if(timeout || ring_cancelled(p_cancel))
+      {
+        timeout = 1;
+
+        break;
+      }
+
+      timeout = wait_cond(p_ring, &p_ring->data_cond, deadline);
+    }
+
+    p_reader->empty_ns += ring_now() - p_reader->empty_since;
+
+    p_reader->empty_since = 0;
+  }
+
+  if(!p_reader->alive) return 0;
+
+  //the loop only leaves short with the stream alive when out of time or cancelled.
+  if((available < size) && p_ring->write_alive) return DSP_RING_TIMEOUT;
+
+  return (available > size ? size : available);
+}
+
+//wait on a cond with the mutex held till it is signaled or the deadline passed, returns 1 on a passed deadline.
+static int wait_cond(struct s_dsp_ring * const p_ring, pthread_cond_t *p_cond, unsigned long long deadline)
+{
+  struct timespec time;
+
+  if(deadline == DSP_RING_FOREVER)
+  {
+    pthread_cond_wait(p_cond, &p_ring->mutex);
+
+    return 0;
+  }
+
+  ring_timespec(deadline, &time);
+
+  return (pthread_cond_timedwait(p_cond, &p_ring->mutex, &time) == ETIMEDOUT);
+}
+
+//copy size elements in or out of the ring at absolute index, handles the wrap.
+static void ring_copy(struct s_dsp_ring const * const p_ring, unsigned long index, void *p_data, unsigned long size, int to_ring)
+{
+  unsigned long offset  = 0;
+  unsigned long first   = 0;
+
+  uint8_t *p_ring_data = NULL;
+
+  if(!size) return;
+
+  offset = index % p_ring->buffer_size;
+
+  first = p_ring->buffer_size - offset;
+
+  if(first > size) first = size;
+
+  p_ring_data = (uint8_t *)p_ring->p_buffer;
+
+  if(to_ring)
+  {
+    memcpy(p_ring_data + (offset * p_ring->type_size), p_data, first * p_ring->type_size);
+
+    memcpy(p_ring_data, (uint8_t *)p_data + (first * p_ring->type_size), (size - first) * p_ring->type_size);
+  }
+  else
+  {
+    memcpy(p_data, p_ring_data + (offset * p_ring->type_size), first * p_ring->type_size);
+
+    memcpy((uint8_t *)p_data + (first * p_ring->type_size), p_ring_data, (size - first) * p_ring->type_size);
+  }
+}
+
+//spsc, spin then sleep till size elements are free, the deadline passed or p_cancel is set, returns 1 free, 0 if the reader or writer ended, -1 on a passed deadline or cancel.
+static int spsc_wait_space(struct s_dsp_ring_spsc * const p_spsc, unsigned long buffer_size, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel)
+{
+  int           blocked     = 0;
+  unsigned int  spin        = 0;
+  unsigned long write_index = 0;
+
+  write_index = atomic_load_explicit(&p_spsc->write_index, memory_order_relaxed);
+
+  for(;;)
+  {
+    unsigned int seq = 0;
+
+    if(!atomic_load(&p_spsc->read_alive) || !atomic_load(&p_spsc->write_alive))
+    {
+      if(blocked) spsc_wait_done(&p_spsc->full_ns, &p_spsc->full_since);
+
+      return 0;
+    }
+
+    if(buffer_size - (write_index - atomic_load_explicit(&p_spsc->read_index, memory_order_acquire)) >= size)
+    {
+      if(blocked) spsc_wait_done(&p_spsc->full_ns, &p_spsc->full_since);
+
+      return 1;
+    }
+
+    //only the writer stores it, relaxed keeps it off the fast path.
+    if(!blocked)
+    {
+      blocked = 1;
+
+      atomic_store_explicit(&p_spsc->write_blocked, atomic_load_explicit(&p_spsc->write_blocked, memory_order_relaxed) + 1, memory_order_relaxed);
+
+      atomic_store_explicit(&p_spsc->full_since, ring_now(), memory_order_relaxed);
+    }
+
+    //the clock is only read when there is a deadline, after the space was checked once more.
+    if(ring_cancelled(p_cancel) || ((deadline != DSP_RING_FOREVER) && (ring_now() >= deadline)))
+    {
+      spsc_wait_done(&p_spsc->full_ns, &p_spsc->full_since);
+
+      return -1;
+    }
+
+    if(spin < p_spsc->spin_limit)
+    {
+      spin++;
+
+      spsc_relax();
+
+      continue;
+    }
+
+    //announce the sleep then check again, the reader sees the flag or we see its release.
+    seq = atomic_load(&p_spsc->space_seq);
+
+    atomic_store(&p_spsc->space_sleeping, 1);
+
+    if(atomic_load(&p_spsc->read_alive) && atomic_load(&p_spsc->write_alive) && (buffer_size - (write_index - atomic_load(&p_spsc->read_index)) < size) && !ring_cancelled(p_cancel))
+    {
+      spsc_sleep(&p_spsc->space_seq, seq, deadline);
+    }
+
+    atomic_store(&p_spsc->space_sleeping, 0);
+  }
+}
+
+//spsc, spin then sleep till size elements are available, the writer ended, the deadline passed or p_cancel is set, returns available (max of size) or DSP_RING_TIMEOUT.
+static unsigned long spsc_wait_data(struct s_dsp_ring_spsc * const p_spsc, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel)
+{
+  int           blocked    = 0;
+  unsigned int  spin       = 0;
+  unsigned long read_index = 0;
+
+  read_index = atomic_load_explicit(&p_spsc->read_index, memory_order_relaxed);
+
+  for(;;)
+  {
+    int           write_alive = 0;
+    unsigned int  seq         = 0;
+    unsigned long available   = 0;
+
+    if(!atomic_load(&p_spsc->read_alive))
+    {
+      if(blocked) spsc_wait_done(&p_spsc->empty_ns, &p_spsc->empty_since);
+
+      return 0;
+    }
+
+    //alive is checked before the index, a ended writer has published everything it wrote.
+    write_alive = atomic_load(&p_spsc->write_alive);
+
+    available = atomic_load_explicit(&p_spsc->write_index, memory_order_acquire) - read_index;
+
+    if((available >= size) || !write_alive)
+    {
+      if(blocked) spsc_wait_done(&p_spsc->empty_ns, &p_spsc->empty_since);
+
+      return (available > size ? size : available);
+    }
+
+    //only the reader stores it, relaxed keeps it off the fast path.
+    if(!blocked)
+    {
+      blocked = 1;
+
+      atomic_store_explicit(&p_spsc->read_blocked, atomic_load_explicit(&p_spsc->read_blocked, memory_order_relaxed) + 1, memory_order_relaxed);
+
+      atomic_store_explicit(&p_spsc->empty_since, ring_now(), memory_order_relaxed);
+    }
+
+    //the clock is only read when there is a deadline, after the data was checked once more.
+    if(ring_cancelled(p_cancel) || ((deadline != DSP_RING_FOREVER) && (ring_now() >= deadline)))
+    {
+      spsc_wait_done(&p_spsc->empty_ns, &p_spsc->empty_since);
+
+      return DSP_RING_TIMEOUT;
+    }
+
+    if(spin < p_spsc->spin_limit)
+    {
+      spin++;
+
+      spsc_relax();
+
+      continue;
+    }
+
+    //announce the sleep then check again, the writer sees the flag or we see its commit.
+    seq = atomic_load(&p_spsc->data_seq);
+
+    atomic_store(&p_spsc->data_sleeping, 1);
+
+    if(atomic_load(&p_spsc->read_alive) && atomic_load(&p_spsc->write_alive) && (atomic_load(&p_spsc->write_index) - read_index < size) && !ring_cancelled(p_cancel))
+    {
+      spsc_sleep(&p_spsc->data_seq, seq, deadline);
+    }
+
+    atomic_store(&p_spsc->data_sleeping, 0);
+  }
+}
+
+//monotonic time in nanoseconds, for fill telemetry, latency stamps and deadlines.
+static unsigned long long ring_now(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec;
+}
+
+//absolute monotonic time in nanoseconds to a timespec.
+static void ring_timespec(unsigned long long time_ns, struct timespec *p_time)
+{
+  p_time->tv_sec = (time_t)(time_ns / 1000000000ULL);
+
+  p_time->tv_nsec = (long)(time_ns % 1000000000ULL);
+}
+
+//mark the high water of every alive reader, called by the writer with the mutex held.
+static void fill_mark(struct s_dsp_ring * const p_ring)
+{
+  unsigned int index = 0;
+  unsigned int num_readers = 0;
+
+  num_readers = atomic_load_explicit(&p_ring->num_readers, memory_order_acquire);
+
+  for(index = 0; index < num_readers; index++)
+  {
+    if(!p_ring->p_readers[index].alive) continue;
+
+    if(p_ring->write_index - p_ring->p_readers[index].read_index > p_ring->p_readers[index].high_water) p_ring->p_readers[index].high_water = p_ring->write_index - p_ring->p_readers[index].read_index;
+  }
+}
+
+//spsc, mark the high water of the reader, called by the writer after the index is published.
+static void spsc_fill_mark(struct s_dsp_ring_spsc * const p_spsc, unsigned long write_index)
+{
+  unsigned long fill = 0;
+
+  fill = write_index - atomic_load_explicit(&p_spsc->read_index, memory_order_relaxed);
+
+  //only the writer stores it.
+  if(fill > atomic_load_explicit(&p_spsc->high_water, memory_order_relaxed)) atomic_store_explicit(&p_spsc->high_water, fill, memory_order_relaxed);
+}
+
+//spsc, add the time since a wait started to its total and clear the start.
+static void spsc_wait_done(atomic_ullong *p_total, atomic_ullong *p_since)
+{
+  atomic_store_explicit(p_total, atomic_load_explicit(p_total, memory_order_relaxed) + (ring_now() - atomic_load_explicit(p_since, memory_order_relaxed)), memory_order_relaxed);
+
+  atomic_store_explicit(p_since, 0, memory_order_relaxed);
+}
+
+//spsc, wake the other side if it is sleeping on p_seq.
+static void spsc_wake(atomic_uint *p_seq, atomic_int *p_sleeping)
+{
+  //orders the index store before the sleeping load, pairs with the sleepers store then check.
+  atomic_thread_fence(memory_order_seq_cst);
+
+  if(!atomic_load_explicit(p_sleeping, memory_order_relaxed)) return;
+
+  //only the first wake after a sleep pays for the syscall.
+  if(!atomic_exchange(p_sleeping, 0)) return;
+
+  atomic_fetch_add(p_seq, 1);
+
+#ifdef __linux__
+  syscall(SYS_futex, (unsigned int *)p_seq, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#endif
+}
+
+//spsc, sleep on p_seq if it still equals seq, no longer then the deadline.
+static void spsc_sleep(atomic_uint *p_seq, unsigned int seq, unsigned long long deadline)
+{
+#ifdef __linux__
+  struct timespec time;
+
+  if(deadline == DSP_RING_FOREVER)
+  {
+    syscall(SYS_futex, (unsigned int *)p_seq, FUTEX_WAIT_PRIVATE, seq, NULL, NULL, 0);
+
+    return;
+  }
+
+  //a bitset wait takes a absolute monotonic timeout, a plain wait only a relative one.
+  ring_timespec(deadline, &time);
+
+  syscall(SYS_futex, (unsigned int *)p_seq, FUTEX_WAIT_BITSET_PRIVATE, seq, &time, NULL, FUTEX_BITSET_MATCH_ANY);
+#else
+  struct timespec sleep_time = {0, 50000};
+
+  (void)deadline;
+
+  if(atomic_load(p_seq) == seq) nanosleep(&sleep_time, NULL);
+#endif
+}
+
+//spsc, cpu hint while spinning.
+static void spsc_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+//1 if a wait was cancelled, p_cancel may be NULL.
+static int ring_cancelled(atomic_int const *p_cancel)
+{
+  if(!p_cancel) return 0;
+
+  return atomic_load(p_cancel) != 0;
+}
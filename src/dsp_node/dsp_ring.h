@@ -0,0 +1,655 @@
+//******************************************************************************
+/// @file     dsp_ring.h
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Ring buffer for DSP node edges, one writer with N readers.
+/// @details  Each reader has its own read cursor, the slowest reader sets
+///           how much space the writer has available.
+//******************************************************************************
+
+#ifndef __dsp_ring
+#define __dsp_ring
+
+// includes
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "dsp_alloc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @enum e_dsp_ring_type
+ * @brief Ring buffer backend, locked allows fan out, spsc is lock free with a single consumer.
+ */
+enum e_dsp_ring_type {DSP_RING_LOCKED=0, DSP_RING_SPSC};
+
+/**
+ * @struct s_dsp_ring_spsc
+ * @brief Lock free single producer single consumer state, private to dsp_ring.c.
+ */
+struct s_dsp_ring_spsc;
+
+/**
+ * @def DSP_RING_TAGS
+ * Number of tags a ring keeps, a reader more then this many tags behind loses the oldest.
+ */
+#define DSP_RING_TAGS 256
+
+/**
+ * @def DSP_RING_READERS
+ * Number of read cursors a DSP_RING_LOCKED ring holds, allocated with the ring so a cursor never moves.
+ */
+#define DSP_RING_READERS 64
+
+/**
+ * @def DSP_RING_FOREVER
+ * Deadline of a timed call that never passes, the call blocks like the untimed one.
+ */
+#define DSP_RING_FOREVER (~0ULL)
+
+/**
+ * @def DSP_RING_TIMEOUT
+ * Returned by a timed call when the deadline passed before it could be done, nothing was moved.
+ */
+#define DSP_RING_TIMEOUT (~0UL)
+
+/**
+ * @enum e_dsp_tag_key
+ * Keys of stream tags, nodes may use their own keys from DSP_TAG_USER up.
+ */
+enum e_dsp_tag_key {DSP_TAG_TIME=0, DSP_TAG_RATE, DSP_TAG_BURST_START, DSP_TAG_BURST_END, DSP_TAG_USER=256};
+
+/**
+ * @struct s_dsp_tag
+ * @brief Key/value tag on a absolute element offset of a ring (edge).
+ */
+struct s_dsp_tag
+{
+  /**
+   * @var s_dsp_tag::offset
+   * absolute element offset in the stream of the ring, the first element written is 0.
+   */
+  unsigned long offset;
+  /**
+   * @var s_dsp_tag::key
+   * e_dsp_tag_key or a node key from DSP_TAG_USER up.
+   */
+  unsigned int key;
+  /**
+   * @var s_dsp_tag::value_int
+   * integer value, DSP_TAG_TIME full seconds.
+   */
+  long long value_int;
+  /**
+   * @var s_dsp_tag::value_real
+   * real value, DSP_TAG_TIME fractional seconds, DSP_TAG_RATE samples per second.
+   */
+  double value_real;
+};
+
+/**
+ * @struct s_dsp_ring_tags
+ * @brief Tags in write order, private to dsp_ring.c.
+ */
+struct s_dsp_ring_tags;
+
+#ifdef DSP_NODE_LATENCY
+/**
+ * @def DSP_RING_STAMPS
+ * Number of write timestamps a ring keeps, older ones are overwritten.
+ */
+#define DSP_RING_STAMPS 256
+
+/**
+ * @struct s_dsp_ring_stamps
+ * @brief Time each write entered the ring, private to dsp_ring.c.
+ */
+struct s_dsp_ring_stamps;
+#endif
+
+/**
+ * @struct s_dsp_ring_reader
+ * @brief Read cursor for a single consumer of a dsp ring.
+ */
+struct s_dsp_ring_reader
+{
+  /**
+   * @var s_dsp_ring_reader::read_index
+   * absolute number of elements read by this reader.
+   */
+  unsigned long read_index;
+  /**
+   * @var s_dsp_ring_reader::alive
+   * 1 reader is consuming, 0 reader has ended and no longer holds back the writer.
+   */
+  int alive;
+  /**
+   * @var s_dsp_ring_reader::blocked
+   * number of reads that had to wait on data, atomic so stats read it without the mutex.
+   */
+  atomic_ulong blocked;
+  /**
+   * @var s_dsp_ring_reader::high_water
+   * most elements ever waiting for this reader.
+   */
+  unsigned long high_water;
+  /**
+   * @var s_dsp_ring_reader::empty_ns
+   * time in nanoseconds this reader waited on a empty ring.
+   */
+  unsigned long long empty_ns;
+  /**
+   * @var s_dsp_ring_reader::empty_since
+   * time the current wait on data started, 0 not waiting.
+   */
+  unsigned long long empty_since;
+  /**
+   * @var s_dsp_ring_reader::added_ns
+   * time the reader was added.
+   */
+  unsigned long long added_ns;
+};
+
+/**
+ * @struct s_dsp_ring_fill
+ * @brief Fill level telemetry of a ring for one reader (one edge), from dsp_ringFill.
+ */
+struct s_dsp_ring_fill
+{
+  /**
+   * @var s_dsp_ring_fill::size
+   * size of the ring in elements.
+   */
+  unsigned long size;
+  /**
+   * @var s_dsp_ring_fill::fill
+   * elements waiting for the reader now.
+   */
+  unsigned long fill;
+  /**
+   * @var s_dsp_ring_fill::high_water
+   * most elements ever waiting for the reader.
+   */
+  unsigned long high_water;
+  /**
+   * @var s_dsp_ring_fill::full_ns
+   * time in nanoseconds the writer waited on a full ring (slow consumer).
+   */
+  unsigned long long full_ns;
+  /**
+   * @var s_dsp_ring_fill::empty_ns
+   * time in nanoseconds the reader waited on a empty ring (starved by the producer).
+   */
+  unsigned long long empty_ns;
+  /**
+   * @var s_dsp_ring_fill::elapsed_ns
+   * time in nanoseconds since the reader was added, full_ns and empty_ns are fractions of it.
+   */
+  unsigned long long elapsed_ns;
+};
+
+/**
+ * @struct s_dsp_ring
+ * @brief Ring buffer with a single writer and any number of readers (fan out).
+ */
+struct s_dsp_ring
+{
+  /**
+   * @var s_dsp_ring::type
+   * backend of the ring, DSP_RING_SPSC uses p_spsc instead of the mutex, indexes and p_readers.
+   */
+  enum e_dsp_ring_type type;
+  /**
+   * @var s_dsp_ring::p_spsc
+   * lock free indexes for DSP_RING_SPSC, NULL for DSP_RING_LOCKED.
+   */
+  struct s_dsp_ring_spsc *p_spsc;
+  /**
+   * @var s_dsp_ring::p_tags
+   * tag side channel, written by the writer and walked by each reader with its own cursor.
+   */
+  struct s_dsp_ring_tags *p_tags;
+#ifdef DSP_NODE_LATENCY
+  /**
+   * @var s_dsp_ring::p_stamps
+   * time each write entered the ring, for per chunk latency.
+   */
+  struct s_dsp_ring_stamps *p_stamps;
+#endif
+  /**
+   * @var s_dsp_ring::alloc
+   * allocation policy p_buffer was allocated with.
+   */
+  struct s_dsp_alloc alloc;
+  /**
+   * @var s_dsp_ring::p_buffer
+   * buffer memory, buffer_size * type_size bytes.
+   */
+  void *p_buffer;
+  /**
+   * @var s_dsp_ring::buffer_size
+   * size of the buffer in elements.
+   */
+  unsigned long buffer_size;
+  /**
+   * @var s_dsp_ring::type_size
+   * size of a element in bytes.
+   */
+  unsigned long type_size;
+  /**
+   * @var s_dsp_ring::write_index
+   * absolute number of elements written.
+   */
+  unsigned long write_index;
+  /**
+   * @var s_dsp_ring::write_alive
+   * 1 writer is producing, 0 writer has ended (end of stream).
+   */
+  int write_alive;
+  /**
+   * @var s_dsp_ring::write_blocked
+   * number of writes that had to wait on space, atomic so stats read it without the mutex.
+   */
+  atomic_ulong write_blocked;
+  /**
+   * @var s_dsp_ring::full_ns
+   * time in nanoseconds the writer waited on a full ring.
+   */
+  unsigned long long full_ns;
+  /**
+   * @var s_dsp_ring::full_since
+   * time the current wait on space started, 0 not waiting.
+   */
+  unsigned long long full_since;
+  /**
+   * @var s_dsp_ring::p_readers
+   * array of DSP_RING_READERS read cursors, one per consumer, never reallocated
+   * since a waiting reader holds a pointer to its cursor.
+   */
+  struct s_dsp_ring_reader *p_readers;
+  /**
+   * @var s_dsp_ring::num_readers
+   * number of read cursors in p_readers, stored with release once a cursor is
+   * filled in so readers and stats check it with a acquire load and no mutex.
+   */
+  atomic_uint num_readers;
+  /**
+   * @var s_dsp_ring::mutex
+   * protects indexes and reader list.
+   */
+  pthread_mutex_t mutex;
+  /**
+   * @var s_dsp_ring::data_cond
+   * signaled when data is written or the writer ends.
+   */
+  pthread_cond_t data_cond;
+  /**
+   * @var s_dsp_ring::space_cond
+   * signaled when data is read or a reader ends.
+   */
+  pthread_cond_t space_cond;
+};
+
+/**************************************************************************//**
+  * @brief Allocate a ring buffer.
+  *
+  * @param buffer_size number of elements the ring holds.
+  * @param type_size size in bytes of each element.
+  * @param type DSP_RING_LOCKED for any number of readers, DSP_RING_SPSC for a
+  * lock free ring with one reader.
+  * @param p_alloc allocation policy of the buffer memory, NULL for malloc.
+  *
+  * @return allocated ring buffer, NULL on error.
+  ****************************************************************************/
+struct s_dsp_ring *dsp_ringCreate(unsigned long buffer_size, unsigned long type_size, enum e_dsp_ring_type type, struct s_dsp_alloc const *p_alloc);
+
+/**************************************************************************//**
+  * @brief Free a ring buffer and set the pointer to NULL.
+  *
+  * @param pp_ring pointer to the ring buffer pointer.
+  ****************************************************************************/
+void dsp_ringFree(struct s_dsp_ring **pp_ring);
+
+/**************************************************************************//**
+  * @brief Add a read cursor, starts at the current write position.
+  *
+  * @param p_ring ring buffer to add a reader to.
+  * @param p_reader returns the reader number to use for reads.
+  *
+  * @return 0 no error, non-zero indicates error. A DSP_RING_SPSC ring errors
+  * if it already has a reader that has not ended, a DSP_RING_LOCKED ring once
+  * DSP_RING_READERS readers were added.
+  ****************************************************************************/
+int dsp_ringAddReader(struct s_dsp_ring *p_ring, unsigned int *p_reader);
+
+/**************************************************************************//**
+  * @brief Write elements, blocks till all of them fit past the slowest reader.
+  *
+  * @param p_ring ring buffer to write to.
+  * @param p_data data to write.
+  * @param size number of elements to write.
+  *
+  * @return number of elements written, less then size when no readers are left.
+  ****************************************************************************/
+unsigned long dsp_ringBlockingWrite(struct s_dsp_ring *p_ring, void const *p_data, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Read elements, blocks till size elements are available or the writer ended.
+  *
+  * @param p_ring ring buffer to read from.
+  * @param reader reader number from dsp_ringAddReader.
+  * @param p_data buffer to read into.
+  * @param size max number of elements to read.
+  *
+  * @return number of elements read, 0 at end of stream.
+  ****************************************************************************/
+unsigned long dsp_ringBlockingRead(struct s_dsp_ring *p_ring, unsigned int reader, void *p_data, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Wait till size elements are available to a reader without reading them.
+  *
+  * @param p_ring ring buffer to wait on.
+  * @param reader reader number from dsp_ringAddReader.
+  * @param size number of elements to wait for.
+  *
+  * @return number of elements available (max of size), less at end of stream.
+  ****************************************************************************/
+unsigned long dsp_ringWaitRead(struct s_dsp_ring *p_ring, unsigned int reader, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Deadline for the timed calls, timeout_ns from now on the monotonic
+  * clock.
+  *
+  * @param timeout_ns nanoseconds from now, DSP_RING_FOREVER never passes.
+  *
+  * @return absolute deadline in nanoseconds.
+  ****************************************************************************/
+unsigned long long dsp_ringDeadline(unsigned long long timeout_ns);
+
+/**************************************************************************//**
+  * @brief Write elements, blocks till all of them fit past the slowest reader
+  * or the deadline passes.
+  *
+  * @param p_ring ring buffer to write to.
+  * @param p_data data to write.
+  * @param size number of elements to write.
+  * @param deadline from dsp_ringDeadline, a passed deadline only writes what fits now.
+  * @param p_cancel flag that ends a wait early when non-zero, as if the
+  * deadline passed. NULL for none.
+  *
+  * @return number of elements written, less then size when no readers are
+  * left or the deadline passed after a part more then the ring size was
+  * written. DSP_RING_TIMEOUT if the deadline passed before any was written.
+  ****************************************************************************/
+unsigned long dsp_ringTimedWrite(struct s_dsp_ring *p_ring, void const *p_data, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel);
+
+/**************************************************************************//**
+  * @brief Read elements, blocks till size elements are available, the writer
+  * ended or the deadline passes.
+  *
+  * @param p_ring ring buffer to read from.
+  * @param reader reader number from dsp_ringAddReader.
+  * @param p_data buffer to read into.
+  * @param size max number of elements to read.
+  * @param deadline from dsp_ringDeadline, a passed deadline only reads if size is there now.
+  * @param p_cancel flag that ends a wait early when non-zero, as if the
+  * deadline passed. NULL for none.
+  *
+  * @return number of elements read, 0 at end of stream, DSP_RING_TIMEOUT if
+  * the deadline passed with less then size available (nothing is read).
+  ****************************************************************************/
+unsigned long dsp_ringTimedRead(struct s_dsp_ring *p_ring, unsigned int reader, void *p_data, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel);
+
+/**************************************************************************//**
+  * @brief Wait till size elements are available to a reader without reading
+  * them, or the deadline passes.
+  *
+  * @param p_ring ring buffer to wait on.
+  * @param reader reader number from dsp_ringAddReader.
+  * @param size number of elements to wait for.
+  * @param deadline from dsp_ringDeadline.
+  * @param p_cancel flag that ends a wait early when non-zero, as if the
+  * deadline passed. NULL for none.
+  *
+  * @return number of elements available (max of size), less at end of stream,
+  * DSP_RING_TIMEOUT if the deadline passed with less then size available.
+  ****************************************************************************/
+unsigned long dsp_ringTimedWaitRead(struct s_dsp_ring *p_ring, unsigned int reader, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel);
+
+/**************************************************************************//**
+  * @brief Number of elements a reader can read right now, does not block.
+  *
+  * @param p_ring ring buffer to check.
+  * @param reader reader number from dsp_ringAddReader.
+  * @param p_ended returns 1 if the writer or this reader has ended, 0 if not.
+  *
+  * @return number of elements available.
+  ****************************************************************************/
+unsigned long dsp_ringAvailable(struct s_dsp_ring *p_ring, unsigned int reader, int *p_ended);
+
+/**************************************************************************//**
+  * @brief Number of elements the writer can write right now, does not block.
+  *
+  * @param p_ring ring buffer to check.
+  * @param p_ended returns 1 if the writer or every reader has ended, 0 if not.
+  *
+  * @return number of elements free.
+  ****************************************************************************/
+unsigned long dsp_ringSpace(struct s_dsp_ring *p_ring, int *p_ended);
+
+/**************************************************************************//**
+  * @brief Reserve contiguous space in ring memory for the writer, blocks till
+  * it is free. The space is only seen by readers after dsp_ringCommit.
+  *
+  * @param p_ring ring buffer to reserve space in.
+  * @param pp_data returns a pointer into ring memory, NULL when 0 is returned.
+  * @param size max number of elements to reserve.
+  *
+  * @return number of elements reserved, less then size at the end of the
+  * buffer (reserve again for the rest), 0 when no readers are left.
+  ****************************************************************************/
+unsigned long dsp_ringReserve(struct s_dsp_ring *p_ring, void **pp_data, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Reserve contiguous space in ring memory for the writer, blocks till
+  * it is free or the deadline passes.
+  *
+  * @param p_ring ring buffer to reserve space in.
+  * @param pp_data returns a pointer into ring memory, NULL unless space was reserved.
+  * @param size max number of elements to reserve.
+  * @param deadline from dsp_ringDeadline.
+  * @param p_cancel flag that ends a wait early when non-zero, as if the
+  * deadline passed. NULL for none.
+  *
+  * @return number of elements reserved, 0 when no readers are left,
+  * DSP_RING_TIMEOUT if the deadline passed before the space was free.
+  ****************************************************************************/
+unsigned long dsp_ringTimedReserve(struct s_dsp_ring *p_ring, void **pp_data, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel);
+
+/**************************************************************************//**
+  * @brief Commit elements written to reserved space, readers can now see them.
+  *
+  * @param p_ring ring buffer to commit to.
+  * @param size number of elements to commit, no more then reserved.
+  ****************************************************************************/
+void dsp_ringCommit(struct s_dsp_ring *p_ring, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Peek at contiguous elements in ring memory for a reader, blocks till
+  * they are available or the writer ended. The data stays in the ring till
+  * dsp_ringRelease.
+  *
+  * @param p_ring ring buffer to peek in.
+  * @param reader reader number from dsp_ringAddReader.
+  * @param pp_data returns a pointer into ring memory, NULL when 0 is returned.
+  * @param size max number of elements to peek at.
+  *
+  * @return number of elements available, less then size at the end of the
+  * buffer (peek again for the rest), 0 at end of stream.
+  ****************************************************************************/
+unsigned long dsp_ringPeek(struct s_dsp_ring *p_ring, unsigned int reader, void const **pp_data, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Peek at contiguous elements in ring memory for a reader, blocks till
+  * they are available, the writer ended or the deadline passes.
+  *
+  * @param p_ring ring buffer to peek in.
+  * @param reader reader number from dsp_ringAddReader.
+  * @param pp_data returns a pointer into ring memory, NULL unless elements are returned.
+  * @param size max number of elements to peek at.
+  * @param deadline from dsp_ringDeadline.
+  * @param p_cancel flag that ends a wait early when non-zero, as if the
+  * deadline passed. NULL for none.
+  *
+  * @return number of elements available, 0 at end of stream,
+  * DSP_RING_TIMEOUT if the deadline passed with less then size available.
+  ****************************************************************************/
+unsigned long dsp_ringTimedPeek(struct s_dsp_ring *p_ring, unsigned int reader, void const **pp_data, unsigned long size, unsigned long long deadline, atomic_int const *p_cancel);
+
+/**************************************************************************//**
+  * @brief Release elements from a peek, the writer can now reuse the space.
+  *
+  * @param p_ring ring buffer the reader belongs to.
+  * @param reader reader number from dsp_ringAddReader.
+  * @param size number of elements to release, no more then peeked at.
+  ****************************************************************************/
+void dsp_ringRelease(struct s_dsp_ring *p_ring, unsigned int reader, unsigned long size);
+
+/**************************************************************************//**
+  * @brief Writer end of stream, readers drain what is left then read 0.
+  *
+  * @param p_ring ring buffer to end.
+  ****************************************************************************/
+void dsp_ringEndWrite(struct s_dsp_ring *p_ring);
+
+/**************************************************************************//**
+  * @brief Reader end of stream, the reader no longer holds back the writer.
+  *
+  * @param p_ring ring buffer the reader belongs to.
+  * @param reader reader number from dsp_ringAddReader.
+  ****************************************************************************/
+void dsp_ringEndRead(struct s_dsp_ring *p_ring, unsigned int reader);
+
+/**************************************************************************//**
+  * @brief Wake every writer and reader waiting on the ring so they check their
+  * cancel flag. Waits without a set flag go back to sleep.
+  *
+  * @param p_ring ring buffer to wake the waits of.
+  ****************************************************************************/
+void dsp_ringInterrupt(struct s_dsp_ring *p_ring);
+
+/**************************************************************************//**
+  * @brief Number of writes (write or reserve) that had to wait on space. Safe
+  * to call from any thread, a relaxed load that never takes the ring mutex.
+  *
+  * @param p_ring ring buffer to check.
+  *
+  * @return number of blocked writes.
+  ****************************************************************************/
+unsigned long dsp_ringWriteBlocked(struct s_dsp_ring *p_ring);
+
+/**************************************************************************//**
+  * @brief Number of reads (read, wait or peek) of a reader that had to wait on
+  * data. Safe to call from any thread, a relaxed load that never takes the
+  * ring mutex.
+  *
+  * @param p_ring ring buffer the reader belongs to.
+  * @param reader reader number from dsp_ringAddReader.
+  *
+  * @return number of blocked reads.
+  ****************************************************************************/
+unsigned long dsp_ringReadBlocked(struct s_dsp_ring *p_ring, unsigned int reader);
+
+/**************************************************************************//**
+  * @brief Fill level telemetry of a reader, safe to call from any thread.
+  * High water is marked on every write, full and empty time is taken only
+  * when a side has to wait so the fast path never reads the clock.
+  *
+  * @param p_ring ring buffer the reader belongs to.
+  * @param reader reader number from dsp_ringAddReader.
+  * @param p_fill returns size, fill, high water, full, empty and elapsed time.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_ringFill(struct s_dsp_ring *p_ring, unsigned int reader, struct s_dsp_ring_fill *p_fill);
+
+/**************************************************************************//**
+  * @brief Absolute offset of the next element the writer commits. Called by
+  * the writer thread, tag offsets are based on it.
+  *
+  * @param p_ring ring buffer to check.
+  *
+  * @return number of elements committed.
+  ****************************************************************************/
+unsigned long dsp_ringWriteOffset(struct s_dsp_ring *p_ring);
+
+/**************************************************************************//**
+  * @brief Absolute offset of the next element a reader reads.
+  *
+  * @param p_ring ring buffer the reader belongs to.
+  * @param reader reader number from dsp_ringAddReader.
+  *
+  * @return number of elements read (released) by the reader.
+  ****************************************************************************/
+unsigned long dsp_ringReadOffset(struct s_dsp_ring *p_ring, unsigned int reader);
+
+/**************************************************************************//**
+  * @brief Add a tag to the side channel. Called by the writer thread only,
+  * tags are added in offset order and before the element is committed so a
+  * reader sees the tag no later then the element.
+  *
+  * @param p_ring ring buffer to tag.
+  * @param p_tag tag to add, copied.
+  *
+  * @return 0 no error, non-zero indicates error or a offset before the last tag.
+  ****************************************************************************/
+int dsp_ringAddTag(struct s_dsp_ring *p_ring, struct s_dsp_tag const *p_tag);
+
+/**************************************************************************//**
+  * @brief Get the tags on the next size elements of a reader. Called by the
+  * reader thread only. Tags before the read position are skipped, a tag is
+  * only returned once. Does not lock or read the clock if there are no new tags.
+  *
+  * @param p_ring ring buffer the reader belongs to.
+  * @param reader reader number from dsp_ringAddReader.
+  * @param size number of elements from the read position to get tags for.
+  * @param p_cursor tag cursor of the reader, starts at 0 and is kept between calls.
+  * @param p_tags returns the tags in offset order.
+  * @param max number of tags p_tags holds, the rest are returned next call.
+  *
+  * @return number of tags returned.
+  ****************************************************************************/
+unsigned long dsp_ringGetTags(struct s_dsp_ring *p_ring, unsigned int reader, unsigned long size, unsigned long *p_cursor, struct s_dsp_tag *p_tags, unsigned long max);
+
+#ifdef DSP_NODE_LATENCY
+/**************************************************************************//**
+  * @brief Monotonic time in nanoseconds, the clock ring timestamps use.
+  *
+  * @return time in nanoseconds.
+  ****************************************************************************/
+unsigned long long dsp_ringStampNow(void);
+
+/**************************************************************************//**
+  * @brief Time the write holding a element of a reader entered the ring.
+  * Called by the reader thread only.
+  *
+  * @param p_ring ring buffer the reader belongs to.
+  * @param reader reader number from dsp_ringAddReader.
+  * @param behind element to look up, counted back from the read position (0
+  * is the next element to read, 1 the last one read).
+  * @param p_cursor stamp cursor of the reader, starts at 0 and is kept between
+  * calls so each lookup only walks the new stamps.
+  *
+  * @return time in nanoseconds from dsp_ringStampNow, 0 if unknown.
+  ****************************************************************************/
+unsigned long long dsp_ringStampTime(struct s_dsp_ring *p_ring, unsigned int reader, unsigned long behind, unsigned long *p_cursor);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
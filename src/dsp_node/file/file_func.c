@@ -10,11 +10,18 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include <poll.h>
 
+#include <sys/stat.h>
+
+#include "dsp_node.h"
 #include "file_func.h"
 #include "kill_throbber.h"
 #include "logger.h"
 
+//wait till the file can be read or written, the node is ended or a poll period passed, returns 1 ready.
+static int file_wait(struct s_dsp_node * const p_dsp_node, short events);
+
 //Setup file arg struct for file read/write init callbacks
 struct s_file_func_args *create_file_args(char *p_name, enum e_binary_type input_type, enum e_binary_type output_type, enum e_io_method io_method)
 {
@@ -62,6 +69,8 @@ void free_file_args(struct s_file_func_args *p_init_args)
 //Setup file reading thread
 int init_callback_file_read(void *p_init_args, void *p_object)
 {
+  struct stat file_stat;
+
   struct s_dsp_node *p_dsp_node = NULL;
 
   struct s_file_func_args *p_file_args = NULL;
@@ -84,6 +93,11 @@ int init_callback_file_read(void *p_init_args, void *p_object)
     return ~0;
   }
 
+  //a pipe or device is read unbuffered, so a poll on it sees all the data there is.
+  if(!fstat(fileno((FILE *)p_dsp_node->p_data), &file_stat) && !S_ISREG(file_stat.st_mode)) setvbuf((FILE *)p_dsp_node->p_data, NULL, _IONBF, 0);
+
+  p_dsp_node->process_call = process_callback_file_read;
+
   logger_info_msg(p_dsp_node->p_logger, "FILE READ node created for %p.", p_dsp_node);
 
   return 0;
@@ -92,7 +106,10 @@ int init_callback_file_read(void *p_init_args, void *p_object)
 //Pthread function for threading read
 void* pthread_function_file_read(void *p_data)
 {
-  uint8_t *p_buffer = NULL;
+  unsigned long numElemRead     = 0;
+  unsigned long numElemReserved = 0;
+
+  void *p_buffer = NULL;
 
   struct s_dsp_node *p_dsp_node = NULL;
 
@@ -102,48 +119,37 @@ void* pthread_function_file_read(void *p_data)
   {
     fprintf(stderr, "ERROR: Data Struct is NULL.\n");
 
-    kill_thread = 1;
-
-    goto error_cleanup;
+    return NULL;
   }
 
   p_dsp_node->active = 1;
 
-  p_buffer = malloc(p_dsp_node->chunk_size * p_dsp_node->output_type_size);
-
-  if(!p_buffer)
-  {
-    logger_error_msg(p_dsp_node->p_logger, "FILE READ, could not allocate file read buffer.");
-
-    kill_thread = 1;
-
-    goto error_cleanup;
-  }
-
   p_dsp_node->total_bytes_processed = 0;
 
   logger_info_msg(p_dsp_node->p_logger, "FILE READ thread started.");
 
   do
   {
-    unsigned long numElemRead   = 0;
-    unsigned long numElemWrote  = 0;
+    //a regular file is always ready, a pipe or device with nothing to read wakes on dsp_end.
+    if(!file_wait(p_dsp_node, POLLIN)) continue;
 
-    numElemRead = fread(p_buffer, p_dsp_node->output_type_size, p_dsp_node->chunk_size, (FILE *)p_dsp_node->p_data);
+    //read straight into the output ring, 0 reserved means every consumer has ended.
+    numElemReserved = dsp_reserveOutputTimed(p_dsp_node, &p_buffer, p_dsp_node->chunk_size, dsp_deadline(DSP_NODE_POLL_MS));
 
-    p_dsp_node->total_bytes_processed += numElemRead * p_dsp_node->output_type_size;
+    //no space in time, check kill_thread and wait again.
+    if(numElemReserved == DSP_NODE_TIMEOUT) continue;
 
-    do
-    {
-      numElemWrote += ringBufferBlockingWrite(p_dsp_node->p_output_ring_buffer, p_buffer + (numElemWrote * p_dsp_node->output_type_size), numElemRead - numElemWrote, NULL);
-    } while(numElemWrote < numElemRead);
+    if(!numElemReserved) break;
 
-  } while(!feof((FILE *)p_dsp_node->p_data) && !kill_thread);
+    numElemRead = fread(p_buffer, p_dsp_node->output_type_size, numElemReserved, (FILE *)p_dsp_node->p_data);
 
-error_cleanup:
-  free(p_buffer);
+    p_dsp_node->total_bytes_processed += numElemRead * p_dsp_node->output_type_size;
 
-  ringBufferEndBlocking(p_dsp_node->p_output_ring_buffer);
+    dsp_commitOutput(p_dsp_node, numElemRead);
+
+  } while(!feof((FILE *)p_dsp_node->p_data) && !ferror((FILE *)p_dsp_node->p_data) && !kill_thread && !dsp_isCancelled(p_dsp_node));
+
+  dsp_endOutput(p_dsp_node);
 
   logger_info_msg(p_dsp_node->p_logger, "FILE READ thread finished.");
 
@@ -152,6 +158,22 @@ error_cleanup:
   return NULL;
 }
 
+//Process callback for fused reads, fills the output block from the file.
+int process_callback_file_read(void *p_object, struct s_dsp_process *p_process)
+{
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_process->input_size = 0;
+
+  p_process->output_size = fread(p_process->p_output, p_dsp_node->output_type_size, p_process->output_size, (FILE *)p_dsp_node->p_data);
+
+  p_dsp_node->total_bytes_processed += p_process->output_size * p_dsp_node->output_type_size;
+
+  return feof((FILE *)p_dsp_node->p_data) || ferror((FILE *)p_dsp_node->p_data) || kill_thread || dsp_isCancelled(p_dsp_node);
+}
+
 //Clean up all allocations from init_callback read
 int free_callback_file_read(void *p_object)
 {
@@ -199,6 +221,8 @@ int init_callback_file_write(void *p_init_args, void *p_object)
     return ~0;
   }
 
+  p_dsp_node->process_call = process_callback_file_write;
+
   logger_info_msg(p_dsp_node->p_logger, "FILE WRITE node created for %p.", p_dsp_node);
 
   return 0;
@@ -209,7 +233,7 @@ void* pthread_function_file_write(void *p_data)
 {
   unsigned long numElemRead = 0;
 
-  uint8_t *p_buffer = NULL;
+  void const *p_buffer = NULL;
 
   struct s_dsp_node *p_dsp_node = NULL;
 
@@ -219,29 +243,16 @@ void* pthread_function_file_write(void *p_data)
   {
     fprintf(stderr, "ERROR: Data Struct is NULL.\n");
 
-    kill_thread = 1;
-
-    goto error_cleanup;
+    return NULL;
   }
 
   p_dsp_node->active = 1;
 
-  if(!p_dsp_node->p_input_ring_buffer)
+  if(!p_dsp_node->input_ports[0].p_ring_buffer)
   {
     logger_error_msg(p_dsp_node->p_logger, "FILE WRITE, no input buffer set for file write!");
 
-    kill_thread = 1;
-
-    goto error_cleanup;
-  }
-
-  p_buffer = malloc(p_dsp_node->chunk_size * p_dsp_node->input_type_size);
-
-  if(!p_buffer)
-  {
-    logger_error_msg(p_dsp_node->p_logger, "FILE WRITE, could not allocate file read buffer.");
-
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto error_cleanup;
   }
@@ -258,23 +269,46 @@ void* pthread_function_file_write(void *p_data)
   {
     unsigned long numElemWrote  = 0;
 
-    numElemRead = ringBufferBlockingRead(p_dsp_node->p_input_ring_buffer, p_buffer, p_dsp_node->chunk_size, NULL);
+    //write straight out of the input ring, no staging buffer.
+    numElemRead = dsp_peekInputTimed(p_dsp_node, &p_buffer, p_dsp_node->chunk_size, dsp_deadline(DSP_NODE_POLL_MS));
+
+    //no data in time, check kill_thread and wait again.
+    if(numElemRead == DSP_NODE_TIMEOUT) continue;
 
     p_dsp_node->total_bytes_processed += numElemRead * p_dsp_node->input_type_size;
 
-    do
+    //a ended node drops what it could not write.
+    while((numElemWrote < numElemRead) && !dsp_isCancelled(p_dsp_node))
     {
-      numElemWrote += fwrite(p_buffer + (numElemWrote * p_dsp_node->input_type_size), p_dsp_node->input_type_size, numElemRead - numElemWrote, (FILE *)p_dsp_node->p_data);
-    } while(numElemRead < numElemWrote);
+      unsigned long numElemFwrite = 0;
+
+      //a pipe or device no one is reading wakes on dsp_end instead of blocking in fwrite.
+      if(!file_wait(p_dsp_node, POLLOUT)) continue;
+
+      numElemFwrite = fwrite((uint8_t const *)p_buffer + (numElemWrote * p_dsp_node->input_type_size), p_dsp_node->input_type_size, numElemRead - numElemWrote, (FILE *)p_dsp_node->p_data);
+
+      if(!numElemFwrite)
+      {
+        logger_error_msg(p_dsp_node->p_logger, "FILE WRITE, write to file failed.");
+
+        dsp_statsError(p_dsp_node);
+
+        dsp_kill(p_dsp_node);
+
+        break;
+      }
+
+      numElemWrote += numElemFwrite;
+    }
 
     fflush((FILE *)p_dsp_node->p_data);
 
-  } while((numElemRead > 0) && !kill_thread);
+    dsp_releaseInput(p_dsp_node, numElemRead);
 
-error_cleanup:
-  free(p_buffer);
+  } while((numElemRead > 0) && !kill_thread && !dsp_isCancelled(p_dsp_node));
 
-  ringBufferEndBlocking(p_dsp_node->p_input_ring_buffer);
+error_cleanup:
+  dsp_endInput(p_dsp_node);
 
   logger_info_msg(p_dsp_node->p_logger, "FILE WRITE thread finished.");
 
@@ -283,6 +317,45 @@ error_cleanup:
   return NULL;
 }
 
+//Process callback for fused writes, writes the whole input block to the file.
+int process_callback_file_write(void *p_object, struct s_dsp_process *p_process)
+{
+  unsigned long numElemWrote = 0;
+
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_process->output_size = 0;
+
+  while(numElemWrote < p_process->input_size)
+  {
+    unsigned long numElemFwrite = 0;
+
+    numElemFwrite = fwrite((uint8_t const *)p_process->p_input + (numElemWrote * p_dsp_node->input_type_size), p_dsp_node->input_type_size, p_process->input_size - numElemWrote, (FILE *)p_dsp_node->p_data);
+
+    if(!numElemFwrite)
+    {
+      logger_error_msg(p_dsp_node->p_logger, "FILE WRITE, write to file failed.");
+
+      dsp_statsError(p_dsp_node);
+
+      p_process->input_size = numElemWrote;
+
+      return ~0;
+    }
+
+    numElemWrote += numElemFwrite;
+  }
+
+  p_dsp_node->total_bytes_processed += numElemWrote * p_dsp_node->input_type_size;
+
+  //everything given is consumed, done once the upstream has ended.
+  if(p_process->end_of_input) fflush((FILE *)p_dsp_node->p_data);
+
+  return p_process->end_of_input || kill_thread || dsp_isCancelled(p_dsp_node);
+}
+
 //Clean up all allocations from init_callback write
 int free_callback_file_write(void *p_object)
 {
@@ -294,3 +367,17 @@ int free_callback_file_write(void *p_object)
 
   return fclose((FILE *)p_dsp_node->p_data);
 }
+
+//wait till the file can be read or written, the node is ended or a poll period passed, returns 1 ready.
+static int file_wait(struct s_dsp_node * const p_dsp_node, short events)
+{
+  struct pollfd file_poll;
+
+  file_poll.fd = fileno((FILE *)p_dsp_node->p_data);
+
+  file_poll.events = events;
+
+  file_poll.revents = 0;
+
+  return dsp_poll(p_dsp_node, &file_poll, 1, dsp_deadline(DSP_NODE_POLL_MS)) > 0;
+}
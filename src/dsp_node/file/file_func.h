@@ -92,6 +92,16 @@ int init_callback_file_read(void *p_init_args, void *p_object);
   ****************************************************************************/
 void* pthread_function_file_read(void *p_data);
 
+/**************************************************************************//**
+  * @brief Process callback for fused reads, fills the output block from the file.
+  *
+  * @param p_object file read dsp node object.
+  * @param p_process output block to fill, output_size is set to elements read.
+  *
+  * @return 0 more data, non-zero end of file, error or kill.
+  ****************************************************************************/
+int process_callback_file_read(void *p_object, struct s_dsp_process *p_process);
+
 /**************************************************************************//**
   * @brief Clean up all allocations from init_callback
   *
@@ -122,6 +132,17 @@ int init_callback_file_write(void *p_init_args, void *p_object);
   ****************************************************************************/
 void* pthread_function_file_write(void *p_data);
 
+/**************************************************************************//**
+  * @brief Process callback for fused writes, writes the whole input block to
+  * the file.
+  *
+  * @param p_object file write dsp node object.
+  * @param p_process input block to write, input_size is set to elements written.
+  *
+  * @return 0 more data, non-zero end of input, error or kill.
+  ****************************************************************************/
+int process_callback_file_write(void *p_object, struct s_dsp_process *p_process);
+
 /**************************************************************************//**
   * @brief Clean up all allocations from init_callback
   *
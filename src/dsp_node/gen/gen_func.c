@@ -0,0 +1,822 @@
+//******************************************************************************
+/// @file     gen_func.c
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Synthetic source and null sink nodes for load generation.
+//******************************************************************************
+
+// standard includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "dsp_node.h"
+#include "dsp_convert.h"
+#include "gen_func.h"
+#include "kill_throbber.h"
+#include "logger.h"
+
+//doubles generated per pass before they are converted to the output type.
+#define GEN_BLOCK 4096
+
+//default seed of noise and PRBS.
+#define GEN_SEED 0x2545F4914F6CDD1DULL
+
+//generator state, the table holds a constant, tone or chirp in the output type.
+struct s_gen_data
+{
+  struct s_gen_func_args args;
+  void *p_table;
+  unsigned long table_size;
+  unsigned long table_bytes;
+  unsigned long table_index;
+  unsigned long written;
+  unsigned long long start_ns;
+  uint64_t state;
+  uint64_t bits;
+  unsigned int num_bits;
+  unsigned int components;
+  double block[GEN_BLOCK];
+};
+
+//null sink state, a and b are the Fletcher sums, partial a word split over two blocks.
+struct s_null_data
+{
+  int checksum;
+  uint64_t sum_a;
+  uint64_t sum_b;
+  uint8_t partial[8];
+  unsigned int partial_bytes;
+};
+
+//build the table of a constant, tone or chirp in the output type.
+static int gen_table(struct s_dsp_node * const p_dsp_node, struct s_gen_data * const p_gen);
+//fill size elements of the output type.
+static void gen_fill(struct s_gen_data * const p_gen, void *p_buffer, unsigned long size);
+//elements of size left before count, size for a endless stream.
+static unsigned long gen_remaining(struct s_gen_data const * const p_gen, unsigned long size);
+//sleep till the elements written are due at the rate, dsp_end wakes it.
+static void gen_pace(struct s_dsp_node * const p_dsp_node, struct s_gen_data * const p_gen);
+//1 for integer types, 0 for floating point.
+static int gen_integer(enum e_binary_type type);
+//next xorshift64* number.
+static uint64_t gen_random(struct s_gen_data * const p_gen);
+//add bytes to the checksum.
+static void null_sum(struct s_null_data * const p_null, uint8_t const *p_buffer, unsigned long bytes);
+//monotonic time in nanoseconds.
+static unsigned long long gen_now(void);
+
+//Setup generator arg struct for the generator init callback
+struct s_gen_func_args *create_gen_args(enum e_gen_wave wave, enum e_binary_type type, double rate, int pace, double amplitude, double freq, double freq_end, double sweep, unsigned long count, uint64_t seed)
+{
+  struct s_gen_func_args *p_temp = NULL;
+
+  p_temp = malloc(sizeof(struct s_gen_func_args));
+
+  if(!p_temp) return NULL;
+
+  p_temp->wave = wave;
+
+  p_temp->type = type;
+
+  p_temp->rate = rate;
+
+  p_temp->pace = pace;
+
+  p_temp->amplitude = amplitude;
+
+  p_temp->freq = freq;
+
+  p_temp->freq_end = freq_end;
+
+  p_temp->sweep = sweep;
+
+  p_temp->count = count;
+
+  p_temp->seed = seed;
+
+  return p_temp;
+}
+
+//Free args struct created from create gen args
+void free_gen_args(struct s_gen_func_args *p_init_args)
+{
+  if(!p_init_args)
+  {
+    fprintf(stderr, "ERROR: Null passed.\n");
+
+    return;
+  }
+
+  free(p_init_args);
+}
+
+//Setup null sink arg struct for the null init callback
+struct s_null_func_args *create_null_args(enum e_binary_type type, int checksum)
+{
+  struct s_null_func_args *p_temp = NULL;
+
+  p_temp = malloc(sizeof(struct s_null_func_args));
+
+  if(!p_temp) return NULL;
+
+  p_temp->type = type;
+
+  p_temp->checksum = checksum;
+
+  return p_temp;
+}
+
+//Free args struct created from create null args
+void free_null_args(struct s_null_func_args *p_init_args)
+{
+  if(!p_init_args)
+  {
+    fprintf(stderr, "ERROR: Null passed.\n");
+
+    return;
+  }
+
+  free(p_init_args);
+}
+
+// THREAD GENERATOR FUNCTIONS //
+
+//Setup generator thread
+int init_callback_gen(void *p_init_args, void *p_object)
+{
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_gen_func_args *p_gen_args = NULL;
+
+  struct s_gen_data *p_gen = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_gen_args = (struct s_gen_func_args *)p_init_args;
+
+  p_dsp_node->input_type = DATA_INVALID;
+
+  p_dsp_node->output_type = p_gen_args->type;
+
+  if(!dsp_convertSupported(DATA_DOUBLE, p_gen_args->type) && !dsp_convertSupported(DATA_CDOUBLE, p_gen_args->type))
+  {
+    logger_error_msg(p_dsp_node->p_logger, "GEN can not generate type %d.", p_gen_args->type);
+
+    return ~0;
+  }
+
+  p_gen = calloc(1, sizeof(struct s_gen_data));
+
+  if(!p_gen) return ~0;
+
+  p_dsp_node->p_data = p_gen;
+
+  p_gen->args = *p_gen_args;
+
+  p_gen->components = (dsp_convertSupported(DATA_CDOUBLE, p_gen_args->type) ? 2 : 1);
+
+  p_gen->state = (p_gen_args->seed ? p_gen_args->seed : GEN_SEED);
+
+  //PRBS31 register, all zeros would never leave zero.
+  if(p_gen->args.wave == GEN_PRBS)
+  {
+    p_gen->state &= 0x7FFFFFFF;
+
+    if(!p_gen->state) p_gen->state = 0x7FFFFFFF;
+  }
+
+  if(p_gen->args.rate > 0)
+  {
+    p_dsp_node->output_rate = p_gen->args.rate;
+  }
+  else if(p_gen->args.pace)
+  {
+    logger_warning_msg(p_dsp_node->p_logger, "GEN pace needs a rate, writing as fast as possible.");
+
+    p_gen->args.pace = 0;
+  }
+
+  if((p_gen->args.wave == GEN_CONSTANT) || (p_gen->args.wave == GEN_TONE) || (p_gen->args.wave == GEN_CHIRP))
+  {
+    if(gen_table(p_dsp_node, p_gen)) return ~0;
+  }
+
+  p_dsp_node->process_call = process_callback_gen;
+
+  logger_info_msg(p_dsp_node->p_logger, "GEN node created for %p.", p_dsp_node);
+
+  return 0;
+}
+
+//Pthread function for threading the generator
+void* pthread_function_gen(void *p_data)
+{
+  unsigned long numElemReserved = 0;
+
+  void *p_buffer = NULL;
+
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_gen_data *p_gen = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_data;
+
+  if(!p_dsp_node)
+  {
+    fprintf(stderr, "ERROR: Data Struct is NULL.\n");
+
+    return NULL;
+  }
+
+  p_gen = (struct s_gen_data *)p_dsp_node->p_data;
+
+  p_dsp_node->active = 1;
+
+  p_dsp_node->total_bytes_processed = 0;
+
+  logger_info_msg(p_dsp_node->p_logger, "GEN thread started.");
+
+  do
+  {
+    //generate straight into the output ring, 0 reserved means every consumer has ended.
+    numElemReserved = dsp_reserveOutputTimed(p_dsp_node, &p_buffer, gen_remaining(p_gen, p_dsp_node->chunk_size), dsp_deadline(DSP_NODE_POLL_MS));
+
+    //no space in time, check kill_thread and wait again.
+    if(numElemReserved == DSP_NODE_TIMEOUT) continue;
+
+    if(!numElemReserved) break;
+
+    gen_fill(p_gen, p_buffer, numElemReserved);
+
+    p_dsp_node->total_bytes_processed += numElemReserved * p_dsp_node->output_type_size;
+
+    dsp_commitOutput(p_dsp_node, numElemReserved);
+
+    gen_pace(p_dsp_node, p_gen);
+
+  } while(gen_remaining(p_gen, 1) && !kill_thread && !dsp_isCancelled(p_dsp_node));
+
+  dsp_endOutput(p_dsp_node);
+
+  logger_info_msg(p_dsp_node->p_logger, "GEN thread finished, %lu elements.", p_gen->written);
+
+  p_dsp_node->active = 0;
+
+  return NULL;
+}
+
+//Process callback for a fused generator, fills the output block.
+int process_callback_gen(void *p_object, struct s_dsp_process *p_process)
+{
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_gen_data *p_gen = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_gen = (struct s_gen_data *)p_dsp_node->p_data;
+
+  p_process->input_size = 0;
+
+  p_process->output_size = gen_remaining(p_gen, p_process->output_size);
+
+  gen_fill(p_gen, p_process->p_output, p_process->output_size);
+
+  p_dsp_node->total_bytes_processed += p_process->output_size * p_dsp_node->output_type_size;
+
+  gen_pace(p_dsp_node, p_gen);
+
+  return !gen_remaining(p_gen, 1) || kill_thread || dsp_isCancelled(p_dsp_node);
+}
+
+//Clean up all allocations from init_callback gen
+int free_callback_gen(void *p_object)
+{
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_gen_data *p_gen = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_gen = (struct s_gen_data *)p_dsp_node->p_data;
+
+  if(!p_gen) return 0;
+
+  if(p_gen->p_table) dsp_freeBuffer(p_dsp_node, p_gen->p_table, p_gen->table_bytes);
+
+  free(p_gen);
+
+  p_dsp_node->p_data = NULL;
+
+  return 0;
+}
+
+// THREAD NULL FUNCTIONS //
+
+//Setup null sink thread
+int init_callback_null(void *p_init_args, void *p_object)
+{
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_null_func_args *p_null_args = NULL;
+
+  struct s_null_data *p_null = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_null_args = (struct s_null_func_args *)p_init_args;
+
+  p_dsp_node->input_type = p_null_args->type;
+
+  p_dsp_node->output_type = DATA_INVALID;
+
+  p_null = calloc(1, sizeof(struct s_null_data));
+
+  if(!p_null) return ~0;
+
+  p_null->checksum = p_null_args->checksum;
+
+  p_dsp_node->p_data = p_null;
+
+  p_dsp_node->process_call = process_callback_null;
+
+  logger_info_msg(p_dsp_node->p_logger, "NULL node created for %p.", p_dsp_node);
+
+  return 0;
+}
+
+//Pthread function for threading the null sink
+void* pthread_function_null(void *p_data)
+{
+  unsigned long numElemRead = 0;
+
+  uint64_t checksum = 0;
+
+  void const *p_buffer = NULL;
+
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_null_data *p_null = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_data;
+
+  if(!p_dsp_node)
+  {
+    fprintf(stderr, "ERROR: Data Struct is NULL.\n");
+
+    return NULL;
+  }
+
+  p_null = (struct s_null_data *)p_dsp_node->p_data;
+
+  p_dsp_node->active = 1;
+
+  p_dsp_node->total_bytes_processed = 0;
+
+  logger_info_msg(p_dsp_node->p_logger, "NULL thread started.");
+
+  do
+  {
+    //checksum straight out of the input ring, no staging buffer.
+    numElemRead = dsp_peekInputTimed(p_dsp_node, &p_buffer, p_dsp_node->chunk_size, dsp_deadline(DSP_NODE_POLL_MS));
+
+    //no data in time, check kill_thread and wait again.
+    if(numElemRead == DSP_NODE_TIMEOUT) continue;
+
+    if(p_null->checksum) null_sum(p_null, (uint8_t const *)p_buffer, numElemRead * p_dsp_node->input_type_size);
+
+    p_dsp_node->total_bytes_processed += numElemRead * p_dsp_node->input_type_size;
+
+    dsp_releaseInput(p_dsp_node, numElemRead);
+
+  } while((numElemRead > 0) && !kill_thread && !dsp_isCancelled(p_dsp_node));
+
+  dsp_endInput(p_dsp_node);
+
+  get_null_checksum(p_dsp_node, &checksum);
+
+  logger_info_msg(p_dsp_node->p_logger, "NULL thread finished, %lu bytes checksum %016llx.", p_dsp_node->total_bytes_processed, (unsigned long long)checksum);
+
+  p_dsp_node->active = 0;
+
+  return NULL;
+}
+
+//Process callback for a fused null sink, checksums the input block.
+int process_callback_null(void *p_object, struct s_dsp_process *p_process)
+{
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_null_data *p_null = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_null = (struct s_null_data *)p_dsp_node->p_data;
+
+  p_process->output_size = 0;
+
+  if(p_null->checksum) null_sum(p_null, (uint8_t const *)p_process->p_input, p_process->input_size * p_dsp_node->input_type_size);
+
+  p_dsp_node->total_bytes_processed += p_process->input_size * p_dsp_node->input_type_size;
+
+  //everything given is consumed, done once the upstream has ended.
+  if(p_process->end_of_input)
+  {
+    uint64_t checksum = 0;
+
+    get_null_checksum(p_dsp_node, &checksum);
+
+    logger_info_msg(p_dsp_node->p_logger, "NULL finished, %lu bytes checksum %016llx.", p_dsp_node->total_bytes_processed, (unsigned long long)checksum);
+  }
+
+  return p_process->end_of_input || kill_thread || dsp_isCancelled(p_dsp_node);
+}
+
+//Checksum of everything the null sink read.
+int get_null_checksum(void *p_object, uint64_t *p_checksum)
+{
+  uint64_t sum_a = 0;
+  uint64_t sum_b = 0;
+
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_null_data *p_null = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  if(!p_dsp_node || !p_checksum || !p_dsp_node->p_data) return ~0;
+
+  p_null = (struct s_null_data *)p_dsp_node->p_data;
+
+  sum_a = p_null->sum_a;
+
+  sum_b = p_null->sum_b;
+
+  //the last word zero padded, without changing the state.
+  if(p_null->partial_bytes)
+  {
+    uint8_t last[8] = {0};
+
+    uint64_t word = 0;
+
+    memcpy(last, p_null->partial, p_null->partial_bytes);
+
+    memcpy(&word, last, sizeof(word));
+
+    sum_a += word;
+
+    sum_b += sum_a;
+  }
+
+  *p_checksum = sum_b ^ ((sum_a << 32) | (sum_a >> 32));
+
+  return 0;
+}
+
+//Clean up all allocations from init_callback null
+int free_callback_null(void *p_object)
+{
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  free(p_dsp_node->p_data);
+
+  p_dsp_node->p_data = NULL;
+
+  return 0;
+}
+
+//build the table of a constant, tone or chirp in the output type.
+static int gen_table(struct s_dsp_node * const p_dsp_node, struct s_gen_data * const p_gen)
+{
+  unsigned long index = 0;
+  unsigned long type_size = get_type_size(p_gen->args.type);
+
+  long long cycles = 0;
+
+  //frequencies are cycles per element without a rate.
+  double rate = (p_gen->args.rate > 0 ? p_gen->args.rate : 1.0);
+  double sweep = 0;
+
+  enum e_binary_type block_type = (p_gen->components == 2 ? DATA_CDOUBLE : DATA_DOUBLE);
+
+  p_gen->table_size = GEN_TABLE_SIZE;
+
+  if(p_gen->args.wave == GEN_CHIRP)
+  {
+    sweep = p_gen->args.sweep * rate;
+
+    if(sweep < 2)
+    {
+      logger_error_msg(p_dsp_node->p_logger, "GEN chirp sweep of %f elements is to short.", sweep);
+
+      return ~0;
+    }
+
+    if(sweep > GEN_TABLE_MAX)
+    {
+      logger_warning_msg(p_dsp_node->p_logger, "GEN chirp sweep of %f elements cut to %d.", sweep, GEN_TABLE_MAX);
+
+      sweep = GEN_TABLE_MAX;
+    }
+
+    p_gen->table_size = (unsigned long)sweep;
+  }
+
+  //a whole number of cycles in the table so it repeats without a jump.
+  if(p_gen->args.wave == GEN_TONE)
+  {
+    cycles = llround(p_gen->args.freq / rate * (double)p_gen->table_size);
+
+    if(fabs((double)cycles * rate / (double)p_gen->table_size - p_gen->args.freq) > 1e-9 * rate)
+    {
+      logger_info_msg(p_dsp_node->p_logger, "GEN tone rounded to %f.", (double)cycles * rate / (double)p_gen->table_size);
+    }
+  }
+
+  p_gen->table_bytes = p_gen->table_size * type_size;
+
+  p_gen->p_table = dsp_allocBuffer(p_dsp_node, p_gen->table_bytes);
+
+  if(!p_gen->p_table)
+  {
+    logger_error_msg(p_dsp_node->p_logger, "GEN could not allocate a table of %lu bytes.", p_gen->table_bytes);
+
+    return ~0;
+  }
+
+  //a block of doubles at a time, converted into the table.
+  for(index = 0; index < p_gen->table_size; index += GEN_BLOCK / p_gen->components)
+  {
+    unsigned long offset = 0;
+    unsigned long size = p_gen->table_size - index;
+
+    if(size > GEN_BLOCK / p_gen->components) size = GEN_BLOCK / p_gen->components;
+
+    for(offset = 0; offset < size; offset++)
+    {
+      double phase = 0;
+
+      unsigned long element = index + offset;
+
+      switch(p_gen->args.wave)
+      {
+        case GEN_TONE:
+          //the integer product keeps the phase exact however long the table.
+          phase = (double)(((unsigned long long)((cycles % (long long)p_gen->table_size) + (long long)p_gen->table_size) * element) % p_gen->table_size) / (double)p_gen->table_size;
+          break;
+        case GEN_CHIRP:
+          phase = fmod((p_gen->args.freq * (double)element / rate) + ((p_gen->args.freq_end - p_gen->args.freq) * (double)element * (double)element / (2.0 * sweep * rate)), 1.0);
+          break;
+        default:
+          break;
+      }
+
+      if(p_gen->args.wave == GEN_CONSTANT)
+      {
+        p_gen->block[offset * p_gen->components] = p_gen->args.amplitude;
+
+        if(p_gen->components == 2) p_gen->block[offset * 2 + 1] = 0;
+
+        continue;
+      }
+
+      p_gen->block[offset * p_gen->components] = p_gen->args.amplitude * cos(2.0 * M_PI * phase);
+
+      if(p_gen->components == 2) p_gen->block[offset * 2 + 1] = p_gen->args.amplitude * sin(2.0 * M_PI * phase);
+    }
+
+    dsp_convertBuffer(block_type, p_gen->args.type, 0, p_gen->block, (uint8_t *)p_gen->p_table + (index * type_size), size);
+  }
+
+  return 0;
+}
+
+//fill size elements of the output type.
+static void gen_fill(struct s_gen_data * const p_gen, void *p_buffer, unsigned long size)
+{
+  unsigned long index = 0;
+  unsigned long type_size = get_type_size(p_gen->args.type);
+  unsigned long bytes = size * type_size;
+
+  uint8_t *p_output = (uint8_t *)p_buffer;
+
+  //pacing counts from the first element.
+  if(p_gen->args.pace && !p_gen->start_ns) p_gen->start_ns = gen_now();
+
+  p_gen->written += size;
+
+  switch(p_gen->args.wave)
+  {
+    case GEN_CONSTANT:
+    case GEN_TONE:
+    case GEN_CHIRP:
+      //copy out of the table, wrapping where it ends.
+      while(size)
+      {
+        unsigned long length = p_gen->table_size - p_gen->table_index;
+
+        if(length > size) length = size;
+
+        memcpy(p_output, (uint8_t *)p_gen->p_table + (p_gen->table_index * type_size), length * type_size);
+
+        p_output += length * type_size;
+
+        size -= length;
+
+        p_gen->table_index = (p_gen->table_index + length) % p_gen->table_size;
+      }
+      break;
+    case GEN_NOISE:
+      //full scale integers are random bits, a word at a time.
+      if((p_gen->args.amplitude >= 1.0) && gen_integer(p_gen->args.type))
+      {
+        //bytes of a word the last fill did not use first, so the stream does not depend on the chunk size.
+        for(; p_gen->num_bits && (index < bytes); index++)
+        {
+          p_output[index] = (uint8_t)p_gen->bits;
+
+          p_gen->bits >>= 8;
+
+          p_gen->num_bits -= 8;
+        }
+
+        for(; index + sizeof(uint64_t) <= bytes; index += sizeof(uint64_t))
+        {
+          uint64_t word = gen_random(p_gen);
+
+          memcpy(p_output + index, &word, sizeof(word));
+        }
+
+        if(index < bytes)
+        {
+          p_gen->bits = gen_random(p_gen);
+
+          p_gen->num_bits = 64;
+
+          for(; index < bytes; index++)
+          {
+            p_output[index] = (uint8_t)p_gen->bits;
+
+            p_gen->bits >>= 8;
+
+            p_gen->num_bits -= 8;
+          }
+        }
+
+        break;
+      }
+
+      for(index = 0; index < size; index += GEN_BLOCK / p_gen->components)
+      {
+        unsigned long offset = 0;
+        unsigned long length = size - index;
+
+        if(length > GEN_BLOCK / p_gen->components) length = GEN_BLOCK / p_gen->components;
+
+        //top 53 bits to -1.0 to 1.0.
+        for(offset = 0; offset < length * p_gen->components; offset++)
+        {
+          p_gen->block[offset] = p_gen->args.amplitude * ((double)(gen_random(p_gen) >> 11) * 0x1.0p-52 - 1.0);
+        }
+
+        dsp_convertBuffer((p_gen->components == 2 ? DATA_CDOUBLE : DATA_DOUBLE), p_gen->args.type, 0, p_gen->block, p_output + (index * type_size), length);
+      }
+      break;
+    case GEN_PRBS:
+      //x^31 + x^28 + 1, 28 new bits a step since every tap is at least 28 back.
+      for(index = 0; index < bytes; index++)
+      {
+        if(p_gen->num_bits < 8)
+        {
+          uint64_t next = (p_gen->state ^ (p_gen->state >> 3)) & 0x0FFFFFFF;
+
+          p_gen->state = (p_gen->state >> 28) | (next << 3);
+
+          p_gen->bits |= next << p_gen->num_bits;
+
+          p_gen->num_bits += 28;
+        }
+
+        p_output[index] = (uint8_t)p_gen->bits;
+
+        p_gen->bits >>= 8;
+
+        p_gen->num_bits -= 8;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+//elements of size left before count, size for a endless stream.
+static unsigned long gen_remaining(struct s_gen_data const * const p_gen, unsigned long size)
+{
+  if(!p_gen->args.count) return size;
+
+  if(p_gen->args.count - p_gen->written < size) return p_gen->args.count - p_gen->written;
+
+  return size;
+}
+
+//sleep till the elements written are due at the rate, dsp_end wakes it.
+static void gen_pace(struct s_dsp_node * const p_dsp_node, struct s_gen_data * const p_gen)
+{
+  unsigned long long due_ns = 0;
+
+  if(!p_gen->args.pace) return;
+
+  due_ns = p_gen->start_ns + (unsigned long long)((double)p_gen->written * 1e9 / p_gen->args.rate);
+
+  //no fds, a sleep on the cancel token till the monotonic due time.
+  dsp_poll(p_dsp_node, NULL, 0, due_ns);
+}
+
+//1 for integer types, 0 for floating point.
+static int gen_integer(enum e_binary_type type)
+{
+  switch(type)
+  {
+    case DATA_FLOAT:
+    case DATA_CFLOAT:
+    case DATA_DOUBLE:
+    case DATA_CDOUBLE:
+      return 0;
+    default:
+      return 1;
+  }
+}
+
+//next xorshift64* number.
+static uint64_t gen_random(struct s_gen_data * const p_gen)
+{
+  p_gen->state ^= p_gen->state >> 12;
+
+  p_gen->state ^= p_gen->state << 25;
+
+  p_gen->state ^= p_gen->state >> 27;
+
+  return p_gen->state * 0x2545F4914F6CDD1DULL;
+}
+
+//add bytes to the checksum.
+static void null_sum(struct s_null_data * const p_null, uint8_t const *p_buffer, unsigned long bytes)
+{
+  uint64_t sum_a = p_null->sum_a;
+  uint64_t sum_b = p_null->sum_b;
+  uint64_t word = 0;
+
+  //the last peek of a stream is empty.
+  if(!p_buffer || !bytes) return;
+
+  //finish the word the last block split.
+  while(p_null->partial_bytes && bytes)
+  {
+    p_null->partial[p_null->partial_bytes++] = *p_buffer++;
+
+    bytes--;
+
+    if(p_null->partial_bytes < sizeof(word)) continue;
+
+    memcpy(&word, p_null->partial, sizeof(word));
+
+    sum_a += word;
+
+    sum_b += sum_a;
+
+    p_null->partial_bytes = 0;
+  }
+
+  for(; bytes >= sizeof(word); bytes -= sizeof(word), p_buffer += sizeof(word))
+  {
+    memcpy(&word, p_buffer, sizeof(word));
+
+    sum_a += word;
+
+    sum_b += sum_a;
+  }
+
+  memcpy(p_null->partial + p_null->partial_bytes, p_buffer, bytes);
+
+  p_null->partial_bytes += (unsigned int)bytes;
+
+  p_null->sum_a = sum_a;
+
+  p_null->sum_b = sum_b;
+}
+
+//monotonic time in nanoseconds.
+static unsigned long long gen_now(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return ((unsigned long long)now.tv_sec * 1000000000ULL) + (unsigned long long)now.tv_nsec;
+}
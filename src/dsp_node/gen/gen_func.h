@@ -0,0 +1,258 @@
+//******************************************************************************
+/// @file     gen_func.h
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Synthetic source and null sink nodes for load generation.
+/// @details  The generator writes straight into its output ring, constant,
+///           tone and chirp are copied from a table built at init. The null
+///           sink reads straight out of its input ring and checksums it.
+//******************************************************************************
+
+#ifndef __gen_func
+#define __gen_func
+
+#include <stdint.h>
+
+#include "dsp_node_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def GEN_TABLE_SIZE
+ * Elements in the table of a constant or tone, a tone is rounded to a whole number of cycles in it.
+ */
+#define GEN_TABLE_SIZE (1 << 16)
+
+/**
+ * @def GEN_TABLE_MAX
+ * Most elements in the table of a chirp, a longer sweep is cut to it.
+ */
+#define GEN_TABLE_MAX (1 << 24)
+
+/**
+ * @enum e_gen_wave
+ * Waveforms of the generator. NOISE is uniform white noise, PRBS is the PRBS31
+ * bit stream (x^31 + x^28 + 1) packed first bit in the LSB whatever the type.
+ */
+enum e_gen_wave {GEN_CONSTANT=0, GEN_TONE, GEN_CHIRP, GEN_NOISE, GEN_PRBS};
+
+/**
+ * @struct s_gen_func_args
+ * @brief Contains argument data for generator node creation (pass to p_init_args for init_callback).
+ */
+struct s_gen_func_args
+{
+  /**
+   * @var s_gen_func_args::wave
+   * waveform to generate.
+   */
+  enum e_gen_wave wave;
+  /**
+   * @var s_gen_func_args::type
+   * output type, any e_binary_type but DATA_UNKNOWN.
+   */
+  enum e_binary_type type;
+  /**
+   * @var s_gen_func_args::rate
+   * elements per second, frequencies are in Hz of it. 0 makes frequencies cycles per element.
+   */
+  double rate;
+  /**
+   * @var s_gen_func_args::pace
+   * 1 writes at rate in real time, 0 as fast as the pipeline takes it.
+   */
+  int pace;
+  /**
+   * @var s_gen_func_args::amplitude
+   * full scale fraction, 0.0 to 1.0, the value of a constant.
+   */
+  double amplitude;
+  /**
+   * @var s_gen_func_args::freq
+   * frequency of a tone, start frequency of a chirp.
+   */
+  double freq;
+  /**
+   * @var s_gen_func_args::freq_end
+   * end frequency of a chirp.
+   */
+  double freq_end;
+  /**
+   * @var s_gen_func_args::sweep
+   * seconds (elements with rate 0) of one chirp from freq to freq_end, it repeats.
+   */
+  double sweep;
+  /**
+   * @var s_gen_func_args::count
+   * elements to write before the stream ends, 0 for forever.
+   */
+  unsigned long count;
+  /**
+   * @var s_gen_func_args::seed
+   * seed of noise and PRBS, 0 picks a fixed default.
+   */
+  uint64_t seed;
+};
+
+/**
+ * @struct s_null_func_args
+ * @brief Contains argument data for null sink creation (pass to p_init_args for init_callback).
+ */
+struct s_null_func_args
+{
+  /**
+   * @var s_null_func_args::type
+   * input type, matches the node that feeds it.
+   */
+  enum e_binary_type type;
+  /**
+   * @var s_null_func_args::checksum
+   * 1 checksums every byte read, 0 only releases it.
+   */
+  int checksum;
+};
+
+// COMMON FUNCTIONS //
+
+/**************************************************************************//**
+  * @brief Setup generator arg struct for the generator init callback
+  *
+  * @param wave waveform to generate.
+  * @param type output type.
+  * @param rate elements per second, 0 for cycles per element frequencies.
+  * @param pace 1 writes at rate in real time, 0 as fast as possible.
+  * @param amplitude full scale fraction, 0.0 to 1.0.
+  * @param freq tone frequency, chirp start frequency.
+  * @param freq_end chirp end frequency.
+  * @param sweep length of one chirp in seconds.
+  * @param count elements before the stream ends, 0 for forever.
+  * @param seed noise and PRBS seed, 0 for the default.
+  *
+  * @return Arg struct
+  ****************************************************************************/
+struct s_gen_func_args *create_gen_args(enum e_gen_wave wave, enum e_binary_type type, double rate, int pace, double amplitude, double freq, double freq_end, double sweep, unsigned long count, uint64_t seed);
+
+/**************************************************************************//**
+  * @brief Free args struct created from create gen args
+  *
+  * @param p_init_args gen args struct to free
+  ****************************************************************************/
+void free_gen_args(struct s_gen_func_args *p_init_args);
+
+/**************************************************************************//**
+  * @brief Setup null sink arg struct for the null init callback
+  *
+  * @param type input type.
+  * @param checksum 1 checksums every byte, 0 only releases it.
+  *
+  * @return Arg struct
+  ****************************************************************************/
+struct s_null_func_args *create_null_args(enum e_binary_type type, int checksum);
+
+/**************************************************************************//**
+  * @brief Free args struct created from create null args
+  *
+  * @param p_init_args null args struct to free
+  ****************************************************************************/
+void free_null_args(struct s_null_func_args *p_init_args);
+
+// THREAD GENERATOR FUNCTIONS //
+
+/**************************************************************************//**
+  * @brief Setup generator thread, builds the table of constant, tone or chirp.
+  *
+  * @param p_init_args Takes s_gen_func_args for setup
+  * @param p_object A dsp_node struct used to change various settings.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int init_callback_gen(void *p_init_args, void *p_object);
+
+/**************************************************************************//**
+  * @brief Pthread function for threading the generator.
+  *
+  * @param p_data This will contain dsp_node struct so all data is available.
+  *
+  * @return NULL
+  ****************************************************************************/
+void* pthread_function_gen(void *p_data);
+
+/**************************************************************************//**
+  * @brief Process callback for a fused generator, fills the output block.
+  *
+  * @param p_object generator dsp node object.
+  * @param p_process output block to fill.
+  *
+  * @return 0 more to come, non-zero the stream ended.
+  ****************************************************************************/
+int process_callback_gen(void *p_object, struct s_dsp_process *p_process);
+
+/**************************************************************************//**
+  * @brief Clean up all allocations from init_callback gen
+  *
+  * @param p_object generator dsp node object to free.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int free_callback_gen(void *p_object);
+
+// THREAD NULL FUNCTIONS //
+
+/**************************************************************************//**
+  * @brief Setup null sink thread
+  *
+  * @param p_init_args Takes s_null_func_args for setup
+  * @param p_object A dsp_node struct used to change various settings.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int init_callback_null(void *p_init_args, void *p_object);
+
+/**************************************************************************//**
+  * @brief Pthread function for threading the null sink, logs the checksum at
+  * the end of the stream.
+  *
+  * @param p_data This will contain dsp_node struct so all data is available.
+  *
+  * @return NULL
+  ****************************************************************************/
+void* pthread_function_null(void *p_data);
+
+/**************************************************************************//**
+  * @brief Process callback for a fused null sink, checksums the input block.
+  *
+  * @param p_object null dsp node object.
+  * @param p_process input block to consume.
+  *
+  * @return 0 more to come, non-zero the input ended.
+  ****************************************************************************/
+int process_callback_null(void *p_object, struct s_dsp_process *p_process);
+
+/**************************************************************************//**
+  * @brief Checksum of everything the null sink read, a Fletcher style sum of
+  * native 64 bit words (mod 2^64), the last word zero padded. Call after
+  * the node has stopped and before it is freed.
+  *
+  * @param p_object null dsp node object.
+  * @param p_checksum returns the checksum.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int get_null_checksum(void *p_object, uint64_t *p_checksum);
+
+/**************************************************************************//**
+  * @brief Clean up all allocations from init_callback null
+  *
+  * @param p_object null dsp node object to free.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int free_callback_null(void *p_object);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -17,6 +17,7 @@
 #include <unistd.h>
 
 #include "ncurses_dsp_monitor.h"
+#include "dsp_node.h"
 #include "kill_throbber.h"
 #include "logger.h"
 
@@ -33,10 +34,11 @@
 #define TERABYTES ((long)1 << 40)
 
 #define DISPLAY_COL_SIZE  75
-#define DISPLAY_ROW_SIZE  5
+#define DISPLAY_ROW_SIZE  6
 #define DISPLAY_COL_ONE   1
 #define DISPLAY_COL_TWO   25
 #define DISPLAY_COL_THREE 45
+#define DISPLAY_COL_OUT   46
 
 #define THROBBER_ROW_SIZE 3
 
@@ -63,9 +65,18 @@ static pthread_mutex_t g_mutex;
 //condition signal for throbber to allow other threads to process;
 static pthread_cond_t g_refresh_condition;
 
+//condition signal for the screen leaving the need refresh state (ready or dead).
+static pthread_cond_t g_ready_condition = PTHREAD_COND_INITIALIZER;
+
 //number of nodes created
 static unsigned int g_node_number = 0;
 
+//node number of the busiest node (least time waiting on its edges), 0 none yet. protected by g_mutex.
+static unsigned int g_bottleneck_node = 0;
+
+//busy fraction of g_bottleneck_node in per mille. protected by g_mutex.
+static unsigned long g_bottleneck_busy = 0;
+
 ///0 is no refresh, 1 is refresh, 2 is no more refresh and block others from trying
 static volatile sig_atomic_t g_need_refresh = 1;
 
@@ -74,6 +85,15 @@ static struct s_logger *gp_logger = NULL;
 //screen initializer and resize helper
 void *init_screen_and_resize(void *p_data);
 
+//sleep till the screen no longer needs a refresh, returns g_need_refresh (0 ready, 2 dead, 1 killed while waiting).
+static int wait_screen_ready(void);
+
+//sleep for one display update period.
+static void wait_sample_period(void);
+
+//per mille of the time between two fill snapshots a edge spent waiting, from the wait totals.
+static unsigned long fill_fraction(unsigned long long previous_ns, unsigned long long current_ns, unsigned long long previous_elapsed, unsigned long long current_elapsed);
+
 //has the screen been resized?
 void handle_winch(int sig);
 
@@ -180,9 +200,7 @@ int ncurses_dsp_monitor_start()
       return error;
     }
 
-    while(g_need_refresh == 1);
-
-    if(g_need_refresh)
+    if(wait_screen_ready())
     {
       logger_error_msg(gp_logger, "NCURSES DSP MONITOR init and resize failed.");
 
@@ -364,8 +382,15 @@ void *init_screen_and_resize(void *p_data)
 
       g_need_refresh = 0;
 
+      pthread_cond_broadcast(&g_ready_condition);
+
       pthread_mutex_unlock(&g_mutex);
     }
+    else
+    {
+      //resize only comes in as a signal, check for it once a display period.
+      wait_sample_period();
+    }
   } while(!kill_thread);
 
   use_default_colors();
@@ -376,8 +401,14 @@ void *init_screen_and_resize(void *p_data)
 
   signal(SIGWINCH, SIG_IGN);
 
+  pthread_mutex_lock(&g_mutex);
+
   g_need_refresh = 2;
 
+  pthread_cond_broadcast(&g_ready_condition);
+
+  pthread_mutex_unlock(&g_mutex);
+
   pthread_join(update_thread, NULL);
 
   pthread_join(throbber_thread, NULL);
@@ -399,7 +430,22 @@ void handle_winch(int sig)
 //function for displaying data from nodes on its window.
 void *display_thread(void *p_data)
 {
+  int active = 0;
+  int has_input = 0;
+  int has_output = 0;
+
+  unsigned long in_full = 0;
+  unsigned long in_empty = 0;
+  unsigned long out_full = 0;
+  unsigned long busy = 0;
+
+  unsigned long in_full_array[AVG_SAMPLE_AMT] = {0};
+  unsigned long in_empty_array[AVG_SAMPLE_AMT] = {0};
+  unsigned long out_full_array[AVG_SAMPLE_AMT] = {0};
+  unsigned long busy_array[AVG_SAMPLE_AMT] = {0};
+
   unsigned long previous_total_bytes = 0;
+  unsigned long total_bytes = 0;
   unsigned long diff_total_bytes = 0;
   unsigned long avg_bytes = 1;
   unsigned long max_bytes = 0;
@@ -412,6 +458,14 @@ void *display_thread(void *p_data)
 
   struct s_ncurses_dsp_monitor *p_object;
 
+  struct s_dsp_stats stats;
+  struct s_dsp_stats previous_stats = {0};
+
+  struct s_dsp_ring_fill in_fill;
+  struct s_dsp_ring_fill out_fill;
+  struct s_dsp_ring_fill previous_in_fill = {0};
+  struct s_dsp_ring_fill previous_out_fill = {0};
+
   WINDOW *p_window = NULL;
 
   p_object = (struct s_ncurses_dsp_monitor *)p_data;
@@ -425,9 +479,7 @@ void *display_thread(void *p_data)
     return NULL;
   }
 
-  while(g_need_refresh == 1);
-
-  if(g_need_refresh)
+  if(wait_screen_ready())
   {
     logger_error_msg(p_object->p_dsp_node->p_logger, "NCURSES DSP MONITOR display thread exited.");
 
@@ -449,9 +501,37 @@ void *display_thread(void *p_data)
 
   do
   {
-    diff_total_bytes = data_rate(previous_total_bytes, p_object->p_dsp_node->total_bytes_processed);
+    //snapshot the node counters, the node thread is never touched.
+    dsp_getStats(p_object->p_dsp_node, &stats);
+
+    //bytes out for nodes with a output, bytes in for sinks.
+    total_bytes = (stats.items_out ? stats.items_out * p_object->p_dsp_node->output_type_size : stats.items_in * p_object->p_dsp_node->input_type_size);
+
+    active = (stats.start_ns && !stats.stop_ns);
 
-    previous_total_bytes = p_object->p_dsp_node->total_bytes_processed;
+    //edge telemetry, full input means this node holds back upstream, full output means downstream holds it back.
+    has_input = !dsp_getInputFill(p_object->p_dsp_node, 0, &in_fill);
+
+    has_output = !dsp_getOutputFill(p_object->p_dsp_node, 0, &out_fill);
+
+    in_full = avg_rate(in_full_array, (has_input ? fill_fraction(previous_in_fill.full_ns, in_fill.full_ns, previous_in_fill.elapsed_ns, in_fill.elapsed_ns) : 0), AVG_SAMPLE_AMT);
+
+    in_empty = avg_rate(in_empty_array, (has_input ? fill_fraction(previous_in_fill.empty_ns, in_fill.empty_ns, previous_in_fill.elapsed_ns, in_fill.elapsed_ns) : 0), AVG_SAMPLE_AMT);
+
+    out_full = avg_rate(out_full_array, (has_output ? fill_fraction(previous_out_fill.full_ns, out_fill.full_ns, previous_out_fill.elapsed_ns, out_fill.elapsed_ns) : 0), AVG_SAMPLE_AMT);
+
+    if(has_input) previous_in_fill = in_fill;
+
+    if(has_output) previous_out_fill = out_fill;
+
+    //compute over all the time the node accounted for, the busiest node is the one holding the pipeline back.
+    busy = avg_rate(busy_array, (active ? fill_fraction(previous_stats.compute_ns, stats.compute_ns, previous_stats.compute_ns + previous_stats.input_wait_ns + previous_stats.output_wait_ns, stats.compute_ns + stats.input_wait_ns + stats.output_wait_ns) : 0), AVG_SAMPLE_AMT);
+
+    previous_stats = stats;
+
+    diff_total_bytes = data_rate(previous_total_bytes, total_bytes);
+
+    previous_total_bytes = total_bytes;
 
     avg_bytes = avg_rate(mov_avg_array, diff_total_bytes, AVG_SAMPLE_AMT);
 
@@ -465,22 +545,37 @@ void *display_thread(void *p_data)
       max_scale_result = scale_result;
     }
 
-    if(g_need_refresh) continue;
+    if(g_need_refresh)
+    {
+      wait_screen_ready();
+
+      continue;
+    }
 
     pthread_mutex_lock(&g_mutex);
 
     pthread_cond_wait(&g_refresh_condition, &g_mutex);
 
-    if(!p_object->p_dsp_node->active) wattron(p_window, COLOR_PAIR(RED_TEXT));
+    if(!active) wattron(p_window, COLOR_PAIR(RED_TEXT));
 
     box(p_window, '|', '-');
 
-    if(!p_object->p_dsp_node->active) wattroff(p_window, COLOR_PAIR(RED_TEXT));
+    if(!active) wattroff(p_window, COLOR_PAIR(RED_TEXT));
 
     wattron(p_window, COLOR_PAIR(RED_TEXT));
 
     mvwaddstr(p_window, 0, (int)(DISPLAY_COL_SIZE/2-strlen(p_object->p_name)/2), p_object->p_name);
 
+    //the leader keeps its title only while no other node is busier.
+    if((busy > g_bottleneck_busy) || (g_bottleneck_node == p_object->node_number))
+    {
+      g_bottleneck_node = p_object->node_number;
+
+      g_bottleneck_busy = busy;
+    }
+
+    if((g_bottleneck_node == p_object->node_number) && busy) mvwaddstr(p_window, 0, DISPLAY_COL_SIZE-13, " BOTTLENECK ");
+
     wattroff(p_window, COLOR_PAIR(RED_TEXT));
 
     wmove(p_window, 1, DISPLAY_COL_ONE);
@@ -507,6 +602,33 @@ void *display_thread(void *p_data)
 
     wprintw(p_window, "Type Size Out: %3d Bytes",  p_object->p_dsp_node->output_type_size);
 
+    wmove(p_window, 1, DISPLAY_COL_THREE);
+
+    wprintw(p_window, "Blocked In : %10lu", stats.blocked_input);
+
+    wmove(p_window, 2, DISPLAY_COL_THREE);
+
+    wprintw(p_window, "Blocked Out: %10lu", stats.blocked_output);
+
+    wmove(p_window, 3, DISPLAY_COL_THREE);
+
+    wprintw(p_window, "Errors     : %10lu", stats.errors);
+
+    wmove(p_window, 4, DISPLAY_COL_ONE);
+
+    if(has_input)
+    {
+      wprintw(p_window, "IN FILL:%3lu%% HIGH:%3lu%% FULL:%3lu%% EMPTY:%3lu%%", in_fill.fill * 100 / in_fill.size, in_fill.high_water * 100 / in_fill.size, in_full / 10, in_empty / 10);
+    }
+    else
+    {
+      wprintw(p_window, "IN  none                                   ");
+    }
+
+    wmove(p_window, 4, DISPLAY_COL_OUT);
+
+    wprintw(p_window, "OUT FULL:%3lu%% BUSY:%3lu%%", out_full / 10, busy / 10);
+
     wnoutrefresh(p_window);
 
     pthread_mutex_unlock(&g_mutex);
@@ -529,9 +651,7 @@ void *display_throbber(void *p_data)
 
   (void)p_data;
 
-  while(g_need_refresh == 1);
-
-  if(g_need_refresh)
+  if(wait_screen_ready())
   {
     logger_error_msg(gp_logger, "NCURSES DSP MONITOR throbber exited.");
 
@@ -551,7 +671,12 @@ void *display_throbber(void *p_data)
 
   do
   {
-    if(g_need_refresh) continue;
+    if(g_need_refresh)
+    {
+      wait_screen_ready();
+
+      continue;
+    }
 
     pthread_mutex_lock(&g_mutex);
 
@@ -592,24 +717,25 @@ void *display_throbber(void *p_data)
 //thread to update displays
 void *display_update(void *p_data)
 {
-  long int diff = 0;
-
-  struct timespec current;
-  struct timespec previous;
+  struct timespec next;
 
   (void)p_data;
 
-  clock_gettime(CLOCK_MONOTONIC, &previous);
+  clock_gettime(CLOCK_MONOTONIC, &next);
 
   do
   {
-    clock_gettime(CLOCK_MONOTONIC, &current);
+    //sleep to the next update, absolute time so the rate does not drift.
+    next.tv_nsec += SAMPLE_RATE_NS;
 
-    diff = nano_second_time_diff(previous, current);
+    if(next.tv_nsec >= 1000000000L)
+    {
+      next.tv_sec++;
 
-    if(diff < SAMPLE_RATE_NS) continue;
+      next.tv_nsec -= 1000000000L;
+    }
 
-    previous = current;
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
 
     pthread_mutex_lock(&g_mutex);
 
@@ -627,6 +753,60 @@ void *display_update(void *p_data)
 
 }
 
+//sleep till the screen no longer needs a refresh, returns g_need_refresh (0 ready, 2 dead, 1 killed while waiting).
+static int wait_screen_ready(void)
+{
+  int need_refresh = 0;
+
+  struct timespec timeout;
+
+  pthread_mutex_lock(&g_mutex);
+
+  while((g_need_refresh == 1) && !kill_thread)
+  {
+    //timed so kill_thread, which can not signal, is seen within a display period.
+    clock_gettime(CLOCK_REALTIME, &timeout);
+
+    timeout.tv_nsec += SAMPLE_RATE_NS;
+
+    if(timeout.tv_nsec >= 1000000000L)
+    {
+      timeout.tv_sec++;
+
+      timeout.tv_nsec -= 1000000000L;
+    }
+
+    pthread_cond_timedwait(&g_ready_condition, &g_mutex, &timeout);
+  }
+
+  need_refresh = g_need_refresh;
+
+  pthread_mutex_unlock(&g_mutex);
+
+  return need_refresh;
+}
+
+//per mille of the time between two fill snapshots a edge spent waiting, from the wait totals.
+static unsigned long fill_fraction(unsigned long long previous_ns, unsigned long long current_ns, unsigned long long previous_elapsed, unsigned long long current_elapsed)
+{
+  unsigned long long fraction = 0;
+
+  //a new edge or a reader that was replaced starts over.
+  if((current_elapsed <= previous_elapsed) || (current_ns < previous_ns)) return 0;
+
+  fraction = (current_ns - previous_ns) * 1000 / (current_elapsed - previous_elapsed);
+
+  return (unsigned long)(fraction > 1000 ? 1000 : fraction);
+}
+
+//sleep for one display update period.
+static void wait_sample_period(void)
+{
+  struct timespec sleep_time = {0, SAMPLE_RATE_NS};
+
+  nanosleep(&sleep_time, NULL);
+}
+
 //time difference
 long int nano_second_time_diff(struct timespec previous, struct timespec current)
 {
@@ -0,0 +1,836 @@
+//******************************************************************************
+/// @file     shm_func.c
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Shared memory edge nodes, a named ring in /dev/shm between processes.
+/// @details  Single producer single consumer, lock free indexes in the mapping
+///           and shared futexes to sleep on. Each side keeps the pid of the
+///           other so a crashed process ends the stream instead of hanging it.
+//******************************************************************************
+
+// standard includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+#include "dsp_node.h"
+#include "shm_func.h"
+#include "kill_throbber.h"
+#include "logger.h"
+
+#if ATOMIC_LONG_LOCK_FREE != 2 || ATOMIC_INT_LOCK_FREE != 2
+#error "shm edges need lock free atomics to share them between processes."
+#endif
+
+//marks a initialized ring, stored last by the writer.
+#define SHM_MAGIC       0x64737072U
+
+//layout version of struct s_shm_header.
+#define SHM_VERSION     1U
+
+//bytes in a cache line, keeps the writer and reader indexes from false sharing.
+#define SHM_CACHE_LINE  64
+
+//longest sleep in nanoseconds before checking kill_thread, dsp_end and the pid of the other side.
+//the futex lives in the shared ring, a cancel in this process can not wake it.
+#define SHM_WAIT_NS     100000000L
+
+//prefix of the shm_open name, so every ring shows up as /dev/shm/dsp_node.name.
+#define SHM_PREFIX      "/dsp_node."
+
+//start of the mapping, the ring data follows at data_offset.
+struct s_shm_header
+{
+  atomic_uint magic;
+  unsigned int version;
+  int type;
+  unsigned int type_size;
+  unsigned long buffer_size;
+  unsigned long data_offset;
+  //written only by the writer
+  _Alignas(SHM_CACHE_LINE) atomic_ulong write_index;
+  atomic_int write_alive;
+  atomic_int write_pid;
+  atomic_ulong dropped;
+  //written only by the reader
+  _Alignas(SHM_CACHE_LINE) atomic_ulong read_index;
+  atomic_int read_alive;
+  atomic_int read_pid;
+  //reader sleeps on data_seq, writer bumps it when the reader is sleeping.
+  _Alignas(SHM_CACHE_LINE) atomic_uint data_seq;
+  atomic_int data_sleeping;
+  //writer sleeps on space_seq, reader bumps it when the writer is sleeping.
+  _Alignas(SHM_CACHE_LINE) atomic_uint space_seq;
+  atomic_int space_sleeping;
+};
+
+//node private data of both sides.
+struct s_shm_data
+{
+  struct s_shm_header *p_header;
+  uint8_t *p_buffer;
+  size_t map_size;
+  char *p_path;
+  int drop;
+};
+
+//shm_open path of a ring name.
+static char *shm_path(char const *p_name);
+//is the process of a side still there, 0 pid is no one.
+static int shm_alive(int pid);
+//pid of the running writer of a existing ring, 0 none.
+static int shm_writer(char const *p_path);
+//copy size elements in or out of the ring at absolute index, handles the wrap.
+static void shm_copy(struct s_shm_data const * const p_shm, unsigned long index, void *p_data, unsigned long size, int to_shm);
+//wake the other side if it is sleeping on p_seq.
+static void shm_wake(atomic_uint *p_seq, atomic_int *p_sleeping);
+//sleep on p_seq if it still equals seq, at most SHM_WAIT_NS.
+static void shm_sleep(atomic_uint *p_seq, unsigned int seq);
+//unmap and free the private data.
+static void shm_free(struct s_shm_data *p_shm);
+
+//Setup shm arg struct for shm read/write init callbacks
+struct s_shm_func_args *create_shm_args(char *p_name, enum e_binary_type type, unsigned long buffer_size, int drop)
+{
+  struct s_shm_func_args *p_temp = NULL;
+
+  if(!p_name)
+  {
+    fprintf(stderr, "ERROR: Must specify shm name.\n");
+
+    return NULL;
+  }
+
+  if(strchr(p_name, '/'))
+  {
+    fprintf(stderr, "ERROR: shm name %s can not have a /.\n", p_name);
+
+    return NULL;
+  }
+
+  p_temp = malloc(sizeof(struct s_shm_func_args));
+
+  if(!p_temp) return NULL;
+
+  p_temp->p_name = strdup(p_name);
+
+  p_temp->type = type;
+
+  p_temp->buffer_size = (buffer_size ? buffer_size : SHM_DEFAULT_SIZE);
+
+  p_temp->drop = drop;
+
+  return p_temp;
+}
+
+//Free args struct created from create shm args
+void free_shm_args(struct s_shm_func_args *p_init_args)
+{
+  if(!p_init_args)
+  {
+    fprintf(stderr, "ERROR: Null passed.\n");
+
+    return;
+  }
+
+  free(p_init_args->p_name);
+
+  free(p_init_args);
+}
+
+// THREAD WRITE FUNCTIONS //
+
+//Create the shared ring
+int init_callback_shm_write(void *p_init_args, void *p_object)
+{
+  int fd = -1;
+
+  unsigned int type_size = 0;
+
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_shm_func_args *p_shm_args = NULL;
+
+  struct s_shm_data *p_shm = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_shm_args = (struct s_shm_func_args *)p_init_args;
+
+  if(!p_dsp_node || !p_shm_args)
+  {
+    fprintf(stderr, "ERROR: Arguments null.\n");
+
+    return ~0;
+  }
+
+  type_size = get_type_size(p_shm_args->type);
+
+  if(!type_size)
+  {
+    logger_error_msg(p_dsp_node->p_logger, "SHM WRITE type %d has no size.", p_shm_args->type);
+
+    return ~0;
+  }
+
+  p_shm = calloc(1, sizeof(struct s_shm_data));
+
+  if(!p_shm)
+  {
+    logger_error_msg(p_dsp_node->p_logger, "SHM WRITE malloc failed for shm data.");
+
+    return ~0;
+  }
+
+  p_shm->p_path = shm_path(p_shm_args->p_name);
+
+  if(!p_shm->p_path) goto error_cleanup;
+
+  p_shm->drop = p_shm_args->drop;
+
+  p_shm->map_size = (sizeof(struct s_shm_header) + SHM_CACHE_LINE - 1) / SHM_CACHE_LINE * SHM_CACHE_LINE + p_shm_args->buffer_size * type_size;
+
+  //a ring of a writer that is still running stays, two writers can not share a name.
+  if(shm_writer(p_shm->p_path))
+  {
+    logger_error_msg(p_dsp_node->p_logger, "SHM WRITE %s already has a running writer.", p_shm->p_path);
+
+    goto error_cleanup;
+  }
+
+  //a ring left by a writer that died goes, a reader still mapping it keeps its copy till it sees the pid is gone.
+  shm_unlink(p_shm->p_path);
+
+  fd = shm_open(p_shm->p_path, O_CREAT | O_EXCL | O_RDWR, 0660);
+
+  if(fd < 0)
+  {
+    logger_error_msg(p_dsp_node->p_logger, "SHM WRITE could not create %s, %s.", p_shm->p_path, strerror(errno));
+
+    goto error_cleanup;
+  }
+
+  if(ftruncate(fd, (off_t)p_shm->map_size))
+  {
+    logger_error_msg(p_dsp_node->p_logger, "SHM WRITE could not size %s to %zu bytes, %s.", p_shm->p_path, p_shm->map_size, strerror(errno));
+
+    goto error_cleanup;
+  }
+
+  p_shm->p_header = mmap(NULL, p_shm->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+  if(p_shm->p_header == MAP_FAILED)
+  {
+    p_shm->p_header = NULL;
+
+    logger_error_msg(p_dsp_node->p_logger, "SHM WRITE could not map %s, %s.", p_shm->p_path, strerror(errno));
+
+    goto error_cleanup;
+  }
+
+  close(fd);
+
+  fd = -1;
+
+  p_shm->p_header->version = SHM_VERSION;
+  p_shm->p_header->type = p_shm_args->type;
+  p_shm->p_header->type_size = type_size;
+  p_shm->p_header->buffer_size = p_shm_args->buffer_size;
+  p_shm->p_header->data_offset = p_shm->map_size - p_shm_args->buffer_size * type_size;
+
+  atomic_init(&p_shm->p_header->write_index, 0);
+  atomic_init(&p_shm->p_header->write_alive, 1);
+  atomic_init(&p_shm->p_header->write_pid, (int)getpid());
+  atomic_init(&p_shm->p_header->dropped, 0);
+  atomic_init(&p_shm->p_header->read_index, 0);
+  atomic_init(&p_shm->p_header->read_alive, 0);
+  atomic_init(&p_shm->p_header->read_pid, 0);
+  atomic_init(&p_shm->p_header->data_seq, 0);
+  atomic_init(&p_shm->p_header->data_sleeping, 0);
+  atomic_init(&p_shm->p_header->space_seq, 0);
+  atomic_init(&p_shm->p_header->space_sleeping, 0);
+
+  p_shm->p_buffer = (uint8_t *)p_shm->p_header + p_shm->p_header->data_offset;
+
+  //readers check the magic first, everything above is visible once it is.
+  atomic_store_explicit(&p_shm->p_header->magic, SHM_MAGIC, memory_order_release);
+
+  p_dsp_node->p_data = p_shm;
+
+  p_dsp_node->input_type = p_shm_args->type;
+
+  p_dsp_node->output_type = DATA_INVALID;
+
+  logger_info_msg(p_dsp_node->p_logger, "SHM WRITE node created for %p, %s with %lu elements.", p_dsp_node, p_shm->p_path, p_shm_args->buffer_size);
+
+  return 0;
+
+error_cleanup:
+  if(fd >= 0)
+  {
+    close(fd);
+
+    shm_unlink(p_shm->p_path);
+  }
+
+  shm_free(p_shm);
+
+  return ~0;
+}
+
+//Pthread function for threading shm write
+void* pthread_function_shm_write(void *p_data)
+{
+  int attached = 0;
+
+  unsigned long numElemRead = 0;
+
+  void const *p_buffer = NULL;
+
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_shm_data *p_shm = NULL;
+
+  struct s_shm_header *p_header = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_data;
+
+  if(!p_dsp_node)
+  {
+    fprintf(stderr, "ERROR: Data Struct is NULL.\n");
+
+    return NULL;
+  }
+
+  p_dsp_node->active = 1;
+
+  p_shm = (struct s_shm_data *)p_dsp_node->p_data;
+
+  p_header = p_shm->p_header;
+
+  p_dsp_node->total_bytes_processed = 0;
+
+  logger_info_msg(p_dsp_node->p_logger, "SHM WRITE thread started.");
+
+  do
+  {
+    unsigned long numElemWrote = 0;
+
+    //copy straight out of the input ring into the shared ring.
+    numElemRead = dsp_peekInputTimed(p_dsp_node, &p_buffer, p_dsp_node->chunk_size, dsp_deadline(DSP_NODE_POLL_MS));
+
+    //no data in time, check kill_thread and wait again.
+    if(numElemRead == DSP_NODE_TIMEOUT) continue;
+
+    while((numElemWrote < numElemRead) && !kill_thread && !dsp_isCancelled(p_dsp_node))
+    {
+      unsigned int  seq         = 0;
+      unsigned long write_index = 0;
+      unsigned long space       = 0;
+
+      write_index = atomic_load_explicit(&p_header->write_index, memory_order_relaxed);
+
+      //no reader holds the data back, a reader attaching starts at the write index.
+      if(atomic_load(&p_header->read_alive))
+      {
+        attached = 1;
+
+        space = p_header->buffer_size - (write_index - atomic_load_explicit(&p_header->read_index, memory_order_acquire));
+      }
+      else if(!attached && !p_shm->drop)
+      {
+        //lossless waits for the first reader, so a consumer started second gets the stream from the start.
+        seq = atomic_load(&p_header->space_seq);
+
+        atomic_store(&p_header->space_sleeping, 1);
+
+        if(!atomic_load(&p_header->read_alive)) shm_sleep(&p_header->space_seq, seq);
+
+        atomic_store(&p_header->space_sleeping, 0);
+
+        continue;
+      }
+      else
+      {
+        space = numElemRead - numElemWrote;
+      }
+
+      //a full ring with the reader process gone would never drain, write past it till another attaches.
+      if(!space && !shm_alive(atomic_load(&p_header->read_pid))) space = numElemRead - numElemWrote;
+
+      if(space > numElemRead - numElemWrote) space = numElemRead - numElemWrote;
+
+      //with no reader holding it back a chunk can be bigger then the shared ring, write it a ring at a time.
+      if(space > p_header->buffer_size) space = p_header->buffer_size;
+
+      if(!space && p_shm->drop)
+      {
+        atomic_store_explicit(&p_header->dropped, atomic_load_explicit(&p_header->dropped, memory_order_relaxed) + (numElemRead - numElemWrote), memory_order_relaxed);
+
+        break;
+      }
+
+      if(!space)
+      {
+        //announce the sleep then check again, the reader sees the flag or we see its release.
+        seq = atomic_load(&p_header->space_seq);
+
+        atomic_store(&p_header->space_sleeping, 1);
+
+        if(atomic_load(&p_header->read_alive) && (p_header->buffer_size == write_index - atomic_load(&p_header->read_index)))
+        {
+          shm_sleep(&p_header->space_seq, seq);
+        }
+
+        atomic_store(&p_header->space_sleeping, 0);
+
+        continue;
+      }
+
+      shm_copy(p_shm, write_index, (void *)((uint8_t const *)p_buffer + (numElemWrote * p_dsp_node->input_type_size)), space, 1);
+
+      atomic_store_explicit(&p_header->write_index, write_index + space, memory_order_release);
+
+      shm_wake(&p_header->data_seq, &p_header->data_sleeping);
+
+      numElemWrote += space;
+    }
+
+    p_dsp_node->total_bytes_processed += numElemRead * p_dsp_node->input_type_size;
+
+    dsp_releaseInput(p_dsp_node, numElemRead);
+
+  } while((numElemRead > 0) && !kill_thread && !dsp_isCancelled(p_dsp_node));
+
+  //everything written is published, the reader drains it then ends.
+  atomic_store(&p_header->write_alive, 0);
+
+  shm_wake(&p_header->data_seq, &p_header->data_sleeping);
+
+  dsp_endInput(p_dsp_node);
+
+  logger_info_msg(p_dsp_node->p_logger, "SHM WRITE thread finished, %lu elements dropped.", atomic_load(&p_header->dropped));
+
+  p_dsp_node->active = 0;
+
+  return NULL;
+}
+
+//Clean up all allocations from init_callback write
+int free_callback_shm_write(void *p_object)
+{
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_shm_data *p_shm = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_shm = (struct s_shm_data *)p_dsp_node->p_data;
+
+  if(!p_shm) return 0;
+
+  atomic_store(&p_shm->p_header->write_alive, 0);
+
+  shm_wake(&p_shm->p_header->data_seq, &p_shm->p_header->data_sleeping);
+
+  //a attached reader keeps its mapping, only the name goes.
+  shm_unlink(p_shm->p_path);
+
+  shm_free(p_shm);
+
+  p_dsp_node->p_data = NULL;
+
+  return 0;
+}
+
+// THREAD READ FUNCTIONS //
+
+//Attach to a shared ring created by a write node
+int init_callback_shm_read(void *p_init_args, void *p_object)
+{
+  int fd = -1;
+
+  struct stat shm_stat;
+
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_shm_func_args *p_shm_args = NULL;
+
+  struct s_shm_data *p_shm = NULL;
+
+  struct s_shm_header *p_header = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_shm_args = (struct s_shm_func_args *)p_init_args;
+
+  if(!p_dsp_node || !p_shm_args)
+  {
+    fprintf(stderr, "ERROR: Arguments null.\n");
+
+    return ~0;
+  }
+
+  p_shm = calloc(1, sizeof(struct s_shm_data));
+
+  if(!p_shm)
+  {
+    logger_error_msg(p_dsp_node->p_logger, "SHM READ malloc failed for shm data.");
+
+    return ~0;
+  }
+
+  p_shm->p_path = shm_path(p_shm_args->p_name);
+
+  if(!p_shm->p_path) goto error_cleanup;
+
+  fd = shm_open(p_shm->p_path, O_RDWR, 0);
+
+  if(fd < 0)
+  {
+    logger_error_msg(p_dsp_node->p_logger, "SHM READ could not open %s, is the writer running? %s.", p_shm->p_path, strerror(errno));
+
+    goto error_cleanup;
+  }
+
+  if(fstat(fd, &shm_stat) || ((size_t)shm_stat.st_size < sizeof(struct s_shm_header)))
+  {
+    logger_error_msg(p_dsp_node->p_logger, "SHM READ %s is not a shm ring.", p_shm->p_path);
+
+    goto error_cleanup;
+  }
+
+  p_shm->map_size = (size_t)shm_stat.st_size;
+
+  p_header = mmap(NULL, p_shm->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+  close(fd);
+
+  fd = -1;
+
+  if(p_header == MAP_FAILED)
+  {
+    logger_error_msg(p_dsp_node->p_logger, "SHM READ could not map %s, %s.", p_shm->p_path, strerror(errno));
+
+    goto error_cleanup;
+  }
+
+  p_shm->p_header = p_header;
+
+  if((atomic_load_explicit(&p_header->magic, memory_order_acquire) != SHM_MAGIC) || (p_header->version != SHM_VERSION) || (p_header->data_offset + p_header->buffer_size * p_header->type_size > p_shm->map_size))
+  {
+    logger_error_msg(p_dsp_node->p_logger, "SHM READ %s is not a version %u shm ring.", p_shm->p_path, SHM_VERSION);
+
+    goto error_cleanup;
+  }
+
+  if((p_shm_args->type != DATA_UNKNOWN) && (p_shm_args->type != (enum e_binary_type)p_header->type))
+  {
+    logger_error_msg(p_dsp_node->p_logger, "SHM READ %s has type %d, not %d.", p_shm->p_path, p_header->type, p_shm_args->type);
+
+    goto error_cleanup;
+  }
+
+  //one reader at a time, a reader whose process died can be replaced.
+  if(atomic_load(&p_header->read_alive) && shm_alive(atomic_load(&p_header->read_pid)))
+  {
+    logger_error_msg(p_dsp_node->p_logger, "SHM READ %s already has a reader, pid %d.", p_shm->p_path, atomic_load(&p_header->read_pid));
+
+    goto error_cleanup;
+  }
+
+  p_shm->p_buffer = (uint8_t *)p_header + p_header->data_offset;
+
+  //start at the current write position, like a ring reader added to a running node.
+  atomic_store(&p_header->read_pid, (int)getpid());
+
+  atomic_store(&p_header->read_index, atomic_load(&p_header->write_index));
+
+  atomic_store(&p_header->read_alive, 1);
+
+  //a lossless writer waits for the first reader to attach.
+  shm_wake(&p_header->space_seq, &p_header->space_sleeping);
+
+  p_dsp_node->p_data = p_shm;
+
+  p_dsp_node->input_type = DATA_INVALID;
+
+  p_dsp_node->output_type = (enum e_binary_type)p_header->type;
+
+  logger_info_msg(p_dsp_node->p_logger, "SHM READ node created for %p, %s from pid %d.", p_dsp_node, p_shm->p_path, atomic_load(&p_header->write_pid));
+
+  return 0;
+
+error_cleanup:
+  if(fd >= 0) close(fd);
+
+  shm_free(p_shm);
+
+  return ~0;
+}
+
+//Pthread function for threading shm read
+void* pthread_function_shm_read(void *p_data)
+{
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_shm_data *p_shm = NULL;
+
+  struct s_shm_header *p_header = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_data;
+
+  if(!p_dsp_node)
+  {
+    fprintf(stderr, "ERROR: Data Struct is NULL.\n");
+
+    return NULL;
+  }
+
+  p_dsp_node->active = 1;
+
+  p_shm = (struct s_shm_data *)p_dsp_node->p_data;
+
+  p_header = p_shm->p_header;
+
+  p_dsp_node->total_bytes_processed = 0;
+
+  logger_info_msg(p_dsp_node->p_logger, "SHM READ thread started.");
+
+  while(!kill_thread && !dsp_isCancelled(p_dsp_node))
+  {
+    int           write_alive     = 0;
+    unsigned int  seq             = 0;
+    unsigned long read_index      = 0;
+    unsigned long available       = 0;
+    unsigned long numElemReserved = 0;
+
+    void *p_buffer = NULL;
+
+    read_index = atomic_load_explicit(&p_header->read_index, memory_order_relaxed);
+
+    //alive is checked before the index, a ended writer has published everything it wrote.
+    write_alive = atomic_load(&p_header->write_alive);
+
+    available = atomic_load_explicit(&p_header->write_index, memory_order_acquire) - read_index;
+
+    if(!available)
+    {
+      //ended, or its process is gone and will never end the stream.
+      if(!write_alive || !shm_alive(atomic_load(&p_header->write_pid))) break;
+
+      //announce the sleep then check again, the writer sees the flag or we see its commit.
+      seq = atomic_load(&p_header->data_seq);
+
+      atomic_store(&p_header->data_sleeping, 1);
+
+      if(atomic_load(&p_header->write_alive) && (atomic_load(&p_header->write_index) == read_index))
+      {
+        shm_sleep(&p_header->data_seq, seq);
+      }
+
+      atomic_store(&p_header->data_sleeping, 0);
+
+      continue;
+    }
+
+    if(available > p_dsp_node->chunk_size) available = p_dsp_node->chunk_size;
+
+    //copy straight into the output ring, 0 reserved means every consumer has ended.
+    numElemReserved = dsp_reserveOutputTimed(p_dsp_node, &p_buffer, available, dsp_deadline(DSP_NODE_POLL_MS));
+
+    //no space in time, the data stays in the shared ring till kill_thread is checked again.
+    if(numElemReserved == DSP_NODE_TIMEOUT) continue;
+
+    if(!numElemReserved) break;
+
+    shm_copy(p_shm, read_index, p_buffer, numElemReserved, 0);
+
+    dsp_commitOutput(p_dsp_node, numElemReserved);
+
+    atomic_store_explicit(&p_header->read_index, read_index + numElemReserved, memory_order_release);
+
+    shm_wake(&p_header->space_seq, &p_header->space_sleeping);
+
+    p_dsp_node->total_bytes_processed += numElemReserved * p_dsp_node->output_type_size;
+  }
+
+  dsp_endOutput(p_dsp_node);
+
+  logger_info_msg(p_dsp_node->p_logger, "SHM READ thread finished.");
+
+  p_dsp_node->active = 0;
+
+  return NULL;
+}
+
+//Clean up all allocations from init_callback read
+int free_callback_shm_read(void *p_object)
+{
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_shm_data *p_shm = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_shm = (struct s_shm_data *)p_dsp_node->p_data;
+
+  if(!p_shm) return 0;
+
+  //detach so a waiting writer goes on and another reader can attach.
+  atomic_store(&p_shm->p_header->read_alive, 0);
+
+  atomic_store(&p_shm->p_header->read_pid, 0);
+
+  shm_wake(&p_shm->p_header->space_seq, &p_shm->p_header->space_sleeping);
+
+  shm_free(p_shm);
+
+  p_dsp_node->p_data = NULL;
+
+  return 0;
+}
+
+//shm_open path of a ring name.
+static char *shm_path(char const *p_name)
+{
+  char *p_path = NULL;
+
+  size_t length = 0;
+
+  length = strlen(SHM_PREFIX) + strlen(p_name) + 1;
+
+  p_path = malloc(length);
+
+  if(!p_path) return NULL;
+
+  snprintf(p_path, length, "%s%s", SHM_PREFIX, p_name);
+
+  return p_path;
+}
+
+//is the process of a side still there, 0 pid is no one.
+static int shm_alive(int pid)
+{
+  if(pid <= 0) return 0;
+
+  //EPERM is a process we may not signal, it is still there.
+  return !kill((pid_t)pid, 0) || (errno == EPERM);
+}
+
+//pid of the running writer of a existing ring, 0 none.
+static int shm_writer(char const *p_path)
+{
+  int fd  = -1;
+  int pid = 0;
+
+  struct stat shm_stat;
+
+  struct s_shm_header *p_header = NULL;
+
+  fd = shm_open(p_path, O_RDWR, 0);
+
+  if(fd < 0) return 0;
+
+  if(!fstat(fd, &shm_stat) && ((size_t)shm_stat.st_size >= sizeof(struct s_shm_header)))
+  {
+    p_header = mmap(NULL, sizeof(struct s_shm_header), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if(p_header != MAP_FAILED)
+    {
+      if((atomic_load(&p_header->magic) == SHM_MAGIC) && atomic_load(&p_header->write_alive) && shm_alive(atomic_load(&p_header->write_pid)))
+      {
+        pid = atomic_load(&p_header->write_pid);
+      }
+
+      munmap(p_header, sizeof(struct s_shm_header));
+    }
+  }
+
+  close(fd);
+
+  return pid;
+}
+
+//copy size elements in or out of the ring at absolute index, handles the wrap.
+static void shm_copy(struct s_shm_data const * const p_shm, unsigned long index, void *p_data, unsigned long size, int to_shm)
+{
+  unsigned long type_size = p_shm->p_header->type_size;
+  unsigned long position  = index % p_shm->p_header->buffer_size;
+  unsigned long first     = p_shm->p_header->buffer_size - position;
+
+  if(first > size) first = size;
+
+  if(to_shm)
+  {
+    memcpy(p_shm->p_buffer + position * type_size, p_data, first * type_size);
+
+    memcpy(p_shm->p_buffer, (uint8_t *)p_data + first * type_size, (size - first) * type_size);
+  }
+  else
+  {
+    memcpy(p_data, p_shm->p_buffer + position * type_size, first * type_size);
+
+    memcpy((uint8_t *)p_data + first * type_size, p_shm->p_buffer, (size - first) * type_size);
+  }
+}
+
+//wake the other side if it is sleeping on p_seq.
+static void shm_wake(atomic_uint *p_seq, atomic_int *p_sleeping)
+{
+  //orders the index store before the sleeping load, pairs with the sleepers store then check.
+  atomic_thread_fence(memory_order_seq_cst);
+
+  if(!atomic_load_explicit(p_sleeping, memory_order_relaxed)) return;
+
+  //only the first wake after a sleep pays for the syscall.
+  if(!atomic_exchange(p_sleeping, 0)) return;
+
+  atomic_fetch_add(p_seq, 1);
+
+#ifdef __linux__
+  //not private, the other side is in another process.
+  syscall(SYS_futex, (unsigned int *)p_seq, FUTEX_WAKE, 1, NULL, NULL, 0);
+#endif
+}
+
+//sleep on p_seq if it still equals seq, at most SHM_WAIT_NS.
+static void shm_sleep(atomic_uint *p_seq, unsigned int seq)
+{
+#ifdef __linux__
+  struct timespec timeout = {0, SHM_WAIT_NS};
+
+  syscall(SYS_futex, (unsigned int *)p_seq, FUTEX_WAIT, seq, &timeout, NULL, 0);
+#else
+  struct timespec sleep_time = {0, 50000};
+
+  if(atomic_load(p_seq) == seq) nanosleep(&sleep_time, NULL);
+#endif
+}
+
+//unmap and free the private data.
+static void shm_free(struct s_shm_data *p_shm)
+{
+  if(!p_shm) return;
+
+  if(p_shm->p_header) munmap(p_shm->p_header, p_shm->map_size);
+
+  free(p_shm->p_path);
+
+  free(p_shm);
+}
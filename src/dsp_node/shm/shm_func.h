@@ -0,0 +1,143 @@
+//******************************************************************************
+/// @file     shm_func.h
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Shared memory edge nodes, a named ring in /dev/shm between processes.
+/// @details  The write node (sink) creates the ring and owns it, the read node
+///           (source) in another process attaches to it by name.
+//******************************************************************************
+
+#ifndef __shm_func
+#define __shm_func
+
+#include "dsp_node_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def SHM_DEFAULT_SIZE
+ * Number of elements in the shared ring when create_shm_args is given 0.
+ */
+#define SHM_DEFAULT_SIZE (1 << 20)
+
+/**
+ * @struct s_shm_func_args
+ * @brief Contains argument data for shm node creation (pass to p_init_args for init_callback).
+ */
+struct s_shm_func_args
+{
+  /**
+   * @var s_shm_func_args::p_name
+   * name of the shared ring, shm_open name without the leading slash.
+   */
+  char *p_name;
+  /**
+   * @var s_shm_func_args::type
+   * data type of the ring, the read node may use DATA_UNKNOWN to take the type of the ring.
+   */
+  enum e_binary_type type;
+  /**
+   * @var s_shm_func_args::buffer_size
+   * number of elements in the shared ring, used by the write node only.
+   */
+  unsigned long buffer_size;
+  /**
+   * @var s_shm_func_args::drop
+   * 1 the write node drops what does not fit so it never waits on a reader, 0 it waits for the first reader and then for space (lossless).
+   */
+  int drop;
+};
+
+// COMMON FUNCTIONS //
+
+/**************************************************************************//**
+  * @brief Setup shm arg struct for shm read/write init callbacks
+  *
+  * @param p_name name of the shared ring, shows up as /dev/shm/dsp_node.p_name.
+  * @param type data type of the ring elements.
+  * @param buffer_size number of elements in the ring (write node), 0 for SHM_DEFAULT_SIZE.
+  * @param drop 1 the write node drops data when the reader is behind, 0 waits.
+  *
+  * @return Arg struct
+  ****************************************************************************/
+struct s_shm_func_args *create_shm_args(char *p_name, enum e_binary_type type, unsigned long buffer_size, int drop);
+
+/**************************************************************************//**
+  * @brief Free args struct created from create shm args
+  *
+  * @param p_init_args shm args struct to free
+  ****************************************************************************/
+void free_shm_args(struct s_shm_func_args *p_init_args);
+
+// THREAD WRITE FUNCTIONS //
+
+/**************************************************************************//**
+  * @brief Create the shared ring, replacing one left by a writer that died.
+  *
+  * @param p_init_args Takes s_shm_func_args for setup
+  * @param p_object A dsp_node struct used to change various settings.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int init_callback_shm_write(void *p_init_args, void *p_object);
+
+/**************************************************************************//**
+  * @brief Pthread function for threading shm write. Lossless waits for the
+  * first reader, after that (or with drop) data is dropped while no reader is
+  * attached, a reader can attach at any time.
+  *
+  * @param p_data This will contain dsp_node struct so all data is available.
+  *
+  * @return NULL
+  ****************************************************************************/
+void* pthread_function_shm_write(void *p_data);
+
+/**************************************************************************//**
+  * @brief Clean up all allocations from init_callback write, ends the stream
+  * for the reader and removes the name.
+  *
+  * @param p_object shm dsp node object to free.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int free_callback_shm_write(void *p_object);
+
+// THREAD READ FUNCTIONS //
+
+/**************************************************************************//**
+  * @brief Attach to a shared ring created by a write node, one reader at a time.
+  *
+  * @param p_init_args Takes s_shm_func_args for setup
+  * @param p_object A dsp_node struct used to change various settings.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int init_callback_shm_read(void *p_init_args, void *p_object);
+
+/**************************************************************************//**
+  * @brief Pthread function for threading shm read. Ends when the writer ends
+  * or its process dies.
+  *
+  * @param p_data This will contain dsp_node struct so all data is available.
+  *
+  * @return NULL
+  ****************************************************************************/
+void* pthread_function_shm_read(void *p_data);
+
+/**************************************************************************//**
+  * @brief Clean up all allocations from init_callback read, detaches so
+  * another reader can attach.
+  *
+  * @param p_object shm dsp node object to free.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int free_callback_shm_read(void *p_object);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
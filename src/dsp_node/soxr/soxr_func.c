@@ -12,6 +12,7 @@
 #include <string.h>
 
 #include "soxr.h"
+#include "dsp_node.h"
 #include "soxr_func.h"
 #include "kill_throbber.h"
 #include "logger.h"
@@ -20,7 +21,7 @@
 struct s_soxr_callback_data
 {
   float *p_data_buffer;
-  struct s_ringBuffer *p_ring_buffer;
+  struct s_dsp_node *p_dsp_node;
 };
 
 //private data struct to hold all data needed in dsp_node struct member p_data.
@@ -28,6 +29,9 @@ struct s_soxr_data
 {
   soxr_t soxr;
   struct s_soxr_func_args soxr_args;
+  //elements of the input and output types in one soxr frame (a sample of every channel).
+  unsigned long input_frame;
+  unsigned long output_frame;
 };
 
 //soxr callback to load data. This is used since we are processing on a streaming set of data.
@@ -36,6 +40,9 @@ size_t input_data_callback(void *p_callback_helper, soxr_cbuf_t *data, size_t le
 //convert the dsp_node type to soxr type.
 soxr_datatype_t get_soxr_type(enum e_binary_type type);
 
+//elements of type in a frame of channels interleaved components, 0 if a element does not fit a frame evenly.
+static unsigned long soxr_frame_size(enum e_binary_type type, unsigned channels);
+
 //Setup soxr input/output args
 struct s_soxr_func_args *create_soxr_args(double input_rate, double output_rate, enum e_binary_type input_type, enum e_binary_type output_type, unsigned channels)
 {
@@ -87,6 +94,14 @@ int init_callback_soxr(void *p_init_args, void *p_object)
     return ~0;
   }
 
+  //soxr counts frames, a complex element is two of the channels.
+  if(!soxr_frame_size(p_soxr_func_args->input_type, p_soxr_func_args->channels) || !soxr_frame_size(p_soxr_func_args->output_type, p_soxr_func_args->channels))
+  {
+    logger_error_msg(p_dsp_node->p_logger, "SOXR %u channels do not fit input type %d and output type %d, a complex type needs a even number of channels.", p_soxr_func_args->channels, p_soxr_func_args->input_type, p_soxr_func_args->output_type);
+
+    return ~0;
+  }
+
   p_dsp_node->p_data = malloc(sizeof(struct s_soxr_data));
 
   if(!p_dsp_node->p_data)
@@ -109,15 +124,33 @@ int init_callback_soxr(void *p_init_args, void *p_object)
 
     free(p_dsp_node->p_data);
 
+    p_dsp_node->p_data = NULL;
+
     return ~0;
   }
 
   memcpy(&((struct s_soxr_data *)p_dsp_node->p_data)->soxr_args, p_soxr_func_args, sizeof(struct s_soxr_func_args));
 
+  ((struct s_soxr_data *)p_dsp_node->p_data)->input_frame = soxr_frame_size(p_soxr_func_args->input_type, p_soxr_func_args->channels);
+
+  ((struct s_soxr_data *)p_dsp_node->p_data)->output_frame = soxr_frame_size(p_soxr_func_args->output_type, p_soxr_func_args->channels);
+
   p_dsp_node->input_type = p_soxr_func_args->input_type;
 
   p_dsp_node->output_type = p_soxr_func_args->output_type;
 
+  p_dsp_node->process_call = process_callback_soxr;
+
+  //a process call needs a whole frame to make progress.
+  p_dsp_node->process_input_max = ((struct s_soxr_data *)p_dsp_node->p_data)->input_frame;
+
+  //rates are frames per second, a frame is one element per channel of a real type and one per two of a complex type.
+  p_dsp_node->input_rate = p_soxr_func_args->input_rate * (double)((struct s_soxr_data *)p_dsp_node->p_data)->input_frame;
+
+  p_dsp_node->output_rate = p_soxr_func_args->output_rate * (double)((struct s_soxr_data *)p_dsp_node->p_data)->output_frame;
+
+  p_dsp_node->granularity = ((struct s_soxr_data *)p_dsp_node->p_data)->input_frame;
+
   logger_info_msg(p_dsp_node->p_logger, "SOXR node created for %p.", p_dsp_node);
 
   return 0;
@@ -143,33 +176,32 @@ void* pthread_function_soxr(void *p_data)
   {
     fprintf(stderr, "ERROR: Data Struct is NULL.\n");
 
-    kill_thread = 1;
-
     goto error_cleanup;
   }
 
   p_dsp_node->active = 1;
 
-  soxr_error = soxr_set_input_fn(((struct s_soxr_data *)p_dsp_node->p_data)->soxr, (soxr_input_fn_t)input_data_callback, &soxr_callback_data, p_dsp_node->chunk_size);
+  //soxr asks for frames, never more then a chunk of elements.
+  soxr_error = soxr_set_input_fn(((struct s_soxr_data *)p_dsp_node->p_data)->soxr, (soxr_input_fn_t)input_data_callback, &soxr_callback_data, (p_dsp_node->chunk_size > ((struct s_soxr_data *)p_dsp_node->p_data)->input_frame ? p_dsp_node->chunk_size / ((struct s_soxr_data *)p_dsp_node->p_data)->input_frame : 1));
 
   if(soxr_error)
   {
     logger_error_msg(p_dsp_node->p_logger, "SOXR, %s\n", soxr_strerror(soxr_error));
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto error_cleanup;
   }
 
-  soxr_callback_data.p_ring_buffer = p_dsp_node->p_input_ring_buffer;
+  soxr_callback_data.p_dsp_node = p_dsp_node;
 
-  soxr_callback_data.p_data_buffer = malloc(p_dsp_node->chunk_size * p_dsp_node->input_type_size * ((struct s_soxr_data *)p_dsp_node->p_data)->soxr_args.channels);
+  soxr_callback_data.p_data_buffer = dsp_allocBuffer(p_dsp_node, p_dsp_node->chunk_size * p_dsp_node->input_type_size * ((struct s_soxr_data *)p_dsp_node->p_data)->soxr_args.channels);
 
   if(!soxr_callback_data.p_data_buffer)
   {
     logger_error_msg(p_dsp_node->p_logger, "SOXR, Malloc failed for buffer.\n");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto error_cleanup;
   }
@@ -184,13 +216,13 @@ void* pthread_function_soxr(void *p_data)
     scaled_chunk_size = p_dsp_node->chunk_size / (long unsigned int)((((struct s_soxr_data *)p_dsp_node->p_data)->soxr_args.input_rate/((struct s_soxr_data *)p_dsp_node->p_data)->soxr_args.output_rate));
   }
 
-  p_output_buffer = malloc(scaled_chunk_size * p_dsp_node->output_type_size * ((struct s_soxr_data *)p_dsp_node->p_data)->soxr_args.channels);
+  p_output_buffer = dsp_allocBuffer(p_dsp_node, scaled_chunk_size * p_dsp_node->output_type_size * ((struct s_soxr_data *)p_dsp_node->p_data)->soxr_args.channels);
 
   if(!p_output_buffer)
   {
     logger_error_msg(p_dsp_node->p_logger, "SOXR, Malloc failed for buffer.\n");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto error_cleanup;
   }
@@ -203,21 +235,22 @@ void* pthread_function_soxr(void *p_data)
   {
     size_t num_resampled = 0;
 
-    num_resampled = soxr_output(((struct s_soxr_data *)p_dsp_node->p_data)->soxr, p_output_buffer, scaled_chunk_size);
+    //soxr puts out frames, the output ring counts elements.
+    num_resampled = soxr_output(((struct s_soxr_data *)p_dsp_node->p_data)->soxr, p_output_buffer, scaled_chunk_size / ((struct s_soxr_data *)p_dsp_node->p_data)->output_frame) * ((struct s_soxr_data *)p_dsp_node->p_data)->output_frame;
 
     p_dsp_node->total_bytes_processed += num_resampled * p_dsp_node->output_type_size;
 
-    num_wrote = ringBufferBlockingWrite(p_dsp_node->p_output_ring_buffer, p_output_buffer, num_resampled, NULL);
+    num_wrote = dsp_writeOutputAll(p_dsp_node, p_output_buffer, num_resampled, &kill_thread);
 
-  } while((num_wrote > 0) && !kill_thread);
+  } while((num_wrote > 0) && !kill_thread && !dsp_isCancelled(p_dsp_node));
 
 error_cleanup:
-  free(p_output_buffer);
+  dsp_freeBuffer(p_dsp_node, p_output_buffer, scaled_chunk_size * p_dsp_node->output_type_size * ((struct s_soxr_data *)p_dsp_node->p_data)->soxr_args.channels);
 
-  free(soxr_callback_data.p_data_buffer);
+  dsp_freeBuffer(p_dsp_node, soxr_callback_data.p_data_buffer, p_dsp_node->chunk_size * p_dsp_node->input_type_size * ((struct s_soxr_data *)p_dsp_node->p_data)->soxr_args.channels);
 
-  ringBufferEndBlocking(p_dsp_node->p_output_ring_buffer);
-  ringBufferEndBlocking(p_dsp_node->p_input_ring_buffer);
+  dsp_endOutput(p_dsp_node);
+  dsp_endInput(p_dsp_node);
 
   logger_info_msg(p_dsp_node->p_logger, "SOXR thread finished.");
 
@@ -226,6 +259,57 @@ error_cleanup:
   return NULL;
 }
 
+//Process callback for fused resampling, soxr_process on the input block.
+int process_callback_soxr(void *p_object, struct s_dsp_process *p_process)
+{
+  int flush = 0;
+
+  size_t idone = 0;
+  size_t odone = 0;
+
+  soxr_error_t soxr_error;
+
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_soxr_data *p_soxr_data = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_soxr_data = (struct s_soxr_data *)p_dsp_node->p_data;
+
+  //a partial frame at the end of the input can not be resampled, it is dropped.
+  flush = p_process->end_of_input && (p_process->input_size < p_soxr_data->input_frame);
+
+  //no more input, NULL input flushes what soxr is holding till it puts out nothing. soxr counts frames, the blocks elements.
+  if(flush)
+  {
+    soxr_error = soxr_process(p_soxr_data->soxr, NULL, 0, NULL, p_process->p_output, p_process->output_size / p_soxr_data->output_frame, &odone);
+  }
+  else
+  {
+    soxr_error = soxr_process(p_soxr_data->soxr, p_process->p_input, p_process->input_size / p_soxr_data->input_frame, &idone, p_process->p_output, p_process->output_size / p_soxr_data->output_frame, &odone);
+  }
+
+  p_process->input_size = (flush ? p_process->input_size : idone * p_soxr_data->input_frame);
+
+  odone *= p_soxr_data->output_frame;
+
+  p_process->output_size = odone;
+
+  if(soxr_error)
+  {
+    logger_error_msg(p_dsp_node->p_logger, "SOXR, %s\n", soxr_strerror(soxr_error));
+
+    dsp_statsError(p_dsp_node);
+
+    return ~0;
+  }
+
+  p_dsp_node->total_bytes_processed += odone * p_dsp_node->output_type_size;
+
+  return (flush && !odone) || kill_thread || dsp_isCancelled(p_dsp_node);
+}
+
 //clean up all allocations from init_callback
 int free_callback_soxr(void *p_object)
 {
@@ -233,10 +317,15 @@ int free_callback_soxr(void *p_object)
 
   p_dsp_node = (struct s_dsp_node *)p_object;
 
+  //a failed init left nothing to free.
+  if(!p_dsp_node->p_data) return 0;
+
   soxr_delete(((struct s_soxr_data *)p_dsp_node->p_data)->soxr);
 
   free(p_dsp_node->p_data);
 
+  p_dsp_node->p_data = NULL;
+
   return 0;
 }
 
@@ -244,6 +333,7 @@ int free_callback_soxr(void *p_object)
 size_t input_data_callback(void *p_callback_helper, soxr_cbuf_t *data, size_t len)
 {
   unsigned long int number_read = 0;
+  unsigned long int input_frame = 0;
 
   struct s_soxr_callback_data *p_soxr_callback_data = NULL;
 
@@ -254,12 +344,22 @@ size_t input_data_callback(void *p_callback_helper, soxr_cbuf_t *data, size_t le
   //invalid? set data to null and read to 0. this will end soxr_output process.
   if(!p_soxr_callback_data) return number_read;
 
-  number_read = ringBufferBlockingRead(p_soxr_callback_data->p_ring_buffer, p_soxr_callback_data->p_data_buffer, len, NULL);
+  //soxr asks for len frames, the input ring counts elements.
+  input_frame = ((struct s_soxr_data *)p_soxr_callback_data->p_dsp_node->p_data)->input_frame;
+
+  //soxr takes 0 as the end of input, so wait a poll period at a time till there is data, the end, kill_thread or dsp_end.
+  do
+  {
+    number_read = dsp_readInputTimed(p_soxr_callback_data->p_dsp_node, p_soxr_callback_data->p_data_buffer, len * input_frame, dsp_deadline(DSP_NODE_POLL_MS));
+  } while((number_read == DSP_NODE_TIMEOUT) && !kill_thread && !dsp_isCancelled(p_soxr_callback_data->p_dsp_node));
+
+  if(number_read == DSP_NODE_TIMEOUT) number_read = 0;
 
   //data is a double pointer, only way to return null.
   *data = (void *)p_soxr_callback_data->p_data_buffer;
 
-  return number_read;
+  //a partial frame at the end of the stream is dropped.
+  return number_read / input_frame;
 }
 
 //get the soxr type from the dsp_node type
@@ -283,3 +383,25 @@ soxr_datatype_t get_soxr_type(enum e_binary_type type)
       return 0;
   }
 }
+
+//elements of type in a frame of channels interleaved components, 0 if a element does not fit a frame evenly.
+static unsigned long soxr_frame_size(enum e_binary_type type, unsigned channels)
+{
+  unsigned long components = 1;
+
+  switch(type)
+  {
+    case(DATA_CS8):
+    case(DATA_CS16):
+    case(DATA_CFLOAT):
+    case(DATA_CDOUBLE):
+      components = 2;
+      break;
+    default:
+      break;
+  }
+
+  if(!channels || (channels % components)) return 0;
+
+  return channels / components;
+}
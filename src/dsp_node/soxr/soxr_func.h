@@ -90,6 +90,17 @@ int init_callback_soxr(void *p_init_args, void *p_object);
   ****************************************************************************/
 void* pthread_function_soxr(void *p_data);
 
+/**************************************************************************//**
+  * @brief Process callback for fused resampling, soxr_process on the input
+  * block. Flushes soxr once the input has ended.
+  *
+  * @param p_object soxr dsp node object.
+  * @param p_process samples in, resampled samples out.
+  *
+  * @return 0 more data, non-zero flushed, error or kill.
+  ****************************************************************************/
+int process_callback_soxr(void *p_object, struct s_dsp_process *p_process);
+
 /**************************************************************************//**
   * @brief Clean up all allocations from init_callback
   *
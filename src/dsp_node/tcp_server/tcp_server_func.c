@@ -11,23 +11,45 @@
 #include <stdint.h>
 #include <string.h>
 #include <unistd.h>
+#include <errno.h>
 #include <poll.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 
+#include "dsp_node.h"
 #include "tcp_server_func.h"
 #include "kill_throbber.h"
 #include "logger.h"
 
-static struct sockaddr_in *gp_socket_info = NULL;
-static struct pollfd g_poll_connection;
-
-static pthread_t connection_thread;
+//one server (address and port), the send and recv node of a pipeline share it.
+struct s_tcp_server_data
+{
+  struct sockaddr_in socket_info;
+  struct pollfd poll_connection;
+  pthread_mutex_t connection_mutex;
+  pthread_cond_t connection_cond;
+  unsigned int connection_holds;
+  pthread_t connection_thread;
+  struct s_logger *p_logger;
+  struct s_dsp_context *p_context;
+  struct s_dsp_cancel *p_cancel;
+  unsigned int refs;
+  struct s_tcp_server_data *p_next;
+};
+
+//servers open in the process, every pipeline listens on its own address and port.
+static struct s_tcp_server_data *gp_tcp_servers = NULL;
+//guards gp_tcp_servers, pipelines set up and clean up nodes from their own threads.
+static pthread_mutex_t g_tcp_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 // PRIVATE FUNCTIONS //
 void* connection_keep_alive(void *p_data);
+//copy the connection and hold it, the connection thread does not close a held fd.
+static void tcp_connection_hold(struct s_tcp_server_data *p_server, struct pollfd *p_connection);
+//release a hold from tcp_connection_hold, wakes the connection thread waiting to close.
+static void tcp_connection_release(struct s_tcp_server_data *p_server);
 
 //Setup tcp arg struct for tcp server/client init callbacks
 struct s_tcp_func_args *create_tcp_args(char *p_address, unsigned short port, enum e_binary_type input_type, enum e_binary_type output_type)
@@ -76,10 +98,14 @@ void free_tcp_args(struct s_tcp_func_args *p_init_args)
 // Setup TCP sockets
 int init_callback_tcp(void *p_init_args, void *p_object)
 {
+  int error = 0;
+
   struct s_dsp_node *p_dsp_node = NULL;
 
   struct s_tcp_func_args *p_tcp_args = NULL;
 
+  struct s_tcp_server_data *p_server = NULL;
+
   p_dsp_node = (struct s_dsp_node *)p_object;
 
   p_tcp_args = (struct s_tcp_func_args *)p_init_args;
@@ -88,48 +114,162 @@ int init_callback_tcp(void *p_init_args, void *p_object)
 
   p_dsp_node->output_type = p_tcp_args->output_type;
 
-  //if and only if null, allocate and start connection thread.
-  if(!gp_socket_info)
+  pthread_mutex_lock(&g_tcp_mutex);
+
+  //the second node of the same address and port shares the server and its connection.
+  for(p_server = gp_tcp_servers; p_server; p_server = p_server->p_next)
   {
-    // open socket discriptor for client/server
-    gp_socket_info = malloc(sizeof(struct sockaddr_in));
+    if((p_server->socket_info.sin_port == htons(p_tcp_args->port)) && (p_server->socket_info.sin_addr.s_addr == inet_addr(p_tcp_args->p_address))) break;
+  }
 
-    if(!gp_socket_info)
-    {
-      logger_error_msg(p_dsp_node->p_logger, "TCP SERVER, TCP Allocation Issue");
+  if(p_server)
+  {
+    p_server->refs++;
 
-      return ~0;
-    }
+    p_dsp_node->p_data = p_server;
 
-    gp_socket_info->sin_family = AF_INET;
+    pthread_mutex_unlock(&g_tcp_mutex);
+
+    return 0;
+  }
 
-    gp_socket_info->sin_port = htons(p_tcp_args->port);
+  p_server = malloc(sizeof(struct s_tcp_server_data));
 
-    gp_socket_info->sin_addr.s_addr = inet_addr(p_tcp_args->p_address);
+  if(!p_server)
+  {
+    logger_error_msg(p_dsp_node->p_logger, "TCP SERVER, TCP Allocation Issue");
 
-    p_dsp_node->p_data = gp_socket_info;
+    error = ~0;
 
-    //launch keep_alive_connection thread to connect and keep connection alive.
-    return pthread_create(&connection_thread, NULL, connection_keep_alive, p_dsp_node);
+    goto error_unlock;
   }
-  else
+
+  p_server->p_cancel = dsp_cancelCreate();
+
+  if(!p_server->p_cancel)
   {
-    p_dsp_node->p_data = gp_socket_info;
+    logger_error_msg(p_dsp_node->p_logger, "TCP SERVER, TCP Allocation Issue");
+
+    error = ~0;
+
+    goto error_free;
   }
 
+  p_server->socket_info.sin_family = AF_INET;
+
+  p_server->socket_info.sin_port = htons(p_tcp_args->port);
+
+  p_server->socket_info.sin_addr.s_addr = inet_addr(p_tcp_args->p_address);
+
+  //no client yet, poll skips a negative fd.
+  p_server->poll_connection.fd = -1;
+
+  p_server->poll_connection.events = POLLIN | POLLOUT | POLLHUP;
+
+  p_server->poll_connection.revents = 0;
+
+  //the nodes hold the connection while they use it, the connection thread waits on them to close it.
+  p_server->connection_holds = 0;
+
+  error = pthread_mutex_init(&p_server->connection_mutex, NULL);
+
+  if(error) goto error_cancel;
+
+  error = pthread_cond_init(&p_server->connection_cond, NULL);
+
+  if(error) goto error_mutex;
+
+  //the connection thread logs and stops with the pipeline that opened the server.
+  p_server->p_logger = p_dsp_node->p_logger;
+
+  p_server->p_context = p_dsp_node->p_context;
+
+  p_server->refs = 1;
+
+  //launch keep_alive_connection thread to connect and keep connection alive.
+  error = pthread_create(&p_server->connection_thread, NULL, connection_keep_alive, p_server);
+
+  if(error) goto error_cond;
+
+  p_server->p_next = gp_tcp_servers;
+
+  gp_tcp_servers = p_server;
+
+  p_dsp_node->p_data = p_server;
+
+  pthread_mutex_unlock(&g_tcp_mutex);
+
   return 0;
+
+error_cond:
+  pthread_cond_destroy(&p_server->connection_cond);
+
+error_mutex:
+  pthread_mutex_destroy(&p_server->connection_mutex);
+
+error_cancel:
+  dsp_cancelFree(&p_server->p_cancel);
+
+error_free:
+  free(p_server);
+
+error_unlock:
+  pthread_mutex_unlock(&g_tcp_mutex);
+
+  return error;
 }
 
 // Clean up all allocations from init_callback
 int free_callback_tcp(void *p_object)
 {
-  (void)p_object;
+  struct s_dsp_node *p_dsp_node = NULL;
+
+  struct s_tcp_server_data *p_server = NULL;
+
+  struct s_tcp_server_data **pp_link = NULL;
+
+  p_dsp_node = (struct s_dsp_node *)p_object;
+
+  p_server = (struct s_tcp_server_data *)p_dsp_node->p_data;
+
+  if(!p_server) return 0;
+
+  p_dsp_node->p_data = NULL;
+
+  pthread_mutex_lock(&g_tcp_mutex);
+
+  p_server->refs--;
+
+  if(p_server->refs)
+  {
+    pthread_mutex_unlock(&g_tcp_mutex);
+
+    return 0;
+  }
+
+  for(pp_link = &gp_tcp_servers; *pp_link; pp_link = &(*pp_link)->p_next)
+  {
+    if(*pp_link != p_server) continue;
+
+    *pp_link = p_server->p_next;
+
+    break;
+  }
+
+  pthread_mutex_unlock(&g_tcp_mutex);
+
+  //the last node of the server closes it, the connection thread wakes on the token.
+  dsp_cancelSet(p_server->p_cancel);
+
+  pthread_join(p_server->connection_thread, NULL);
 
-  if(gp_socket_info) pthread_join(connection_thread, NULL);
+  dsp_cancelFree(&p_server->p_cancel);
 
-  free(gp_socket_info);
+  pthread_cond_destroy(&p_server->connection_cond);
 
-  gp_socket_info = NULL;
+  pthread_mutex_destroy(&p_server->connection_mutex);
+
+  free(p_server);
 
   return 0;
 }
@@ -145,26 +285,28 @@ void* pthread_function_tcp_server_send(void *p_data)
 
   struct s_dsp_node *p_dsp_node = NULL;
 
+  struct s_tcp_server_data *p_server = NULL;
+
   p_dsp_node = (struct s_dsp_node *)p_data;
 
   if(!p_dsp_node)
   {
     fprintf(stderr, "ERROR: Data Struct is NULL.\n");
 
-    kill_thread = 1;
-
     goto error_cleanup;
   }
 
+  p_server = (struct s_tcp_server_data *)p_dsp_node->p_data;
+
   p_dsp_node->active = 1;
 
-  p_buffer = malloc(p_dsp_node->chunk_size * p_dsp_node->input_type_size);
+  p_buffer = dsp_allocBuffer(p_dsp_node, p_dsp_node->chunk_size * p_dsp_node->input_type_size);
 
   if(!p_buffer)
   {
     logger_error_msg(p_dsp_node->p_logger, "TCP SERVER, Could not allocate buffer");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto error_cleanup;
   }
@@ -175,36 +317,56 @@ void* pthread_function_tcp_server_send(void *p_data)
 
   do
   {
-    long numElemRead   = 0;
-    long numElemWrote  = 0;
+    struct pollfd connection;
 
-    error = poll(&g_poll_connection, 1, 0);
+    //the connection thread swaps the fd on a new client, poll a held copy.
+    tcp_connection_hold(p_server, &connection);
 
-    if(error <= 0) continue;
+    //wait on the connection a poll period at a time, dsp_end wakes it at once.
+    error = dsp_poll(p_dsp_node, &connection, 1, dsp_deadline(DSP_NODE_POLL_MS));
 
-    if(g_poll_connection.revents & POLLHUP) continue;
-
-    if(g_poll_connection.revents & POLLERR) continue;
-
-    if((g_poll_connection.revents & POLLOUT) && (p_dsp_node->input_type != DATA_INVALID))
+    if((error > 0) && !(connection.revents & (POLLHUP | POLLERR)) && (connection.revents & POLLOUT) && (p_dsp_node->input_type != DATA_INVALID))
     {
-      //read from input buffer, write to TCP
-      numElemRead = (long)ringBufferBlockingRead(p_dsp_node->p_input_ring_buffer, p_buffer, p_dsp_node->chunk_size, NULL);
+      unsigned long numElemInput = 0;
 
-      do
+      //read from input buffer, write to TCP, no data in time checks kill_thread and polls again.
+      numElemInput = dsp_readInputTimed(p_dsp_node, p_buffer, p_dsp_node->chunk_size, dsp_deadline(DSP_NODE_POLL_MS));
+
+      if(numElemInput != DSP_NODE_TIMEOUT)
       {
-        numElemWrote += send(g_poll_connection.fd, p_buffer, (size_t)(numElemRead * p_dsp_node->input_type_size), MSG_DONTWAIT);
-      } while(numElemWrote < (numElemRead * p_dsp_node->input_type_size));
+        size_t numBytes = numElemInput * p_dsp_node->input_type_size;
+        size_t numBytesSent = 0;
+
+        while((numBytesSent < numBytes) && !kill_thread && !dsp_isCancelled(p_dsp_node))
+        {
+          ssize_t numBytesChunk = 0;
+
+          numBytesChunk = send(connection.fd, p_buffer + numBytesSent, numBytes - numBytesSent, MSG_DONTWAIT | MSG_NOSIGNAL);
+
+          if(numBytesChunk >= 0)
+          {
+            numBytesSent += (size_t)numBytesChunk;
+
+            continue;
+          }
+
+          //anything but a full socket is the client gone, drop the rest.
+          if((errno != EAGAIN) && (errno != EWOULDBLOCK)) break;
 
-      if(numElemWrote <= 0) continue;
+          //wait a poll period for room in the socket.
+          dsp_poll(p_dsp_node, &connection, 1, dsp_deadline(DSP_NODE_POLL_MS));
+        }
+      }
     }
 
-  } while (!kill_thread);
+    tcp_connection_release(p_server);
+
+  } while (!kill_thread && !dsp_isCancelled(p_dsp_node));
 
-  free(p_buffer);
+  dsp_freeBuffer(p_dsp_node, p_buffer, p_dsp_node->chunk_size * p_dsp_node->input_type_size);
 
 error_cleanup:
-  ringBufferEndBlocking(p_dsp_node->p_input_ring_buffer);
+  dsp_endInput(p_dsp_node);
 
   logger_info_msg(p_dsp_node->p_logger, "TCP SERVER SEND thread finished.");
 
@@ -222,26 +384,30 @@ void* pthread_function_tcp_server_recv(void *p_data)
 
   struct s_dsp_node *p_dsp_node = NULL;
 
+  struct s_tcp_server_data *p_server = NULL;
+
+  size_t numBytesHeld = 0;
+
   p_dsp_node = (struct s_dsp_node *)p_data;
 
   if(!p_dsp_node)
   {
     fprintf(stderr, "ERROR: Data Struct is NULL.\n");
 
-    kill_thread = 1;
-
     goto error_cleanup;
   }
 
+  p_server = (struct s_tcp_server_data *)p_dsp_node->p_data;
+
   p_dsp_node->active = 1;
 
-  p_buffer = malloc(p_dsp_node->chunk_size * p_dsp_node->output_type_size);
+  p_buffer = dsp_allocBuffer(p_dsp_node, p_dsp_node->chunk_size * p_dsp_node->output_type_size);
 
   if(!p_buffer)
   {
     logger_error_msg(p_dsp_node->p_logger, "TCP SERVER, Could not allocate buffer");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto error_cleanup;
   }
@@ -252,35 +418,50 @@ void* pthread_function_tcp_server_recv(void *p_data)
 
   do
   {
-    long numElemRead   = 0;
-    long numElemWrote  = 0;
+    ssize_t numBytesRead = 0;
 
-    error = poll(&g_poll_connection, 1, 0);
+    struct pollfd connection;
 
-    if(error <= 0) continue;
+    //the connection thread swaps the fd on a new client, poll a held copy.
+    tcp_connection_hold(p_server, &connection);
 
-    if(g_poll_connection.revents & POLLHUP) continue;
+    //wait on the connection a poll period at a time, dsp_end wakes it at once.
+    error = dsp_poll(p_dsp_node, &connection, 1, dsp_deadline(DSP_NODE_POLL_MS));
 
-    if(g_poll_connection.revents & POLLERR) continue;
-
-    if((g_poll_connection.revents & POLLIN) && (p_dsp_node->output_type != DATA_INVALID))
+    if((error > 0) && !(connection.revents & (POLLHUP | POLLERR)) && (connection.revents & POLLIN) && (p_dsp_node->output_type != DATA_INVALID))
     {
       // read from TCP, write to output buffer.
-      numElemRead = recv(g_poll_connection.fd, p_buffer, p_dsp_node->chunk_size * p_dsp_node->output_type_size, MSG_DONTWAIT);
+      numBytesRead = recv(connection.fd, p_buffer + numBytesHeld, (p_dsp_node->chunk_size * p_dsp_node->output_type_size) - numBytesHeld, MSG_DONTWAIT);
+    }
 
-      p_dsp_node->total_bytes_processed += (unsigned long)(numElemRead * p_dsp_node->output_type_size);
+    //the fd is not used past recv, let a disconnect close it while the output waits.
+    tcp_connection_release(p_server);
 
-      if(numElemRead <= 0) continue;
+    if(numBytesRead > 0)
+    {
+      unsigned long numElemRead = 0;
+
+      p_dsp_node->total_bytes_processed += (unsigned long)numBytesRead;
+
+      numBytesHeld += (size_t)numBytesRead;
+
+      //tcp splits on bytes, write the whole elements and keep a partial one for the next recv.
+      numElemRead = numBytesHeld / p_dsp_node->output_type_size;
 
-      numElemWrote = (long)ringBufferBlockingWrite(p_dsp_node->p_output_ring_buffer, p_buffer + (numElemWrote * p_dsp_node->output_type_size), (unsigned)(numElemRead), NULL);
+      //what was received is not dropped unless the thread is killed.
+      dsp_writeOutputAll(p_dsp_node, p_buffer, numElemRead, &kill_thread);
+
+      numBytesHeld -= numElemRead * p_dsp_node->output_type_size;
+
+      memmove(p_buffer, p_buffer + (numElemRead * p_dsp_node->output_type_size), numBytesHeld);
     }
 
-  } while (!kill_thread);
+  } while (!kill_thread && !dsp_isCancelled(p_dsp_node));
 
-  free(p_buffer);
+  dsp_freeBuffer(p_dsp_node, p_buffer, p_dsp_node->chunk_size * p_dsp_node->output_type_size);
 
 error_cleanup:
-  ringBufferEndBlocking(p_dsp_node->p_output_ring_buffer);
+  dsp_endOutput(p_dsp_node);
 
   logger_info_msg(p_dsp_node->p_logger, "TCP SERVER RECV thread finished.");
 
@@ -292,46 +473,44 @@ error_cleanup:
 void* connection_keep_alive(void *p_data)
 {
   int error = 0;
-  int prev_revents = 0;
+  int client_fd = -1;
   unsigned socket_len = 0;
 
-  char p_buffer[16];
-
   struct pollfd poll_socket;
 
   struct sockaddr_in client_socket_info;
 
-  struct s_dsp_node *p_dsp_node = NULL;
+  struct s_tcp_server_data *p_server = NULL;
 
-  p_dsp_node = (struct s_dsp_node *)p_data;
+  p_server = (struct s_tcp_server_data *)p_data;
 
-  if(!p_dsp_node)
+  if(!p_server)
   {
     fprintf(stderr, "ERROR: Data Struct is NULL.\n");
 
     return NULL;
   }
 
-  poll_socket.fd = socket(gp_socket_info->sin_family, SOCK_STREAM || SOCK_NONBLOCK, 0);
+  poll_socket.fd = socket(p_server->socket_info.sin_family, SOCK_STREAM || SOCK_NONBLOCK, 0);
 
   if(poll_socket.fd == -1)
   {
-    logger_error_msg(p_dsp_node->p_logger, "TCP SERVER, Failed to create socket");
+    logger_error_msg(p_server->p_logger, "TCP SERVER, Failed to create socket");
 
-    kill_thread = 1;
+    dsp_contextStop(p_server->p_context);
 
     return NULL;
   }
 
-  error = bind(poll_socket.fd, (struct sockaddr *)gp_socket_info, sizeof(struct sockaddr_in));
+  error = bind(poll_socket.fd, (struct sockaddr *)&p_server->socket_info, sizeof(struct sockaddr_in));
 
   if(error == -1)
   {
-    logger_error_msg(p_dsp_node->p_logger, "TCP SERVER, Failed to bind");
+    logger_error_msg(p_server->p_logger, "TCP SERVER, Failed to bind");
 
     close(poll_socket.fd);
 
-    kill_thread = 1;
+    dsp_contextStop(p_server->p_context);
 
     return NULL;
   }
@@ -340,93 +519,127 @@ void* connection_keep_alive(void *p_data)
 
   if(error == -1)
   {
-    logger_error_msg(p_dsp_node->p_logger, "TCP SERVER, Failed to listen");
+    logger_error_msg(p_server->p_logger, "TCP SERVER, Failed to listen");
 
     close(poll_socket.fd);
 
-    kill_thread = 1;
+    dsp_contextStop(p_server->p_context);
 
     return NULL;
   }
 
   poll_socket.events = POLLIN;
 
-  logger_info_msg(p_dsp_node->p_logger, "TCP SERVER STARTED");
+  logger_info_msg(p_server->p_logger, "TCP SERVER STARTED");
 
-  logger_info_msg(p_dsp_node->p_logger, "TCP SERVER WAITING FOR CLIENT");
+  logger_info_msg(p_server->p_logger, "TCP SERVER WAITING FOR CLIENT");
 
   do
   {
-    error = poll(&poll_socket, 1, 0);
+    error = dsp_cancelPoll(p_server->p_cancel, &poll_socket, 1, dsp_deadline(DSP_NODE_POLL_MS));
 
     if(error < 0)
     {
-      logger_error_msg(p_dsp_node->p_logger, "TCP SERVER, Poll failed");
+      logger_error_msg(p_server->p_logger, "TCP SERVER, Poll failed");
 
-      kill_thread = 1;
+      dsp_contextStop(p_server->p_context);
 
-      continue;
+      break;
     }
 
     if(error == 0) continue;
 
-    if(poll_socket.revents == POLLIN)
-    {
-      g_poll_connection.fd = accept(poll_socket.fd, (struct sockaddr *)&client_socket_info, &socket_len);
+    if(!(poll_socket.revents & POLLIN)) continue;
 
-      if(g_poll_connection.fd < 0)
-      {
-        logger_error_msg(p_dsp_node->p_logger, "TCP SERVER, Accept failed");
+    socket_len = sizeof(client_socket_info);
 
-        kill_thread = 1;
+    client_fd = accept(poll_socket.fd, (struct sockaddr *)&client_socket_info, &socket_len);
 
-        continue;
-      }
+    if(client_fd < 0)
+    {
+      logger_error_msg(p_server->p_logger, "TCP SERVER, Accept failed");
+
+      dsp_contextStop(p_server->p_context);
 
-      g_poll_connection.events = POLLIN | POLLOUT | POLLHUP;
+      break;
     }
 
-    logger_info_msg(p_dsp_node->p_logger, "TCP SERVER CONNECTED %s", inet_ntoa(client_socket_info.sin_addr));
+    //publish the client to the send and recv nodes.
+    pthread_mutex_lock(&p_server->connection_mutex);
 
-    // while connected, just wait till dissconnect or kill_thread
-    // while(!(g_poll_connection.revents & POLLHUP) && !(g_poll_connection.revents & POLLERR) && !kill_thread);
-    prev_revents = g_send_tcp_server[*p_index].poll_connection.revents;
+    p_server->poll_connection.fd = client_fd;
 
-    // while connected, just wait till dissconnect or kill_thread
+    pthread_mutex_unlock(&p_server->connection_mutex);
+
+    logger_info_msg(p_server->p_logger, "TCP SERVER CONNECTED %s", inet_ntoa(client_socket_info.sin_addr));
+
+    // while connected, just wait till dissconnect or the server is closed
     for(;;)
     {
-      int num_bytes_read = 0;
+      struct pollfd connection;
 
-      error = poll(&g_send_tcp_server[*p_index].poll_connection, 1, 0);
+      //the send and recv nodes poll the connection, watch a copy for the hang up only.
+      connection.fd = client_fd;
 
-      if(error <= 0) continue;
+      connection.events = POLLRDHUP;
 
-      if(g_poll_connection.revents & POLLHUP) break;
-      if(g_poll_connection.revents & POLLERR) break;
-      if(!kill_thread) break;
+      connection.revents = 0;
 
-      if(prev_revents != g_poll_connection.revents)
-      {
-        prev_revents = g_poll_connection.poll_connection.revents;
+      error = dsp_cancelPoll(p_server->p_cancel, &connection, 1, dsp_deadline(DSP_NODE_POLL_MS));
 
-        num_bytes_read = recv(g_poll_connection.fd, p_buffer, 16, MSG_PEEK);
+      if(error < 0) break;
 
-        if(num_bytes_read <= 0) break;
-      }
-    };
+      if(kill_thread || dsp_cancelIsSet(p_server->p_cancel)) break;
+
+      if(connection.revents & (POLLRDHUP | POLLHUP | POLLERR | POLLNVAL)) break;
+    }
+
+    logger_info_msg(p_server->p_logger, "TCP SERVER DISCONNECTED");
 
-    logger_info_msg(p_dsp_node->p_logger, "TCP SERVER DISCONNECTED");
+    //take the fd back from the nodes and wait out their holds, a closed fd number is reused by the next open.
+    pthread_mutex_lock(&p_server->connection_mutex);
 
-    close(g_poll_connection.fd);
+    p_server->poll_connection.fd = -1;
 
-    if(!kill_thread) logger_info_msg(p_dsp_node->p_logger, "TCP SERVER WAITING FOR CLIENT");
+    while(p_server->connection_holds) pthread_cond_wait(&p_server->connection_cond, &p_server->connection_mutex);
+
+    pthread_mutex_unlock(&p_server->connection_mutex);
+
+    close(client_fd);
+
+    client_fd = -1;
+
+    if(!kill_thread && !dsp_cancelIsSet(p_server->p_cancel)) logger_info_msg(p_server->p_logger, "TCP SERVER WAITING FOR CLIENT");
   }
-  while(!kill_thread);
+  while(!kill_thread && !dsp_cancelIsSet(p_server->p_cancel));
 
-  logger_info_msg(p_dsp_node->p_logger, "TCP SERVER SHUTTING DOWN");
+  logger_info_msg(p_server->p_logger, "TCP SERVER SHUTTING DOWN");
 
   close(poll_socket.fd);
 
   return NULL;
 }
 
+// Copy the connection and count the hold under the server mutex
+static void tcp_connection_hold(struct s_tcp_server_data *p_server, struct pollfd *p_connection)
+{
+  pthread_mutex_lock(&p_server->connection_mutex);
+
+  *p_connection = p_server->poll_connection;
+
+  p_server->connection_holds++;
+
+  pthread_mutex_unlock(&p_server->connection_mutex);
+}
+
+// Drop a hold, the last one wakes the connection thread
+static void tcp_connection_release(struct s_tcp_server_data *p_server)
+{
+  pthread_mutex_lock(&p_server->connection_mutex);
+
+  p_server->connection_holds--;
+
+  if(!p_server->connection_holds) pthread_cond_broadcast(&p_server->connection_cond);
+
+  pthread_mutex_unlock(&p_server->connection_mutex);
+}
@@ -11,36 +11,59 @@
 #include <stdint.h>
 #include <string.h>
 #include <unistd.h>
+#include <pthread.h>
 
 // local includes
 #include "uhd.h"
+#include "dsp_node.h"
 #include "uhd_func.h"
 #include "kill_throbber.h"
 #include "logger.h"
 
-//uhd struct type for global data
+//uhd struct type for one device, the rx and tx node of a device share it.
 struct s_uhd_data
 {
   uhd_usrp_handle           usrp;
-  uhd_stream_args_t         stream_args;
   uhd_string_vector_handle  device_vector;
+  char                      *p_device_args;
+  unsigned int              refs;
+  struct s_uhd_data         *p_next;
+};
+
+//uhd struct type for one node, its own stream on the shared device.
+struct s_uhd_node
+{
+  struct s_uhd_data         *p_device;
+  uhd_stream_args_t         stream_args;
+  size_t                    channel;
+  char                      *p_cpu_format;
 };
 
-//global UHD data variable, this will only allow one radio connection for this library....
-//yes this is kinda dumb, but it was quick, dirty and did what I needed. Byte me.
-static struct s_uhd_data *gp_uhd_data = NULL;
+//devices open in the process by device args, a usrp can only be made once so pipelines on one radio share it.
+static struct s_uhd_data *gp_uhd_devices = NULL;
+//guards gp_uhd_devices, pipelines set up and clean up nodes from their own threads.
+static pthread_mutex_t g_uhd_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 // PRIVATE FUNCTIONS //
 
 //connect to the device if no connection has been made.
 struct s_uhd_data *connect_to_uhd_device(struct s_dsp_node *p_dsp_node, struct s_uhd_func_args *p_func_args);
 
-//disconnect if the device is still connected.
-void disconnect_from_uhd_device();
+//disconnect once the last node of the device is done with it.
+void disconnect_from_uhd_device(struct s_uhd_data *p_uhd_data);
+
+//connect a node to its device and copy the channel and format of its stream, the args may be freed after init.
+static struct s_uhd_node *uhd_node_create(struct s_dsp_node *p_dsp_node, struct s_uhd_func_args *p_func_args);
+
+//free a node and drop its reference to the device.
+static void uhd_node_free(struct s_uhd_node *p_uhd_node);
 
 //convert cpu string type to dsp_node enum type
 enum e_binary_type convert_uhd_cpu_data_type(char *p_cpu_data);
 
+//tag the block about to be committed with the rx metadata, time after a gap, burst start and end.
+void tag_uhd_rx_metadata(struct s_dsp_node *p_dsp_node, uhd_rx_metadata_handle md, unsigned long num_samples, int *p_gap);
+
 // COMMON FUNCTIONS //
 
 //Setup uhd arg struct for file rx/tx init callbacks
@@ -119,7 +142,7 @@ int init_callback_uhd_rx(void *p_init_args, void *p_object)
 
   p_uhd_args = (struct s_uhd_func_args *)p_init_args;
 
-  p_dsp_node->p_data = connect_to_uhd_device(p_dsp_node, p_uhd_args);
+  p_dsp_node->p_data = uhd_node_create(p_dsp_node, p_uhd_args);
 
   if(!p_dsp_node->p_data)
   {
@@ -139,7 +162,7 @@ int init_callback_uhd_rx(void *p_init_args, void *p_object)
   tune_request.args             = "";
 
   // setup rx rate
-  error = uhd_usrp_set_rx_rate(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, p_uhd_args->rate, p_uhd_args->channel);
+  error = uhd_usrp_set_rx_rate(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, p_uhd_args->rate, p_uhd_args->channel);
 
   if(error)
   {
@@ -149,12 +172,14 @@ int init_callback_uhd_rx(void *p_init_args, void *p_object)
   }
 
   // print what the rate is set to
-  uhd_usrp_get_rx_rate(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, p_uhd_args->channel, &p_uhd_args->rate);
+  uhd_usrp_get_rx_rate(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, p_uhd_args->channel, &p_uhd_args->rate);
 
   logger_info_msg(p_dsp_node->p_logger, "UHD RX, rate set to %f\n", p_uhd_args->rate);
 
+  p_dsp_node->output_rate = p_uhd_args->rate;
+
   // setup rx gain
-  error = uhd_usrp_set_rx_gain(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, p_uhd_args->gain, p_uhd_args->channel, "");
+  error = uhd_usrp_set_rx_gain(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, p_uhd_args->gain, p_uhd_args->channel, "");
 
   if(error)
   {
@@ -164,12 +189,12 @@ int init_callback_uhd_rx(void *p_init_args, void *p_object)
   }
 
   // print what the gain is set to
-  uhd_usrp_get_rx_gain(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, p_uhd_args->channel, "", &p_uhd_args->gain);
+  uhd_usrp_get_rx_gain(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, p_uhd_args->channel, "", &p_uhd_args->gain);
 
   logger_info_msg(p_dsp_node->p_logger, "UHD RX, gain set to %f\n", p_uhd_args->gain);
 
   // setup rx frequency
-  error = uhd_usrp_set_rx_freq(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, &tune_request, p_uhd_args->channel, &tune_result);
+  error = uhd_usrp_set_rx_freq(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, &tune_request, p_uhd_args->channel, &tune_result);
 
   if(error)
   {
@@ -179,14 +204,14 @@ int init_callback_uhd_rx(void *p_init_args, void *p_object)
   }
 
   // print what the rx frequency is set to
-  uhd_usrp_get_rx_freq(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, p_uhd_args->channel, &p_uhd_args->freq);
+  uhd_usrp_get_rx_freq(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, p_uhd_args->channel, &p_uhd_args->freq);
 
   logger_info_msg(p_dsp_node->p_logger, "UHD RX, frequnecy set to %f\n", p_uhd_args->freq);
 
   // set bandwidth
 
   //! Set the bandwidth for the given channel's RX frontend
-  error = uhd_usrp_set_rx_bandwidth(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, p_uhd_args->bandwidth, p_uhd_args->channel);
+  error = uhd_usrp_set_rx_bandwidth(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, p_uhd_args->bandwidth, p_uhd_args->channel);
 
   if(error)
   {
@@ -196,20 +221,21 @@ int init_callback_uhd_rx(void *p_init_args, void *p_object)
   }
 
   // print what the bandwidth is
-  uhd_usrp_get_rx_bandwidth(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, p_uhd_args->channel, &p_uhd_args->bandwidth);
+  uhd_usrp_get_rx_bandwidth(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, p_uhd_args->channel, &p_uhd_args->bandwidth);
 
   logger_info_msg(p_dsp_node->p_logger, "UHD RX, bandwidth set to %f\n", p_uhd_args->bandwidth);
 
 ERR_CLOSE_USRP:
   if(error)
   {
-    uhd_usrp_free(&((struct s_uhd_data *)p_dsp_node->p_data)->usrp);
-
     uhd_get_last_error(err_str, 512);
 
     logger_error_msg(p_dsp_node->p_logger, "UHD RX, %s\n", err_str);
 
-    uhd_string_vector_free(&((struct s_uhd_data *)p_dsp_node->p_data)->device_vector);
+    //other nodes may share the device, only drop this one.
+    uhd_node_free((struct s_uhd_node *)p_dsp_node->p_data);
+
+    p_dsp_node->p_data = NULL;
   }
 
   return error;
@@ -219,7 +245,9 @@ ERR_CLOSE_USRP:
 void* pthread_function_uhd_rx(void *p_data)
 {
   int     error = 0;
+  int     gap = 1;
   size_t  samps_per_buff = 0;
+  double  rate = 0;
 
   char    err_str[512] = {"\0"};
 
@@ -228,9 +256,10 @@ void* pthread_function_uhd_rx(void *p_data)
   uhd_rx_streamer_handle  rx_streamer;
 
   struct s_uhd_data *p_uhd_data = NULL;
+  struct s_uhd_node *p_uhd_node = NULL;
   struct s_dsp_node *p_dsp_node = NULL;
 
-  uint8_t *p_buffer = NULL;
+  void *p_buffer = NULL;
 
   p_dsp_node = (struct s_dsp_node *)p_data;
 
@@ -238,14 +267,14 @@ void* pthread_function_uhd_rx(void *p_data)
   {
     fprintf(stderr, "ERROR: Data Struct is NULL.\n");
 
-    kill_thread = 1;
-
     goto ERR_EXIT_THREAD;
   }
 
   p_dsp_node->active = 1;
 
-  p_uhd_data = (struct s_uhd_data *)p_dsp_node->p_data;
+  p_uhd_node = (struct s_uhd_node *)p_dsp_node->p_data;
+
+  p_uhd_data = p_uhd_node->p_device;
 
   error = uhd_rx_streamer_make(&rx_streamer);
 
@@ -253,18 +282,18 @@ void* pthread_function_uhd_rx(void *p_data)
   {
     logger_error_msg(p_dsp_node->p_logger, "UHD RX, make rx streamer failed.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto ERR_EXIT_THREAD;
   }
 
-  error = uhd_usrp_get_rx_stream(p_uhd_data->usrp, &p_uhd_data->stream_args, rx_streamer);
+  error = uhd_usrp_get_rx_stream(p_uhd_data->usrp, &p_uhd_node->stream_args, rx_streamer);
 
   if(error)
   {
     logger_error_msg(p_dsp_node->p_logger, "UHD RX, could not setup stream.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto ERR_EXIT_THREAD;
   }
@@ -284,7 +313,7 @@ void* pthread_function_uhd_rx(void *p_data)
   {
     logger_error_msg(p_dsp_node->p_logger, "UHD RX, could not get max number of samples.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto ERR_KILL_STREAMER;
   }
@@ -304,50 +333,62 @@ void* pthread_function_uhd_rx(void *p_data)
   {
     logger_error_msg(p_dsp_node->p_logger, "UHD RX, could not issue stream command.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto ERR_KILL_STREAMER;
   }
 
-  // metadata, not using this at the moment
+  // metadata, passed downstream as stream tags
   error = uhd_rx_metadata_make(&md);
 
   if(error)
   {
     logger_error_msg(p_dsp_node->p_logger, "UHD RX, could not create metadata.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto ERR_KILL_STREAMER;
   }
 
-  // allocate a buffer for data
-  p_buffer = malloc(samps_per_buff * p_dsp_node->output_type_size);
+  p_dsp_node->total_bytes_processed = 0;
 
-  if(!p_buffer)
+  //the actual rate of the channel of this node, the device may not give what was asked for.
+  if(!uhd_usrp_get_rx_rate(p_uhd_data->usrp, p_uhd_node->channel, &rate))
   {
-    logger_error_msg(p_dsp_node->p_logger, "UHD RX, allocation failed");
+    struct s_dsp_tag tag = {0};
 
-    kill_thread = 1;
+    tag.offset = dsp_getOutputOffset(p_dsp_node);
 
-    goto ERR_EXIT_THREAD_MD;
-  }
+    tag.key = DSP_TAG_RATE;
 
-  p_dsp_node->total_bytes_processed = 0;
+    tag.value_real = rate;
+
+    dsp_addOutputTag(p_dsp_node, &tag);
+  }
 
   logger_info_msg(p_dsp_node->p_logger, "UHD RX, thread started.");
-  // read from USRP and write to ring buffer
+  // read from USRP straight into the output ring buffer
   do
   {
-    size_t numElemRead              = 0;
-    unsigned long int numElemWrote  = 0;
+    size_t numElemRead                = 0;
+    unsigned long int numElemReserved = 0;
+
+    //0 reserved means every consumer has ended.
+    numElemReserved = dsp_reserveOutputTimed(p_dsp_node, &p_buffer, (unsigned long)samps_per_buff, dsp_deadline(DSP_NODE_POLL_MS));
+
+    //no space in time, check kill_thread and wait again, the overflow is tagged on the next recv.
+    if(numElemReserved == DSP_NODE_TIMEOUT) continue;
 
-    error = uhd_rx_streamer_recv(rx_streamer, (void**)&p_buffer, samps_per_buff, &md, 3.0, false, &numElemRead);
+    if(!numElemReserved) break;
+
+    error = uhd_rx_streamer_recv(rx_streamer, &p_buffer, (size_t)numElemReserved, &md, 3.0, false, &numElemRead);
 
     if(error)
     {
       logger_error_msg(p_dsp_node->p_logger, "UHD RX, streamer issues.");
 
+      dsp_statsError(p_dsp_node);
+
       break;
     }
 
@@ -355,23 +396,19 @@ void* pthread_function_uhd_rx(void *p_data)
 
     p_dsp_node->total_bytes_processed += numElemRead * p_dsp_node->output_type_size;
 
-    do
-    {
-      numElemWrote += ringBufferBlockingWrite(p_dsp_node->p_output_ring_buffer, p_buffer + (numElemWrote * p_dsp_node->output_type_size), (unsigned long)numElemRead - numElemWrote, NULL);
-    } while(numElemWrote < numElemRead);
+    tag_uhd_rx_metadata(p_dsp_node, md, (unsigned long)numElemRead, &gap);
 
-  } while(!kill_thread);
+    dsp_commitOutput(p_dsp_node, (unsigned long)numElemRead);
 
-  free(p_buffer);
+  } while(!kill_thread && !dsp_isCancelled(p_dsp_node));
 
-ERR_EXIT_THREAD_MD:
   uhd_rx_metadata_free(&md);
 
 ERR_KILL_STREAMER:
   uhd_rx_streamer_free(&rx_streamer);
 
 ERR_EXIT_THREAD:
-  ringBufferEndBlocking(p_dsp_node->p_output_ring_buffer);
+  dsp_endOutput(p_dsp_node);
 
   logger_info_msg(p_dsp_node->p_logger, "UHD RX thread finished.");
 
@@ -399,7 +436,7 @@ int init_callback_uhd_tx(void *p_init_args, void *p_object)
 
   p_uhd_args = (struct s_uhd_func_args *)p_init_args;
 
-  p_dsp_node->p_data = connect_to_uhd_device(p_dsp_node, p_uhd_args);
+  p_dsp_node->p_data = uhd_node_create(p_dsp_node, p_uhd_args);
 
   if(!p_dsp_node->p_data)
   {
@@ -419,7 +456,7 @@ int init_callback_uhd_tx(void *p_init_args, void *p_object)
   tune_request.args             = "";
 
   // setup tx rate
-  error = uhd_usrp_set_tx_rate(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, p_uhd_args->rate, p_uhd_args->channel);
+  error = uhd_usrp_set_tx_rate(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, p_uhd_args->rate, p_uhd_args->channel);
 
   if(error)
   {
@@ -429,12 +466,14 @@ int init_callback_uhd_tx(void *p_init_args, void *p_object)
   }
 
   // print what the rate is set to
-  uhd_usrp_get_tx_rate(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, p_uhd_args->channel, &p_uhd_args->rate);
+  uhd_usrp_get_tx_rate(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, p_uhd_args->channel, &p_uhd_args->rate);
 
   logger_info_msg(p_dsp_node->p_logger, "UHD TX, rate set to %f", p_uhd_args->rate);
 
+  p_dsp_node->input_rate = p_uhd_args->rate;
+
   // setup rx gain
-  error = uhd_usrp_set_rx_gain(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, p_uhd_args->gain, p_uhd_args->channel, "");
+  error = uhd_usrp_set_rx_gain(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, p_uhd_args->gain, p_uhd_args->channel, "");
 
   if(error)
   {
@@ -444,12 +483,12 @@ int init_callback_uhd_tx(void *p_init_args, void *p_object)
   }
 
   // print what the gain is set to
-  uhd_usrp_get_tx_gain(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, p_uhd_args->channel, "", &p_uhd_args->gain);
+  uhd_usrp_get_tx_gain(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, p_uhd_args->channel, "", &p_uhd_args->gain);
 
   logger_info_msg(p_dsp_node->p_logger, "UHD TX, gain set to %f", p_uhd_args->gain);
 
   // setup tx frequency
-  error = uhd_usrp_set_tx_freq(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, &tune_request, p_uhd_args->channel, &tune_result);
+  error = uhd_usrp_set_tx_freq(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, &tune_request, p_uhd_args->channel, &tune_result);
 
   if(error)
   {
@@ -459,14 +498,14 @@ int init_callback_uhd_tx(void *p_init_args, void *p_object)
   }
 
   // print what the tx frequency is set to
-  uhd_usrp_get_tx_freq(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, p_uhd_args->channel, &p_uhd_args->freq);
+  uhd_usrp_get_tx_freq(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, p_uhd_args->channel, &p_uhd_args->freq);
 
   logger_info_msg(p_dsp_node->p_logger, "UHD TX, frequnecy set to %f", p_uhd_args->freq);
 
   // set bandwidth
 
   //! Set the bandwidth for the given channel's TX frontend
-  error = uhd_usrp_set_tx_bandwidth(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, p_uhd_args->bandwidth, p_uhd_args->channel);
+  error = uhd_usrp_set_tx_bandwidth(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, p_uhd_args->bandwidth, p_uhd_args->channel);
 
   if(error)
   {
@@ -476,20 +515,21 @@ int init_callback_uhd_tx(void *p_init_args, void *p_object)
   }
 
   // print what the bandwidth is
-  uhd_usrp_get_tx_bandwidth(((struct s_uhd_data *)p_dsp_node->p_data)->usrp, p_uhd_args->channel, &p_uhd_args->bandwidth);
+  uhd_usrp_get_tx_bandwidth(((struct s_uhd_node *)p_dsp_node->p_data)->p_device->usrp, p_uhd_args->channel, &p_uhd_args->bandwidth);
 
   logger_info_msg(p_dsp_node->p_logger, "UHD TX, bandwidth set to %f", p_uhd_args->bandwidth);
 
 ERR_CLOSE_USRP:
   if(error)
   {
-    uhd_usrp_free(&((struct s_uhd_data *)p_dsp_node->p_data)->usrp);
-
     uhd_get_last_error(err_str, 512);
 
     logger_error_msg(p_dsp_node->p_logger, "UHD TX, ERROR: %s", err_str);
 
-    uhd_string_vector_free(&((struct s_uhd_data *)p_dsp_node->p_data)->device_vector);
+    //other nodes may share the device, only drop this one.
+    uhd_node_free((struct s_uhd_node *)p_dsp_node->p_data);
+
+    p_dsp_node->p_data = NULL;
   }
 
   return error;
@@ -508,9 +548,10 @@ void* pthread_function_uhd_tx(void *p_data)
   uhd_tx_streamer_handle  tx_streamer;
 
   struct s_uhd_data *p_uhd_data = NULL;
+  struct s_uhd_node *p_uhd_node = NULL;
   struct s_dsp_node *p_dsp_node = NULL;
 
-  uint8_t *p_buffer = NULL;
+  void const *p_buffer = NULL;
 
   p_dsp_node = (struct s_dsp_node *)p_data;
 
@@ -518,14 +559,14 @@ void* pthread_function_uhd_tx(void *p_data)
   {
     fprintf(stderr, "ERROR: Data Struct is NULL.");
 
-    kill_thread = 1;
-
     goto ERR_EXIT_THREAD;
   }
 
   p_dsp_node->active = 1;
 
-  p_uhd_data = (struct s_uhd_data *)p_dsp_node->p_data;
+  p_uhd_node = (struct s_uhd_node *)p_dsp_node->p_data;
+
+  p_uhd_data = p_uhd_node->p_device;
 
   error = uhd_tx_streamer_make(&tx_streamer);
 
@@ -533,18 +574,18 @@ void* pthread_function_uhd_tx(void *p_data)
   {
     logger_error_msg(p_dsp_node->p_logger, "UHD TX, USRP make tx streamer failed.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto ERR_EXIT_THREAD;
   }
 
-  error = uhd_usrp_get_tx_stream(p_uhd_data->usrp, &p_uhd_data->stream_args, tx_streamer);
+  error = uhd_usrp_get_tx_stream(p_uhd_data->usrp, &p_uhd_node->stream_args, tx_streamer);
 
   if(error)
   {
     logger_error_msg(p_dsp_node->p_logger, "UHD TX, TX could not setup stream.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto ERR_EXIT_THREAD;
   }
@@ -564,7 +605,7 @@ void* pthread_function_uhd_tx(void *p_data)
   {
     logger_error_msg(p_dsp_node->p_logger, "UHD TX, Could not get max number of samples.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto ERR_KILL_STREAMER;
   }
@@ -580,49 +621,44 @@ void* pthread_function_uhd_tx(void *p_data)
   {
     logger_error_msg(p_dsp_node->p_logger, "UHD TX, Could not create metadata.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto ERR_KILL_STREAMER;
   }
 
-  // allocate a buffer for data
-  p_buffer = malloc(samps_per_buff * p_dsp_node->input_type_size);
-
-  if(!p_buffer)
-  {
-    logger_error_msg(p_dsp_node->p_logger, "UHD TX, ERROR TX");
-
-    kill_thread = 1;
-
-    goto ERR_EXIT_THREAD_MD;
-  }
-
   p_dsp_node->total_bytes_processed = 0;
 
   logger_info_msg(p_dsp_node->p_logger, "UHD TX thread started.");
 
-  // read from ringbuffer, write to usrp
+  // send to usrp straight out of the input ring buffer
   do
   {
     unsigned long int numElemWrote  = 0;
 
-    // read data
-    numElemRead = ringBufferBlockingRead(p_dsp_node->p_input_ring_buffer, p_buffer, samps_per_buff, NULL);
+    // peek at data
+    numElemRead = dsp_peekInputTimed(p_dsp_node, &p_buffer, samps_per_buff, dsp_deadline(DSP_NODE_POLL_MS));
+
+    //no data in time, check kill_thread and wait again.
+    if(numElemRead == DSP_NODE_TIMEOUT) continue;
 
     p_dsp_node->total_bytes_processed += numElemRead * p_dsp_node->input_type_size;
 
-    error = uhd_tx_streamer_send(tx_streamer, (const void **)&p_buffer, numElemRead, &md, 3.0, &numElemWrote);
+    error = uhd_tx_streamer_send(tx_streamer, &p_buffer, numElemRead, &md, 3.0, &numElemWrote);
 
-    if(error) logger_error_msg(p_dsp_node->p_logger, "UHD TX, TX streamer issues.");
+    if(error)
+    {
+      logger_error_msg(p_dsp_node->p_logger, "UHD TX, TX streamer issues.");
+
+      dsp_statsError(p_dsp_node);
+    }
 
-  } while((numElemRead > 0) && !kill_thread);
+    dsp_releaseInput(p_dsp_node, numElemRead);
+
+  } while((numElemRead > 0) && !kill_thread && !dsp_isCancelled(p_dsp_node));
 
   // the buffers of the device need some time to empty, before closing the stream, or total loss occurs. Would be nice if there was a method to check! grrr
   sleep(5.0);
 
-  free(p_buffer);
-
-ERR_EXIT_THREAD_MD:
   uhd_tx_metadata_free(&md);
 
 ERR_KILL_STREAMER:
@@ -630,7 +666,7 @@ ERR_KILL_STREAMER:
 
 ERR_EXIT_THREAD:
 
-  ringBufferEndBlocking(p_dsp_node->p_input_ring_buffer);
+  dsp_endInput(p_dsp_node);
 
   logger_info_msg(p_dsp_node->p_logger, "UHD TX thread finished.");
 
@@ -648,7 +684,7 @@ int free_callback_uhd(void *p_object)
 
   if(!p_dsp_node->p_data) return 0;
 
-  disconnect_from_uhd_device();
+  uhd_node_free((struct s_uhd_node *)p_dsp_node->p_data);
 
   p_dsp_node->p_data = NULL;
 
@@ -665,34 +701,62 @@ struct s_uhd_data *connect_to_uhd_device(struct s_dsp_node *p_dsp_node, struct s
   char err_str[512]   = {"\0"};
   char temp_str[512]  = {"\0"};
 
-  if(gp_uhd_data)
+  struct s_uhd_data *p_uhd_data = NULL;
+
+  pthread_mutex_lock(&g_uhd_mutex);
+
+  for(p_uhd_data = gp_uhd_devices; p_uhd_data; p_uhd_data = p_uhd_data->p_next)
   {
+    if(!strcmp(p_uhd_data->p_device_args, p_func_args->p_device_args)) break;
+  }
+
+  if(p_uhd_data)
+  {
+    p_uhd_data->refs++;
+
+    pthread_mutex_unlock(&g_uhd_mutex);
+
     logger_info_msg(p_dsp_node->p_logger, "UHD, USRP Device descriptor previously created, reusing.");
 
-    return gp_uhd_data;
+    return p_uhd_data;
   }
 
-  gp_uhd_data = malloc(sizeof(struct s_uhd_data));
+  p_uhd_data = malloc(sizeof(struct s_uhd_data));
 
-  if(!gp_uhd_data)
+  if(!p_uhd_data)
   {
-    logger_error_msg(p_dsp_node->p_logger, "UHD, Could not allocate UHD global struct.");
+    logger_error_msg(p_dsp_node->p_logger, "UHD, Could not allocate UHD device struct.");
+
+    pthread_mutex_unlock(&g_uhd_mutex);
+
+    return NULL;
+  }
+
+  p_uhd_data->p_device_args = strdup(p_func_args->p_device_args);
+
+  if(!p_uhd_data->p_device_args)
+  {
+    logger_error_msg(p_dsp_node->p_logger, "UHD, Could not allocate UHD device struct.");
+
+    free(p_uhd_data);
+
+    pthread_mutex_unlock(&g_uhd_mutex);
 
     return NULL;
   }
 
   logger_info_msg(p_dsp_node->p_logger, "UHD, searching for USRP device with args %s", p_func_args->p_device_args);
 
-  error = uhd_string_vector_make(&gp_uhd_data->device_vector);
+  error = uhd_string_vector_make(&p_uhd_data->device_vector);
 
   if(error)
   {
     logger_error_msg(p_dsp_node->p_logger, "UHD, Device vector make failed.");
 
-    goto ERR_FREE_VECTOR;
+    goto ERR_FREE_DATA;
   }
 
-  error = uhd_usrp_find(p_func_args->p_device_args, &gp_uhd_data->device_vector);
+  error = uhd_usrp_find(p_func_args->p_device_args, &p_uhd_data->device_vector);
 
   if(error)
   {
@@ -701,7 +765,7 @@ struct s_uhd_data *connect_to_uhd_device(struct s_dsp_node *p_dsp_node, struct s
     goto ERR_FREE_VECTOR;
   }
 
-  uhd_string_vector_size(gp_uhd_data->device_vector, &num);
+  uhd_string_vector_size(p_uhd_data->device_vector, &num);
 
   logger_info_msg(p_dsp_node->p_logger, "UHD, Found %ld devices.", num);
 
@@ -716,53 +780,209 @@ struct s_uhd_data *connect_to_uhd_device(struct s_dsp_node *p_dsp_node, struct s
 
   for(index = 0; index < num; index++)
   {
-    uhd_string_vector_at(gp_uhd_data->device_vector, index, temp_str, 512);
+    uhd_string_vector_at(p_uhd_data->device_vector, index, temp_str, 512);
     logger_info_msg(p_dsp_node->p_logger, "UHD, Device found at %ld is %s", index, temp_str);
   }
 
   // create usrp device handle
-  error = uhd_usrp_make(&gp_uhd_data->usrp, p_func_args->p_device_args);
+  error = uhd_usrp_make(&p_uhd_data->usrp, p_func_args->p_device_args);
 
   if(error)
   {
     uhd_get_last_error(err_str, 512);
 
     logger_error_msg(p_dsp_node->p_logger, "UHD, ERROR: %s", err_str);
+
+    goto ERR_FREE_VECTOR;
   }
 
+  p_uhd_data->refs = 1;
+
+  p_uhd_data->p_next = gp_uhd_devices;
+
+  gp_uhd_devices = p_uhd_data;
+
+  pthread_mutex_unlock(&g_uhd_mutex);
+
+  return p_uhd_data;
+
 ERR_FREE_VECTOR:
-  if(error)
+  uhd_string_vector_free(&p_uhd_data->device_vector);
+
+ERR_FREE_DATA:
+  free(p_uhd_data->p_device_args);
+
+  free(p_uhd_data);
+
+  pthread_mutex_unlock(&g_uhd_mutex);
+
+  return NULL;
+}
+
+//disconnect once the last node of the device is done with it.
+void disconnect_from_uhd_device(struct s_uhd_data *p_uhd_data)
+{
+  struct s_uhd_data **pp_link = NULL;
+
+  if(!p_uhd_data) return;
+
+  pthread_mutex_lock(&g_uhd_mutex);
+
+  p_uhd_data->refs--;
+
+  if(p_uhd_data->refs)
+  {
+    pthread_mutex_unlock(&g_uhd_mutex);
+
+    return;
+  }
+
+  for(pp_link = &gp_uhd_devices; *pp_link; pp_link = &(*pp_link)->p_next)
+  {
+    if(*pp_link != p_uhd_data) continue;
+
+    *pp_link = p_uhd_data->p_next;
+
+    break;
+  }
+
+  pthread_mutex_unlock(&g_uhd_mutex);
+
+  sleep(2.0);
+
+  uhd_usrp_free(&p_uhd_data->usrp);
+
+  uhd_string_vector_free(&p_uhd_data->device_vector);
+
+  free(p_uhd_data->p_device_args);
+
+  free(p_uhd_data);
+}
+
+//connect a node to its device and copy the channel and format of its stream, the args may be freed after init.
+static struct s_uhd_node *uhd_node_create(struct s_dsp_node *p_dsp_node, struct s_uhd_func_args *p_func_args)
+{
+  struct s_uhd_node *p_uhd_node = NULL;
+
+  p_uhd_node = malloc(sizeof(struct s_uhd_node));
+
+  if(!p_uhd_node)
   {
-    uhd_string_vector_free(&gp_uhd_data->device_vector);
+    logger_error_msg(p_dsp_node->p_logger, "UHD, Could not allocate UHD node struct.");
 
-    gp_uhd_data = NULL;
+    return NULL;
+  }
+
+  p_uhd_node->p_cpu_format = strdup(p_func_args->p_cpu_data);
+
+  if(!p_uhd_node->p_cpu_format)
+  {
+    logger_error_msg(p_dsp_node->p_logger, "UHD, Could not allocate UHD node struct.");
+
+    free(p_uhd_node);
 
     return NULL;
   }
 
-  gp_uhd_data->stream_args.cpu_format = p_func_args->p_cpu_data;
-  gp_uhd_data->stream_args.otw_format = "sc16";
-  gp_uhd_data->stream_args.args = "";
-  gp_uhd_data->stream_args.channel_list = &p_func_args->channel;
-  gp_uhd_data->stream_args.n_channels = 1;
+  p_uhd_node->p_device = connect_to_uhd_device(p_dsp_node, p_func_args);
 
-  return gp_uhd_data;
+  if(!p_uhd_node->p_device)
+  {
+    free(p_uhd_node->p_cpu_format);
+
+    free(p_uhd_node);
+
+    return NULL;
+  }
+
+  //every node streams its own channel and format, only the usrp is shared.
+  p_uhd_node->channel = p_func_args->channel;
+
+  p_uhd_node->stream_args.cpu_format = p_uhd_node->p_cpu_format;
+  p_uhd_node->stream_args.otw_format = "sc16";
+  p_uhd_node->stream_args.args = "";
+  p_uhd_node->stream_args.channel_list = &p_uhd_node->channel;
+  p_uhd_node->stream_args.n_channels = 1;
+
+  return p_uhd_node;
 }
 
-//disconnect if the device is still connected.
-void disconnect_from_uhd_device()
+//free a node and drop its reference to the device.
+static void uhd_node_free(struct s_uhd_node *p_uhd_node)
 {
-  if(!gp_uhd_data) return;
+  if(!p_uhd_node) return;
 
-  sleep(2.0);
+  disconnect_from_uhd_device(p_uhd_node->p_device);
+
+  free(p_uhd_node->p_cpu_format);
+
+  free(p_uhd_node);
+}
+
+//tag the block about to be committed with the rx metadata, time after a gap, burst start and end.
+void tag_uhd_rx_metadata(struct s_dsp_node *p_dsp_node, uhd_rx_metadata_handle md, unsigned long num_samples, int *p_gap)
+{
+  bool result = false;
+
+  uhd_rx_metadata_error_code_t error_code = UHD_RX_METADATA_ERROR_CODE_NONE;
 
-  uhd_usrp_free(&gp_uhd_data->usrp);
+  struct s_dsp_tag tag = {0};
 
-  uhd_string_vector_free(&gp_uhd_data->device_vector);
+  uhd_rx_metadata_error_code(md, &error_code);
 
-  free(gp_uhd_data);
+  //a overflow or timeout drops samples, the next block gets a new time.
+  if(error_code != UHD_RX_METADATA_ERROR_CODE_NONE)
+  {
+    *p_gap = 1;
+
+    return;
+  }
+
+  if(!num_samples) return;
+
+  tag.offset = dsp_getOutputOffset(p_dsp_node);
+
+  uhd_rx_metadata_start_of_burst(md, &result);
+
+  if(result)
+  {
+    tag.key = DSP_TAG_BURST_START;
 
-  gp_uhd_data = NULL;
+    dsp_addOutputTag(p_dsp_node, &tag);
+  }
+
+  uhd_rx_metadata_has_time_spec(md, &result);
+
+  //time of the first sample once, then only after samples were lost.
+  if(result && *p_gap)
+  {
+    int64_t full_secs = 0;
+
+    tag.key = DSP_TAG_TIME;
+
+    uhd_rx_metadata_time_spec(md, &full_secs, &tag.value_real);
+
+    tag.value_int = full_secs;
+
+    dsp_addOutputTag(p_dsp_node, &tag);
+
+    *p_gap = 0;
+  }
+
+  uhd_rx_metadata_end_of_burst(md, &result);
+
+  if(result)
+  {
+    tag.offset += num_samples - 1;
+
+    tag.key = DSP_TAG_BURST_END;
+
+    tag.value_int = 0;
+
+    tag.value_real = 0;
+
+    dsp_addOutputTag(p_dsp_node, &tag);
+  }
 }
 
 //convert cpu string type to dsp_node enum type
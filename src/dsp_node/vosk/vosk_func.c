@@ -12,6 +12,7 @@
 #include <string.h>
 
 #include "vosk_api.h"
+#include "dsp_node.h"
 #include "vosk_func.h"
 #include "kill_throbber.h"
 #include "logger.h"
@@ -87,6 +88,8 @@ int init_callback_vosk(void *p_init_args, void *p_object)
 
   p_dsp_node->output_type = DATA_U8;
 
+  p_dsp_node->input_rate = p_vosk_args->sample_rate;
+
   p_dsp_node->p_data = p_vosk_data;
 
   p_vosk_data->model = vosk_model_new("model");
@@ -117,8 +120,6 @@ void* pthread_function_vosk(void *p_data)
   {
     fprintf(stderr, "ERROR: Data Struct is NULL.\n");
 
-    kill_thread = 1;
-
     goto error_cleanup;
   }
 
@@ -126,13 +127,13 @@ void* pthread_function_vosk(void *p_data)
 
   p_dsp_node->active = 1;
 
-  p_buffer = malloc(p_dsp_node->chunk_size * p_dsp_node->output_type_size);
+  p_buffer = dsp_allocBuffer(p_dsp_node, p_dsp_node->chunk_size * p_dsp_node->output_type_size);
 
   if(!p_buffer)
   {
     logger_error_msg(p_dsp_node->p_logger, "VOSK, could not allocate input buffer.");
 
-    kill_thread = 1;
+    dsp_kill(p_dsp_node);
 
     goto error_cleanup;
   }
@@ -148,9 +149,22 @@ void* pthread_function_vosk(void *p_data)
     unsigned long numElemWrote  = 0;
     char *p_json_txt            = NULL;
 
-    numElemRead = ringBufferBlockingRead(p_dsp_node->p_input_ring_buffer, p_buffer, p_dsp_node->chunk_size, NULL);
+    numElemRead = dsp_readInputTimed(p_dsp_node, p_buffer, p_dsp_node->chunk_size, dsp_deadline(DSP_NODE_POLL_MS));
+
+    //no audio in time, check kill_thread and wait again.
+    if(numElemRead == DSP_NODE_TIMEOUT) continue;
+
+    //end of stream, flush the words of the last partial utterance.
+    if(!numElemRead)
+    {
+      p_json_txt = (char *)vosk_recognizer_final_result(p_vosk_data->recognizer);
+
+      numChars = strlen(p_json_txt);
 
-    if(numElemRead <= 0) continue;
+      dsp_writeOutputAll(p_dsp_node, p_json_txt, numChars, &kill_thread);
+
+      break;
+    }
 
     p_dsp_node->total_bytes_processed += numElemRead * p_dsp_node->input_type_size;
 
@@ -174,17 +188,19 @@ void* pthread_function_vosk(void *p_data)
 
     numChars = strlen(p_json_txt);
 
-    do
-    {
-      numElemWrote += ringBufferBlockingWrite(p_dsp_node->p_output_ring_buffer, p_json_txt + numElemWrote, numChars - numElemWrote, NULL);
-    } while(numElemWrote < numChars);
+    numElemWrote = dsp_writeOutputAll(p_dsp_node, p_json_txt, numChars, &kill_thread);
+
+    //less written then recognized means every consumer has ended.
+    if(numElemWrote < numChars) break;
 
-  } while((numElemRead > 0) && !kill_thread);
+  } while((numElemRead > 0) && !kill_thread && !dsp_isCancelled(p_dsp_node));
 
 error_cleanup:
-  free(p_buffer);
+  dsp_freeBuffer(p_dsp_node, p_buffer, p_dsp_node->chunk_size * p_dsp_node->output_type_size);
+
+  dsp_endOutput(p_dsp_node);
 
-  ringBufferEndBlocking(p_dsp_node->p_output_ring_buffer);
+  dsp_endInput(p_dsp_node);
 
   logger_info_msg(p_dsp_node->p_logger, "VOSK thread finished.");
 
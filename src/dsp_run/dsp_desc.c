@@ -0,0 +1,1358 @@
+//******************************************************************************
+/// @file     dsp_desc.c
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Text description of a node graph, parsed and built into a s_dsp_graph.
+/// @details  Node types are a table of the create_*_args and callbacks each
+///           node library already has, libraries not built are left out.
+//******************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <sched.h>
+
+#include "dsp_desc.h"
+#include "dsp_convert.h"
+#include "file/file_func.h"
+#include "shm/shm_func.h"
+#include "gen/gen_func.h"
+
+#ifdef DSP_DESC_ALSA
+#include "alsa/alsa_func.h"
+#endif
+
+#ifdef DSP_DESC_CODEC2
+#include "codec2/codec2_func.h"
+#endif
+
+#ifdef DSP_DESC_SOXR
+#include "soxr/soxr_func.h"
+#endif
+
+#ifdef DSP_DESC_TCP_SERVER
+#include "tcp_server/tcp_server_func.h"
+#endif
+
+#ifdef DSP_DESC_UHD
+#include "uhd/uhd_func.h"
+#endif
+
+#ifdef DSP_DESC_VOSK
+#include "vosk/vosk_func.h"
+#endif
+
+//keys every node has, the launcher applies them between dsp_create and dsp_setup.
+#define DESC_NODE_KEYS "buffer chunk cpus ring sched latency budget alloc numa convert"
+
+//keys of the graph statement.
+#define DESC_GRAPH_KEYS "fusion pool"
+
+//names of e_binary_type, in enum order from DATA_S8.
+static char const * const gp_type_names[] = {"s8", "u8", "cs8", "s16", "u16", "cs16", "s32", "u32", "float", "cfloat", "double", "cdouble", "unknown"};
+
+//set a key, replacing the value if the node has it.
+static int desc_put(struct s_dsp_desc_node * const p_node, char const * const p_key, char const * const p_value);
+//1 if p_key is in the space separated list p_keys.
+static int desc_known(char const *p_keys, char const * const p_key);
+//type of a node by name, added types first, NULL if there is none.
+static struct s_dsp_desc_type const *desc_find_type(struct s_dsp_desc const * const p_desc, char const * const p_name);
+//apply the node keys to a created node, before setup.
+static int desc_settings(struct s_dsp_desc_node * const p_node);
+//parse a cpu list (0,2-3) into a set.
+static int desc_cpus(char const *p_list, cpu_set_t * const p_cpuset);
+//split key=value tokens of a statement into a node.
+static int desc_keys(struct s_dsp_desc_node * const p_node, char *p_save, unsigned int line);
+//free the strings of a node.
+static void desc_free_node(struct s_dsp_desc_node * const p_node);
+
+//create args of each node type.
+static void *desc_file_read_args(struct s_dsp_desc_node const * const p_node);
+static void *desc_file_write_args(struct s_dsp_desc_node const * const p_node);
+static void desc_free_file(void *p_args);
+static void *desc_convert_args(struct s_dsp_desc_node const * const p_node);
+static void desc_free_convert(void *p_args);
+static void *desc_shm_read_args(struct s_dsp_desc_node const * const p_node);
+static void *desc_shm_write_args(struct s_dsp_desc_node const * const p_node);
+static void desc_free_shm(void *p_args);
+static void *desc_gen_args(struct s_dsp_desc_node const * const p_node);
+static void desc_free_gen(void *p_args);
+static void *desc_null_args(struct s_dsp_desc_node const * const p_node);
+static void desc_free_null(void *p_args);
+#ifdef DSP_DESC_ALSA
+static void *desc_alsa_args(struct s_dsp_desc_node const * const p_node);
+static void desc_free_alsa(void *p_args);
+#endif
+#ifdef DSP_DESC_CODEC2
+static void *desc_codec2_args(struct s_dsp_desc_node const * const p_node);
+static void desc_free_codec2(void *p_args);
+#endif
+#ifdef DSP_DESC_SOXR
+static void *desc_soxr_args(struct s_dsp_desc_node const * const p_node);
+static void desc_free_soxr(void *p_args);
+#endif
+#ifdef DSP_DESC_TCP_SERVER
+static void *desc_tcp_args(struct s_dsp_desc_node const * const p_node);
+static void desc_free_tcp(void *p_args);
+#endif
+#ifdef DSP_DESC_UHD
+static void *desc_uhd_args(struct s_dsp_desc_node const * const p_node);
+static void desc_free_uhd(void *p_args);
+#endif
+#ifdef DSP_DESC_VOSK
+static void *desc_vosk_args(struct s_dsp_desc_node const * const p_node);
+static void desc_free_vosk(void *p_args);
+#endif
+
+//node types built in.
+static struct s_dsp_desc_type const g_desc_types[] =
+{
+  {"file_read", "file type", desc_file_read_args, desc_free_file, init_callback_file_read, pthread_function_file_read, free_callback_file_read},
+  {"file_write", "file type mode", desc_file_write_args, desc_free_file, init_callback_file_write, pthread_function_file_write, free_callback_file_write},
+  {"convert", "in out swap", desc_convert_args, desc_free_convert, init_callback_convert, pthread_function_convert, free_callback_convert},
+  {"shm_read", "name type", desc_shm_read_args, desc_free_shm, init_callback_shm_read, pthread_function_shm_read, free_callback_shm_read},
+  {"shm_write", "name type size drop", desc_shm_write_args, desc_free_shm, init_callback_shm_write, pthread_function_shm_write, free_callback_shm_write},
+  {"gen", "wave type rate pace amplitude freq freq_end sweep count seed", desc_gen_args, desc_free_gen, init_callback_gen, pthread_function_gen, free_callback_gen},
+  {"null", "type checksum", desc_null_args, desc_free_null, init_callback_null, pthread_function_null, free_callback_null},
+#ifdef DSP_DESC_ALSA
+  {"alsa_read", "device format channels rate", desc_alsa_args, desc_free_alsa, init_callback_alsa_read, pthread_function_alsa_read, free_callback_alsa_read},
+  {"alsa_write", "device format channels rate", desc_alsa_args, desc_free_alsa, init_callback_alsa_write, pthread_function_alsa_write, free_callback_alsa_write},
+#endif
+#ifdef DSP_DESC_CODEC2
+  {"codec2_mod", "type", desc_codec2_args, desc_free_codec2, init_callback_codec2_mod, pthread_function_codec2_mod, free_callback_codec2_mod},
+  {"codec2_demod", "type", desc_codec2_args, desc_free_codec2, init_callback_codec2_demod, pthread_function_codec2_demod, free_callback_codec2_demod},
+#endif
+#ifdef DSP_DESC_SOXR
+  {"soxr", "in_rate out_rate in out channels", desc_soxr_args, desc_free_soxr, init_callback_soxr, pthread_function_soxr, free_callback_soxr},
+#endif
+#ifdef DSP_DESC_TCP_SERVER
+  {"tcp_send", "address port in out", desc_tcp_args, desc_free_tcp, init_callback_tcp, pthread_function_tcp_server_send, free_callback_tcp},
+  {"tcp_recv", "address port in out", desc_tcp_args, desc_free_tcp, init_callback_tcp, pthread_function_tcp_server_recv, free_callback_tcp},
+#endif
+#ifdef DSP_DESC_UHD
+  {"uhd_rx", "args freq rate gain bw cpu", desc_uhd_args, desc_free_uhd, init_callback_uhd_rx, pthread_function_uhd_rx, free_callback_uhd},
+  {"uhd_tx", "args freq rate gain bw cpu", desc_uhd_args, desc_free_uhd, init_callback_uhd_tx, pthread_function_uhd_tx, free_callback_uhd},
+#endif
+#ifdef DSP_DESC_VOSK
+  {"vosk", "rate type", desc_vosk_args, desc_free_vosk, init_callback_vosk, pthread_function_vosk, free_callback_vosk},
+#endif
+};
+
+#define DESC_NUM_TYPES (sizeof(g_desc_types) / sizeof(g_desc_types[0]))
+
+//Allocate a empty description.
+struct s_dsp_desc *dsp_descCreate(void)
+{
+  struct s_dsp_desc *p_temp = NULL;
+
+  p_temp = calloc(1, sizeof(struct s_dsp_desc));
+
+  if(!p_temp)
+  {
+    perror("DSP description struct failed");
+
+    return NULL;
+  }
+
+  return p_temp;
+}
+
+//Add a node type for this description.
+int dsp_descAddType(struct s_dsp_desc * const p_desc, struct s_dsp_desc_type const * const p_type)
+{
+  struct s_dsp_desc_type *p_temp = NULL;
+
+  if(!p_desc || !p_type || !p_type->p_name || !p_type->p_keys || !p_type->create_args || !p_type->free_args) return ~0;
+
+  p_temp = realloc(p_desc->p_types, (p_desc->num_types + 1) * sizeof(struct s_dsp_desc_type));
+
+  if(!p_temp)
+  {
+    perror("DSP description type failed");
+
+    return ~0;
+  }
+
+  p_desc->p_types = p_temp;
+
+  p_desc->p_types[p_desc->num_types] = *p_type;
+
+  p_desc->num_types++;
+
+  return 0;
+}
+
+//Check a node type is built in or added.
+int dsp_descHasType(struct s_dsp_desc const * const p_desc, char const * const p_name)
+{
+  if(!p_name) return 0;
+
+  return (desc_find_type(p_desc, p_name) != NULL);
+}
+
+//Parse a description file into p_desc.
+int dsp_descLoad(struct s_dsp_desc * const p_desc, char const * const p_file)
+{
+  int error = 0;
+
+  unsigned int line = 0;
+
+  char buffer[DSP_DESC_LINE];
+
+  FILE *p_fd = NULL;
+
+  if(!p_desc || !p_file) return ~0;
+
+  p_fd = (strcmp(p_file, "-") ? fopen(p_file, "r") : stdin);
+
+  if(!p_fd)
+  {
+    fprintf(stderr, "ERROR: could not open graph description %s.\n", p_file);
+
+    return ~0;
+  }
+
+  while(fgets(buffer, sizeof(buffer), p_fd))
+  {
+    line++;
+
+    if(!strchr(buffer, '\n') && !feof(p_fd))
+    {
+      fprintf(stderr, "ERROR: line %u is longer then %d chars.\n", line, DSP_DESC_LINE - 1);
+
+      error = ~0;
+
+      break;
+    }
+
+    error = dsp_descParse(p_desc, buffer, line);
+
+    if(error) break;
+  }
+
+  if(p_fd != stdin) fclose(p_fd);
+
+  return error;
+}
+
+//Parse one statement.
+int dsp_descParse(struct s_dsp_desc * const p_desc, char const * const p_line, unsigned int line)
+{
+  int error = 0;
+
+  char buffer[DSP_DESC_LINE];
+
+  char *p_save = NULL;
+  char *p_token = NULL;
+  char *p_comment = NULL;
+
+  if(!p_desc || !p_line) return ~0;
+
+  if(p_desc->p_graph)
+  {
+    fprintf(stderr, "ERROR: line %u, graph is already built.\n", line);
+
+    return ~0;
+  }
+
+  strncpy(buffer, p_line, sizeof(buffer) - 1);
+
+  buffer[sizeof(buffer) - 1] = '\0';
+
+  p_comment = strchr(buffer, '#');
+
+  if(p_comment) *p_comment = '\0';
+
+  p_token = strtok_r(buffer, " \t\r\n", &p_save);
+
+  //blank or comment
+  if(!p_token) return 0;
+
+  if(!strcmp(p_token, "graph"))
+  {
+    p_desc->graph.line = line;
+
+    return desc_keys(&p_desc->graph, p_save, line);
+  }
+
+  if(!strcmp(p_token, "node"))
+  {
+    char *p_name = NULL;
+    char *p_type = NULL;
+
+    struct s_dsp_desc_node *p_temp = NULL;
+
+    p_name = strtok_r(NULL, " \t\r\n", &p_save);
+
+    p_type = strtok_r(NULL, " \t\r\n", &p_save);
+
+    if(!p_name || !p_type || strchr(p_name, '=') || strchr(p_type, '='))
+    {
+      fprintf(stderr, "ERROR: line %u, node needs a name and a type.\n", line);
+
+      return ~0;
+    }
+
+    if(!strcmp(p_name, "graph") || strchr(p_name, '.') || (dsp_descFind(p_desc, p_name) != p_desc->num_nodes))
+    {
+      fprintf(stderr, "ERROR: line %u, node name %s is reserved, has a . or is used.\n", line, p_name);
+
+      return ~0;
+    }
+
+    if(!desc_find_type(p_desc, p_type))
+    {
+      fprintf(stderr, "ERROR: line %u, node type %s is not built in (-t lists them).\n", line, p_type);
+
+      return ~0;
+    }
+
+    p_temp = realloc(p_desc->p_nodes, (p_desc->num_nodes + 1) * sizeof(struct s_dsp_desc_node));
+
+    if(!p_temp)
+    {
+      perror("DSP description node failed");
+
+      return ~0;
+    }
+
+    p_desc->p_nodes = p_temp;
+
+    p_temp = &p_desc->p_nodes[p_desc->num_nodes];
+
+    memset(p_temp, 0, sizeof(struct s_dsp_desc_node));
+
+    p_temp->line = line;
+
+    p_temp->p_name = strdup(p_name);
+
+    p_temp->p_type = strdup(p_type);
+
+    //counted before keys so a failure frees the strings.
+    p_desc->num_nodes++;
+
+    if(!p_temp->p_name || !p_temp->p_type)
+    {
+      perror("DSP description node failed");
+
+      return ~0;
+    }
+
+    return desc_keys(p_temp, p_save, line);
+  }
+
+  if(!strcmp(p_token, "edge"))
+  {
+    char *p_src = NULL;
+    char *p_dst = NULL;
+
+    char const *p_value = NULL;
+
+    struct s_dsp_desc_node keys;
+
+    struct s_dsp_desc_edge *p_temp = NULL;
+
+    p_src = strtok_r(NULL, " \t\r\n", &p_save);
+
+    p_dst = strtok_r(NULL, " \t\r\n", &p_save);
+
+    if(!p_src || !p_dst)
+    {
+      fprintf(stderr, "ERROR: line %u, edge needs a source and destination node.\n", line);
+
+      return ~0;
+    }
+
+    p_temp = realloc(p_desc->p_edges, (p_desc->num_edges + 1) * sizeof(struct s_dsp_desc_edge));
+
+    if(!p_temp)
+    {
+      perror("DSP description edge failed");
+
+      return ~0;
+    }
+
+    p_desc->p_edges = p_temp;
+
+    p_temp = &p_desc->p_edges[p_desc->num_edges];
+
+    p_temp->src = dsp_descFind(p_desc, p_src);
+
+    p_temp->dst = dsp_descFind(p_desc, p_dst);
+
+    p_temp->line = line;
+
+    if((p_temp->src == p_desc->num_nodes) || (p_temp->dst == p_desc->num_nodes))
+    {
+      fprintf(stderr, "ERROR: line %u, edge %s to %s names a node not declared before it.\n", line, p_src, p_dst);
+
+      return ~0;
+    }
+
+    memset(&keys, 0, sizeof(keys));
+
+    error = desc_keys(&keys, p_save, line);
+
+    if(!error)
+    {
+      unsigned int index = 0;
+
+      p_temp->port = (unsigned int)dsp_descReal(&keys, "port", "0");
+
+      for(index = 0; index < keys.num_keys; index++)
+      {
+        if(desc_known("port buffer", keys.p_keys[index].p_key)) continue;
+
+        fprintf(stderr, "ERROR: line %u, edge has no key %s.\n", line, keys.p_keys[index].p_key);
+
+        error = ~0;
+      }
+
+      //the edge reads the output ring of the source, a larger buffer on any of its edges sizes the ring.
+      p_value = dsp_descGet(&keys, "buffer", NULL);
+
+      if(!error && p_value)
+      {
+        unsigned long size = dsp_descSize(&keys, "buffer", NULL);
+        unsigned long current = dsp_descSize(&p_desc->p_nodes[p_temp->src], "buffer", "auto");
+
+        if(size == ~0UL)
+        {
+          error = ~0;
+        }
+        else if((current == ~0UL) || (size > current))
+        {
+          error = desc_put(&p_desc->p_nodes[p_temp->src], "buffer", p_value);
+        }
+      }
+    }
+
+    desc_free_node(&keys);
+
+    if(error) return ~0;
+
+    p_desc->num_edges++;
+
+    return 0;
+  }
+
+  fprintf(stderr, "ERROR: line %u, unknown statement %s (graph, node or edge).\n", line, p_token);
+
+  return ~0;
+}
+
+//Set a key of a node or the graph.
+int dsp_descSet(struct s_dsp_desc * const p_desc, char const * const p_set)
+{
+  int error = 0;
+
+  char *p_temp = NULL;
+  char *p_key = NULL;
+  char *p_value = NULL;
+
+  unsigned int index = 0;
+
+  struct s_dsp_desc_node *p_node = NULL;
+
+  if(!p_desc || !p_set) return ~0;
+
+  p_temp = strdup(p_set);
+
+  if(!p_temp) return ~0;
+
+  p_key = strchr(p_temp, '.');
+
+  p_value = strchr(p_temp, '=');
+
+  if(!p_key || !p_value || (p_value < p_key))
+  {
+    fprintf(stderr, "ERROR: set %s is not name.key=value.\n", p_set);
+
+    free(p_temp);
+
+    return ~0;
+  }
+
+  *p_key++ = '\0';
+
+  *p_value++ = '\0';
+
+  index = dsp_descFind(p_desc, p_temp);
+
+  if(!strcmp(p_temp, "graph"))
+  {
+    p_node = &p_desc->graph;
+  }
+  else if(index != p_desc->num_nodes)
+  {
+    p_node = &p_desc->p_nodes[index];
+  }
+
+  if(!p_node)
+  {
+    fprintf(stderr, "ERROR: set %s, there is no node %s.\n", p_set, p_temp);
+
+    error = ~0;
+  }
+  else
+  {
+    error = desc_put(p_node, p_key, p_value);
+  }
+
+  free(p_temp);
+
+  return error;
+}
+
+//Create, setup and connect every node into a graph.
+struct s_dsp_graph *dsp_descBuild(struct s_dsp_desc * const p_desc)
+{
+  int error = 0;
+
+  unsigned int index = 0;
+  unsigned int key = 0;
+
+  if(!p_desc) return NULL;
+
+  if(p_desc->p_graph) return p_desc->p_graph;
+
+  for(key = 0; key < p_desc->graph.num_keys; key++)
+  {
+    if(desc_known(DESC_GRAPH_KEYS, p_desc->graph.p_keys[key].p_key)) continue;
+
+    fprintf(stderr, "ERROR: graph has no key %s.\n", p_desc->graph.p_keys[key].p_key);
+
+    return NULL;
+  }
+
+  //check every key before anything is created, a typo in a tuning run should not start half a graph.
+  for(index = 0; index < p_desc->num_nodes; index++)
+  {
+    struct s_dsp_desc_type const *p_type = desc_find_type(p_desc, p_desc->p_nodes[index].p_type);
+
+    for(key = 0; key < p_desc->p_nodes[index].num_keys; key++)
+    {
+      char const *p_key = p_desc->p_nodes[index].p_keys[key].p_key;
+
+      if(desc_known(DESC_NODE_KEYS, p_key) || desc_known(p_type->p_keys, p_key)) continue;
+
+      fprintf(stderr, "ERROR: line %u, node %s type %s has no key %s.\n", p_desc->p_nodes[index].line, p_desc->p_nodes[index].p_name, p_type->p_name, p_key);
+
+      return NULL;
+    }
+  }
+
+  p_desc->p_graph = dsp_graphCreate();
+
+  if(!p_desc->p_graph) return NULL;
+
+  if(dsp_descGet(&p_desc->graph, "fusion", NULL))
+  {
+    error = dsp_graphSetFusion(p_desc->p_graph, (int)dsp_descReal(&p_desc->graph, "fusion", "0"));
+
+    if(error) goto error_cleanup;
+  }
+
+  if(dsp_descGet(&p_desc->graph, "pool", NULL))
+  {
+    unsigned int workers = DSP_POOL_CORES;
+
+    if(strcmp(dsp_descGet(&p_desc->graph, "pool", NULL), "cores")) workers = (unsigned int)dsp_descReal(&p_desc->graph, "pool", "0");
+
+    error = dsp_graphSetPool(p_desc->p_graph, workers);
+
+    if(error) goto error_cleanup;
+  }
+
+  for(index = 0; index < p_desc->num_nodes; index++)
+  {
+    unsigned long buffer_size = 0;
+    unsigned long chunk_size = 0;
+
+    struct s_dsp_desc_node *p_node = &p_desc->p_nodes[index];
+
+    struct s_dsp_desc_type const *p_type = desc_find_type(p_desc, p_node->p_type);
+
+    buffer_size = dsp_descSize(p_node, "buffer", "auto");
+
+    chunk_size = dsp_descSize(p_node, "chunk", "auto");
+
+    if((buffer_size == ~0UL) || (chunk_size == ~0UL)) goto error_cleanup;
+
+    p_node->p_args = p_type->create_args(p_node);
+
+    if(!p_node->p_args)
+    {
+      fprintf(stderr, "ERROR: line %u, node %s args are not valid.\n", p_node->line, p_node->p_name);
+
+      goto error_cleanup;
+    }
+
+    p_node->p_node = dsp_create(buffer_size, chunk_size);
+
+    if(!p_node->p_node) goto error_cleanup;
+
+    //owned by the graph from here, even if setup fails.
+    error = dsp_graphAddNode(p_desc->p_graph, p_node->p_node);
+
+    if(error)
+    {
+      dsp_cleanup(p_node->p_node);
+
+      p_node->p_node = NULL;
+
+      goto error_cleanup;
+    }
+
+    error = desc_settings(p_node);
+
+    if(error) goto error_cleanup;
+
+    error = dsp_setup(p_node->p_node, p_type->init_call, p_type->thread_func, p_type->free_call, p_node->p_args);
+
+    if(error)
+    {
+      fprintf(stderr, "ERROR: line %u, node %s type %s setup failed.\n", p_node->line, p_node->p_name, p_type->p_name);
+
+      goto error_cleanup;
+    }
+  }
+
+  for(index = 0; index < p_desc->num_edges; index++)
+  {
+    struct s_dsp_desc_edge const *p_edge = &p_desc->p_edges[index];
+
+    error = dsp_graphConnect(p_desc->p_graph, p_desc->p_nodes[p_edge->src].p_node, p_desc->p_nodes[p_edge->dst].p_node, p_edge->port);
+
+    if(error)
+    {
+      fprintf(stderr, "ERROR: line %u, could not connect %s to %s port %u (types or port).\n", p_edge->line, p_desc->p_nodes[p_edge->src].p_name, p_desc->p_nodes[p_edge->dst].p_name, p_edge->port);
+
+      goto error_cleanup;
+    }
+  }
+
+  return p_desc->p_graph;
+
+error_cleanup:
+  dsp_graphCleanup(p_desc->p_graph);
+
+  p_desc->p_graph = NULL;
+
+  //args are created again by the next build.
+  for(index = 0; index < p_desc->num_nodes; index++)
+  {
+    struct s_dsp_desc_type const *p_type = desc_find_type(p_desc, p_desc->p_nodes[index].p_type);
+
+    if(p_desc->p_nodes[index].p_args) p_type->free_args(p_desc->p_nodes[index].p_args);
+
+    p_desc->p_nodes[index].p_args = NULL;
+
+    p_desc->p_nodes[index].p_node = NULL;
+  }
+
+  return NULL;
+}
+
+//Index of a node by name.
+unsigned int dsp_descFind(struct s_dsp_desc const * const p_desc, char const * const p_name)
+{
+  unsigned int index = 0;
+
+  if(!p_desc || !p_name) return 0;
+
+  for(index = 0; index < p_desc->num_nodes; index++)
+  {
+    if(!strcmp(p_desc->p_nodes[index].p_name, p_name)) break;
+  }
+
+  return index;
+}
+
+//Print the node types built in or added and their keys.
+void dsp_descTypes(struct s_dsp_desc const * const p_desc, FILE *p_file)
+{
+  unsigned int index = 0;
+
+  if(!p_file) return;
+
+  fprintf(p_file, "graph keys: %s\n", DESC_GRAPH_KEYS);
+
+  fprintf(p_file, "node keys:  %s\n", DESC_NODE_KEYS);
+
+  fprintf(p_file, "edge keys:  port buffer\n");
+
+  for(index = 0; p_desc && (index < p_desc->num_types); index++)
+  {
+    fprintf(p_file, "  %-14s %s\n", p_desc->p_types[index].p_name, p_desc->p_types[index].p_keys);
+  }
+
+  for(index = 0; index < DESC_NUM_TYPES; index++)
+  {
+    fprintf(p_file, "  %-14s %s\n", g_desc_types[index].p_name, g_desc_types[index].p_keys);
+  }
+}
+
+//Value of a key.
+char const *dsp_descGet(struct s_dsp_desc_node const * const p_node, char const * const p_key, char const * const p_default)
+{
+  unsigned int index = 0;
+
+  for(index = 0; index < p_node->num_keys; index++)
+  {
+    if(!strcmp(p_node->p_keys[index].p_key, p_key)) return p_node->p_keys[index].p_value;
+  }
+
+  return p_default;
+}
+
+//Binary type of a key.
+enum e_binary_type dsp_descType(struct s_dsp_desc_node const * const p_node, char const * const p_key, char const * const p_default)
+{
+  int index = 0;
+
+  char const *p_value = dsp_descGet(p_node, p_key, p_default);
+
+  for(index = 0; index <= DATA_UNKNOWN; index++)
+  {
+    if(!strcmp(gp_type_names[index], p_value)) return (enum e_binary_type)index;
+  }
+
+  fprintf(stderr, "ERROR: line %u, %s=%s is not a type (s8 u8 cs8 s16 u16 cs16 s32 u32 float cfloat double cdouble unknown).\n", p_node->line, p_key, p_value);
+
+  return DATA_INVALID;
+}
+
+//Size of a key.
+unsigned long dsp_descSize(struct s_dsp_desc_node const * const p_node, char const * const p_key, char const * const p_default)
+{
+  unsigned long size = 0;
+
+  char *p_end = NULL;
+
+  char const *p_value = dsp_descGet(p_node, p_key, p_default);
+
+  if(!p_value) return ~0UL;
+
+  if(!strcmp(p_value, "auto")) return DSP_SIZE_AUTO;
+
+  size = strtoul(p_value, &p_end, 0);
+
+  switch(tolower(*p_end))
+  {
+    case 'k':
+      size <<= 10;
+      p_end++;
+      break;
+    case 'm':
+      size <<= 20;
+      p_end++;
+      break;
+    case 'g':
+      size <<= 30;
+      p_end++;
+      break;
+    default:
+      break;
+  }
+
+  if((p_end == p_value) || (*p_end != '\0'))
+  {
+    fprintf(stderr, "ERROR: line %u, %s=%s is not a size (auto, number with optional k m g).\n", p_node->line, p_key, p_value);
+
+    return ~0UL;
+  }
+
+  return size;
+}
+
+//Real number of a key.
+double dsp_descReal(struct s_dsp_desc_node const * const p_node, char const * const p_key, char const * const p_default)
+{
+  char const *p_value = dsp_descGet(p_node, p_key, p_default);
+
+  if(!p_value) return 0;
+
+  return strtod(p_value, NULL);
+}
+
+//Cleanup the graph, the init args and the description.
+void dsp_descFree(struct s_dsp_desc *p_desc)
+{
+  unsigned int index = 0;
+
+  if(!p_desc) return;
+
+  dsp_graphCleanup(p_desc->p_graph);
+
+  for(index = 0; index < p_desc->num_nodes; index++)
+  {
+    struct s_dsp_desc_type const *p_type = desc_find_type(p_desc, p_desc->p_nodes[index].p_type);
+
+    if(p_type && p_desc->p_nodes[index].p_args) p_type->free_args(p_desc->p_nodes[index].p_args);
+
+    desc_free_node(&p_desc->p_nodes[index]);
+  }
+
+  desc_free_node(&p_desc->graph);
+
+  free(p_desc->p_nodes);
+
+  free(p_desc->p_edges);
+
+  free(p_desc->p_types);
+
+  free(p_desc);
+}
+
+//set a key, replacing the value if the node has it.
+static int desc_put(struct s_dsp_desc_node * const p_node, char const * const p_key, char const * const p_value)
+{
+  unsigned int index = 0;
+
+  char *p_temp = NULL;
+
+  struct s_dsp_desc_key *p_keys = NULL;
+
+  p_temp = strdup(p_value);
+
+  if(!p_temp) return ~0;
+
+  for(index = 0; index < p_node->num_keys; index++)
+  {
+    if(strcmp(p_node->p_keys[index].p_key, p_key)) continue;
+
+    free(p_node->p_keys[index].p_value);
+
+    p_node->p_keys[index].p_value = p_temp;
+
+    return 0;
+  }
+
+  p_keys = realloc(p_node->p_keys, (p_node->num_keys + 1) * sizeof(struct s_dsp_desc_key));
+
+  if(!p_keys)
+  {
+    free(p_temp);
+
+    return ~0;
+  }
+
+  p_node->p_keys = p_keys;
+
+  p_node->p_keys[p_node->num_keys].p_key = strdup(p_key);
+
+  if(!p_node->p_keys[p_node->num_keys].p_key)
+  {
+    free(p_temp);
+
+    return ~0;
+  }
+
+  p_node->p_keys[p_node->num_keys].p_value = p_temp;
+
+  p_node->num_keys++;
+
+  return 0;
+}
+
+//1 if p_key is in the space separated list p_keys.
+static int desc_known(char const *p_keys, char const * const p_key)
+{
+  size_t length = strlen(p_key);
+
+  while(p_keys && *p_keys)
+  {
+    if(!strncmp(p_keys, p_key, length) && ((p_keys[length] == ' ') || (p_keys[length] == '\0'))) return 1;
+
+    p_keys = strchr(p_keys, ' ');
+
+    if(p_keys) p_keys++;
+  }
+
+  return 0;
+}
+
+//type of a node by name.
+static struct s_dsp_desc_type const *desc_find_type(struct s_dsp_desc const * const p_desc, char const * const p_name)
+{
+  unsigned int index = 0;
+
+  for(index = 0; p_desc && (index < p_desc->num_types); index++)
+  {
+    if(!strcmp(p_desc->p_types[index].p_name, p_name)) return &p_desc->p_types[index];
+  }
+
+  for(index = 0; index < DESC_NUM_TYPES; index++)
+  {
+    if(!strcmp(g_desc_types[index].p_name, p_name)) return &g_desc_types[index];
+  }
+
+  return NULL;
+}
+
+//apply the node keys to a created node, before setup.
+static int desc_settings(struct s_dsp_desc_node * const p_node)
+{
+  int error = 0;
+
+  char const *p_value = NULL;
+
+  p_value = dsp_descGet(p_node, "ring", NULL);
+
+  if(p_value)
+  {
+    if(!strcmp(p_value, "spsc"))
+    {
+      error = dsp_setRingType(p_node->p_node, DSP_RING_SPSC);
+    }
+    else if(!strcmp(p_value, "locked"))
+    {
+      error = dsp_setRingType(p_node->p_node, DSP_RING_LOCKED);
+    }
+    else
+    {
+      fprintf(stderr, "ERROR: line %u, ring=%s is not spsc or locked.\n", p_node->line, p_value);
+
+      error = ~0;
+    }
+
+    if(error) return error;
+  }
+
+  p_value = dsp_descGet(p_node, "cpus", NULL);
+
+  if(p_value)
+  {
+    cpu_set_t cpuset;
+
+    error = desc_cpus(p_value, &cpuset);
+
+    if(error)
+    {
+      fprintf(stderr, "ERROR: line %u, cpus=%s is not a cpu list (0,2-3).\n", p_node->line, p_value);
+
+      return error;
+    }
+
+    error = dsp_setAffinity(p_node->p_node, &cpuset);
+
+    if(error) return error;
+  }
+
+  p_value = dsp_descGet(p_node, "sched", NULL);
+
+  if(p_value)
+  {
+    int policy = SCHED_OTHER;
+    int priority = 0;
+
+    char const *p_priority = strchr(p_value, ':');
+
+    if(p_priority) priority = atoi(p_priority + 1);
+
+    if(!strncmp(p_value, "fifo", 4))
+    {
+      policy = SCHED_FIFO;
+    }
+    else if(!strncmp(p_value, "rr", 2))
+    {
+      policy = SCHED_RR;
+    }
+    else if(strncmp(p_value, "other", 5))
+    {
+      fprintf(stderr, "ERROR: line %u, node %s sched=%s is not fifo:prio, rr:prio or other.\n", p_node->line, p_node->p_name, p_value);
+
+      return ~0;
+    }
+
+    error = dsp_setSched(p_node->p_node, policy, priority);
+
+    if(error)
+    {
+      fprintf(stderr, "ERROR: line %u, node %s sched=%s was rejected (priority out of range for the policy).\n", p_node->line, p_node->p_name, p_value);
+
+      return error;
+    }
+  }
+
+  if(dsp_descGet(p_node, "latency", NULL) || dsp_descGet(p_node, "budget", NULL))
+  {
+    unsigned long latency = dsp_descSize(p_node, "latency", "0");
+    unsigned long budget = dsp_descSize(p_node, "budget", "0");
+
+    if((latency == ~0UL) || (budget == ~0UL)) return ~0;
+
+    error = dsp_setSizing(p_node->p_node, latency, budget);
+
+    if(error) return error;
+  }
+
+  p_value = dsp_descGet(p_node, "alloc", NULL);
+
+  if(p_value)
+  {
+    unsigned int flags = DSP_ALLOC_DEFAULT;
+
+    int numa_node = 0;
+
+    char const *p_numa = dsp_descGet(p_node, "numa", NULL);
+
+    if(strstr(p_value, "hugetlb")) flags |= DSP_ALLOC_HUGETLB;
+    else if(strstr(p_value, "huge")) flags |= DSP_ALLOC_HUGE;
+
+    if(strstr(p_value, "prefault")) flags |= DSP_ALLOC_PREFAULT;
+
+    if(strstr(p_value, "mlock")) flags |= DSP_ALLOC_MLOCK;
+
+    if(p_numa)
+    {
+      flags |= DSP_ALLOC_NUMA;
+
+      numa_node = (strcmp(p_numa, "cpu") ? atoi(p_numa) : DSP_ALLOC_NUMA_CPU);
+    }
+
+    error = dsp_setAllocPolicy(p_node->p_node, flags, numa_node);
+
+    if(error) return error;
+  }
+
+  if(dsp_descGet(p_node, "convert", NULL))
+  {
+    error = dsp_setAutoConvert(p_node->p_node, (int)dsp_descReal(p_node, "convert", "0"));
+  }
+
+  return error;
+}
+
+//parse a cpu list into a set.
+static int desc_cpus(char const *p_list, cpu_set_t * const p_cpuset)
+{
+  CPU_ZERO(p_cpuset);
+
+  while(*p_list)
+  {
+    char *p_end = NULL;
+
+    unsigned long first = 0;
+    unsigned long last = 0;
+
+    first = strtoul(p_list, &p_end, 10);
+
+    if(p_end == p_list) return ~0;
+
+    last = first;
+
+    if(*p_end == '-')
+    {
+      p_list = p_end + 1;
+
+      last = strtoul(p_list, &p_end, 10);
+
+      if((p_end == p_list) || (last < first)) return ~0;
+    }
+
+    if(last >= CPU_SETSIZE) return ~0;
+
+    for(; first <= last; first++)
+    {
+      CPU_SET(first, p_cpuset);
+    }
+
+    if(*p_end == ',') p_end++;
+    else if(*p_end != '\0') return ~0;
+
+    p_list = p_end;
+  }
+
+  return (CPU_COUNT(p_cpuset) ? 0 : ~0);
+}
+
+//split key=value tokens of a statement into a node.
+static int desc_keys(struct s_dsp_desc_node * const p_node, char *p_save, unsigned int line)
+{
+  char *p_token = NULL;
+
+  while((p_token = strtok_r(NULL, " \t\r\n", &p_save)))
+  {
+    char *p_value = strchr(p_token, '=');
+
+    if(!p_value || (p_value == p_token))
+    {
+      fprintf(stderr, "ERROR: line %u, %s is not key=value.\n", line, p_token);
+
+      return ~0;
+    }
+
+    *p_value++ = '\0';
+
+    if(desc_put(p_node, p_token, p_value))
+    {
+      perror("DSP description key failed");
+
+      return ~0;
+    }
+  }
+
+  return 0;
+}
+
+//free the strings of a node.
+static void desc_free_node(struct s_dsp_desc_node * const p_node)
+{
+  unsigned int index = 0;
+
+  for(index = 0; index < p_node->num_keys; index++)
+  {
+    free(p_node->p_keys[index].p_key);
+
+    free(p_node->p_keys[index].p_value);
+  }
+
+  free(p_node->p_keys);
+
+  free(p_node->p_name);
+
+  free(p_node->p_type);
+
+  p_node->p_keys = NULL;
+
+  p_node->num_keys = 0;
+
+  p_node->p_name = NULL;
+
+  p_node->p_type = NULL;
+}
+
+//file read, the file sets the output type.
+static void *desc_file_read_args(struct s_dsp_desc_node const * const p_node)
+{
+  enum e_binary_type type = dsp_descType(p_node, "type", "u8");
+
+  if(type == DATA_INVALID) return NULL;
+
+  return create_file_args((char *)dsp_descGet(p_node, "file", ""), DATA_INVALID, type, OVERWRITE_FILE);
+}
+
+//file write, append or overwrite.
+static void *desc_file_write_args(struct s_dsp_desc_node const * const p_node)
+{
+  enum e_binary_type type = dsp_descType(p_node, "type", "u8");
+
+  enum e_io_method method = (strcmp(dsp_descGet(p_node, "mode", "overwrite"), "append") ? OVERWRITE_FILE : APPEND_FILE);
+
+  if(type == DATA_INVALID) return NULL;
+
+  return create_file_args((char *)dsp_descGet(p_node, "file", ""), type, DATA_INVALID, method);
+}
+
+static void desc_free_file(void *p_args)
+{
+  free_file_args((struct s_file_func_args *)p_args);
+}
+
+//convert between any two types dsp_convertSupported allows.
+static void *desc_convert_args(struct s_dsp_desc_node const * const p_node)
+{
+  enum e_binary_type input_type = dsp_descType(p_node, "in", "s16");
+  enum e_binary_type output_type = dsp_descType(p_node, "out", "float");
+
+  if((input_type == DATA_INVALID) || (output_type == DATA_INVALID)) return NULL;
+
+  return create_convert_args(input_type, output_type, (int)dsp_descReal(p_node, "swap", "0"));
+}
+
+static void desc_free_convert(void *p_args)
+{
+  free_convert_args((struct s_dsp_convert_args *)p_args);
+}
+
+//shm read, unknown takes the type of the ring.
+static void *desc_shm_read_args(struct s_dsp_desc_node const * const p_node)
+{
+  enum e_binary_type type = dsp_descType(p_node, "type", "unknown");
+
+  if(type == DATA_INVALID) return NULL;
+
+  return create_shm_args((char *)dsp_descGet(p_node, "name", ""), type, 0, 0);
+}
+
+//shm write, lossless unless drop is set.
+static void *desc_shm_write_args(struct s_dsp_desc_node const * const p_node)
+{
+  unsigned long size = dsp_descSize(p_node, "size", "0");
+
+  enum e_binary_type type = dsp_descType(p_node, "type", "u8");
+
+  if((type == DATA_INVALID) || (size == ~0UL)) return NULL;
+
+  return create_shm_args((char *)dsp_descGet(p_node, "name", ""), type, size, (int)dsp_descReal(p_node, "drop", "0"));
+}
+
+static void desc_free_shm(void *p_args)
+{
+  free_shm_args((struct s_shm_func_args *)p_args);
+}
+
+//generator, wave is constant, tone, chirp, noise or prbs.
+static void *desc_gen_args(struct s_dsp_desc_node const * const p_node)
+{
+  static char const * const p_waves[] = {"constant", "tone", "chirp", "noise", "prbs"};
+
+  unsigned int wave = 0;
+
+  unsigned long count = dsp_descSize(p_node, "count", "0");
+
+  char const *p_wave = dsp_descGet(p_node, "wave", "constant");
+
+  enum e_binary_type type = dsp_descType(p_node, "type", "u8");
+
+  for(wave = 0; wave < sizeof(p_waves) / sizeof(p_waves[0]); wave++)
+  {
+    if(!strcmp(p_wave, p_waves[wave])) break;
+  }
+
+  if(wave == sizeof(p_waves) / sizeof(p_waves[0]))
+  {
+    fprintf(stderr, "ERROR: line %u, wave=%s is not constant, tone, chirp, noise or prbs.\n", p_node->line, p_wave);
+
+    return NULL;
+  }
+
+  if((type == DATA_INVALID) || (count == ~0UL)) return NULL;
+
+  return create_gen_args((enum e_gen_wave)wave, type, dsp_descReal(p_node, "rate", "0"), (int)dsp_descReal(p_node, "pace", "0"), dsp_descReal(p_node, "amplitude", "1"), dsp_descReal(p_node, "freq", "0"), dsp_descReal(p_node, "freq_end", "0"), dsp_descReal(p_node, "sweep", "1"), count, strtoull(dsp_descGet(p_node, "seed", "0"), NULL, 0));
+}
+
+static void desc_free_gen(void *p_args)
+{
+  free_gen_args((struct s_gen_func_args *)p_args);
+}
+
+//null sink, checksums unless checksum=0.
+static void *desc_null_args(struct s_dsp_desc_node const * const p_node)
+{
+  enum e_binary_type type = dsp_descType(p_node, "type", "u8");
+
+  if(type == DATA_INVALID) return NULL;
+
+  return create_null_args(type, (int)dsp_descReal(p_node, "checksum", "1"));
+}
+
+static void desc_free_null(void *p_args)
+{
+  free_null_args((struct s_null_func_args *)p_args);
+}
+
+#ifdef DSP_DESC_ALSA
+//alsa read or write, format is the alsa name (S16_LE, U8, FLOAT_LE).
+static void *desc_alsa_args(struct s_dsp_desc_node const * const p_node)
+{
+  snd_pcm_format_t format = snd_pcm_format_value(dsp_descGet(p_node, "format", "S16_LE"));
+
+  if(format == SND_PCM_FORMAT_UNKNOWN)
+  {
+    fprintf(stderr, "ERROR: line %u, format=%s is not a alsa format.\n", p_node->line, dsp_descGet(p_node, "format", "S16_LE"));
+
+    return NULL;
+  }
+
+  return create_alsa_args((char *)dsp_descGet(p_node, "device", "default"), format, (unsigned int)dsp_descReal(p_node, "channels", "1"), (unsigned int)dsp_descReal(p_node, "rate", "48000"));
+}
+
+static void desc_free_alsa(void *p_args)
+{
+  free_alsa_args((struct s_alsa_func_args *)p_args);
+}
+#endif
+
+#ifdef DSP_DESC_CODEC2
+//codec2 mod or demod, type of the modem samples.
+static void *desc_codec2_args(struct s_dsp_desc_node const * const p_node)
+{
+  enum e_binary_type type = dsp_descType(p_node, "type", "s16");
+
+  if(type == DATA_INVALID) return NULL;
+
+  return create_codec2_args(type);
+}
+
+static void desc_free_codec2(void *p_args)
+{
+  free_codec2_args((struct s_codec2_func_args *)p_args);
+}
+#endif
+
+#ifdef DSP_DESC_SOXR
+//soxr resample, both rates are needed.
+static void *desc_soxr_args(struct s_dsp_desc_node const * const p_node)
+{
+  enum e_binary_type input_type = dsp_descType(p_node, "in", "cfloat");
+  enum e_binary_type output_type = dsp_descType(p_node, "out", "cfloat");
+
+  if((input_type == DATA_INVALID) || (output_type == DATA_INVALID)) return NULL;
+
+  if(!dsp_descGet(p_node, "in_rate", NULL) || !dsp_descGet(p_node, "out_rate", NULL))
+  {
+    fprintf(stderr, "ERROR: line %u, soxr needs in_rate and out_rate.\n", p_node->line);
+
+    return NULL;
+  }
+
+  return create_soxr_args(dsp_descReal(p_node, "in_rate", NULL), dsp_descReal(p_node, "out_rate", NULL), input_type, output_type, (unsigned)dsp_descReal(p_node, "channels", "2"));
+}
+
+static void desc_free_soxr(void *p_args)
+{
+  free_soxr_args((struct s_soxr_func_args *)p_args);
+}
+#endif
+
+#ifdef DSP_DESC_TCP_SERVER
+//tcp server send or recv.
+static void *desc_tcp_args(struct s_dsp_desc_node const * const p_node)
+{
+  enum e_binary_type input_type = dsp_descType(p_node, "in", "u8");
+  enum e_binary_type output_type = dsp_descType(p_node, "out", "u8");
+
+  if((input_type == DATA_INVALID) || (output_type == DATA_INVALID)) return NULL;
+
+  return create_tcp_args((char *)dsp_descGet(p_node, "address", "127.0.0.1"), (unsigned short)dsp_descReal(p_node, "port", "2000"), input_type, output_type);
+}
+
+static void desc_free_tcp(void *p_args)
+{
+  free_tcp_args((struct s_tcp_func_args *)p_args);
+}
+#endif
+
+#ifdef DSP_DESC_UHD
+//uhd rx or tx, cpu is the uhd cpu format (sc16, fc32).
+static void *desc_uhd_args(struct s_dsp_desc_node const * const p_node)
+{
+  return create_uhd_args((char *)dsp_descGet(p_node, "args", ""), dsp_descReal(p_node, "freq", "0"), dsp_descReal(p_node, "rate", "0"), dsp_descReal(p_node, "gain", "0"), dsp_descReal(p_node, "bw", "0"), (char *)dsp_descGet(p_node, "cpu", "sc16"));
+}
+
+static void desc_free_uhd(void *p_args)
+{
+  free_uhd_args((struct s_uhd_func_args *)p_args);
+}
+#endif
+
+#ifdef DSP_DESC_VOSK
+//vosk speech to text.
+static void *desc_vosk_args(struct s_dsp_desc_node const * const p_node)
+{
+  enum e_binary_type type = dsp_descType(p_node, "type", "u8");
+
+  if(type == DATA_INVALID) return NULL;
+
+  return create_vosk_args((float)dsp_descReal(p_node, "rate", "16000"), type);
+}
+
+static void desc_free_vosk(void *p_args)
+{
+  free_vosk_args((struct s_vosk_func_args *)p_args);
+}
+#endif
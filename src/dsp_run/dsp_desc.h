@@ -0,0 +1,361 @@
+//******************************************************************************
+/// @file     dsp_desc.h
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    Text description of a node graph, parsed and built into a s_dsp_graph.
+/// @details  One statement per line, # starts a comment.
+///           graph key=value ...           graph settings (fusion, pool).
+///           node name type key=value ...  node of a type with its args.
+///           edge src dst key=value ...    connect src output to dst (port, buffer).
+//******************************************************************************
+
+#ifndef __dsp_desc
+#define __dsp_desc
+
+// includes
+#include <stdio.h>
+
+#include "dsp_graph.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def DSP_DESC_LINE
+ * Longest line of a description file, in chars.
+ */
+#define DSP_DESC_LINE 1024
+
+/**
+ * @struct s_dsp_desc_key
+ * @brief A key=value pair of a node or the graph.
+ */
+struct s_dsp_desc_key
+{
+  /**
+   * @var s_dsp_desc_key::p_key
+   * key, text before the first =.
+   */
+  char *p_key;
+  /**
+   * @var s_dsp_desc_key::p_value
+   * value, text after the first =.
+   */
+  char *p_value;
+};
+
+/**
+ * @struct s_dsp_desc_node
+ * @brief A node statement, built into a node of the graph.
+ */
+struct s_dsp_desc_node;
+
+/**
+ * @struct s_dsp_desc_type
+ * @brief A node type, the args are created from the keys of a node statement.
+ */
+struct s_dsp_desc_type
+{
+  /**
+   * @var s_dsp_desc_type::p_name
+   * name node statements use for the type.
+   */
+  char const *p_name;
+  /**
+   * @var s_dsp_desc_type::p_keys
+   * space separated keys of the args, any other key is a error.
+   */
+  char const *p_keys;
+  /**
+   * @var s_dsp_desc_type::create_args
+   * create the init args from the node keys, NULL on error.
+   */
+  void *(*create_args)(struct s_dsp_desc_node const * const p_node);
+  /**
+   * @var s_dsp_desc_type::free_args
+   * free args from create_args.
+   */
+  void (*free_args)(void *p_args);
+  /**
+   * @var s_dsp_desc_type::init_call
+   * init callback of the node.
+   */
+  init_callback init_call;
+  /**
+   * @var s_dsp_desc_type::thread_func
+   * pthread function of the node.
+   */
+  pthread_function thread_func;
+  /**
+   * @var s_dsp_desc_type::free_call
+   * free callback of the node.
+   */
+  free_callback free_call;
+};
+
+/**
+ * @struct s_dsp_desc_node
+ * @brief A node statement, built into a node of the graph.
+ */
+struct s_dsp_desc_node
+{
+  /**
+   * @var s_dsp_desc_node::p_name
+   * name edges and overrides use for the node.
+   */
+  char *p_name;
+  /**
+   * @var s_dsp_desc_node::p_type
+   * node type, one of the types dsp_descTypes lists.
+   */
+  char *p_type;
+  /**
+   * @var s_dsp_desc_node::p_keys
+   * array of keys, node settings and args of the type.
+   */
+  struct s_dsp_desc_key *p_keys;
+  /**
+   * @var s_dsp_desc_node::num_keys
+   * number of keys in p_keys.
+   */
+  unsigned int num_keys;
+  /**
+   * @var s_dsp_desc_node::line
+   * line of the statement, for errors.
+   */
+  unsigned int line;
+  /**
+   * @var s_dsp_desc_node::p_args
+   * init args created from the keys by build, freed by dsp_descFree.
+   */
+  void *p_args;
+  /**
+   * @var s_dsp_desc_node::p_node
+   * node created by build, owned by the graph.
+   */
+  struct s_dsp_node *p_node;
+};
+
+/**
+ * @struct s_dsp_desc_edge
+ * @brief A edge statement.
+ */
+struct s_dsp_desc_edge
+{
+  /**
+   * @var s_dsp_desc_edge::src
+   * index of the node that writes the edge.
+   */
+  unsigned int src;
+  /**
+   * @var s_dsp_desc_edge::dst
+   * index of the node that reads the edge.
+   */
+  unsigned int dst;
+  /**
+   * @var s_dsp_desc_edge::port
+   * input port of dst.
+   */
+  unsigned int port;
+  /**
+   * @var s_dsp_desc_edge::line
+   * line of the statement, for errors.
+   */
+  unsigned int line;
+};
+
+/**
+ * @struct s_dsp_desc
+ * @brief Parsed description and the graph built from it.
+ */
+struct s_dsp_desc
+{
+  /**
+   * @var s_dsp_desc::p_nodes
+   * array of node statements, in file order.
+   */
+  struct s_dsp_desc_node *p_nodes;
+  /**
+   * @var s_dsp_desc::num_nodes
+   * number of nodes in p_nodes.
+   */
+  unsigned int num_nodes;
+  /**
+   * @var s_dsp_desc::p_edges
+   * array of edge statements, in file order.
+   */
+  struct s_dsp_desc_edge *p_edges;
+  /**
+   * @var s_dsp_desc::num_edges
+   * number of edges in p_edges.
+   */
+  unsigned int num_edges;
+  /**
+   * @var s_dsp_desc::graph
+   * keys of the graph statements, p_name and p_type unused.
+   */
+  struct s_dsp_desc_node graph;
+  /**
+   * @var s_dsp_desc::p_graph
+   * graph created by build, NULL before.
+   */
+  struct s_dsp_graph *p_graph;
+  /**
+   * @var s_dsp_desc::p_types
+   * array of types added with dsp_descAddType, found before the built in ones.
+   */
+  struct s_dsp_desc_type *p_types;
+  /**
+   * @var s_dsp_desc::num_types
+   * number of types in p_types.
+   */
+  unsigned int num_types;
+};
+
+/**************************************************************************//**
+  * @brief Allocate a empty description.
+  *
+  * @return allocated description, NULL on error.
+  ****************************************************************************/
+struct s_dsp_desc *dsp_descCreate(void);
+
+/**************************************************************************//**
+  * @brief Add a node type for this description, call before parsing nodes of
+  * it. Tools add their own nodes this way.
+  *
+  * @param p_desc struct s_dsp_desc object from dsp_descCreate
+  * @param p_type type to copy, the strings must live as long as p_desc.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_descAddType(struct s_dsp_desc * const p_desc, struct s_dsp_desc_type const * const p_type);
+
+/**************************************************************************//**
+  * @brief Check a node type is built in or added.
+  *
+  * @param p_desc struct s_dsp_desc object, NULL for built in only.
+  * @param p_name name of the type.
+  *
+  * @return 1 the type exists, 0 it does not.
+  ****************************************************************************/
+int dsp_descHasType(struct s_dsp_desc const * const p_desc, char const * const p_name);
+
+/**************************************************************************//**
+  * @brief Parse a description file into p_desc, can be called more then once
+  * to add to it.
+  *
+  * @param p_desc struct s_dsp_desc object from dsp_descCreate
+  * @param p_file path of the file to read, "-" for stdin.
+  *
+  * @return 0 no error, non-zero indicates error (printed with the line).
+  ****************************************************************************/
+int dsp_descLoad(struct s_dsp_desc * const p_desc, char const * const p_file);
+
+/**************************************************************************//**
+  * @brief Parse one statement, same syntax as a line of the file.
+  *
+  * @param p_desc struct s_dsp_desc object from dsp_descCreate
+  * @param p_line statement to parse.
+  * @param line line number for errors.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_descParse(struct s_dsp_desc * const p_desc, char const * const p_line, unsigned int line);
+
+/**************************************************************************//**
+  * @brief Set a key of a node or the graph, replacing the value from the file.
+  * Call before dsp_descBuild.
+  *
+  * @param p_desc struct s_dsp_desc object
+  * @param p_set name.key=value, name is a node name or graph.
+  *
+  * @return 0 no error, non-zero indicates error.
+  ****************************************************************************/
+int dsp_descSet(struct s_dsp_desc * const p_desc, char const * const p_set);
+
+/**************************************************************************//**
+  * @brief Create, setup and connect every node into a graph, not started.
+  *
+  * @param p_desc struct s_dsp_desc object
+  *
+  * @return graph owned by p_desc, NULL on error.
+  ****************************************************************************/
+struct s_dsp_graph *dsp_descBuild(struct s_dsp_desc * const p_desc);
+
+/**************************************************************************//**
+  * @brief Index of a node by name.
+  *
+  * @param p_desc struct s_dsp_desc object
+  * @param p_name name of the node.
+  *
+  * @return index in p_nodes, num_nodes if there is none.
+  ****************************************************************************/
+unsigned int dsp_descFind(struct s_dsp_desc const * const p_desc, char const * const p_name);
+
+/**************************************************************************//**
+  * @brief Value of a key of a node statement, for create_args.
+  *
+  * @param p_node node statement.
+  * @param p_key key to find.
+  * @param p_default returned when the node does not have the key.
+  *
+  * @return value of the key or p_default.
+  ****************************************************************************/
+char const *dsp_descGet(struct s_dsp_desc_node const * const p_node, char const * const p_key, char const * const p_default);
+
+/**************************************************************************//**
+  * @brief Binary type of a key (s8 u8 cs8 s16 u16 cs16 s32 u32 float cfloat
+  * double cdouble unknown).
+  *
+  * @param p_node node statement.
+  * @param p_key key to find.
+  * @param p_default type name used when the node does not have the key.
+  *
+  * @return type, DATA_INVALID with a error printed if it is not a type.
+  ****************************************************************************/
+enum e_binary_type dsp_descType(struct s_dsp_desc_node const * const p_node, char const * const p_key, char const * const p_default);
+
+/**************************************************************************//**
+  * @brief Size of a key, auto for DSP_SIZE_AUTO or a number with a k, m or g
+  * binary multiple.
+  *
+  * @param p_node node statement.
+  * @param p_key key to find.
+  * @param p_default size used when the node does not have the key.
+  *
+  * @return size, ~0UL with a error printed if it is not a size.
+  ****************************************************************************/
+unsigned long dsp_descSize(struct s_dsp_desc_node const * const p_node, char const * const p_key, char const * const p_default);
+
+/**************************************************************************//**
+  * @brief Real number of a key.
+  *
+  * @param p_node node statement.
+  * @param p_key key to find.
+  * @param p_default number used when the node does not have the key.
+  *
+  * @return number, 0 if there is no key and no default.
+  ****************************************************************************/
+double dsp_descReal(struct s_dsp_desc_node const * const p_node, char const * const p_key, char const * const p_default);
+
+/**************************************************************************//**
+  * @brief Print the node types built in or added and their keys.
+  *
+  * @param p_desc struct s_dsp_desc object, NULL for built in only.
+  * @param p_file stream to print to.
+  ****************************************************************************/
+void dsp_descTypes(struct s_dsp_desc const * const p_desc, FILE *p_file);
+
+/**************************************************************************//**
+  * @brief Cleanup the graph (if built), the init args and the description.
+  *
+  * @param p_desc struct s_dsp_desc object
+  ****************************************************************************/
+void dsp_descFree(struct s_dsp_desc *p_desc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
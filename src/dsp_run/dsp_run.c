@@ -0,0 +1,162 @@
+//******************************************************************************
+/// @file     dsp_run.c
+/// @author   Jay Convertino(johnathan.convertino.1@us.af.mil)
+/// @date     2026.10.16
+/// @brief    run any pipeline from a graph description file, no rebuild to tune it.
+//******************************************************************************
+
+// standard includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <getopt.h>
+
+// local includes
+#include "dsp_node.h"
+#include "dsp_graph.h"
+#include "dsp_desc.h"
+#include "kill_throbber.h"
+
+void help();
+
+// main :)
+int main(int argc, char *argv[])
+{
+  // varibles
+  int error = 0;
+  int opt   = 0;
+  int index = 0;
+  int num_sets = 0;
+  int dry_run = 0;
+
+  // arrays
+  char *p_desc_file = NULL;
+
+  char **pp_sets = NULL;
+
+  // structs
+  struct s_dsp_desc *p_desc = NULL;
+  struct s_dsp_graph *p_graph = NULL;
+
+  pp_sets = calloc((size_t)argc, sizeof(char *));
+
+  if(!pp_sets) return EXIT_FAILURE;
+
+  // get args
+  while((opt = getopt(argc, argv, "f:s:nth")) != -1)
+  {
+    switch(opt)
+    {
+      case 'f':
+        p_desc_file = optarg;
+        break;
+      case 's':
+        pp_sets[num_sets++] = optarg;
+        break;
+      case 'n':
+        dry_run = 1;
+        break;
+      case 't':
+        dsp_descTypes(NULL, stdout);
+        free(pp_sets);
+        return EXIT_SUCCESS;
+      case 'h':
+        help();
+        free(pp_sets);
+        return EXIT_SUCCESS;
+      default:
+        help();
+        free(pp_sets);
+        return EXIT_FAILURE;
+    }
+  }
+
+  if(!p_desc_file)
+  {
+    fprintf(stderr, "ERROR: graph description file needed.\n");
+
+    help();
+
+    free(pp_sets);
+
+    return EXIT_FAILURE;
+  }
+
+  p_desc = dsp_descCreate();
+
+  if(!p_desc) goto cleanup_sets;
+
+  error = dsp_descLoad(p_desc, p_desc_file);
+
+  if(error) goto cleanup_desc;
+
+  for(index = 0; index < num_sets; index++)
+  {
+    error = dsp_descSet(p_desc, pp_sets[index]);
+
+    if(error) goto cleanup_desc;
+  }
+
+  p_graph = dsp_descBuild(p_desc);
+
+  if(!p_graph)
+  {
+    error = ~0;
+
+    goto cleanup_desc;
+  }
+
+  if(dry_run)
+  {
+    printf("%s: %u nodes, %u edges built.\n", p_desc_file, p_desc->num_nodes, p_desc->num_edges);
+
+    goto cleanup_desc;
+  }
+
+  kill_throbber_create();
+
+  error = dsp_graphStart(p_graph);
+
+  if(error) goto cleanup_desc;
+
+  kill_throbber_start();
+
+  error = dsp_graphWait(p_graph);
+
+  kill_throbber_end();
+
+  kill_throbber_wait();
+
+cleanup_desc:
+  dsp_descFree(p_desc);
+
+cleanup_sets:
+  free(pp_sets);
+
+  return (error ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+// help
+void help()
+{
+  printf("\n");
+
+  printf("Run a pipeline from a graph description file.\n");
+
+  printf("-f:\tGraph description file, - for stdin.\n");
+  printf("-s:\tSet a key, name.key=value (graph.key=value), repeat for more.\n");
+  printf("-n:\tBuild the graph and exit, checks the description.\n");
+  printf("-t:\tList the node types and keys built in.\n");
+  printf("-h:\tThis help information.\n");
+
+  printf("\n");
+
+  printf("Description, one statement per line, # starts a comment:\n");
+  printf("  graph fusion=1 pool=cores\n");
+  printf("  node src file_read file=in.bin type=u8 chunk=64k cpus=2 ring=spsc\n");
+  printf("  node dst file_write file=out.bin type=u8\n");
+  printf("  edge src dst buffer=4m\n");
+
+  printf("\n");
+}
@@ -18,15 +18,13 @@
 #define BUF_SIZE 1 << 10
 #define RD_SIZE  1 << 8
 
-// pthread writer var
-static pthread_t writer_thread;
 // pthread writer func
 void *pthread_file_writer(void *p_data);
 // string writer function
 int string_write(struct s_logger *p_logger, const char *p_append, const char *p_message, va_list arg);
 
 // Create logger
-struct s_logger *logger_create(char *p_file)
+struct s_logger *logger_create(char const *p_file)
 {
   int error = 0;
 
@@ -79,7 +77,7 @@ struct s_logger *logger_create(char *p_file)
     goto error_ringbuffer;
   }
 
-  error = pthread_create(&writer_thread, NULL, pthread_file_writer, p_temp);
+  error = pthread_create(&p_temp->writer_thread, NULL, pthread_file_writer, p_temp);
 
   if(error)
   {
@@ -166,7 +164,7 @@ int logger_cleanup(struct s_logger *p_logger)
 
   ringBufferEndBlocking(p_logger->p_ringbuffer);
 
-  pthread_join(writer_thread, NULL);
+  pthread_join(p_logger->writer_thread, NULL);
 
   freeRingBuffer(&p_logger->p_ringbuffer);
 
@@ -8,6 +8,9 @@
 #ifndef __logger
 #define __logger
 
+#include <stdio.h>
+#include <pthread.h>
+
 #include "ringBuffer.h"
 
 #ifdef __cplusplus
@@ -35,6 +38,11 @@ struct s_logger
    * ringbuffer that stores strings formatted by methods to be written by logger.
    */
   struct s_ringBuffer *p_ringbuffer;
+  /**
+   * @var s_logger::writer_thread
+   * thread writing strings from the ringbuffer to the file, one per logger.
+   */
+  pthread_t writer_thread;
 };
 
 /**************************************************************************//**
@@ -44,7 +52,7 @@ struct s_logger
   *
   * @return logger object
   ****************************************************************************/
-struct s_logger *logger_create(char *p_file);
+struct s_logger *logger_create(char const *p_file);
 
 /**************************************************************************//**
   * @brief Write error messages, appends "ERROR: " at begining and newline at end.